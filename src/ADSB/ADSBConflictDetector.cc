@@ -0,0 +1,143 @@
+#include "ADSBConflictDetector.h"
+#include "ADSBTrafficStore.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QtMath>
+#include <algorithm>
+#include <cmath>
+
+QGC_LOGGING_CATEGORY(ADSBConflictDetectorLog, "ADSB.ADSBConflictDetector")
+
+namespace {
+
+constexpr double kMetersPerDegreeLatitude = 111320.;
+constexpr double kMinRelativeSpeedSquared = 1e-6;   ///< Avoids dividing by zero for aircraft moving with the vehicle
+
+} // namespace
+
+void ADSBConflictDetector::evaluate(const ADSBTrafficStore &store, const QList<OwnVehicle> &ownVehicles, const Thresholds &thresholds, QList<Threat> &threats)
+{
+    threats.clear();
+
+    const qsizetype targetCount = store.count();
+    if ((targetCount == 0) || ownVehicles.isEmpty()) {
+        return;
+    }
+
+    _prepareTargets(store);
+
+    _distance.resize(targetCount);
+    _cpaDistance.resize(targetCount);
+    _tcpa.resize(targetCount);
+    _verticalSeparation.resize(targetCount);
+    _conflict.resize(targetCount);
+
+    for (const OwnVehicle &ownVehicle : ownVehicles) {
+        if (!ownVehicle.position.isValid()) {
+            continue;
+        }
+
+        _evaluateVehicle(store, ownVehicle, thresholds);
+
+        for (qsizetype i = 0; i < targetCount; i++) {
+            if (_conflict[i]) {
+                threats.append(Threat{
+                    store.icaoAddress(static_cast<int>(i)),
+                    ownVehicle.id,
+                    _distance[i],
+                    _cpaDistance[i],
+                    _tcpa[i],
+                    _verticalSeparation[i]
+                });
+            }
+        }
+    }
+
+    std::sort(threats.begin(), threats.end(), [](const Threat &a, const Threat &b) {
+        if (a.tcpa != b.tcpa) {
+            return a.tcpa < b.tcpa;
+        }
+        return a.cpaDistance < b.cpaDistance;
+    });
+
+    qCDebug(ADSBConflictDetectorLog) << threats.count() << "threats from" << targetCount << "aircraft against" << ownVehicles.count() << "vehicles";
+}
+
+void ADSBConflictDetector::_prepareTargets(const ADSBTrafficStore &store)
+{
+    const qsizetype targetCount = store.count();
+    _velocityEast.resize(targetCount);
+    _velocityNorth.resize(targetCount);
+    _velocityUp.resize(targetCount);
+
+    const double *heading = store.headings().constData();
+    const double *velocity = store.velocities().constData();
+    const double *verticalVel = store.verticalVels().constData();
+
+    // Aircraft which did not report a velocity yet are treated as stationary
+    for (qsizetype i = 0; i < targetCount; i++) {
+        const double speed = std::isnan(velocity[i]) || std::isnan(heading[i]) ? 0. : velocity[i];
+        const double track = std::isnan(heading[i]) ? 0. : qDegreesToRadians(heading[i]);
+        _velocityEast[i] = speed * std::sin(track);
+        _velocityNorth[i] = speed * std::cos(track);
+        _velocityUp[i] = std::isnan(verticalVel[i]) ? 0. : verticalVel[i];
+    }
+}
+
+void ADSBConflictDetector::_evaluateVehicle(const ADSBTrafficStore &store, const OwnVehicle &ownVehicle, const Thresholds &thresholds)
+{
+    const qsizetype targetCount = store.count();
+
+    // Equirectangular projection around the vehicle, accurate to well below the thresholds at lookahead distances
+    const double ownLatitude = ownVehicle.position.latitude();
+    const double ownLongitude = ownVehicle.position.longitude();
+    const double ownAltitude = ownVehicle.position.altitude();
+    const double metersPerDegreeLongitude = kMetersPerDegreeLatitude * std::cos(qDegreesToRadians(ownLatitude));
+
+    const double horizontalThreshold = thresholds.horizontalMeters;
+    const double verticalThreshold = thresholds.verticalMeters;
+    const double lookahead = thresholds.lookaheadSeconds;
+
+    const double *latitude = store.latitudes().constData();
+    const double *longitude = store.longitudes().constData();
+    const double *altitude = store.altitudes().constData();
+    const double *velocityEast = _velocityEast.constData();
+    const double *velocityNorth = _velocityNorth.constData();
+    const double *velocityUp = _velocityUp.constData();
+
+    double *distance = _distance.data();
+    double *cpaDistance = _cpaDistance.data();
+    double *tcpa = _tcpa.data();
+    double *verticalSeparation = _verticalSeparation.data();
+    unsigned char *conflict = _conflict.data();
+
+    // Keep this loop free of branches and calls other than sqrt/nearbyint so it vectorizes
+    for (qsizetype i = 0; i < targetCount; i++) {
+        double deltaLongitude = longitude[i] - ownLongitude;
+        deltaLongitude -= 360. * std::nearbyint(deltaLongitude / 360.);
+
+        const double east = deltaLongitude * metersPerDegreeLongitude;
+        const double north = (latitude[i] - ownLatitude) * kMetersPerDegreeLatitude;
+        const double up = altitude[i] - ownAltitude;
+
+        const double relativeEast = velocityEast[i] - ownVehicle.velocityEast;
+        const double relativeNorth = velocityNorth[i] - ownVehicle.velocityNorth;
+        const double relativeUp = velocityUp[i] - ownVehicle.velocityUp;
+
+        const double relativeSpeedSquared = std::max((relativeEast * relativeEast) + (relativeNorth * relativeNorth), kMinRelativeSpeedSquared);
+        const double time = std::clamp(-((east * relativeEast) + (north * relativeNorth)) / relativeSpeedSquared, 0., lookahead);
+
+        const double cpaEast = east + (relativeEast * time);
+        const double cpaNorth = north + (relativeNorth * time);
+        const double miss = std::sqrt((cpaEast * cpaEast) + (cpaNorth * cpaNorth));
+        const double separation = std::abs(up + (relativeUp * time));
+
+        distance[i] = std::sqrt((east * east) + (north * north));
+        cpaDistance[i] = miss;
+        tcpa[i] = time;
+        verticalSeparation[i] = separation;
+
+        // An unknown altitude gives a NaN separation, which is treated as conflicting
+        conflict[i] = static_cast<unsigned char>((miss <= horizontalThreshold) & !(separation >= verticalThreshold));
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QtCore/QList>
+#include <QtPositioning/QGeoCoordinate>
+
+class ADSBTrafficStore;
+
+/// Closest point of approach (CPA) evaluation of the tracked ADS-B traffic against own vehicles.
+///
+/// Every aircraft in the store is projected into a local east/north/up frame around each own vehicle and
+/// extrapolated at constant velocity. The time of horizontal closest approach (TCPA) is clamped to
+/// [0, lookahead], and an aircraft is a threat when both the horizontal miss distance and the vertical
+/// separation at that time are inside the thresholds. The per aircraft math runs as branch free loops
+/// over contiguous arrays so the compiler can vectorize it, which keeps thousands of targets against
+/// several vehicles well inside a 10 Hz budget.
+class ADSBConflictDetector
+{
+public:
+    struct Thresholds {
+        double horizontalMeters = 600.;
+        double verticalMeters = 75.;
+        double lookaheadSeconds = 60.;
+    };
+
+    struct OwnVehicle {
+        int id = 0;
+        QGeoCoordinate position;        ///< Altitude is AMSL, an unknown altitude is treated as conflicting vertically
+        double velocityEast = 0.;       ///< m/s
+        double velocityNorth = 0.;      ///< m/s
+        double velocityUp = 0.;         ///< m/s
+    };
+
+    struct Threat {
+        uint32_t icaoAddress = 0;
+        int vehicleId = 0;
+        double distance = 0.;           ///< Current horizontal distance, m
+        double cpaDistance = 0.;        ///< Horizontal distance at the closest point of approach, m
+        double tcpa = 0.;               ///< Time to the closest point of approach, s
+        double verticalSeparation = 0.; ///< Vertical separation at the closest point of approach, m, NaN if unknown
+    };
+
+    /// Evaluates all aircraft in store against ownVehicles.
+    ///     @param threats Replaced with the threats ranked by time to closest approach, then miss distance
+    void evaluate(const ADSBTrafficStore &store, const QList<OwnVehicle> &ownVehicles, const Thresholds &thresholds, QList<Threat> &threats);
+
+private:
+    void _prepareTargets(const ADSBTrafficStore &store);
+    void _evaluateVehicle(const ADSBTrafficStore &store, const OwnVehicle &ownVehicle, const Thresholds &thresholds);
+
+    // Target state in the same order as the store slots, reused between calls
+    QList<double> _velocityEast;
+    QList<double> _velocityNorth;
+    QList<double> _velocityUp;
+
+    // Per vehicle results, reused between vehicles
+    QList<double> _distance;
+    QList<double> _cpaDistance;
+    QList<double> _tcpa;
+    QList<double> _verticalSeparation;
+    QList<unsigned char> _conflict;
+};
@@ -0,0 +1,247 @@
+#include "ADSBSBSParser.h"
+#include "QGCLoggingCategory.h"
+
+#include <array>
+
+QGC_LOGGING_CATEGORY(ADSBSBSParserLog, "ADSB.ADSBSBSParser")
+
+namespace {
+
+constexpr qsizetype kMaxFields = 22; ///< MSG lines have 22 comma separated fields
+
+constexpr qsizetype kIcaoField = 4;
+constexpr qsizetype kCallsignField = 10;
+constexpr qsizetype kAltitudeField = 11;
+constexpr qsizetype kGroundSpeedField = 12;
+constexpr qsizetype kTrackField = 13;
+constexpr qsizetype kLatitudeField = 14;
+constexpr qsizetype kLongitudeField = 15;
+constexpr qsizetype kVerticalRateField = 16;
+constexpr qsizetype kAlertField = 19;
+
+constexpr double kFeetToMeters = 0.3048;
+constexpr double kKnotsToMetersPerSecond = 0.514444;
+constexpr double kFeetPerMinuteToMetersPerSecond = 0.00508;
+
+} // namespace
+
+qsizetype ADSBSBSParser::parse(QByteArrayView data)
+{
+    qsizetype consumed = 0;
+    while (consumed < data.size()) {
+        const qsizetype newline = data.indexOf('\n', consumed);
+        if (newline < 0) {
+            break;
+        }
+
+        Update update;
+        if (_parseLine(data.sliced(consumed, newline - consumed), update)) {
+            const auto it = _pending.find(update.icaoAddress);
+            if (it == _pending.end()) {
+                ADSB::VehicleInfo_t vehicleInfo;
+                vehicleInfo.icaoAddress = update.icaoAddress;
+                _apply(update, vehicleInfo);
+                (void) _pending.insert(update.icaoAddress, vehicleInfo);
+            } else {
+                _apply(update, it.value());
+            }
+        }
+
+        ++_linesParsed;
+        consumed = newline + 1;
+    }
+
+    return consumed;
+}
+
+bool ADSBSBSParser::parseLine(QByteArrayView line, ADSB::VehicleInfo_t &vehicleInfo)
+{
+    Update update;
+    if (!_parseLine(line, update)) {
+        return false;
+    }
+
+    vehicleInfo.icaoAddress = update.icaoAddress;
+    vehicleInfo.availableFlags = ADSB::AvailableInfoType();
+    _apply(update, vehicleInfo);
+    return true;
+}
+
+QList<ADSB::VehicleInfo_t> ADSBSBSParser::takePendingUpdates()
+{
+    QList<ADSB::VehicleInfo_t> updates;
+    updates.reserve(_pending.size());
+    for (auto it = _pending.cbegin(); it != _pending.cend(); ++it) {
+        updates.append(it.value());
+    }
+    _pending.clear();
+    return updates;
+}
+
+bool ADSBSBSParser::_parseLine(QByteArrayView line, Update &update)
+{
+    while (!line.isEmpty() && ((line.back() == '\n') || (line.back() == '\r'))) {
+        line.chop(1);
+    }
+
+    if ((line.size() <= 4) || !line.startsWith("MSG")) {
+        return false;
+    }
+
+    const char msgTypeChar = line.at(4);
+    if ((msgTypeChar < '0') || (msgTypeChar > '9')) {
+        qCDebug(ADSBSBSParserLog) << "ADSB Invalid message type" << msgTypeChar;
+        return false;
+    }
+
+    // Skip unsupported mesg types to avoid parsing
+    const int msgType = msgTypeChar - '0';
+    if ((msgType < ADSB::IdentificationAndCategory) || (msgType == ADSB::SurfacePosition) || (msgType > ADSB::SurveillanceId)) {
+        return false;
+    }
+
+    std::array<QByteArrayView, kMaxFields> fields;
+    qsizetype fieldCount = 0;
+    qsizetype fieldStart = 0;
+    while (fieldCount < kMaxFields) {
+        const qsizetype comma = line.indexOf(',', fieldStart);
+        if (comma < 0) {
+            fields[fieldCount++] = line.sliced(fieldStart);
+            break;
+        }
+        fields[fieldCount++] = line.sliced(fieldStart, comma - fieldStart);
+        fieldStart = comma + 1;
+    }
+
+    if (fieldCount <= kIcaoField) {
+        return false;
+    }
+
+    bool icaoOk = false;
+    update.icaoAddress = fields[kIcaoField].toUInt(&icaoOk, 16);
+    if (!icaoOk) {
+        return false;
+    }
+
+    switch (msgType) {
+    case ADSB::IdentificationAndCategory:
+    case ADSB::SurveillanceAltitude:
+    case ADSB::SurveillanceId:
+    {
+        if (fieldCount <= kCallsignField) {
+            return false;
+        }
+
+        update.callsign = fields[kCallsignField].trimmed();
+        if (update.callsign.isEmpty()) {
+            return false;
+        }
+
+        update.availableFlags = ADSB::CallsignAvailable;
+        return true;
+    }
+    case ADSB::AirbornePosition:
+    {
+        if (fieldCount <= kAlertField) {
+            return false;
+        }
+
+        // Altitude is either Barometric - based on pressure, in ft
+        // or HAE - as reported by GPS - based on WGS84 Ellipsoid, in ft
+        // If altitude ends with H, we have HAE
+        // There's a slight difference between Barometric alt and HAE, but it would require
+        // knowledge about Geoid shape in particular Lat, Lon. It's not worth complicating the code
+        QByteArrayView altitudeField = fields[kAltitudeField];
+        if (altitudeField.endsWith('H')) {
+            altitudeField.chop(1);
+        }
+
+        bool altOk = false, latOk = false, lonOk = false, alertOk = false;
+        const int modeCAltitude = altitudeField.toInt(&altOk);
+        const double lat = fields[kLatitudeField].toDouble(&latOk);
+        const double lon = fields[kLongitudeField].toDouble(&lonOk);
+        const int alert = fields[kAlertField].toInt(&alertOk);
+        if (!altOk || !latOk || !lonOk || !alertOk) {
+            return false;
+        }
+
+        if (qFuzzyIsNull(lat) && qFuzzyIsNull(lon)) {
+            return false;
+        }
+
+        update.latitude = lat;
+        update.longitude = lon;
+        update.altitude = modeCAltitude * kFeetToMeters;
+        update.alert = (alert == 1);
+        update.availableFlags = ADSB::LocationAvailable | ADSB::AltitudeAvailable | ADSB::AlertAvailable;
+        return true;
+    }
+    case ADSB::AirborneVelocity:
+    {
+        if (fieldCount <= kTrackField) {
+            return false;
+        }
+
+        bool headingOk = false, speedOk = false;
+        const double heading = fields[kTrackField].toDouble(&headingOk);
+        const double speedKnots = fields[kGroundSpeedField].toDouble(&speedOk);
+        if (!headingOk || !speedOk) {
+            return false;
+        }
+
+        update.heading = heading;
+        update.velocity = speedKnots * kKnotsToMetersPerSecond;
+        update.availableFlags = ADSB::HeadingAvailable | ADSB::VelocityAvailable;
+
+        if (fieldCount > kVerticalRateField) {
+            bool vertOk = false;
+            const double verticalRate = fields[kVerticalRateField].toDouble(&vertOk);
+            if (vertOk) {
+                update.verticalVel = verticalRate * kFeetPerMinuteToMetersPerSecond;
+                update.availableFlags |= ADSB::VerticalVelAvailable;
+            }
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+void ADSBSBSParser::_apply(const Update &update, ADSB::VehicleInfo_t &vehicleInfo)
+{
+    if (update.availableFlags & ADSB::CallsignAvailable) {
+        // Only build a new string when the callsign actually changed
+        const QLatin1StringView callsign(update.callsign.data(), update.callsign.size());
+        if (vehicleInfo.callsign != callsign) {
+            vehicleInfo.callsign = callsign;
+        }
+    }
+
+    if (update.availableFlags & ADSB::LocationAvailable) {
+        vehicleInfo.location.setLatitude(update.latitude);
+        vehicleInfo.location.setLongitude(update.longitude);
+    }
+
+    if (update.availableFlags & ADSB::AltitudeAvailable) {
+        vehicleInfo.location.setAltitude(update.altitude);
+    }
+
+    if (update.availableFlags & ADSB::AlertAvailable) {
+        vehicleInfo.alert = update.alert;
+    }
+
+    if (update.availableFlags & ADSB::HeadingAvailable) {
+        vehicleInfo.heading = update.heading;
+    }
+
+    if (update.availableFlags & ADSB::VelocityAvailable) {
+        vehicleInfo.velocity = update.velocity;
+    }
+
+    if (update.availableFlags & ADSB::VerticalVelAvailable) {
+        vehicleInfo.verticalVel = update.verticalVel;
+    }
+
+    vehicleInfo.availableFlags |= update.availableFlags;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QtCore/QByteArrayView>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+
+#include "ADSB.h"
+
+/// Parses SBS-1 (BaseStation, port 30003) text as produced by dump1090 and similar decoders.
+/// Lines are tokenized as views into the received bytes so no field is copied, and the parsed
+/// updates are merged per ICAO address until they are taken, so a busy feed reaches the UI at
+/// most once per vehicle per take.
+class ADSBSBSParser
+{
+public:
+    /// Parses all complete lines in data and merges them into the pending updates.
+    ///     @return Number of bytes consumed, anything after that is an incomplete line
+    qsizetype parse(QByteArrayView data);
+
+    /// Parses a single line.
+    ///     @return false if the line does not carry a supported update
+    static bool parseLine(QByteArrayView line, ADSB::VehicleInfo_t &vehicleInfo);
+
+    bool hasPendingUpdates() const { return !_pending.isEmpty(); }
+
+    /// @return One merged update per ICAO address seen since the last call
+    QList<ADSB::VehicleInfo_t> takePendingUpdates();
+
+    quint64 linesParsed() const { return _linesParsed; }
+
+private:
+    struct Update {
+        ADSB::AvailableInfoTypes availableFlags = ADSB::AvailableInfoType();
+        uint32_t icaoAddress = 0;
+        QByteArrayView callsign;
+        double latitude = 0.;
+        double longitude = 0.;
+        double altitude = 0.;
+        double heading = 0.;
+        double velocity = 0.;
+        double verticalVel = 0.;
+        bool alert = false;
+    };
+
+    static bool _parseLine(QByteArrayView line, Update &update);
+    static void _apply(const Update &update, ADSB::VehicleInfo_t &vehicleInfo);
+
+    QHash<uint32_t, ADSB::VehicleInfo_t> _pending;
+    quint64 _linesParsed = 0;
+};
@@ -2,18 +2,36 @@
 // #include "QGCSensors.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtCore/QThread>
 #include <QtCore/QTimer>
 #include <QtNetwork/QTcpSocket>
 
 QGC_LOGGING_CATEGORY(ADSBTCPLinkLog, "ADSB.ADSBTCPLink")
 
-ADSBTCPLink::ADSBTCPLink(const QHostAddress &hostAddress, quint16 port, QObject *parent)
+/*===========================================================================*/
+
+ADSBTCPWorker::ADSBTCPWorker(QObject *parent)
     : QObject(parent)
-    , _hostAddress(hostAddress)
-    , _port(port)
-    , _socket(new QTcpSocket(this))
-    , _processTimer(new QTimer(this))
 {
+    // qCDebug(ADSBTCPLinkLog) << Q_FUNC_INFO << this;
+}
+
+ADSBTCPWorker::~ADSBTCPWorker()
+{
+    // qCDebug(ADSBTCPLinkLog) << Q_FUNC_INFO << this;
+}
+
+void ADSBTCPWorker::setupSocket()
+{
+    Q_ASSERT(!_socket);
+
+    _socket = new QTcpSocket(this);
+    _publishTimer = new QTimer(this);
+    _publishTimer->setSingleShot(true);
+    _publishTimer->setTimerType(Qt::PreciseTimer);
+    _publishTimer->setInterval(_publishIntervalMs);
+    (void) connect(_publishTimer, &QTimer::timeout, this, &ADSBTCPWorker::_publishUpdates);
+
     if (ADSBTCPLinkLog().isDebugEnabled()) {
         (void) connect(_socket, &QTcpSocket::stateChanged, this, [](QTcpSocket::SocketState state) {
             switch (state) {
@@ -35,204 +53,117 @@ ADSBTCPLink::ADSBTCPLink(const QHostAddress &hostAddress, quint16 port, QObject
         }, Qt::AutoConnection);
     }
 
-    (void) QObject::connect(_socket, &QTcpSocket::errorOccurred, this, [this](QTcpSocket::SocketError error) {
+    (void) connect(_socket, &QTcpSocket::errorOccurred, this, [this](QTcpSocket::SocketError error) {
         qCDebug(ADSBTCPLinkLog) << error << _socket->errorString();
         // TODO: Check if it is a critical error or not and send if the socket is stopped/recoverable
-        emit errorOccurred(_socket->errorString(), false);
+        emit errorOccurred(_socket->errorString());
     }, Qt::AutoConnection);
 
-    (void) connect(_socket, &QTcpSocket::readyRead, this, &ADSBTCPLink::_readBytes);
-
-    _processTimer->setInterval(_processInterval); // Set an interval for processing lines
-    (void) connect(_processTimer, &QTimer::timeout, this, &ADSBTCPLink::_processLines);
-
-    // qCDebug(ADSBTCPLinkLog) << Q_FUNC_INFO << this;
+    (void) connect(_socket, &QTcpSocket::readyRead, this, &ADSBTCPWorker::_readBytes);
 }
 
-ADSBTCPLink::~ADSBTCPLink()
+void ADSBTCPWorker::connectToHost(const QHostAddress &hostAddress, quint16 port)
 {
-    // qCDebug(ADSBTCPLinkLog) << Q_FUNC_INFO << this;
+    _buffer.clear();
+    _socket->connectToHost(hostAddress, port);
 }
 
-bool ADSBTCPLink::init()
+void ADSBTCPWorker::_readBytes()
 {
-    /* if (!QGCDeviceInfo::isInternetAvailable()) {
-        return false;
-    } */
-
-    if (_hostAddress.isNull()) {
-        return false;
+    // Read straight into the tail of the reusable buffer, capacity is kept across reads
+    const qint64 available = _socket->bytesAvailable();
+    if (available <= 0) {
+        return;
     }
 
-    _socket->connectToHost(_hostAddress, _port);
+    const qsizetype offset = _buffer.size();
+    _buffer.resize(offset + available);
+    const qint64 bytesRead = _socket->read(_buffer.data() + offset, available);
+    _buffer.resize(offset + qMax<qint64>(bytesRead, 0));
 
-    return true;
-}
+    const qsizetype consumed = _parser.parse(_buffer);
+    if (consumed > 0) {
+        (void) _buffer.remove(0, consumed);
+    }
 
-void ADSBTCPLink::_readBytes()
-{
-    while (_socket && _socket->canReadLine()) {
-        const QByteArray bytes = _socket->readLine();
-        (void) _lineBuffer.append(QString::fromLocal8Bit(bytes));
+    if (_buffer.size() > _maxLineLength) {
+        qCDebug(ADSBTCPLinkLog) << "ADSB Discarding" << _buffer.size() << "bytes without line ending";
+        _buffer.clear();
     }
 
-    // Start or restart the timer to process lines
-    if (!_processTimer->isActive()) {
-        _processTimer->start();
+    if (_parser.hasPendingUpdates() && !_publishTimer->isActive()) {
+        _publishTimer->start();
     }
 }
 
-void ADSBTCPLink::_processLines()
+void ADSBTCPWorker::_publishUpdates()
 {
-    int linesProcessed = 0;
-    while (!_lineBuffer.isEmpty() && (linesProcessed < _maxLinesToProcess)) {
-        const QString line = _lineBuffer.takeFirst();
-        _parseLine(line);
-        ++linesProcessed;
+    if (!_parser.hasPendingUpdates()) {
+        return;
     }
 
-    // Stop the timer if there are no more lines to process
-    if (_lineBuffer.isEmpty()) {
-        _processTimer->stop();
-    }
+    const QList<ADSB::VehicleInfo_t> updates = _parser.takePendingUpdates();
+    qCDebug(ADSBTCPLinkLog) << "ADSB Publishing" << updates.size() << "vehicle updates," << _parser.linesParsed() << "lines parsed";
+    emit vehicleUpdates(updates);
 }
 
-void ADSBTCPLink::_parseLine(const QString &line)
-{
-    if (line.size() <= 4) {
-        return;
-    }
+/*===========================================================================*/
 
-    if (!line.startsWith(QStringLiteral("MSG"))) {
-        return;
-    }
+ADSBTCPLink::ADSBTCPLink(const QHostAddress &hostAddress, quint16 port, QObject *parent)
+    : QObject(parent)
+    , _hostAddress(hostAddress)
+    , _port(port)
+    , _worker(new ADSBTCPWorker())
+    , _workerThread(new QThread(this))
+{
+    // qCDebug(ADSBTCPLinkLog) << Q_FUNC_INFO << this;
 
-    const int msgType = line.at(4).digitValue();
-    if (msgType == ADSB::Unsupported) {
-        qCDebug(ADSBTCPLinkLog) << "ADSB Invalid message type" << msgType;
-        return;
-    }
+    (void) qRegisterMetaType<ADSB::VehicleInfo_t>("ADSB::VehicleInfo_t");
+    (void) qRegisterMetaType<QList<ADSB::VehicleInfo_t>>("QList<ADSB::VehicleInfo_t>");
 
-    // Skip unsupported mesg types to avoid parsing
-    if ((msgType == ADSB::SurfacePosition) || (msgType > ADSB::SurveillanceId)) {
-        return;
-    }
+    _workerThread->setObjectName(QStringLiteral("ADSB_TCP"));
 
-    qCDebug(ADSBTCPLinkLog) << "ADSB SBS-1" << line;
+    _worker->moveToThread(_workerThread);
 
-    const QStringList values = line.split(QChar(','));
-    if (values.size() <= 4) {
-        return;
-    }
+    (void) connect(_workerThread, &QThread::started, _worker, &ADSBTCPWorker::setupSocket);
+    (void) connect(_workerThread, &QThread::finished, _worker, &QObject::deleteLater);
 
-    bool icaoOk;
-    const uint32_t icaoAddress = values.at(4).toUInt(&icaoOk, 16);
-    if (!icaoOk) {
-        return;
-    }
+    (void) connect(_worker, &ADSBTCPWorker::vehicleUpdates, this, &ADSBTCPLink::_vehicleUpdates, Qt::QueuedConnection);
+    (void) connect(_worker, &ADSBTCPWorker::errorOccurred, this, [this](const QString &errorMsg) {
+        emit errorOccurred(errorMsg, false);
+    }, Qt::QueuedConnection);
 
-    ADSB::VehicleInfo_t adsbInfo;
-    adsbInfo.icaoAddress = icaoAddress;
-
-    switch (msgType) {
-    case ADSB::IdentificationAndCategory:
-    case ADSB::SurveillanceAltitude:
-    case ADSB::SurveillanceId:
-        _parseAndEmitCallsign(adsbInfo, values);
-        break;
-    case ADSB::AirbornePosition:
-        _parseAndEmitLocation(adsbInfo, values);
-        break;
-    case ADSB::AirborneVelocity:
-        _parseAndEmitHeading(adsbInfo, values);
-        break;
-    default:
-        break;
-    }
+    _workerThread->start();
 }
 
-void ADSBTCPLink::_parseAndEmitCallsign(ADSB::VehicleInfo_t &adsbInfo, const QStringList &values)
+ADSBTCPLink::~ADSBTCPLink()
 {
-    if (values.size() <= 10) {
-        return;
+    _workerThread->quit();
+    if (!_workerThread->wait(1000)) {
+        qCWarning(ADSBTCPLinkLog) << "Failed to wait for ADSB Thread to close";
     }
 
-    const QString callsign = values.at(10).trimmed();
-    if (callsign.isEmpty()) {
-        return;
-    }
-
-    adsbInfo.callsign = callsign;
-    adsbInfo.availableFlags = ADSB::CallsignAvailable;
-
-    emit adsbVehicleUpdate(adsbInfo);
+    // qCDebug(ADSBTCPLinkLog) << Q_FUNC_INFO << this;
 }
 
-void ADSBTCPLink::_parseAndEmitLocation(ADSB::VehicleInfo_t &adsbInfo, const QStringList &values)
+bool ADSBTCPLink::init()
 {
-    if (values.size() <= 19) {
-        return;
-    }
-
-    // Altitude is either Barometric - based on pressure, in ft
-    // or HAE - as reported by GPS - based on WGS84 Ellipsoid, in ft
-    // If altitude ends with H, we have HAE
-    // There's a slight difference between Barometric alt and HAE, but it would require
-    // knowledge about Geoid shape in particular Lat, Lon. It's not worth complicating the code
-    QString altitudeStr = values.at(11);
-    if (altitudeStr.endsWith('H')) {
-        (void) altitudeStr.chop(1);
-    }
-
-    bool altOk, latOk, lonOk, alertOk;
-    const int modeCAltitude = altitudeStr.toInt(&altOk);
-    const double lat = values.at(14).toDouble(&latOk);
-    const double lon = values.at(15).toDouble(&lonOk);
-    const int alert = values.at(19).toInt(&alertOk);
-
-    if (!altOk || !latOk || !lonOk || !alertOk) {
-        return;
-    }
+    /* if (!QGCDeviceInfo::isInternetAvailable()) {
+        return false;
+    } */
 
-    if (qFuzzyIsNull(lat) && qFuzzyIsNull(lon)) {
-        return;
+    if (_hostAddress.isNull()) {
+        return false;
     }
 
-    const double altitude = modeCAltitude * 0.3048;
-    const QGeoCoordinate location(lat, lon, altitude);
-
-    adsbInfo.location = location;
-    adsbInfo.alert = (alert == 1);
-    adsbInfo.availableFlags = ADSB::LocationAvailable | ADSB::AltitudeAvailable | ADSB::AlertAvailable;
-
-    emit adsbVehicleUpdate(adsbInfo);
+    return QMetaObject::invokeMethod(_worker, [worker = _worker, hostAddress = _hostAddress, port = _port]() {
+        worker->connectToHost(hostAddress, port);
+    }, Qt::QueuedConnection);
 }
 
-void ADSBTCPLink::_parseAndEmitHeading(ADSB::VehicleInfo_t &adsbInfo, const QStringList &values)
+void ADSBTCPLink::_vehicleUpdates(const QList<ADSB::VehicleInfo_t> &vehicleInfos)
 {
-    if (values.size() <= 13) {
-        return;
-    }
-
-    bool headingOk = false, speedOk = false;
-    const double heading = values.at(13).toDouble(&headingOk);
-    const double speedKnots = values.at(12).toDouble(&speedOk);
-    if (!headingOk || !speedOk) {
-        return;
+    for (const ADSB::VehicleInfo_t &vehicleInfo : vehicleInfos) {
+        emit adsbVehicleUpdate(vehicleInfo);
     }
-
-    adsbInfo.heading = heading;
-    adsbInfo.velocity = speedKnots * 0.514444;
-    adsbInfo.availableFlags = ADSB::HeadingAvailable | ADSB::VelocityAvailable;
-
-    if (values.size() > 16) {
-        bool vertOk = false;
-        const double verticalRate = values.at(16).toDouble(&vertOk);
-        if (vertOk) {
-            adsbInfo.verticalVel = verticalRate * 0.00508;
-            adsbInfo.availableFlags |= ADSB::VerticalVelAvailable;
-        }
-    }
-
-    emit adsbVehicleUpdate(adsbInfo);
 }
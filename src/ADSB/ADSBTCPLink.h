@@ -1,15 +1,57 @@
 #pragma once
 
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
 #include <QtCore/QObject>
+#include <QtNetwork/QAbstractSocket>
 #include <QtNetwork/QHostAddress>
 
 #include "ADSB.h"
+#include "ADSBSBSParser.h"
 
 class QTcpSocket;
+class QThread;
 class QTimer;
 
+/*===========================================================================*/
+
+/// Owns the socket and the SBS-1 parser on the ADS-B worker thread. Parsed updates are
+/// coalesced per ICAO address and delivered once per display frame.
+class ADSBTCPWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ADSBTCPWorker(QObject *parent = nullptr);
+    ~ADSBTCPWorker();
+
+signals:
+    /// Emitted at most once per display frame with one merged update per vehicle.
+    void vehicleUpdates(const QList<ADSB::VehicleInfo_t> &vehicleInfos);
+    void errorOccurred(const QString &errorMsg);
+
+public slots:
+    void setupSocket();
+    void connectToHost(const QHostAddress &hostAddress, quint16 port);
+
+private slots:
+    void _readBytes();
+    void _publishUpdates();
+
+private:
+    QTcpSocket *_socket = nullptr;
+    QTimer *_publishTimer = nullptr;
+    QByteArray _buffer;              ///< Received bytes not yet parsed, reused across reads
+    ADSBSBSParser _parser;
+
+    static constexpr int _publishIntervalMs = 16;           ///< One display frame at 60 Hz
+    static constexpr qsizetype _maxLineLength = 4096;      ///< Longer data without a newline is not SBS-1 and is dropped
+};
+
+/*===========================================================================*/
+
 /// The ADSBTCPLink class handles the TCP connection to an ADS-B server
-/// and processes incoming ADS-B data.
+/// and processes incoming ADS-B data on a worker thread.
 class ADSBTCPLink : public QObject
 {
     Q_OBJECT
@@ -37,39 +79,12 @@ class ADSBTCPLink : public QObject
     void errorOccurred(const QString &errorMsg, bool stopped = false);
 
 private slots:
-    /// Reads bytes from the TCP socket.
-    void _readBytes();
-
-    /// Processes buffered lines of ADS-B data.
-    void _processLines();
+    void _vehicleUpdates(const QList<ADSB::VehicleInfo_t> &vehicleInfos);
 
 private:
-    /// Parses a line of ADS-B data.
-    ///     @param line The line to parse.
-    void _parseLine(const QString &line);
-
-    /// Parses and emits the callsign from ADS-B data.
-    ///     @param adsbInfo The ADS-B vehicle info structure to update.
-    ///     @param values The values parsed from the line.
-    void _parseAndEmitCallsign(ADSB::VehicleInfo_t &adsbInfo, const QStringList &values);
-
-    /// Parses and emits the location from ADS-B data.
-    ///     @param adsbInfo The ADS-B vehicle info structure to update.
-    ///     @param values The values parsed from the line.
-    void _parseAndEmitLocation(ADSB::VehicleInfo_t &adsbInfo, const QStringList &values);
-
-    /// Parses and emits the heading from ADS-B data.
-    ///     @param adsbInfo The ADS-B vehicle info structure to update.
-    ///     @param values The values parsed from the line.
-    void _parseAndEmitHeading(ADSB::VehicleInfo_t &adsbInfo, const QStringList &values);
-
     QHostAddress _hostAddress;
     quint16 _port = 30003;
 
-    QTcpSocket *_socket = nullptr;     ///< Pointer to the TCP socket used for connection
-    QTimer *_processTimer = nullptr;   ///< Timer for periodic processing of ADS-B data
-    QStringList _lineBuffer;           ///< Buffer for storing incoming lines of ADS-B data
-
-    static constexpr int _processInterval = 50;     ///< Interval for processing lines
-    static constexpr int _maxLinesToProcess = 100;  ///< Maximum number of lines to process per timer timeout
+    ADSBTCPWorker *_worker = nullptr;
+    QThread *_workerThread = nullptr;
 };
@@ -0,0 +1,199 @@
+#include "ADSBTrafficModel.h"
+#include "ADSBTrafficStore.h"
+
+#include <utility>
+
+ADSBTrafficModel::ADSBTrafficModel(const ADSBTrafficStore *store, QObject *parent)
+    : QAbstractListModel(parent)
+    , _store(store)
+{
+}
+
+ADSBTrafficModel::~ADSBTrafficModel()
+{
+}
+
+int ADSBTrafficModel::rowCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return static_cast<int>(_rows.count());
+}
+
+QVariant ADSBTrafficModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || (index.row() < 0) || (index.row() >= _rows.count())) {
+        return QVariant();
+    }
+
+    const int slot = _store->slot(_rows[index.row()].icaoAddress);
+    if (slot < 0) {
+        return QVariant();
+    }
+
+    switch (role) {
+    case IcaoAddressRole:
+        return _store->icaoAddress(slot);
+    case CoordinateRole:
+        return QVariant::fromValue(_store->coordinate(slot));
+    case AltitudeRole:
+        return _store->altitude(slot);
+    case CallsignRole:
+        return _store->callsign(slot);
+    case HeadingRole:
+        return _store->heading(slot);
+    case VelocityRole:
+        return _store->velocity(slot);
+    case VerticalVelRole:
+        return _store->verticalVel(slot);
+    case SquawkRole:
+        return _store->squawk(slot);
+    case AlertRole:
+        return _store->alert(slot);
+    case ConflictRole:
+        return _conflicts.contains(_store->icaoAddress(slot));
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> ADSBTrafficModel::roleNames() const
+{
+    return {
+        {IcaoAddressRole, "icaoAddress"},
+        {CoordinateRole, "coordinate"},
+        {AltitudeRole, "altitude"},
+        {CallsignRole, "callsign"},
+        {HeadingRole, "heading"},
+        {VelocityRole, "velocity"},
+        {VerticalVelRole, "verticalVel"},
+        {SquawkRole, "squawk"},
+        {AlertRole, "alert"},
+        {ConflictRole, "conflict"}
+    };
+}
+
+void ADSBTrafficModel::publish(const QList<int> &visibleSlots)
+{
+    const int previousCount = count();
+
+    _keepRow.fill(false, _rows.count());
+    _addedSlots.clear();
+    for (const int slot : visibleSlots) {
+        const int row = _rowByIcao.value(_store->icaoAddress(slot), -1);
+        if (row >= 0) {
+            _keepRow[row] = true;
+        } else {
+            _addedSlots.append(slot);
+        }
+    }
+
+    // Remove from the back so earlier row numbers stay valid, one notification per contiguous range
+    bool rowsRemoved = false;
+    for (int row = static_cast<int>(_rows.count()) - 1; row >= 0;) {
+        if (_keepRow[row]) {
+            row--;
+            continue;
+        }
+
+        const int last = row;
+        while ((row >= 0) && !_keepRow[row]) {
+            row--;
+        }
+        const int first = row + 1;
+
+        beginRemoveRows(QModelIndex(), first, last);
+        _rows.remove(first, last - first + 1);
+        endRemoveRows();
+        rowsRemoved = true;
+    }
+    if (rowsRemoved) {
+        _rebuildRowIndex();
+    }
+
+    // Changed rows, one notification per contiguous range
+    int firstChanged = -1;
+    for (int row = 0; row <= _rows.count(); row++) {
+        bool rowChanged = false;
+        if (row < _rows.count()) {
+            Row &entry = _rows[row];
+            const quint32 revision = _store->revision(_store->slot(entry.icaoAddress));
+            rowChanged = (revision != entry.revision);
+            entry.revision = revision;
+        }
+
+        if (rowChanged && (firstChanged < 0)) {
+            firstChanged = row;
+        } else if (!rowChanged && (firstChanged >= 0)) {
+            emit dataChanged(index(firstChanged), index(row - 1));
+            firstChanged = -1;
+        }
+    }
+
+    // New aircraft are appended in one batch
+    if (!_addedSlots.isEmpty()) {
+        const int first = static_cast<int>(_rows.count());
+        beginInsertRows(QModelIndex(), first, first + static_cast<int>(_addedSlots.count()) - 1);
+        for (const int slot : std::as_const(_addedSlots)) {
+            const uint32_t icaoAddress = _store->icaoAddress(slot);
+            _rowByIcao.insert(icaoAddress, static_cast<int>(_rows.count()));
+            _rows.append(Row{icaoAddress, _store->revision(slot)});
+        }
+        endInsertRows();
+    }
+
+    if (count() != previousCount) {
+        emit countChanged();
+    }
+}
+
+void ADSBTrafficModel::setConflicts(const QSet<uint32_t> &icaoAddresses)
+{
+    if (icaoAddresses == _conflicts) {
+        return;
+    }
+
+    const QList<int> roles = {ConflictRole};
+    const auto notify = [this, &roles](uint32_t icaoAddress) {
+        const int row = _rowByIcao.value(icaoAddress, -1);
+        if (row >= 0) {
+            const QModelIndex rowIndex = index(row);
+            emit dataChanged(rowIndex, rowIndex, roles);
+        }
+    };
+
+    const QSet<uint32_t> previous = std::exchange(_conflicts, icaoAddresses);
+    for (const uint32_t icaoAddress : previous) {
+        if (!_conflicts.contains(icaoAddress)) {
+            notify(icaoAddress);
+        }
+    }
+    for (const uint32_t icaoAddress : std::as_const(_conflicts)) {
+        if (!previous.contains(icaoAddress)) {
+            notify(icaoAddress);
+        }
+    }
+}
+
+void ADSBTrafficModel::clear()
+{
+    _conflicts.clear();
+
+    if (_rows.isEmpty()) {
+        return;
+    }
+
+    beginResetModel();
+    _rows.clear();
+    _rowByIcao.clear();
+    endResetModel();
+
+    emit countChanged();
+}
+
+void ADSBTrafficModel::_rebuildRowIndex()
+{
+    _rowByIcao.clear();
+    for (int row = 0; row < _rows.count(); row++) {
+        _rowByIcao.insert(_rows[row].icaoAddress, row);
+    }
+}
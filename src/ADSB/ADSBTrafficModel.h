@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QtCore/QAbstractListModel>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QSet>
+#include <QtQmlIntegration/QtQmlIntegration>
+
+class ADSBTrafficStore;
+
+/// List model of the ADS-B aircraft published to the map. Rows are only touched in publish(), which
+/// applies removals, changes and insertions as a few batched model notifications.
+class ADSBTrafficModel : public QAbstractListModel
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("")
+
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    enum Roles {
+        IcaoAddressRole = Qt::UserRole + 1,
+        CoordinateRole,
+        AltitudeRole,
+        CallsignRole,
+        HeadingRole,
+        VelocityRole,
+        VerticalVelRole,
+        SquawkRole,
+        AlertRole,
+        ConflictRole        ///< Predicted to come within the conflict thresholds of an own vehicle
+    };
+
+    explicit ADSBTrafficModel(const ADSBTrafficStore *store, QObject *parent = nullptr);
+    ~ADSBTrafficModel() override;
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return rowCount(); }
+
+    /// Makes the model show exactly the aircraft in visibleSlots of the store
+    void publish(const QList<int> &visibleSlots);
+
+    /// Marks the aircraft in icaoAddresses as conflicting, only rows whose state changes are notified
+    void setConflicts(const QSet<uint32_t> &icaoAddresses);
+
+    void clear();
+
+signals:
+    void countChanged();
+
+private:
+    struct Row {
+        uint32_t icaoAddress = 0;
+        quint32 revision = 0;
+    };
+
+    void _rebuildRowIndex();
+
+    const ADSBTrafficStore *_store = nullptr;
+    QList<Row> _rows;
+    QHash<uint32_t, int> _rowByIcao;
+    QSet<uint32_t> _conflicts;
+
+    // Scratch buffers reused by publish()
+    QList<bool> _keepRow;
+    QList<int> _addedSlots;
+};
@@ -0,0 +1,407 @@
+#include "ADSBTrafficStore.h"
+#include "QGCMath.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtPositioning/QGeoRectangle>
+
+#include <cmath>
+
+QGC_LOGGING_CATEGORY(ADSBTrafficStoreLog, "ADSB.ADSBTrafficStore")
+
+namespace {
+
+constexpr double kMetersPerDegreeLatitude = 111320.;
+constexpr double kEarthRadiusMeters = 6371000.;
+
+} // namespace
+
+ADSBTrafficStore::ADSBTrafficStore(qint64 expiryMs, double cellSizeDegrees)
+    : _expiryMs(expiryMs)
+    , _cellSizeDegrees(cellSizeDegrees)
+{
+    // One spare bucket so an aircraft scheduled in the current tick never lands in the bucket being processed
+    _wheel.resize(((expiryMs + _tickMs - 1) / _tickMs) + 2);
+}
+
+QGeoCoordinate ADSBTrafficStore::coordinate(int slot) const
+{
+    if (_availableFlags[slot] & ADSB::AltitudeAvailable) {
+        return QGeoCoordinate(_latitude[slot], _longitude[slot], _altitude[slot]);
+    }
+    return QGeoCoordinate(_latitude[slot], _longitude[slot]);
+}
+
+bool ADSBTrafficStore::update(const ADSB::VehicleInfo_t &vehicleInfo, qint64 nowMs)
+{
+    int slot = this->slot(vehicleInfo.icaoAddress);
+    bool changed = false;
+
+    if (slot < 0) {
+        if (!(vehicleInfo.availableFlags & ADSB::LocationAvailable)) {
+            return false;
+        }
+
+        slot = static_cast<int>(_icaoAddress.count());
+        _icaoAddress.append(vehicleInfo.icaoAddress);
+        _latitude.append(vehicleInfo.location.latitude());
+        _longitude.append(vehicleInfo.location.longitude());
+        _altitude.append(qQNaN());
+        _heading.append(qQNaN());
+        _velocity.append(qQNaN());
+        _verticalVel.append(qQNaN());
+        _callsign.append(QString());
+        _squawk.append(0);
+        _alert.append(false);
+        _availableFlags.append(ADSB::LocationAvailable);
+        _lastUpdateMs.append(nowMs);
+        _expiryTick.append(-1);
+        _cell.append(_cellKey(vehicleInfo.location.latitude(), vehicleInfo.location.longitude()));
+        _revision.append(0);
+
+        _slotByIcao.insert(vehicleInfo.icaoAddress, slot);
+        _addToCell(_cell[slot], slot);
+        qCDebug(ADSBTrafficStoreLog) << "Added" << QString::number(vehicleInfo.icaoAddress, 16);
+        changed = true;
+    }
+
+    const ADSB::AvailableInfoTypes flags = vehicleInfo.availableFlags;
+
+    if (flags & ADSB::LocationAvailable) {
+        const double latitude = vehicleInfo.location.latitude();
+        const double longitude = vehicleInfo.location.longitude();
+        if (!QGC::fuzzyCompare(latitude, _latitude[slot]) || !QGC::fuzzyCompare(longitude, _longitude[slot])) {
+            _latitude[slot] = latitude;
+            _longitude[slot] = longitude;
+            const quint64 cell = _cellKey(latitude, longitude);
+            if (cell != _cell[slot]) {
+                _removeFromCell(_cell[slot], slot);
+                _addToCell(cell, slot);
+                _cell[slot] = cell;
+            }
+            changed = true;
+        }
+    }
+
+    const auto updateValue = [&changed](double value, double &current) {
+        if (!QGC::fuzzyCompare(value, current)) {
+            current = value;
+            changed = true;
+        }
+    };
+
+    if (flags & ADSB::AltitudeAvailable) {
+        updateValue(vehicleInfo.location.altitude(), _altitude[slot]);
+    }
+    if (flags & ADSB::HeadingAvailable) {
+        updateValue(vehicleInfo.heading, _heading[slot]);
+    }
+    if (flags & ADSB::VelocityAvailable) {
+        updateValue(vehicleInfo.velocity, _velocity[slot]);
+    }
+    if (flags & ADSB::VerticalVelAvailable) {
+        updateValue(vehicleInfo.verticalVel, _verticalVel[slot]);
+    }
+    if ((flags & ADSB::CallsignAvailable) && (vehicleInfo.callsign != _callsign[slot])) {
+        _callsign[slot] = vehicleInfo.callsign;
+        changed = true;
+    }
+    if ((flags & ADSB::SquawkAvailable) && (vehicleInfo.squawk != _squawk[slot])) {
+        _squawk[slot] = vehicleInfo.squawk;
+        changed = true;
+    }
+    if ((flags & ADSB::AlertAvailable) && (vehicleInfo.alert != _alert[slot])) {
+        _alert[slot] = vehicleInfo.alert;
+        changed = true;
+    }
+
+    if ((_availableFlags[slot] | flags) != _availableFlags[slot]) {
+        _availableFlags[slot] |= flags;
+        changed = true;
+    }
+
+    _lastUpdateMs[slot] = nowMs;
+    _schedule(slot, nowMs);
+
+    if (changed) {
+        _revision[slot] = ++_lastRevision;
+    }
+
+    return changed;
+}
+
+QList<uint32_t> ADSBTrafficStore::expire(qint64 nowMs)
+{
+    QList<uint32_t> removed;
+
+    const qint64 currentTick = nowMs / _tickMs;
+    if (!_wheelStarted) {
+        _lastExpireTick = currentTick - 1;
+        _wheelStarted = true;
+    }
+
+    // After a long pause every bucket is due once, there is no point in going around the wheel more than once
+    const qint64 wheelSize = _wheel.count();
+    const qint64 firstTick = qMax(_lastExpireTick + 1, currentTick - wheelSize + 1);
+
+    for (qint64 tick = firstTick; tick <= currentTick; tick++) {
+        const qsizetype bucketIndex = tick % wheelSize;
+        QList<uint32_t> &bucket = _wheel[bucketIndex];
+
+        qsizetype kept = 0;
+        for (qsizetype i = 0; i < bucket.count(); i++) {
+            const uint32_t icaoAddress = bucket[i];
+            const int slot = this->slot(icaoAddress);
+            if (slot < 0) {
+                continue;
+            }
+
+            const qint64 expiryTick = _expiryTick[slot];
+            if (expiryTick <= currentTick) {
+                qCDebug(ADSBTrafficStoreLog) << "Expired" << QString::number(icaoAddress, 16);
+                removed.append(icaoAddress);
+                _remove(slot);
+            } else if ((expiryTick % wheelSize) == bucketIndex) {
+                // Due a full turn later, stays in this bucket
+                bucket[kept++] = icaoAddress;
+            }
+            // Otherwise the aircraft was rescheduled into another bucket after this entry was made
+        }
+        bucket.resize(kept);
+    }
+
+    _lastExpireTick = currentTick;
+
+    return removed;
+}
+
+void ADSBTrafficStore::clear()
+{
+    _icaoAddress.clear();
+    _latitude.clear();
+    _longitude.clear();
+    _altitude.clear();
+    _heading.clear();
+    _velocity.clear();
+    _verticalVel.clear();
+    _callsign.clear();
+    _squawk.clear();
+    _alert.clear();
+    _availableFlags.clear();
+    _lastUpdateMs.clear();
+    _expiryTick.clear();
+    _cell.clear();
+    _revision.clear();
+
+    _slotByIcao.clear();
+    _grid.clear();
+    for (QList<uint32_t> &bucket : _wheel) {
+        bucket.clear();
+    }
+    _lastExpireTick = 0;
+    _wheelStarted = false;
+}
+
+void ADSBTrafficStore::slotsInRect(const QGeoRectangle &rect, QList<int> &result) const
+{
+    if (!rect.isValid()) {
+        return;
+    }
+
+    const double south = rect.bottomLeft().latitude();
+    const double north = rect.topRight().latitude();
+    const double west = rect.bottomLeft().longitude();
+    const double east = rect.topRight().longitude();
+
+    if (west <= east) {
+        _slotsInBox(south, west, north, east, result);
+    } else {
+        // Crosses the antimeridian
+        _slotsInBox(south, west, north, 180., result);
+        _slotsInBox(south, -180., north, east, result);
+    }
+}
+
+void ADSBTrafficStore::slotsInRange(const QGeoCoordinate &center, double radiusMeters, QList<int> &result) const
+{
+    if (!center.isValid() || (radiusMeters <= 0)) {
+        return;
+    }
+
+    const double deltaLatitude = radiusMeters / kMetersPerDegreeLatitude;
+    const double south = qMax(center.latitude() - deltaLatitude, -90.);
+    const double north = qMin(center.latitude() + deltaLatitude, 90.);
+
+    const double cosLatitude = std::cos(qDegreesToRadians(qMax(qAbs(south), qAbs(north))));
+    const double deltaLongitude = (cosLatitude > 1e-6) ? (deltaLatitude / cosLatitude) : 360.;
+
+    QList<int> candidates;
+    if (deltaLongitude >= 180.) {
+        _slotsInBox(south, -180., north, 180., candidates);
+    } else {
+        const double west = center.longitude() - deltaLongitude;
+        const double east = center.longitude() + deltaLongitude;
+        if (west < -180.) {
+            _slotsInBox(south, west + 360., north, 180., candidates);
+            _slotsInBox(south, -180., north, east, candidates);
+        } else if (east > 180.) {
+            _slotsInBox(south, west, north, 180., candidates);
+            _slotsInBox(south, -180., north, east - 360., candidates);
+        } else {
+            _slotsInBox(south, west, north, east, candidates);
+        }
+    }
+
+    // Haversine on the mean earth radius, close enough for choosing what to display
+    const double centerLatitude = qDegreesToRadians(center.latitude());
+    const double centerLongitude = qDegreesToRadians(center.longitude());
+    for (const int slot : std::as_const(candidates)) {
+        const double latitude = qDegreesToRadians(_latitude[slot]);
+        const double sinDeltaLatitude = std::sin((latitude - centerLatitude) / 2.);
+        const double sinDeltaLongitude = std::sin((qDegreesToRadians(_longitude[slot]) - centerLongitude) / 2.);
+        const double a = (sinDeltaLatitude * sinDeltaLatitude) + (std::cos(centerLatitude) * std::cos(latitude) * sinDeltaLongitude * sinDeltaLongitude);
+        const double distance = 2. * kEarthRadiusMeters * std::asin(std::sqrt(qMin(a, 1.)));
+        if (distance <= radiusMeters) {
+            result.append(slot);
+        }
+    }
+}
+
+void ADSBTrafficStore::_slotsInBox(double south, double west, double north, double east, QList<int> &result) const
+{
+    const auto inBox = [&](int slot) {
+        const double latitude = _latitude[slot];
+        const double longitude = _longitude[slot];
+        return (latitude >= south) && (latitude <= north) && (longitude >= west) && (longitude <= east);
+    };
+
+    const qint64 firstRow = static_cast<qint64>(std::floor(south / _cellSizeDegrees));
+    const qint64 lastRow = static_cast<qint64>(std::floor(north / _cellSizeDegrees));
+    const qint64 firstColumn = static_cast<qint64>(std::floor(west / _cellSizeDegrees));
+    const qint64 lastColumn = static_cast<qint64>(std::floor(east / _cellSizeDegrees));
+    const qint64 cellCount = (lastRow - firstRow + 1) * (lastColumn - firstColumn + 1);
+
+    // A zoomed out view covers more cells than there are occupied ones, walk the occupied cells instead
+    if (cellCount > _grid.size()) {
+        for (auto it = _grid.cbegin(); it != _grid.cend(); ++it) {
+            for (const int slot : it.value()) {
+                if (inBox(slot)) {
+                    result.append(slot);
+                }
+            }
+        }
+        return;
+    }
+
+    for (qint64 row = firstRow; row <= lastRow; row++) {
+        for (qint64 column = firstColumn; column <= lastColumn; column++) {
+            const quint64 key = (static_cast<quint64>(static_cast<quint32>(row)) << 32) | static_cast<quint32>(column);
+            const auto it = _grid.constFind(key);
+            if (it == _grid.cend()) {
+                continue;
+            }
+            const bool edgeCell = (row == firstRow) || (row == lastRow) || (column == firstColumn) || (column == lastColumn);
+            for (const int slot : it.value()) {
+                if (!edgeCell || inBox(slot)) {
+                    result.append(slot);
+                }
+            }
+        }
+    }
+}
+
+quint64 ADSBTrafficStore::_cellKey(double latitude, double longitude) const
+{
+    const qint64 row = static_cast<qint64>(std::floor(latitude / _cellSizeDegrees));
+    const qint64 column = static_cast<qint64>(std::floor(longitude / _cellSizeDegrees));
+    return (static_cast<quint64>(static_cast<quint32>(row)) << 32) | static_cast<quint32>(column);
+}
+
+void ADSBTrafficStore::_addToCell(quint64 cell, int slot)
+{
+    _grid[cell].append(slot);
+}
+
+void ADSBTrafficStore::_removeFromCell(quint64 cell, int slot)
+{
+    const auto it = _grid.find(cell);
+    if (it == _grid.end()) {
+        return;
+    }
+
+    QList<int> &cellSlots = it.value();
+    const qsizetype index = cellSlots.indexOf(slot);
+    if (index >= 0) {
+        cellSlots.swapItemsAt(index, cellSlots.count() - 1);
+        cellSlots.removeLast();
+    }
+    if (cellSlots.isEmpty()) {
+        (void) _grid.erase(it);
+    }
+}
+
+void ADSBTrafficStore::_schedule(int slot, qint64 nowMs)
+{
+    const qint64 expiryTick = (nowMs + _expiryMs + _tickMs - 1) / _tickMs;
+    if (expiryTick == _expiryTick[slot]) {
+        return;
+    }
+
+    if (!_wheelStarted) {
+        _lastExpireTick = (nowMs / _tickMs) - 1;
+        _wheelStarted = true;
+    }
+
+    // Stale entries in earlier buckets are skipped when those buckets come due
+    _expiryTick[slot] = expiryTick;
+    _wheel[expiryTick % _wheel.count()].append(_icaoAddress[slot]);
+}
+
+void ADSBTrafficStore::_remove(int slot)
+{
+    const int lastSlot = static_cast<int>(_icaoAddress.count()) - 1;
+
+    _removeFromCell(_cell[slot], slot);
+    (void) _slotByIcao.remove(_icaoAddress[slot]);
+
+    if (slot != lastSlot) {
+        // Move the last aircraft into the freed slot
+        QList<int> &lastCell = _grid[_cell[lastSlot]];
+        const qsizetype index = lastCell.indexOf(lastSlot);
+        if (index >= 0) {
+            lastCell[index] = slot;
+        }
+        _slotByIcao[_icaoAddress[lastSlot]] = slot;
+
+        _icaoAddress[slot] = _icaoAddress[lastSlot];
+        _latitude[slot] = _latitude[lastSlot];
+        _longitude[slot] = _longitude[lastSlot];
+        _altitude[slot] = _altitude[lastSlot];
+        _heading[slot] = _heading[lastSlot];
+        _velocity[slot] = _velocity[lastSlot];
+        _verticalVel[slot] = _verticalVel[lastSlot];
+        _callsign[slot] = std::move(_callsign[lastSlot]);
+        _squawk[slot] = _squawk[lastSlot];
+        _alert[slot] = _alert[lastSlot];
+        _availableFlags[slot] = _availableFlags[lastSlot];
+        _lastUpdateMs[slot] = _lastUpdateMs[lastSlot];
+        _expiryTick[slot] = _expiryTick[lastSlot];
+        _cell[slot] = _cell[lastSlot];
+        _revision[slot] = _revision[lastSlot];
+    }
+
+    _icaoAddress.removeLast();
+    _latitude.removeLast();
+    _longitude.removeLast();
+    _altitude.removeLast();
+    _heading.removeLast();
+    _velocity.removeLast();
+    _verticalVel.removeLast();
+    _callsign.removeLast();
+    _squawk.removeLast();
+    _alert.removeLast();
+    _availableFlags.removeLast();
+    _lastUpdateMs.removeLast();
+    _expiryTick.removeLast();
+    _cell.removeLast();
+    _revision.removeLast();
+}
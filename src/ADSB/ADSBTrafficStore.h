@@ -0,0 +1,115 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtPositioning/QGeoCoordinate>
+
+#include "ADSB.h"
+
+class QGeoRectangle;
+
+/// Compact store for tracked ADS-B traffic.
+///
+/// Aircraft are kept as parallel arrays (struct of arrays) addressed by a slot index. Removal moves the
+/// last aircraft into the freed slot so the arrays stay dense, which means slots are only valid until the
+/// next removal; keep ICAO addresses, not slots, across calls. A uniform latitude/longitude grid indexes
+/// the slots by position for viewport and range queries, and a timing wheel with one bucket per second
+/// expires aircraft which stopped reporting without scanning the whole store.
+class ADSBTrafficStore
+{
+public:
+    /// @param expiryMs Aircraft not updated for this long are removed by expire()
+    /// @param cellSizeDegrees Size of the spatial index cells
+    explicit ADSBTrafficStore(qint64 expiryMs = kDefaultExpiryMs, double cellSizeDegrees = kDefaultCellSizeDegrees);
+
+    /// Merges the available fields of vehicleInfo into the aircraft. Aircraft are only added once their location is known.
+    ///     @return true if the store changed
+    bool update(const ADSB::VehicleInfo_t &vehicleInfo, qint64 nowMs);
+
+    /// Removes the aircraft not updated within the expiry time. Only the wheel buckets which came due since
+    /// the previous call are visited.
+    ///     @return ICAO addresses of the removed aircraft
+    QList<uint32_t> expire(qint64 nowMs);
+
+    void clear();
+
+    qsizetype count() const { return _icaoAddress.count(); }
+    bool contains(uint32_t icaoAddress) const { return _slotByIcao.contains(icaoAddress); }
+
+    /// @return Slot of the aircraft, -1 if it is not tracked
+    int slot(uint32_t icaoAddress) const { return _slotByIcao.value(icaoAddress, -1); }
+
+    uint32_t icaoAddress(int slot) const { return _icaoAddress[slot]; }
+    QGeoCoordinate coordinate(int slot) const;
+    double latitude(int slot) const { return _latitude[slot]; }
+    double longitude(int slot) const { return _longitude[slot]; }
+    double altitude(int slot) const { return _altitude[slot]; }
+    double heading(int slot) const { return _heading[slot]; }
+    double velocity(int slot) const { return _velocity[slot]; }
+    double verticalVel(int slot) const { return _verticalVel[slot]; }
+    const QString &callsign(int slot) const { return _callsign[slot]; }
+    uint16_t squawk(int slot) const { return _squawk[slot]; }
+    bool alert(int slot) const { return _alert[slot]; }
+    ADSB::AvailableInfoTypes availableFlags(int slot) const { return _availableFlags[slot]; }
+    qint64 lastUpdateMs(int slot) const { return _lastUpdateMs[slot]; }
+
+    /// Incremented whenever a field of the aircraft changes, lets consumers skip unchanged aircraft
+    quint32 revision(int slot) const { return _revision[slot]; }
+
+    /// Whole columns indexed by slot, for batch processing. Unknown values are NaN.
+    const QList<double> &latitudes() const { return _latitude; }
+    const QList<double> &longitudes() const { return _longitude; }
+    const QList<double> &altitudes() const { return _altitude; }
+    const QList<double> &headings() const { return _heading; }
+    const QList<double> &velocities() const { return _velocity; }
+    const QList<double> &verticalVels() const { return _verticalVel; }
+
+    /// Appends the slots of all aircraft inside rect to result. Rectangles crossing the antimeridian are supported.
+    void slotsInRect(const QGeoRectangle &rect, QList<int> &result) const;
+
+    /// Appends the slots of all aircraft within radiusMeters horizontal distance of center to result.
+    void slotsInRange(const QGeoCoordinate &center, double radiusMeters, QList<int> &result) const;
+
+    static constexpr qint64 kDefaultExpiryMs = 120000;
+    static constexpr double kDefaultCellSizeDegrees = 0.25;
+
+private:
+    quint64 _cellKey(double latitude, double longitude) const;
+    void _addToCell(quint64 cell, int slot);
+    void _removeFromCell(quint64 cell, int slot);
+    void _schedule(int slot, qint64 nowMs);
+    void _remove(int slot);
+
+    /// Appends the slots inside the latitude/longitude box, west <= east
+    void _slotsInBox(double south, double west, double north, double east, QList<int> &result) const;
+
+    const qint64 _expiryMs;
+    const double _cellSizeDegrees;
+
+    QList<uint32_t> _icaoAddress;
+    QList<double> _latitude;
+    QList<double> _longitude;
+    QList<double> _altitude;
+    QList<double> _heading;
+    QList<double> _velocity;
+    QList<double> _verticalVel;
+    QList<QString> _callsign;
+    QList<uint16_t> _squawk;
+    QList<bool> _alert;
+    QList<ADSB::AvailableInfoTypes> _availableFlags;
+    QList<qint64> _lastUpdateMs;
+    QList<qint64> _expiryTick;
+    QList<quint64> _cell;
+    QList<quint32> _revision;
+
+    QHash<uint32_t, int> _slotByIcao;
+    QHash<quint64, QList<int>> _grid;           ///< Cell key to the slots inside the cell
+
+    QList<QList<uint32_t>> _wheel;              ///< ICAO addresses by the tick they are due to expire, modulo the wheel size
+    qint64 _lastExpireTick = 0;
+    bool _wheelStarted = false;
+    quint32 _lastRevision = 0;
+
+    static constexpr qint64 _tickMs = 1000;
+};
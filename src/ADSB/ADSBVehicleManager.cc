@@ -4,12 +4,18 @@
 #include "SettingsManager.h"
 #include "ADSBVehicleManagerSettings.h"
 #include "ADSBTCPLink.h"
-#include "ADSBVehicle.h"
+#include "ADSBTrafficModel.h"
+#include "MultiVehicleManager.h"
 #include "QmlObjectListModel.h"
 #include "QGCLoggingCategory.h"
+#include "Vehicle.h"
+#include "VehicleFactGroup.h"
+#include "VehicleGPSFactGroup.h"
+#include "VehicleLocalPositionFactGroup.h"
 
 #include <QtCore/QApplicationStatic>
 #include <QtCore/QTimer>
+#include <QtCore/QtMath>
 #include <qassert.h>
 
 QGC_LOGGING_CATEGORY(ADSBVehicleManagerLog, "ADSB.ADSBVehicleManager")
@@ -20,16 +26,31 @@ ADSBVehicleManager::ADSBVehicleManager(ADSBVehicleManagerSettings *settings, QOb
     : QObject(parent)
     , _adsbSettings(settings)
     , _adsbVehicleCleanupTimer(new QTimer(this))
-    , _adsbVehicles(new QmlObjectListModel(this))
+    , _publishTimer(new QTimer(this))
+    , _conflictTimer(new QTimer(this))
+    , _adsbVehicles(new ADSBTrafficModel(&_trafficStore, this))
 {
     // qCDebug(ADSBVehicleManagerLog) << Q_FUNC_INFO << this;
 
     (void) qRegisterMetaType<ADSB::VehicleInfo_t>("ADSB::VehicleInfo_t");
 
+    _clock.start();
+
     _adsbVehicleCleanupTimer->setSingleShot(false);
     _adsbVehicleCleanupTimer->setInterval(1000);
     (void) connect(_adsbVehicleCleanupTimer, &QTimer::timeout, this, &ADSBVehicleManager::_cleanupStaleVehicles);
 
+    _publishTimer->setSingleShot(true);
+    _publishTimer->setInterval(kPublishIntervalMs);
+    (void) connect(_publishTimer, &QTimer::timeout, this, &ADSBVehicleManager::_publish);
+
+    _conflictTimer->setSingleShot(false);
+    _conflictTimer->setInterval(kConflictIntervalMs);
+    (void) connect(_conflictTimer, &QTimer::timeout, this, &ADSBVehicleManager::_detectConflicts);
+
+    (void) connect(_adsbSettings->adsbDisplayRange(), &Fact::rawValueChanged, this, &ADSBVehicleManager::_schedulePublish);
+    (void) connect(MultiVehicleManager::instance(), &MultiVehicleManager::activeVehicleChanged, this, &ADSBVehicleManager::_schedulePublish);
+
     Fact* const adsbEnabled = _adsbSettings->adsbServerConnectEnabled();
     Fact* const hostAddress = _adsbSettings->adsbServerHostAddress();
     Fact* const port = _adsbSettings->adsbServerPort();
@@ -138,18 +159,149 @@ void ADSBVehicleManager::_handleADSBVehicle(const mavlink_message_t &message)
 
 void ADSBVehicleManager::adsbVehicleUpdate(const ADSB::VehicleInfo_t &vehicleInfo)
 {
-    const uint32_t icaoAddress = vehicleInfo.icaoAddress;
-    if (_adsbICAOMap.contains(icaoAddress)) {
-        _adsbICAOMap[icaoAddress]->update(vehicleInfo);
+    if (!_trafficStore.update(vehicleInfo, _clock.elapsed())) {
+        return;
+    }
+
+    if (!_adsbVehicleCleanupTimer->isActive()) {
+        _adsbVehicleCleanupTimer->start();
+        _conflictTimer->start();
+    }
+    _schedulePublish();
+}
+
+void ADSBVehicleManager::setViewport(const QGeoRectangle &viewport)
+{
+    if (viewport == _viewport) {
         return;
     }
 
-    if (vehicleInfo.availableFlags & ADSB::LocationAvailable) {
-        ADSBVehicle* const adsbVehicle = new ADSBVehicle(vehicleInfo, this);
-        _adsbICAOMap[icaoAddress] = adsbVehicle;
-        _adsbVehicles->append(adsbVehicle);
-        qCDebug(ADSBVehicleManagerLog) << "Added" << QString::number(adsbVehicle->icaoAddress());
+    _viewport = viewport;
+    _schedulePublish();
+}
+
+void ADSBVehicleManager::_schedulePublish()
+{
+    if (!_publishTimer->isActive()) {
+        _publishTimer->start();
+    }
+}
+
+void ADSBVehicleManager::_publish()
+{
+    const qsizetype aircraftCount = _trafficStore.count();
+
+    _visibleSlots.clear();
+
+    Vehicle *activeVehicle = MultiVehicleManager::instance()->activeVehicle();
+    const QGeoCoordinate rangeCenter = activeVehicle ? activeVehicle->coordinate() : QGeoCoordinate();
+    const double range = _adsbSettings->adsbDisplayRange()->rawValue().toDouble();
+    const bool rangeFilter = rangeCenter.isValid() && (range > 0);
+
+    if (!_viewport.isValid() && !rangeFilter) {
+        // Nothing on screen to cull against yet
+        for (int slot = 0; slot < aircraftCount; slot++) {
+            _visibleSlots.append(slot);
+        }
+    } else {
+        _trafficStore.slotsInRect(_viewport, _visibleSlots);
+        if (rangeFilter) {
+            _trafficStore.slotsInRange(rangeCenter, range, _visibleSlots);
+        }
+
+        // An aircraft can be both in view and in range
+        _slotVisible.fill(false, aircraftCount);
+        qsizetype unique = 0;
+        for (const int slot : std::as_const(_visibleSlots)) {
+            if (!_slotVisible[slot]) {
+                _slotVisible[slot] = true;
+                _visibleSlots[unique++] = slot;
+            }
+        }
+        _visibleSlots.resize(unique);
+    }
+
+    _adsbVehicles->publish(_visibleSlots);
+}
+
+void ADSBVehicleManager::_detectConflicts()
+{
+    _ownVehicles.clear();
+    const QmlObjectListModel *const vehicles = MultiVehicleManager::instance()->vehicles();
+    for (int i = 0; i < vehicles->count(); i++) {
+        Vehicle *const vehicle = vehicles->value<Vehicle*>(i);
+        VehicleFactGroup *const vehicleFactGroup = qobject_cast<VehicleFactGroup*>(vehicle->vehicleFactGroup());
+        if (!vehicleFactGroup) {
+            continue;
+        }
+
+        ADSBConflictDetector::OwnVehicle ownVehicle;
+        ownVehicle.id = vehicle->id();
+        ownVehicle.position = vehicle->coordinate();
+
+        // Heading is where the nose points, which differs from the track in wind or when a multirotor
+        // flies sideways. Prefer the estimator's NED velocity, then GPS course over ground.
+        VehicleLocalPositionFactGroup *const localPosition = qobject_cast<VehicleLocalPositionFactGroup*>(vehicle->localPositionFactGroup());
+        VehicleGPSFactGroup *const gps = qobject_cast<VehicleGPSFactGroup*>(vehicle->gpsFactGroup());
+        const double velocityNorth = localPosition ? localPosition->vx()->rawValue().toDouble() : qQNaN();
+        const double velocityEast = localPosition ? localPosition->vy()->rawValue().toDouble() : qQNaN();
+        const double courseOverGround = gps ? qDegreesToRadians(gps->courseOverGround()->rawValue().toDouble()) : qQNaN();
+        const double groundSpeed = vehicleFactGroup->groundSpeed()->rawValue().toDouble();
+        const double climbRate = vehicleFactGroup->climbRate()->rawValue().toDouble();
+        if (!qIsNaN(velocityNorth) && !qIsNaN(velocityEast)) {
+            ownVehicle.velocityEast = velocityEast;
+            ownVehicle.velocityNorth = velocityNorth;
+        } else if (!qIsNaN(courseOverGround) && !qIsNaN(groundSpeed)) {
+            ownVehicle.velocityEast = groundSpeed * qSin(courseOverGround);
+            ownVehicle.velocityNorth = groundSpeed * qCos(courseOverGround);
+        }
+        if (!qIsNaN(climbRate)) {
+            ownVehicle.velocityUp = climbRate;
+        }
+
+        _ownVehicles.append(ownVehicle);
+    }
+
+    ADSBConflictDetector::Thresholds thresholds;
+    thresholds.horizontalMeters = _adsbSettings->adsbConflictHorizontalSeparation()->rawValue().toDouble();
+    thresholds.verticalMeters = _adsbSettings->adsbConflictVerticalSeparation()->rawValue().toDouble();
+    thresholds.lookaheadSeconds = _adsbSettings->adsbConflictLookahead()->rawValue().toDouble();
+
+    _conflictDetector.evaluate(_trafficStore, _ownVehicles, thresholds, _conflicts);
+
+    _conflictIcaos.clear();
+    for (const ADSBConflictDetector::Threat &threat : std::as_const(_conflicts)) {
+        _conflictIcaos.insert(threat.icaoAddress);
+    }
+    _adsbVehicles->setConflicts(_conflictIcaos);
+
+    const QVariantList threats = threatList(_conflicts, _trafficStore, kMaxPublishedThreats);
+    if (threats != _threats) {
+        _threats = threats;
+        emit threatsChanged();
+    }
+}
+
+QVariantList ADSBVehicleManager::threatList(const QList<ADSBConflictDetector::Threat> &threats, const ADSBTrafficStore &store, qsizetype maxThreats)
+{
+    QVariantList list;
+    const qsizetype threatCount = qMin(threats.count(), maxThreats);
+    list.reserve(threatCount);
+    for (qsizetype i = 0; i < threatCount; i++) {
+        const ADSBConflictDetector::Threat &threat = threats[i];
+        const int slot = store.slot(threat.icaoAddress);
+        list.append(QVariantMap{
+            {QStringLiteral("icaoAddress"), threat.icaoAddress},
+            {QStringLiteral("callsign"), store.callsign(slot)},
+            {QStringLiteral("coordinate"), QVariant::fromValue(store.coordinate(slot))},
+            {QStringLiteral("vehicleId"), threat.vehicleId},
+            {QStringLiteral("distance"), threat.distance},
+            {QStringLiteral("cpaDistance"), threat.cpaDistance},
+            {QStringLiteral("tcpa"), threat.tcpa},
+            {QStringLiteral("verticalSeparation"), threat.verticalSeparation}
+        });
     }
+    return list;
 }
 
 void ADSBVehicleManager::_start(const QString &hostAddress, quint16 port)
@@ -168,7 +320,6 @@ void ADSBVehicleManager::_start(const QString &hostAddress, quint16 port)
     (void) connect(_adsbTcpLink, &ADSBTCPLink::adsbVehicleUpdate, this, &ADSBVehicleManager::adsbVehicleUpdate, Qt::AutoConnection);
     (void) connect(_adsbTcpLink, &ADSBTCPLink::errorOccurred, this, &ADSBVehicleManager::_linkError, Qt::AutoConnection);
 
-    _adsbVehicleCleanupTimer->start();
 }
 
 void ADSBVehicleManager::_stop()
@@ -178,21 +329,26 @@ void ADSBVehicleManager::_stop()
     _adsbTcpLink = nullptr;
 
     _adsbVehicleCleanupTimer->stop();
+    _publishTimer->stop();
+    _conflictTimer->stop();
 
-    _adsbVehicles->clearAndDeleteContents();
-    _adsbICAOMap.clear();
+    _adsbVehicles->clear();
+    _trafficStore.clear();
+    _detectConflicts();
 }
 
 void ADSBVehicleManager::_cleanupStaleVehicles()
 {
-    for (qsizetype i = _adsbVehicles->count() - 1; i >= 0; i--) {
-        ADSBVehicle* const adsbVehicle = _adsbVehicles->value<ADSBVehicle*>(i);
-        if (adsbVehicle->expired()) {
-            qCDebug(ADSBVehicleManagerLog) << "Expired" << QString::number(adsbVehicle->icaoAddress());
-            (void) _adsbVehicles->removeAt(i);
-            (void) _adsbICAOMap.remove(adsbVehicle->icaoAddress());
-            adsbVehicle->deleteLater();
-        }
+    const QList<uint32_t> expired = _trafficStore.expire(_clock.elapsed());
+    if (!expired.isEmpty()) {
+        qCDebug(ADSBVehicleManagerLog) << "Expired" << expired.count() << "aircraft";
+        _schedulePublish();
+    }
+
+    if (_trafficStore.count() == 0) {
+        _adsbVehicleCleanupTimer->stop();
+        _conflictTimer->stop();
+        _detectConflicts();
     }
 }
 
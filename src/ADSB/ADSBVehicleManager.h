@@ -1,22 +1,28 @@
 #pragma once
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QVariantList>
+#include <QtPositioning/QGeoRectangle>
 
 #include "ADSB.h"
+#include "ADSBConflictDetector.h"
+#include "ADSBTrafficStore.h"
 #include "MAVLinkMessageType.h"
 
 class ADSBTCPLink;
-class ADSBVehicle;
-class QmlObjectListModel;
+class ADSBTrafficModel;
 class QTimer;
 class ADSBVehicleManagerSettings;
 
 class ADSBVehicleManager : public QObject
 {
     Q_OBJECT
-    Q_MOC_INCLUDE("QmlObjectListModel.h")
+    Q_MOC_INCLUDE("ADSBTrafficModel.h")
 
-    Q_PROPERTY(const QmlObjectListModel *adsbVehicles READ adsbVehicles CONSTANT)
+    Q_PROPERTY(const ADSBTrafficModel *adsbVehicles READ adsbVehicles CONSTANT)
+    Q_PROPERTY(QVariantList threats READ threats NOTIFY threatsChanged)
 
 public:
     explicit ADSBVehicleManager(ADSBVehicleManagerSettings *settings, QObject *parent = nullptr);
@@ -24,28 +30,70 @@ class ADSBVehicleManager : public QObject
 
     static ADSBVehicleManager *instance();
 
-    const QmlObjectListModel *adsbVehicles() const { return _adsbVehicles; }
+    /// Aircraft inside the map viewport or within display range of the active vehicle
+    const ADSBTrafficModel *adsbVehicles() const { return _adsbVehicles; }
+
+    /// All tracked aircraft
+    const ADSBTrafficStore &trafficStore() const { return _trafficStore; }
+
+    /// Traffic conflicts with the own vehicles, ranked by time to closest approach
+    const QList<ADSBConflictDetector::Threat> &conflicts() const { return _conflicts; }
+
+    /// The most urgent conflicts for display, in conflicts() order, see threatList()
+    QVariantList threats() const { return _threats; }
+
+    /// Display form of the first maxThreats of threats, keeping their ranking. Each entry holds icaoAddress,
+    /// callsign, coordinate, vehicleId, distance, cpaDistance, tcpa and verticalSeparation.
+    static QVariantList threatList(const QList<ADSBConflictDetector::Threat> &threats, const ADSBTrafficStore &store, qsizetype maxThreats);
+
+    /// Sets the area shown by the map, aircraft inside it are published to adsbVehicles
+    Q_INVOKABLE void setViewport(const QGeoRectangle &viewport);
 
     void mavlinkMessageReceived(const mavlink_message_t &message);
 
+signals:
+    void threatsChanged();
+
 public slots:
     void adsbVehicleUpdate(const ADSB::VehicleInfo_t &vehicleInfo);
 
 private slots:
     void _cleanupStaleVehicles();
     void _linkError(const QString &errorMsg, bool stopped = false);
+    void _publish();
+    void _detectConflicts();
 
 private:
     void _start(const QString &hostAddress, quint16 port);
     void _stop();
     void _handleADSBVehicle(const mavlink_message_t &message);
+    void _schedulePublish();
 
     ADSBVehicleManagerSettings *_adsbSettings = nullptr;
     QTimer *_adsbVehicleCleanupTimer = nullptr;
-    QmlObjectListModel *_adsbVehicles = nullptr;
+    QTimer *_publishTimer = nullptr;
+    QTimer *_conflictTimer = nullptr;
+    ADSBTrafficStore _trafficStore;
+    ADSBTrafficModel *_adsbVehicles = nullptr;
+    QElapsedTimer _clock;
+    QGeoRectangle _viewport;
+    ADSBConflictDetector _conflictDetector;
+    QList<ADSBConflictDetector::Threat> _conflicts;
+    QVariantList _threats;
+
+    // Scratch buffers reused by _publish()
+    QList<int> _visibleSlots;
+    QList<bool> _slotVisible;
+
+    // Scratch buffers reused by _detectConflicts()
+    QList<ADSBConflictDetector::OwnVehicle> _ownVehicles;
+    QSet<uint32_t> _conflictIcaos;
 
-    QMap<uint32_t, ADSBVehicle*> _adsbICAOMap;
     ADSBTCPLink *_adsbTcpLink = nullptr;
 
+    static constexpr int kPublishIntervalMs = 100;  ///< Model updates are batched at this interval
+    static constexpr int kConflictIntervalMs = 100; ///< Conflicts are evaluated at this interval while there is traffic
+    static constexpr int kMaxPublishedThreats = 10;
+
     static constexpr uint8_t kMaxTimeSinceLastSeen = 15;
 };
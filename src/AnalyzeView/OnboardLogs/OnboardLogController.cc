@@ -365,8 +365,14 @@ bool OnboardLogController::_logComplete() const
 void OnboardLogController::_receivedAllData()
 {
     _timer->stop();
+    if (_downloadData && _logComplete()) {
+        _downloadData->removeJournal();
+    }
+
     if (_prepareLogDownload()) {
-        _requestLogData(_downloadData->ID, 0, _downloadData->chunk_table.size() * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
+        _requestLogData(_downloadData->ID,
+                        _downloadData->current_chunk * OnboardLogDownloadData::kChunkSize,
+                        _downloadData->chunk_table.size() * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
         _timer->start(kTimeOutMs);
     } else {
         _resetSelection();
@@ -405,7 +411,20 @@ bool OnboardLogController::_prepareLogDownload()
 
     _downloadData->file.setFileName(_downloadPath + _downloadData->filename);
 
+    int resumeChunk = -1;
     if (_downloadData->file.exists()) {
+        resumeChunk = _downloadData->loadJournal();
+        if ((resumeChunk < 0) && !QFile::exists(_downloadData->journalPath()) && (_downloadData->file.size() == entry->size())) {
+            // A complete copy of this log is already on disk, the LOG_DATA protocol offers no checksum so the size has to do
+            qCDebug(OnboardLogControllerLog) << "Skipping log which is already downloaded:" << _downloadData->file.fileName();
+            entry->setStatus(tr("Already downloaded"));
+            return _prepareLogDownload();
+        }
+    }
+
+    if (resumeChunk >= 0) {
+        qCDebug(OnboardLogControllerLog) << "Resuming log download:" << _downloadData->file.fileName() << "chunk" << resumeChunk;
+    } else if (_downloadData->file.exists()) {
         uint32_t numDups = 0;
         const QStringList filename_spl = _downloadData->filename.split('.');
         do {
@@ -415,21 +434,35 @@ bool OnboardLogController::_prepareLogDownload()
         } while ( _downloadData->file.exists());
     }
 
+    const bool resume = (resumeChunk >= 0);
+    const QIODevice::OpenMode openMode = resume ? QIODevice::ReadWrite : QIODevice::WriteOnly;
+
+    _downloadData->current_chunk = resume ? static_cast<uint32_t>(resumeChunk) : 0;
+
+    // The journal is written before the file is grown to full size. A full size file without a journal
+    // is taken to be a complete download and would never be fetched again.
     bool result = false;
-    if (!_downloadData->file.open(QIODevice::WriteOnly)) {
+    if (!_downloadData->file.open(openMode)) {
         qCWarning(OnboardLogControllerLog) << "Failed to create log file:" <<  _downloadData->filename;
+    } else if (!_downloadData->saveJournal()) {
+        qCWarning(OnboardLogControllerLog) << "Failed to write download journal for log file:" <<  _downloadData->filename;
     } else if (!_downloadData->file.resize(entry->size())) {
         qCWarning(OnboardLogControllerLog) << "Failed to allocate space for log file:" <<  _downloadData->filename;
     } else {
-        _downloadData->current_chunk = 0;
         _downloadData->chunk_table = QBitArray(_downloadData->chunkBins(), false);
+        _downloadData->written = _downloadData->current_chunk * OnboardLogDownloadData::kChunkSize;
+        _downloadData->last_status_written = _downloadData->written;
         _downloadData->elapsed.start();
         result = true;
     }
 
     if (!result) {
-        if (_downloadData->file.exists()) {
-            (void) _downloadData->file.remove();
+        if (!resume) {
+            _downloadData->file.close();
+            if (_downloadData->file.exists()) {
+                (void) _downloadData->file.remove();
+            }
+            _downloadData->removeJournal();
         }
 
         _downloadData->entry->setStatus(QStringLiteral("Error"));
@@ -469,7 +502,8 @@ void OnboardLogController::cancel()
 
     if (_downloadData) {
         _downloadData->entry->setStatus(QStringLiteral("Canceled"));
-        if (_downloadData->file.exists()) {
+        // Keep the partial file when its journal was written so the next download of this log resumes
+        if (_downloadData->file.exists() && !QFile::exists(_downloadData->journalPath())) {
             (void) _downloadData->file.remove();
         }
 
@@ -3,6 +3,10 @@
 #include "QGCFormat.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
 #include <QtCore/QtMath>
 
 QGC_LOGGING_CATEGORY(OnboardLogEntryLog, "AnalyzeView.QGCOnboardLogEntry")
@@ -25,6 +29,14 @@ void OnboardLogDownloadData::advanceChunk()
 {
     ++current_chunk;
     chunk_table = QBitArray(chunkBins(), false);
+
+    // The journal must never claim a chunk whose data is still sitting in the QFile buffer, a resume
+    // after a crash would otherwise skip bytes that never reached the file
+    if (!file.isOpen() || !file.flush()) {
+        qCWarning(OnboardLogEntryLog) << "Failed to flush log file, download journal not advanced" << file.fileName() << file.errorString();
+        return;
+    }
+    (void) saveJournal();
 }
 
 uint32_t OnboardLogDownloadData::chunkBins() const
@@ -44,6 +56,71 @@ bool OnboardLogDownloadData::chunkEquals(const bool val) const
     return (chunk_table == QBitArray(chunk_table.size(), val));
 }
 
+namespace {
+    constexpr int kJournalVersion = 1;
+    constexpr const char *kJournalVersionKey = "version";
+    constexpr const char *kJournalLogIdKey = "logId";
+    constexpr const char *kJournalSizeKey = "size";
+    constexpr const char *kJournalTimeKey = "timeUtc";
+    constexpr const char *kJournalChunkSizeKey = "chunkSize";
+    constexpr const char *kJournalCompletedChunksKey = "completedChunks";
+}
+
+bool OnboardLogDownloadData::saveJournal() const
+{
+    QJsonObject json;
+    json[kJournalVersionKey] = kJournalVersion;
+    json[kJournalLogIdKey] = static_cast<qint64>(ID);
+    json[kJournalSizeKey] = static_cast<qint64>(entry->size());
+    json[kJournalTimeKey] = entry->time().toSecsSinceEpoch();
+    json[kJournalChunkSizeKey] = static_cast<qint64>(kChunkSize);
+    json[kJournalCompletedChunksKey] = static_cast<qint64>(current_chunk);
+
+    QSaveFile journal(journalPath());
+    if (!journal.open(QIODevice::WriteOnly)) {
+        qCWarning(OnboardLogEntryLog) << "Failed to open download journal" << journalPath() << journal.errorString();
+        return false;
+    }
+
+    (void) journal.write(QJsonDocument(json).toJson(QJsonDocument::Compact));
+    if (!journal.commit()) {
+        qCWarning(OnboardLogEntryLog) << "Failed to write download journal" << journalPath() << journal.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+int OnboardLogDownloadData::loadJournal() const
+{
+    QFile journal(journalPath());
+    if (!journal.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+
+    const QJsonObject json = QJsonDocument::fromJson(journal.readAll()).object();
+    if ((json[kJournalVersionKey].toInt() != kJournalVersion) ||
+            (json[kJournalLogIdKey].toInteger() != ID) ||
+            (json[kJournalSizeKey].toInteger() != entry->size()) ||
+            (json[kJournalTimeKey].toInteger() != entry->time().toSecsSinceEpoch()) ||
+            (json[kJournalChunkSizeKey].toInteger() != kChunkSize)) {
+        qCDebug(OnboardLogEntryLog) << "Download journal does not match log entry" << journalPath();
+        return -1;
+    }
+
+    const qint64 completedChunks = json[kJournalCompletedChunksKey].toInteger(-1);
+    if ((completedChunks < 0) || (completedChunks >= numChunks())) {
+        return -1;
+    }
+
+    return static_cast<int>(completedChunks);
+}
+
+void OnboardLogDownloadData::removeJournal() const
+{
+    (void) QFile::remove(journalPath());
+}
+
 /*===========================================================================*/
 
 QGCOnboardLogEntry::QGCOnboardLogEntry(uint logId, const QDateTime &dateTime, uint logSize, bool received, QObject *parent)
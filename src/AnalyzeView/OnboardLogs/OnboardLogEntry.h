@@ -15,6 +15,7 @@ struct OnboardLogDownloadData
     explicit OnboardLogDownloadData(QGCOnboardLogEntry * const logEntry);
     ~OnboardLogDownloadData();
 
+    /// Moves on to the next chunk and records the completed ones in the journal once the file has been flushed
     void advanceChunk();
 
     /// The number of MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN bins in the current chunk
@@ -26,6 +27,18 @@ struct OnboardLogDownloadData
     /// True if all bins in the chunk have been set to val
     bool chunkEquals(const bool val) const;
 
+    /// Journal stored next to the download file which records how many chunks are complete, so an
+    /// interrupted download can resume after a cancel, link loss or restart
+    QString journalPath() const { return file.fileName() + QStringLiteral(".part"); }
+
+    /// Records current_chunk as the number of completed chunks
+    bool saveJournal() const;
+
+    /// @return Number of completed chunks recorded for this log, -1 if there is no journal matching the log entry
+    int loadJournal() const;
+
+    void removeJournal() const;
+
     uint ID = 0;
     QGCOnboardLogEntry *const entry = nullptr;
 
@@ -5,6 +5,7 @@
 #include "OnboardLogFtpEntry.h"
 #include "QGCFormat.h"
 #include "QGCLoggingCategory.h"
+#include "QGCMath.h"
 #include "QmlObjectListModel.h"
 #include "SettingsManager.h"
 #include "Vehicle.h"
@@ -13,7 +14,9 @@
 #include <QtCore/QDateTime>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
 #include <QtCore/QTimeZone>
+#include <QtConcurrent/QtConcurrentRun>
 
 QGC_LOGGING_CATEGORY(OnboardLogFtpControllerLog, "AnalyzeView.OnboardLogFtpController")
 
@@ -49,7 +52,6 @@ void OnboardLogFtpController::_setActiveVehicle(Vehicle *vehicle)
         _logEntriesModel->clearAndDeleteContents();
         FTPManager *const ftp = _vehicle->ftpManager();
         (void) disconnect(ftp, &FTPManager::listDirectoryComplete, this, &OnboardLogFtpController::_listDirComplete);
-        (void) disconnect(ftp, &FTPManager::downloadComplete,      this, &OnboardLogFtpController::_downloadComplete);
         (void) disconnect(ftp, &FTPManager::commandProgress,       this, &OnboardLogFtpController::_downloadProgress);
 
         _listState = Idle;
@@ -57,6 +59,7 @@ void OnboardLogFtpController::_setActiveVehicle(Vehicle *vehicle)
         _logIdCounter = 0;
         _downloadQueue.clear();
         _currentDownloadEntry = nullptr;
+        ftp->cancelQueuedOperations(this);
     }
 
     _vehicle = vehicle;
@@ -301,8 +304,6 @@ void OnboardLogFtpController::_downloadEntry(QGCOnboardLogFtpEntry *entry)
     _downloadRateAvg = 0.;
     _downloadElapsed.start();
 
-    entry->setStatus(tr("Downloading"));
-
     QString localFilename;
     if (entry->time().isValid() && entry->time().date().year() >= 2010) {
         localFilename = entry->time().toString(QStringLiteral("yyyy-M-d-hh-mm-ss")) + QStringLiteral(".ulg");
@@ -310,6 +311,51 @@ void OnboardLogFtpController::_downloadEntry(QGCOnboardLogFtpEntry *entry)
         localFilename = QStringLiteral("log_") + QString::number(entry->id()) + QStringLiteral(".ulg");
     }
 
+    const QFileInfo existingFile(_downloadPath + localFilename);
+    if (existingFile.exists() && (existingFile.size() == entry->size())) {
+        // Same name and size as the vehicle copy, confirm it with a CRC computed on the vehicle before skipping it
+        entry->setStatus(tr("Verifying"));
+        qCDebug(OnboardLogFtpControllerLog) << "verifying existing" << existingFile.absoluteFilePath();
+
+        const QString localPath = existingFile.absoluteFilePath();
+        _vehicle->ftpManager()->queueCalcFileCRC32(FTPManager::Priority::Bulk, this,
+            [this, entry, localPath, localFilename](uint32_t crc32, const QString &errorMsg) {
+                if (_currentDownloadEntry != entry) {
+                    return;
+                }
+                if (!errorMsg.isEmpty()) {
+                    // Not every firmware implements kCmdCalcFileCRC32, the size match has to do
+                    qCDebug(OnboardLogFtpControllerLog) << "vehicle CRC32 unavailable, matched on size:" << errorMsg;
+                    entry->setStatus(tr("Already downloaded"));
+                    _downloadNext();
+                    return;
+                }
+
+                // Logs can be hundreds of MB, hash the local copy off the GUI thread
+                (void) QtConcurrent::run(&OnboardLogFtpController::_fileCRC32, localPath).then(this,
+                    [this, entry, crc32, localPath, localFilename](uint32_t localCrc32) {
+                        if (!_vehicle || (_currentDownloadEntry != entry)) {
+                            return;
+                        }
+                        if (crc32 != localCrc32) {
+                            qCDebug(OnboardLogFtpControllerLog) << "CRC32 mismatch, downloading again" << localPath;
+                            _startDownload(entry, _uniqueFilename(localFilename));
+                            return;
+                        }
+                        entry->setStatus(tr("Already downloaded"));
+                        _downloadNext();
+                    });
+            },
+            MAV_COMP_ID_AUTOPILOT1, entry->ftpPath());
+        return;
+    }
+
+    _startDownload(entry, _uniqueFilename(localFilename));
+}
+
+QString OnboardLogFtpController::_uniqueFilename(const QString &filename) const
+{
+    QString localFilename = filename;
     if (QFile::exists(_downloadPath + localFilename)) {
         const QStringList parts = localFilename.split(QLatin1Char('.'));
         uint numDups = 0;
@@ -319,25 +365,43 @@ void OnboardLogFtpController::_downloadEntry(QGCOnboardLogFtpEntry *entry)
         } while (QFile::exists(_downloadPath + localFilename));
     }
 
+    return localFilename;
+}
+
+uint32_t OnboardLogFtpController::_fileCRC32(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+
+    constexpr qint64 kReadSize = 64 * 1024;
+    uint32_t crc32 = 0;
+    while (!file.atEnd()) {
+        const QByteArray bytes = file.read(kReadSize);
+        if (bytes.isEmpty()) {
+            break;
+        }
+        crc32 = QGC::crc32(reinterpret_cast<const uint8_t*>(bytes.constData()), static_cast<unsigned>(bytes.size()), crc32);
+    }
+
+    return crc32;
+}
+
+void OnboardLogFtpController::_startDownload(QGCOnboardLogFtpEntry *entry, const QString &localFilename)
+{
+    entry->setStatus(tr("Downloading"));
+
     FTPManager *const ftp = _vehicle->ftpManager();
-    (void) disconnect(ftp, &FTPManager::downloadComplete, this, &OnboardLogFtpController::_downloadComplete);
     (void) disconnect(ftp, &FTPManager::commandProgress,  this, &OnboardLogFtpController::_downloadProgress);
-    (void) connect(ftp, &FTPManager::downloadComplete, this, &OnboardLogFtpController::_downloadComplete);
     (void) connect(ftp, &FTPManager::commandProgress,  this, &OnboardLogFtpController::_downloadProgress);
 
     qCDebug(OnboardLogFtpControllerLog) << "downloading" << entry->ftpPath() << "to" << _downloadPath + localFilename;
 
-    if (!ftp->download(MAV_COMP_ID_AUTOPILOT1, entry->ftpPath(), _downloadPath, localFilename, true)) {
-        qCWarning(OnboardLogFtpControllerLog) << "failed to start download for" << entry->ftpPath();
-        entry->setStatus(tr("Error"));
-        _currentDownloadEntry = nullptr;
-
-        if (!_downloadQueue.isEmpty()) {
-            _downloadEntry(_downloadQueue.dequeue());
-        } else {
-            _setDownloading(false);
-        }
-    }
+    // Logs are queued one at a time at bulk priority so interactive and connect time FTP requests run between them
+    ftp->queueDownload(FTPManager::Priority::Bulk, this,
+        [this](const QString &file, const QString &errorMsg) { _downloadComplete(file, errorMsg); },
+        MAV_COMP_ID_AUTOPILOT1, entry->ftpPath(), _downloadPath, localFilename, true);
 }
 
 void OnboardLogFtpController::_downloadComplete(const QString &file, const QString &errorMsg)
@@ -348,12 +412,21 @@ void OnboardLogFtpController::_downloadComplete(const QString &file, const QStri
 
     if (errorMsg.isEmpty()) {
         _currentDownloadEntry->setStatus(tr("Downloaded"));
-        qCDebug(OnboardLogFtpControllerLog) << "download complete" << file;
+        const FTPManager::TransferStats_t &stats = _vehicle->ftpManager()->transferStats();
+        qCDebug(OnboardLogFtpControllerLog) << "download complete" << file
+                                            << "rate:" << stats.bytesPerSecond()
+                                            << "retransmits:" << stats.retransmits
+                                            << "missingBlocks:" << stats.missingBlocks;
     } else {
         _currentDownloadEntry->setStatus(tr("Error"));
         qCWarning(OnboardLogFtpControllerLog) << "download error:" << errorMsg;
     }
 
+    _downloadNext();
+}
+
+void OnboardLogFtpController::_downloadNext()
+{
     _currentDownloadEntry = nullptr;
 
     if (!_downloadQueue.isEmpty()) {
@@ -365,7 +438,7 @@ void OnboardLogFtpController::_downloadComplete(const QString &file, const QStri
 
 void OnboardLogFtpController::_downloadProgress(float value)
 {
-    if (!_currentDownloadEntry) {
+    if (!_currentDownloadEntry || !_vehicle || (_vehicle->ftpManager()->activeOperationContext() != this)) {
         return;
     }
 
@@ -381,9 +454,10 @@ void OnboardLogFtpController::_downloadProgress(float value)
     _downloadBytesAtLastUpdate = totalBytes;
     _downloadElapsed.start();
 
-    const QString status = QStringLiteral("%1 (%2/s)").arg(
-        QGC::bigSizeToString(totalBytes),
-        QGC::bigSizeToString(_downloadRateAvg));
+    const uint32_t retransmits = _vehicle ? _vehicle->ftpManager()->transferStats().retransmits : 0;
+    const QString status = (retransmits > 0)
+        ? tr("%1 (%2/s), %n retries", nullptr, static_cast<int>(retransmits)).arg(QGC::bigSizeToString(totalBytes), QGC::bigSizeToString(_downloadRateAvg))
+        : QStringLiteral("%1 (%2/s)").arg(QGC::bigSizeToString(totalBytes), QGC::bigSizeToString(_downloadRateAvg));
 
     _currentDownloadEntry->setStatus(status);
 }
@@ -401,12 +475,12 @@ void OnboardLogFtpController::cancel()
     }
 
     if (_downloadingLogs) {
-        _vehicle->ftpManager()->cancelDownload();
         if (_currentDownloadEntry) {
             _currentDownloadEntry->setStatus(tr("Canceled"));
             _currentDownloadEntry = nullptr;
         }
         _downloadQueue.clear();
+        _vehicle->ftpManager()->cancelQueuedOperations(this);
     }
 
     _resetSelection(true);
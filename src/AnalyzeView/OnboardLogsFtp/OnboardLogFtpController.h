@@ -54,6 +54,11 @@ private slots:
     void _listNextSubdir();
     uint _processFileEntries(const QStringList &dirList, const QString &subdir);
     void _downloadEntry(QGCOnboardLogFtpEntry *entry);
+    void _startDownload(QGCOnboardLogFtpEntry *entry, const QString &localFilename);
+    void _downloadNext();
+    QString _uniqueFilename(const QString &filename) const;
+    /// Reads the whole file, run it off the GUI thread
+    static uint32_t _fileCRC32(const QString &path);
     void _downloadToDirectory(const QString &dir);
     void _resetSelection(bool canceled = false);
     void _setDownloading(bool active);
@@ -4,7 +4,7 @@
 
 APMFollowComponentController::APMFollowComponentController(QObject *parent)
     : FactPanelController(parent)
-    , _metaDataMap(FactMetaData::createMapFromJsonFile(QStringLiteral(":/json/APMFollowComponent.FactMetaData.json"), this))
+    , _metaDataMap(FactMetaData::sharedMapFromJsonFile(QStringLiteral(":/json/APMFollowComponent.FactMetaData.json")))
     , _angleFact(new SettingsFact(_settingsGroup, _metaDataMap[_angleName], this))
     , _distanceFact(new SettingsFact(_settingsGroup, _metaDataMap[_distanceName], this))
     , _heightFact(new SettingsFact(_settingsGroup, _metaDataMap[_heightName], this))
@@ -0,0 +1,468 @@
+#include "QGCCameraDefinition.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QIODevice>
+#include <QtCore/QXmlStreamReader>
+
+QGC_LOGGING_CATEGORY(QGCCameraDefinitionLog, "Camera.QGCCameraDefinition")
+
+namespace {
+
+constexpr quint32 kMagic = 0x51434446; // "QCDF"
+
+constexpr QLatin1StringView kCondition       ("condition");
+constexpr QLatin1StringView kControl         ("control");
+constexpr QLatin1StringView kDefault         ("default");
+constexpr QLatin1StringView kDefinition      ("definition");
+constexpr QLatin1StringView kDescription     ("description");
+constexpr QLatin1StringView kExclusion       ("exclude");
+constexpr QLatin1StringView kExclusions      ("exclusions");
+constexpr QLatin1StringView kLocale          ("locale");
+constexpr QLatin1StringView kLocalization    ("localization");
+constexpr QLatin1StringView kMax             ("max");
+constexpr QLatin1StringView kMin             ("min");
+constexpr QLatin1StringView kModel           ("model");
+constexpr QLatin1StringView kName            ("name");
+constexpr QLatin1StringView kOption          ("option");
+constexpr QLatin1StringView kOptions         ("options");
+constexpr QLatin1StringView kOriginal        ("original");
+constexpr QLatin1StringView kParameter       ("parameter");
+constexpr QLatin1StringView kParameterrange  ("parameterrange");
+constexpr QLatin1StringView kParameterranges ("parameterranges");
+constexpr QLatin1StringView kParameters      ("parameters");
+constexpr QLatin1StringView kReadOnly        ("readonly");
+constexpr QLatin1StringView kWriteOnly       ("writeonly");
+constexpr QLatin1StringView kRoption         ("roption");
+constexpr QLatin1StringView kStep            ("step");
+constexpr QLatin1StringView kDecimalPlaces   ("decimalPlaces");
+constexpr QLatin1StringView kStrings         ("strings");
+constexpr QLatin1StringView kTranslated      ("translated");
+constexpr QLatin1StringView kType            ("type");
+constexpr QLatin1StringView kUnit            ("unit");
+constexpr QLatin1StringView kUpdate          ("update");
+constexpr QLatin1StringView kUpdates         ("updates");
+constexpr QLatin1StringView kValue           ("value");
+constexpr QLatin1StringView kVendor          ("vendor");
+constexpr QLatin1StringView kVersion         ("version");
+
+/// @return Attribute value, null if the attribute is missing and empty (not null) if it is present without a value
+QString attribute(const QXmlStreamReader &reader, QLatin1StringView name)
+{
+    const QXmlStreamAttributes attributes = reader.attributes();
+    if (!attributes.hasAttribute(name)) {
+        return QString();
+    }
+    const QString value = attributes.value(name).toString();
+    return value.isNull() ? QString(QLatin1StringView("")) : value;
+}
+
+void readBoolAttribute(const QXmlStreamReader &reader, QLatin1StringView name, bool &target)
+{
+    const QString value = attribute(reader, name);
+    if (!value.isNull()) {
+        target = (value != QStringLiteral("0"));
+    }
+}
+
+/// Reads the text of all <childName> children of the current element
+QStringList readTextList(QXmlStreamReader &reader, QLatin1StringView childName)
+{
+    QStringList list;
+    while (reader.readNextStartElement()) {
+        if (reader.name() == childName) {
+            const QString text = reader.readElementText(QXmlStreamReader::IncludeChildElements);
+            if (!text.isEmpty()) {
+                list << text;
+            }
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+    return list;
+}
+
+bool parseRange(QXmlStreamReader &reader, const QString &factName, QGCCameraDefinition::ParameterRange &range, QString &errorString)
+{
+    range.parameter = attribute(reader, kParameter);
+    if (range.parameter.isNull()) {
+        errorString = QStringLiteral("Malformed option range for parameter %1").arg(factName);
+        return false;
+    }
+    range.condition = attribute(reader, kCondition);
+
+    while (reader.readNextStartElement()) {
+        if (reader.name() != kRoption) {
+            reader.skipCurrentElement();
+            continue;
+        }
+        const QString optName = attribute(reader, kName);
+        if (optName.isNull()) {
+            errorString = QStringLiteral("Malformed roption for parameter %1").arg(factName);
+            return false;
+        }
+        const QString optValue = attribute(reader, kValue);
+        if (optValue.isNull()) {
+            errorString = QStringLiteral("Malformed rvalue for parameter %1").arg(factName);
+            return false;
+        }
+        range.optNames << optName;
+        range.optValues << optValue;
+        reader.skipCurrentElement();
+    }
+
+    return true;
+}
+
+bool parseOption(QXmlStreamReader &reader, const QString &factName, QGCCameraDefinition::Option &option, QString &errorString)
+{
+    option.name = attribute(reader, kName);
+    if (option.name.isNull()) {
+        errorString = QStringLiteral("Malformed option for parameter %1").arg(factName);
+        return false;
+    }
+    option.value = attribute(reader, kValue);
+    if (option.value.isNull()) {
+        errorString = QStringLiteral("Malformed value for parameter %1").arg(factName);
+        return false;
+    }
+
+    while (reader.readNextStartElement()) {
+        if (reader.name() == kExclusions) {
+            option.exclusions = readTextList(reader, kExclusion);
+        } else if (reader.name() == kParameterranges) {
+            while (reader.readNextStartElement()) {
+                if (reader.name() != kParameterrange) {
+                    reader.skipCurrentElement();
+                    continue;
+                }
+                QGCCameraDefinition::ParameterRange range;
+                if (!parseRange(reader, factName, range, errorString)) {
+                    return false;
+                }
+                if (!range.optNames.isEmpty()) {
+                    option.ranges.append(range);
+                }
+            }
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+
+    return true;
+}
+
+bool parseParameter(QXmlStreamReader &reader, QGCCameraDefinition::Parameter &parameter, QString &errorString)
+{
+    parameter.name = attribute(reader, kName);
+    if (parameter.name.isNull()) {
+        errorString = QStringLiteral("Parameter entry missing parameter name");
+        return false;
+    }
+    parameter.type = attribute(reader, kType);
+    if (parameter.type.isNull()) {
+        errorString = QStringLiteral("Parameter %1 missing parameter type").arg(parameter.name);
+        return false;
+    }
+    readBoolAttribute(reader, kControl, parameter.control);
+    readBoolAttribute(reader, kReadOnly, parameter.readOnly);
+    readBoolAttribute(reader, kWriteOnly, parameter.writeOnly);
+    parameter.defaultValue  = attribute(reader, kDefault);
+    parameter.min           = attribute(reader, kMin);
+    parameter.max           = attribute(reader, kMax);
+    parameter.step          = attribute(reader, kStep);
+    parameter.decimalPlaces = attribute(reader, kDecimalPlaces);
+    parameter.unit          = attribute(reader, kUnit);
+
+    bool hasDescription = false;
+    while (reader.readNextStartElement()) {
+        if ((reader.name() == kDescription) && !hasDescription) {
+            parameter.description = reader.readElementText(QXmlStreamReader::IncludeChildElements);
+            hasDescription = true;
+        } else if (reader.name() == kUpdates) {
+            parameter.updates = readTextList(reader, kUpdate);
+        } else if (reader.name() == kOptions) {
+            while (reader.readNextStartElement()) {
+                if (reader.name() != kOption) {
+                    reader.skipCurrentElement();
+                    continue;
+                }
+                QGCCameraDefinition::Option option;
+                if (!parseOption(reader, parameter.name, option, errorString)) {
+                    return false;
+                }
+                parameter.options.append(option);
+            }
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+
+    if (!hasDescription) {
+        errorString = QStringLiteral("Parameter %1 missing parameter description").arg(parameter.name);
+        return false;
+    }
+
+    return true;
+}
+
+bool parseDefinition(QXmlStreamReader &reader, QGCCameraDefinition &definition, QString &errorString)
+{
+    const QString version = attribute(reader, kVersion);
+    bool hasModel = false;
+    bool hasVendor = false;
+    while (reader.readNextStartElement()) {
+        if (reader.name() == kModel) {
+            definition.model = reader.readElementText(QXmlStreamReader::IncludeChildElements);
+            hasModel = true;
+        } else if (reader.name() == kVendor) {
+            definition.vendor = reader.readElementText(QXmlStreamReader::IncludeChildElements);
+            hasVendor = true;
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+
+    if (version.isNull() || !hasModel || !hasVendor) {
+        errorString = QStringLiteral("Unable to load camera constants from camera definition");
+        return false;
+    }
+    definition.version = version.toInt();
+
+    return true;
+}
+
+void writeStringList(QDataStream &stream, const QStringList &list)
+{
+    stream << static_cast<quint32>(list.count());
+    for (const QString &string : list) {
+        stream << string;
+    }
+}
+
+bool readStringList(QDataStream &stream, QStringList &list)
+{
+    quint32 count = 0;
+    stream >> count;
+    list.clear();
+    for (quint32 i = 0; (i < count) && (stream.status() == QDataStream::Ok); i++) {
+        QString string;
+        stream >> string;
+        list << string;
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+} // namespace
+
+bool QGCCameraDefinition::parse(const QByteArray &xml, QGCCameraDefinition &definition, QString &errorString)
+{
+    definition = QGCCameraDefinition();
+    errorString.clear();
+
+    QXmlStreamReader reader(xml);
+    bool hasDefinition = false;
+    bool hasParameters = false;
+    if (reader.readNextStartElement()) {
+        while (reader.readNextStartElement()) {
+            if ((reader.name() == kDefinition) && !hasDefinition) {
+                if (!parseDefinition(reader, definition, errorString)) {
+                    return false;
+                }
+                hasDefinition = true;
+            } else if ((reader.name() == kParameters) && !hasParameters) {
+                while (reader.readNextStartElement()) {
+                    if (reader.name() != kParameter) {
+                        reader.skipCurrentElement();
+                        continue;
+                    }
+                    Parameter parameter;
+                    if (!parseParameter(reader, parameter, errorString)) {
+                        return false;
+                    }
+                    definition.parameters.append(parameter);
+                }
+                hasParameters = true;
+            } else {
+                reader.skipCurrentElement();
+            }
+        }
+    }
+
+    if (reader.hasError()) {
+        errorString = QStringLiteral("Line %1: %2").arg(reader.lineNumber()).arg(reader.errorString());
+        return false;
+    }
+
+    if (!hasDefinition) {
+        errorString = QStringLiteral("Unable to load camera constants from camera definition");
+        return false;
+    }
+
+    return true;
+}
+
+QByteArray QGCCameraDefinition::localize(const QByteArray &xml, const QString &localeName)
+{
+    struct Locale {
+        QString name;
+        QList<QPair<QString, QString>> strings;
+    };
+
+    QList<Locale> locales;
+    QXmlStreamReader reader(xml);
+    if (reader.readNextStartElement()) {
+        while (reader.readNextStartElement()) {
+            if (reader.name() != kLocalization) {
+                reader.skipCurrentElement();
+                continue;
+            }
+            while (reader.readNextStartElement()) {
+                if (reader.name() != kLocale) {
+                    reader.skipCurrentElement();
+                    continue;
+                }
+                Locale locale;
+                locale.name = attribute(reader, kName);
+                while (reader.readNextStartElement()) {
+                    if (reader.name() == kStrings) {
+                        const QString original = attribute(reader, kOriginal);
+                        const QString translated = attribute(reader, kTranslated);
+                        if (!original.isNull() && !translated.isNull()) {
+                            locale.strings.append(qMakePair(original, translated));
+                        }
+                    }
+                    reader.skipCurrentElement();
+                }
+                if (locale.name.isNull()) {
+                    qCWarning(QGCCameraDefinitionLog) << "Localization entry is missing its name attribute";
+                    continue;
+                }
+                locales.append(locale);
+            }
+        }
+    }
+
+    if (locales.isEmpty()) {
+        return xml;
+    }
+
+    const auto normalized = [](const QString &name) { return name.toLower().replace(QLatin1Char('-'), QLatin1Char('_')); };
+
+    // Direct match first, then the first entry for the same language
+    const Locale *match = nullptr;
+    for (const Locale &locale : std::as_const(locales)) {
+        if (normalized(locale.name) == localeName) {
+            match = &locale;
+            break;
+        }
+    }
+    if (!match) {
+        const QString language = localeName.left(3);
+        for (const Locale &locale : std::as_const(locales)) {
+            if (locale.name.toLower().startsWith(language)) {
+                match = &locale;
+                break;
+            }
+        }
+    }
+    if (!match) {
+        qCWarning(QGCCameraDefinitionLog) << "No match for" << localeName << "in camera definition file";
+        return xml;
+    }
+
+    QByteArray localized = xml;
+    for (const auto &[original, translated] : match->strings) {
+        (void) localized.replace(QString(QLatin1Char('"') + original + QLatin1Char('"')).toUtf8(), QString(QLatin1Char('"') + translated + QLatin1Char('"')).toUtf8());
+        (void) localized.replace(QString(QLatin1Char('>') + original + QLatin1Char('<')).toUtf8(), QString(QLatin1Char('>') + translated + QLatin1Char('<')).toUtf8());
+    }
+
+    return localized;
+}
+
+QByteArray QGCCameraDefinition::serialize() const
+{
+    QByteArray bytes;
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    stream << kMagic << kFormatVersion;
+    stream << static_cast<qint32>(version) << model << vendor;
+    stream << static_cast<quint32>(parameters.count());
+    for (const Parameter &parameter : parameters) {
+        stream << parameter.name << parameter.type << parameter.description << parameter.defaultValue
+               << parameter.min << parameter.max << parameter.step << parameter.decimalPlaces << parameter.unit
+               << parameter.control << parameter.readOnly << parameter.writeOnly;
+        writeStringList(stream, parameter.updates);
+        stream << static_cast<quint32>(parameter.options.count());
+        for (const Option &option : parameter.options) {
+            stream << option.name << option.value;
+            writeStringList(stream, option.exclusions);
+            stream << static_cast<quint32>(option.ranges.count());
+            for (const ParameterRange &range : option.ranges) {
+                stream << range.parameter << range.condition;
+                writeStringList(stream, range.optNames);
+                writeStringList(stream, range.optValues);
+            }
+        }
+    }
+
+    return bytes;
+}
+
+bool QGCCameraDefinition::deserialize(const QByteArray &bytes, QGCCameraDefinition &definition)
+{
+    definition = QGCCameraDefinition();
+
+    QDataStream stream(bytes);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 formatVersion = 0;
+    stream >> magic >> formatVersion;
+    if ((stream.status() != QDataStream::Ok) || (magic != kMagic) || (formatVersion != kFormatVersion)) {
+        qCDebug(QGCCameraDefinitionLog) << "Not a compiled camera definition of format" << kFormatVersion;
+        return false;
+    }
+
+    qint32 version = 0;
+    quint32 parameterCount = 0;
+    stream >> version >> definition.model >> definition.vendor >> parameterCount;
+    definition.version = version;
+
+    for (quint32 i = 0; (i < parameterCount) && (stream.status() == QDataStream::Ok); i++) {
+        Parameter parameter;
+        stream >> parameter.name >> parameter.type >> parameter.description >> parameter.defaultValue
+               >> parameter.min >> parameter.max >> parameter.step >> parameter.decimalPlaces >> parameter.unit
+               >> parameter.control >> parameter.readOnly >> parameter.writeOnly;
+        (void) readStringList(stream, parameter.updates);
+
+        quint32 optionCount = 0;
+        stream >> optionCount;
+        for (quint32 j = 0; (j < optionCount) && (stream.status() == QDataStream::Ok); j++) {
+            Option option;
+            stream >> option.name >> option.value;
+            (void) readStringList(stream, option.exclusions);
+
+            quint32 rangeCount = 0;
+            stream >> rangeCount;
+            for (quint32 k = 0; (k < rangeCount) && (stream.status() == QDataStream::Ok); k++) {
+                ParameterRange range;
+                stream >> range.parameter >> range.condition;
+                (void) readStringList(stream, range.optNames);
+                (void) readStringList(stream, range.optValues);
+                option.ranges.append(range);
+            }
+            parameter.options.append(option);
+        }
+        definition.parameters.append(parameter);
+    }
+
+    if ((stream.status() != QDataStream::Ok) || !stream.atEnd()) {
+        qCWarning(QGCCameraDefinitionLog) << "Compiled camera definition is corrupt";
+        definition = QGCCameraDefinition();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+Q_DECLARE_LOGGING_CATEGORY(QGCCameraDefinitionLog)
+
+/// Parsed contents of a MAVLink camera definition file (https://mavlink.io/en/services/camera_def.html).
+/// The XML is read with a streaming reader and the result can be stored in a compact binary form, so cameras
+/// which were seen before load their settings without parsing the XML again.
+/// Optional attributes which are missing from the XML are null strings.
+struct QGCCameraDefinition
+{
+    struct ParameterRange {
+        QString     parameter;
+        QString     condition;
+        QStringList optNames;
+        QStringList optValues;
+    };
+
+    struct Option {
+        QString                 name;
+        QString                 value;
+        QStringList             exclusions;
+        QList<ParameterRange>   ranges;
+    };
+
+    struct Parameter {
+        QString         name;
+        QString         type;
+        QString         description;
+        QString         defaultValue;
+        QString         min;
+        QString         max;
+        QString         step;
+        QString         decimalPlaces;
+        QString         unit;
+        bool            control     = true;
+        bool            readOnly    = false;
+        bool            writeOnly   = false;
+        QStringList     updates;
+        QList<Option>   options;
+    };
+
+    int                 version = 0;
+    QString             model;
+    QString             vendor;
+    QList<Parameter>    parameters;
+
+    /// Parses camera definition XML. Translations must already be applied, see localize().
+    ///     @param errorString Set to the reason when parsing fails
+    static bool parse(const QByteArray &xml, QGCCameraDefinition &definition, QString &errorString);
+
+    /// @return XML with the strings of the <localization> entry best matching localeName (e.g. "de_de") applied
+    static QByteArray localize(const QByteArray &xml, const QString &localeName);
+
+    QByteArray serialize() const;
+
+    /// @return false if the data is not a compiled definition of the current format version
+    static bool deserialize(const QByteArray &bytes, QGCCameraDefinition &definition);
+
+    /// Bump whenever the binary layout or the parse rules change so stale compiled files are ignored
+    static constexpr quint32 kFormatVersion = 1;
+};
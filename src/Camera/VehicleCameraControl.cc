@@ -1,5 +1,6 @@
 #include "VehicleCameraControl.h"
 #include "QGCCameraIO.h"
+#include "QGCCameraDefinition.h"
 #include "AppMessages.h"
 #include "QGCFormat.h"
 #include "SettingsManager.h"
@@ -20,12 +21,12 @@
 #include "MissionCommandTree.h"
 
 #include <QtNetwork/QNetworkAccessManager>
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QDir>
+#include <QtCore/QSaveFile>
 
 #include <algorithm>
 #include <QtCore/QSettings>
-#include <QtXml/QDomDocument>
-#include <QtXml/QDomNodeList>
 #include <QtQml/QQmlEngine>
 #include <QtNetwork/QNetworkReply>
 
@@ -54,58 +55,6 @@ QGCCameraOptionRange::QGCCameraOptionRange(QObject* parent, QString param_, QStr
 {
 }
 
-static bool read_attribute(QDomNode& node, const char* tagName, bool& target)
-{
-    QDomNamedNodeMap attrs = node.attributes();
-    if(!attrs.count()) {
-        return false;
-    }
-    QDomNode subNode = attrs.namedItem(tagName);
-    if(subNode.isNull()) {
-        return false;
-    }
-    target = subNode.nodeValue() != "0";
-    return true;
-}
-
-static bool read_attribute(QDomNode& node, const char* tagName, int& target)
-{
-    QDomNamedNodeMap attrs = node.attributes();
-    if(!attrs.count()) {
-        return false;
-    }
-    QDomNode subNode = attrs.namedItem(tagName);
-    if(subNode.isNull()) {
-        return false;
-    }
-    target = subNode.nodeValue().toInt();
-    return true;
-}
-
-static bool read_attribute(QDomNode& node, const char* tagName, QString& target)
-{
-    QDomNamedNodeMap attrs = node.attributes();
-    if(!attrs.count()) {
-        return false;
-    }
-    QDomNode subNode = attrs.namedItem(tagName);
-    if(subNode.isNull()) {
-        return false;
-    }
-    target = subNode.nodeValue();
-    return true;
-}
-
-static bool read_value(QDomNode& element, const char* tagName, QString& target)
-{
-    QDomElement de = element.firstChildElement(tagName);
-    if(de.isNull()) {
-        return false;
-    }
-    target = de.text();
-    return true;
-}
-
 VehicleCameraControl::VehicleCameraControl(const mavlink_camera_information_t *info, Vehicle* vehicle, int compID, QObject* parent)
     : MavlinkCameraControlInterface(vehicle, parent)
     , _compID(compID)
@@ -121,6 +70,15 @@ VehicleCameraControl::VehicleCameraControl(const mavlink_camera_information_t *i
                                     _vendor.toStdString().c_str(),
                                     _modelName.toStdString().c_str(),
                                     static_cast<int>(_mavlinkCameraInfo.cam_definition_version));
+    //-- The compiled form also depends on where the definition came from and on the translation applied to it
+    const QString definitionUri = QString::fromUtf8(info->cam_definition_uri, qstrnlen(info->cam_definition_uri, sizeof(info->cam_definition_uri)));
+    const QByteArray definitionKey = QCryptographicHash::hash(QString("%1|%2").arg(definitionUri, _localeName()).toUtf8(), QCryptographicHash::Md5).toHex().left(8);
+    _compiledCacheFile = QString("%1/%2_%3_%4_%5.camdef").arg(
+        SettingsManager::instance()->appSettings()->parameterSavePath(),
+        _vendor,
+        _modelName,
+        QString::asprintf("%03d", static_cast<int>(_mavlinkCameraInfo.cam_definition_version)),
+        QString::fromLatin1(definitionKey));
 
     if(info->cam_definition_uri[0] != 0) {
         //-- Process camera definition file
@@ -877,35 +835,36 @@ void VehicleCameraControl::_setPhotoCaptureStatus(PhotoCaptureStatus captureStat
     }
 }
 
-bool VehicleCameraControl::_loadCameraDefinitionFile(QByteArray& bytes)
+QString VehicleCameraControl::_localeName()
 {
-    QByteArray originalData(bytes);
-    //-- Handle localization
-    if(!_handleLocalization(bytes)) {
-        return false;
-    }
+    QLocale locale = QLocale::system();
+#if defined (Q_OS_MACOS)
+    locale = QLocale(locale.name());
+#endif
+    return locale.name().toLower().replace("-", "_");
+}
 
-    QDomDocument doc;
-    const QDomDocument::ParseResult result = doc.setContent(bytes, QDomDocument::ParseOption::Default);
-    if (!result) {
-        qCCritical(VehicleCameraControlLog) << "Unable to parse camera definition file on line:" << result.errorLine;
-        qCCritical(VehicleCameraControlLog) << result.errorMessage;
-        return false;
-    }
-    //-- Load camera constants
-    QDomNodeList defElements = doc.elementsByTagName(kDefnition);
-    if(!defElements.size() || !_loadConstants(defElements)) {
-        qCWarning(VehicleCameraControlLog) <<  "Unable to load camera constants from camera definition";
-        return false;
+bool VehicleCameraControl::_parseCameraDefinitionFile(const QByteArray& bytes, QGCCameraDefinition& definition)
+{
+    //-- Handle localization
+    QByteArray localized(bytes);
+    const QString localeName = _localeName();
+    qCDebug(VehicleCameraControlLog) << "Current locale:" << localeName;
+    if(localeName != "en_us") {
+        localized = QGCCameraDefinition::localize(bytes, localeName);
     }
-    //-- Load camera parameters
-    QDomNodeList paramElements = doc.elementsByTagName(kParameters);
-    if(!paramElements.size()) {
-        qCDebug(VehicleCameraControlLog) <<  "No parameters to load from camera";
+    QString errorString;
+    if(!QGCCameraDefinition::parse(localized, definition, errorString)) {
+        qCCritical(VehicleCameraControlLog) << "Unable to parse camera definition file:" << errorString;
         return false;
     }
-    if(!_loadSettings(paramElements)) {
-        qCWarning(VehicleCameraControlLog) <<  "Unable to load camera parameters from camera definition";
+    return true;
+}
+
+bool VehicleCameraControl::_loadCameraDefinitionFile(const QByteArray& bytes)
+{
+    QGCCameraDefinition definition;
+    if(!_parseCameraDefinitionFile(bytes, definition) || !_loadCameraDefinition(definition)) {
         return false;
     }
     //-- If this is new, cache it
@@ -915,146 +874,145 @@ bool VehicleCameraControl::_loadCameraDefinitionFile(QByteArray& bytes)
         if (!file.open(QIODevice::WriteOnly)) {
             qWarning() << QString("Could not save cache file %1. Error: %2").arg(_cacheFile).arg(file.errorString());
         } else {
-            file.write(originalData);
+            file.write(bytes);
         }
     }
+    _saveCompiledCameraDefinition(definition);
+    return true;
+}
+
+bool VehicleCameraControl::_loadCameraDefinition(const QGCCameraDefinition& definition)
+{
+    //-- Load camera constants
+    _version    = definition.version;
+    _modelName  = definition.model;
+    _vendor     = definition.vendor;
+    //-- Load camera parameters
+    if(definition.parameters.isEmpty()) {
+        qCDebug(VehicleCameraControlLog) <<  "No parameters to load from camera";
+        return false;
+    }
+    if(!_loadSettings(definition.parameters)) {
+        qCWarning(VehicleCameraControlLog) <<  "Unable to load camera parameters from camera definition";
+        return false;
+    }
     return true;
 }
 
-bool VehicleCameraControl::_loadConstants(const QDomNodeList nodeList)
+bool VehicleCameraControl::_loadCompiledCameraDefinition()
 {
-    QDomNode node = nodeList.item(0);
-    if(!read_attribute(node, kVersion, _version)) {
+    QFile file(_compiledCacheFile);
+    if(!file.exists()) {
         return false;
     }
-    if(!read_value(node, kModel, _modelName)) {
+    if(!file.open(QIODevice::ReadOnly)) {
+        qCWarning(VehicleCameraControlLog) << "Could not read compiled camera definition file:" << _compiledCacheFile << file.errorString();
         return false;
     }
-    if(!read_value(node, kVendor, _vendor)) {
+    QGCCameraDefinition definition;
+    if(!QGCCameraDefinition::deserialize(file.readAll(), definition)) {
+        qCDebug(VehicleCameraControlLog) << "Discarding stale compiled camera definition file:" << _compiledCacheFile;
+        file.close();
+        (void) QFile::remove(_compiledCacheFile);
         return false;
     }
+    if(!_loadCameraDefinition(definition)) {
+        //-- Let the caller fall back to the XML definition, which compiles a fresh cache if it loads
+        qCWarning(VehicleCameraControlLog) << "Discarding unusable compiled camera definition file:" << _compiledCacheFile;
+        file.close();
+        (void) QFile::remove(_compiledCacheFile);
+        return false;
+    }
+    qCDebug(VehicleCameraControlLog) << "Using compiled camera definition file:" << _compiledCacheFile;
+    _cached = true;
     return true;
 }
 
-bool VehicleCameraControl::_loadSettings(const QDomNodeList nodeList)
+void VehicleCameraControl::_saveCompiledCameraDefinition(const QGCCameraDefinition& definition)
 {
-    QDomNode node = nodeList.item(0);
-    QDomElement elem = node.toElement();
-    QDomNodeList parameters = elem.elementsByTagName(kParameter);
-    //-- Pre-process settings (maintain order and skip non-controls)
-    for(int i = 0; i < parameters.size(); i++) {
-        QDomNode parameterNode = parameters.item(i);
-        QString name;
-        if(read_attribute(parameterNode, kName, name)) {
-            bool control = true;
-            read_attribute(parameterNode, kControl, control);
-            if(control) {
-                _settings << name;
-            }
-        } else {
-            qCritical() << "Parameter entry missing parameter name";
+    QSaveFile file(_compiledCacheFile);
+    if(!file.open(QIODevice::WriteOnly)) {
+        qCWarning(VehicleCameraControlLog) << "Could not save compiled camera definition file:" << _compiledCacheFile << file.errorString();
+        return;
+    }
+    (void) file.write(definition.serialize());
+    if(!file.commit()) {
+        qCWarning(VehicleCameraControlLog) << "Could not save compiled camera definition file:" << _compiledCacheFile << file.errorString();
+    }
+}
+
+bool VehicleCameraControl::_loadSettings(const QList<QGCCameraDefinition::Parameter>& parameters)
+{
+    //-- Reject unknown types up front so a failed load leaves no partial settings behind
+    for(const QGCCameraDefinition::Parameter& parameter : parameters) {
+        bool unknownType;
+        (void) FactMetaData::stringToType(parameter.type, unknownType);
+        if (unknownType) {
+            qCritical() << QString("Unknown type for parameter %1").arg(parameter.name);
             return false;
         }
     }
-    //-- Load parameters
-    for(int i = 0; i < parameters.size(); i++) {
-        QDomNode parameterNode = parameters.item(i);
-        QString factName;
-        read_attribute(parameterNode, kName, factName);
-        QString type;
-        if(!read_attribute(parameterNode, kType, type)) {
-            qCritical() << QString("Parameter %1 missing parameter type").arg(factName);
-            return false;
+    //-- Pre-process settings (maintain order and skip non-controls)
+    for(const QGCCameraDefinition::Parameter& parameter : parameters) {
+        if(parameter.control) {
+            _settings << parameter.name;
         }
+    }
+    //-- Load parameters
+    for(const QGCCameraDefinition::Parameter& parameter : parameters) {
+        const QString& factName = parameter.name;
         //-- Does it have a control?
-        bool control = true;
-        read_attribute(parameterNode, kControl, control);
-        //-- Is it read only?
-        bool readOnly = false;
-        read_attribute(parameterNode, kReadOnly, readOnly);
-        //-- Is it write only?
-        bool writeOnly = false;
-        read_attribute(parameterNode, kWriteOnly, writeOnly);
+        bool control = parameter.control;
         //-- It can't be both
-        if(readOnly && writeOnly) {
+        if(parameter.readOnly && parameter.writeOnly) {
             qCritical() << QString("Parameter %1 cannot be both read only and write only").arg(factName);
         }
         //-- Param type
         bool unknownType;
-        FactMetaData::ValueType_t factType = FactMetaData::stringToType(type, unknownType);
-        if (unknownType) {
-            qCritical() << QString("Unknown type for parameter %1").arg(factName);
-            return false;
-        }
+        FactMetaData::ValueType_t factType = FactMetaData::stringToType(parameter.type, unknownType);
         //-- By definition, custom types do not have control
         if(factType == FactMetaData::valueTypeCustom) {
             control = false;
         }
-        //-- Description
-        QString description;
-        if(!read_value(parameterNode, kDescription, description)) {
-            qCritical() << QString("Parameter %1 missing parameter description").arg(factName);
-            return false;
-        }
         //-- Check for updates
-        QStringList updates = _loadUpdates(parameterNode);
-        if(updates.size()) {
-            qCDebug(VehicleCameraControlVerboseLog) << "Parameter" << factName << "requires updates for:" << updates;
-            _requestUpdates[factName] = updates;
+        if(parameter.updates.size()) {
+            qCDebug(VehicleCameraControlVerboseLog) << "Parameter" << factName << "requires updates for:" << parameter.updates;
+            _requestUpdates[factName] = parameter.updates;
         }
         //-- Build metadata
         FactMetaData* metaData = new FactMetaData(factType, factName, this);
         QQmlEngine::setObjectOwnership(metaData, QQmlEngine::CppOwnership);
-        metaData->setShortDescription(description);
-        metaData->setLongDescription(description);
+        metaData->setShortDescription(parameter.description);
+        metaData->setLongDescription(parameter.description);
         metaData->setHasControl(control);
-        metaData->setReadOnly(readOnly);
-        metaData->setWriteOnly(writeOnly);
+        metaData->setReadOnly(parameter.readOnly);
+        metaData->setWriteOnly(parameter.writeOnly);
         //-- Options (enums)
-        QDomElement optionElem = parameterNode.toElement();
-        QDomNodeList optionsRoot = optionElem.elementsByTagName(kOptions);
-        if(optionsRoot.size()) {
-            //-- Iterate options
-            QDomNode optionsNode = optionsRoot.item(0);
-            QDomElement optionsElem = optionsNode.toElement();
-            QDomNodeList options = optionsElem.elementsByTagName(kOption);
-            for(int optionIndex = 0; optionIndex < options.size(); optionIndex++) {
-                QDomNode option = options.item(optionIndex);
-                QString optName;
-                QString optValue;
-                QVariant optVariant;
-                if(!_loadNameValue(option, factName, metaData, optName, optValue, optVariant)) {
-                    delete metaData;
-                    return false;
-                }
-                metaData->addEnumInfo(optName, optVariant);
-                _originalOptNames[factName]  << optName;
-                _originalOptValues[factName] << optVariant;
-                //-- Check for exclusions
-                QStringList exclusions = _loadExclusions(option);
-                if(exclusions.size()) {
-                    qCDebug(VehicleCameraControlVerboseLog) << "New exclusions:" << factName << optValue << exclusions;
-                    QGCCameraOptionExclusion* pExc = new QGCCameraOptionExclusion(this, factName, optValue, exclusions);
-                    QQmlEngine::setObjectOwnership(pExc, QQmlEngine::CppOwnership);
-                    _valueExclusions.append(pExc);
-                }
-                //-- Check for range rules
-                if(!_loadRanges(option, factName, optValue)) {
-                    delete metaData;
-                    return false;
-                }
+        for(const QGCCameraDefinition::Option& option : parameter.options) {
+            QVariant optVariant;
+            _loadNameValue(option, factName, metaData, optVariant);
+            metaData->addEnumInfo(option.name, optVariant);
+            _originalOptNames[factName]  << option.name;
+            _originalOptValues[factName] << optVariant;
+            //-- Check for exclusions
+            if(option.exclusions.size()) {
+                qCDebug(VehicleCameraControlVerboseLog) << "New exclusions:" << factName << option.value << option.exclusions;
+                QGCCameraOptionExclusion* pExc = new QGCCameraOptionExclusion(this, factName, option.value, option.exclusions);
+                QQmlEngine::setObjectOwnership(pExc, QQmlEngine::CppOwnership);
+                _valueExclusions.append(pExc);
             }
+            //-- Check for range rules
+            _loadRanges(option, factName);
         }
-        QString defaultValue;
-        if(read_attribute(parameterNode, kDefault, defaultValue)) {
+        if(!parameter.defaultValue.isNull()) {
             QVariant defaultVariant;
             QString  errorString;
-            if (metaData->convertAndValidateRaw(defaultValue, false, defaultVariant, errorString)) {
+            if (metaData->convertAndValidateRaw(parameter.defaultValue, false, defaultVariant, errorString)) {
                 metaData->setRawDefaultValue(defaultVariant);
             } else {
                 qWarning() << "Invalid default value for" << factName
                            << " type:"  << metaData->type()
-                           << " value:" << defaultValue
+                           << " value:" << parameter.defaultValue
                            << " error:" << errorString;
             }
         }
@@ -1063,78 +1021,63 @@ bool VehicleCameraControl::_loadSettings(const QDomNodeList nodeList)
             qWarning() << QStringLiteral("Duplicate fact name:") << factName;
             delete metaData;
         } else {
-            {
-                //-- Check for Min Value
-                QString attr;
-                if(read_attribute(parameterNode, kMin, attr)) {
-                    QVariant typedValue;
-                    QString  errorString;
-                    if (metaData->convertAndValidateRaw(attr, true /* convertOnly */, typedValue, errorString)) {
-                        metaData->setRawMin(typedValue);
-                    } else {
-                        qWarning() << "Invalid min value for" << factName
-                                   << " type:"  << metaData->type()
-                                   << " value:" << attr
-                                   << " error:" << errorString;
-                    }
+            //-- Check for Min Value
+            if(!parameter.min.isNull()) {
+                QVariant typedValue;
+                QString  errorString;
+                if (metaData->convertAndValidateRaw(parameter.min, true /* convertOnly */, typedValue, errorString)) {
+                    metaData->setRawMin(typedValue);
+                } else {
+                    qWarning() << "Invalid min value for" << factName
+                               << " type:"  << metaData->type()
+                               << " value:" << parameter.min
+                               << " error:" << errorString;
                 }
             }
-            {
-                //-- Check for Max Value
-                QString attr;
-                if(read_attribute(parameterNode, kMax, attr)) {
-                    QVariant typedValue;
-                    QString  errorString;
-                    if (metaData->convertAndValidateRaw(attr, true /* convertOnly */, typedValue, errorString)) {
-                        metaData->setRawMax(typedValue);
-                    } else {
-                        qWarning() << "Invalid max value for" << factName
-                                   << " type:"  << metaData->type()
-                                   << " value:" << attr
-                                   << " error:" << errorString;
-                    }
+            //-- Check for Max Value
+            if(!parameter.max.isNull()) {
+                QVariant typedValue;
+                QString  errorString;
+                if (metaData->convertAndValidateRaw(parameter.max, true /* convertOnly */, typedValue, errorString)) {
+                    metaData->setRawMax(typedValue);
+                } else {
+                    qWarning() << "Invalid max value for" << factName
+                               << " type:"  << metaData->type()
+                               << " value:" << parameter.max
+                               << " error:" << errorString;
                 }
             }
-            {
-                //-- Check for Step Value
-                QString attr;
-                if(read_attribute(parameterNode, kStep, attr)) {
-                    QVariant typedValue;
-                    QString  errorString;
-                    if (metaData->convertAndValidateRaw(attr, true /* convertOnly */, typedValue, errorString)) {
-                        metaData->setRawIncrement(typedValue.toDouble());
-                    } else {
-                        qWarning() << "Invalid step value for" << factName
-                                   << " type:"  << metaData->type()
-                                   << " value:" << attr
-                                   << " error:" << errorString;
-                    }
+            //-- Check for Step Value
+            if(!parameter.step.isNull()) {
+                QVariant typedValue;
+                QString  errorString;
+                if (metaData->convertAndValidateRaw(parameter.step, true /* convertOnly */, typedValue, errorString)) {
+                    metaData->setRawIncrement(typedValue.toDouble());
+                } else {
+                    qWarning() << "Invalid step value for" << factName
+                               << " type:"  << metaData->type()
+                               << " value:" << parameter.step
+                               << " error:" << errorString;
                 }
             }
-            {
-                //-- Check for Decimal Places
-                QString attr;
-                if(read_attribute(parameterNode, kDecimalPlaces, attr)) {
-                    QVariant typedValue;
-                    QString  errorString;
-                    if (metaData->convertAndValidateRaw(attr, true /* convertOnly */, typedValue, errorString)) {
-                        metaData->setDecimalPlaces(typedValue.toInt());
-                    } else {
-                        qWarning() << "Invalid decimal places value for" << factName
-                                   << " type:"  << metaData->type()
-                                   << " value:" << attr
-                                   << " error:" << errorString;
-                    }
+            //-- Check for Decimal Places
+            if(!parameter.decimalPlaces.isNull()) {
+                QVariant typedValue;
+                QString  errorString;
+                if (metaData->convertAndValidateRaw(parameter.decimalPlaces, true /* convertOnly */, typedValue, errorString)) {
+                    metaData->setDecimalPlaces(typedValue.toInt());
+                } else {
+                    qWarning() << "Invalid decimal places value for" << factName
+                               << " type:"  << metaData->type()
+                               << " value:" << parameter.decimalPlaces
+                               << " error:" << errorString;
                 }
             }
-            {
-                //-- Check for Units
-                QString attr;
-                if(read_attribute(parameterNode, kUnit, attr)) {
-                    metaData->setRawUnits(attr);
-                }
+            //-- Check for Units
+            if(!parameter.unit.isNull()) {
+                metaData->setRawUnits(parameter.unit);
             }
-            qCDebug(VehicleCameraControlLog) << "New parameter:" << factName << (readOnly ? "ReadOnly" : "Writable") << (writeOnly ? "WriteOnly" : "Readable");
+            qCDebug(VehicleCameraControlLog) << "New parameter:" << factName << (parameter.readOnly ? "ReadOnly" : "Writable") << (parameter.writeOnly ? "WriteOnly" : "Readable");
             _nameToFactMetaDataMap[factName] = metaData;
             Fact* pFact = new Fact(_compID, factName, factType, this);
             QQmlEngine::setObjectOwnership(pFact, QQmlEngine::CppOwnership);
@@ -1156,85 +1099,6 @@ bool VehicleCameraControl::_loadSettings(const QDomNodeList nodeList)
     return false;
 }
 
-bool VehicleCameraControl::_handleLocalization(QByteArray& bytes)
-{
-    QDomDocument doc;
-    const QDomDocument::ParseResult result = doc.setContent(bytes, QDomDocument::ParseOption::Default);
-    if (!result) {
-        qCritical() << "Unable to parse camera definition file on line:" << result.errorLine;
-        qCritical() << result.errorMessage;
-        return false;
-    }
-    //-- Find out where we are
-    QLocale locale = QLocale::system();
-#if defined (Q_OS_MACOS)
-    locale = QLocale(locale.name());
-#endif
-    QString localeName = locale.name().toLower().replace("-", "_");
-    qCDebug(VehicleCameraControlLog) << "Current locale:" << localeName;
-    if(localeName == "en_us") {
-        // Nothing to do
-        return true;
-    }
-    QDomNodeList locRoot = doc.elementsByTagName(kLocalization);
-    if(!locRoot.size()) {
-        // Nothing to do
-        return true;
-    }
-    //-- Iterate locales
-    QDomNode node = locRoot.item(0);
-    QDomElement elem = node.toElement();
-    QDomNodeList locales = elem.elementsByTagName(kLocale);
-    for(int i = 0; i < locales.size(); i++) {
-        QDomNode localeNode = locales.item(i);
-        QString name;
-        if(!read_attribute(localeNode, kName, name)) {
-            qWarning() << "Localization entry is missing its name attribute";
-            continue;
-        }
-        // If we found a direct match, deal with it now
-        if(localeName == name.toLower().replace("-", "_")) {
-            return _replaceLocaleStrings(localeNode, bytes);
-        }
-    }
-    //-- No direct match. Pick first matching language (if any)
-    localeName = localeName.left(3);
-    for(int i = 0; i < locales.size(); i++) {
-        QDomNode localeNode = locales.item(i);
-        QString name;
-        read_attribute(localeNode, kName, name);
-        if(name.toLower().startsWith(localeName)) {
-            return _replaceLocaleStrings(localeNode, bytes);
-        }
-    }
-    //-- Could not find a language to use
-    qWarning() <<  "No match for" << QLocale::system().name() << "in camera definition file";
-    //-- Just use default, en_US
-    return true;
-}
-
-bool VehicleCameraControl::_replaceLocaleStrings(const QDomNode node, QByteArray& bytes)
-{
-    QDomElement stringElem = node.toElement();
-    QDomNodeList strings = stringElem.elementsByTagName(kStrings);
-    for(int i = 0; i < strings.size(); i++) {
-        QDomNode stringNode = strings.item(i);
-        QString original;
-        QString translated;
-        if(read_attribute(stringNode, kOriginal, original)) {
-            if(read_attribute(stringNode, kTranslated, translated)) {
-                QString o; o = "\"" + original + "\"";
-                QString t; t = "\"" + translated + "\"";
-                bytes.replace(o.toUtf8(), t.toUtf8());
-                o = ">" + original + "<";
-                t = ">" + translated + "<";
-                bytes.replace(o.toUtf8(), t.toUtf8());
-            }
-        }
-    }
-    return true;
-}
-
 void VehicleCameraControl::_requestAllParameters()
 {
     //-- Reset receive list
@@ -2035,94 +1899,13 @@ void VehicleCameraControl::_storageInfoTimeout()
     _requestStorageInfo();
 }
 
-QStringList
-VehicleCameraControl::_loadExclusions(QDomNode option)
+void VehicleCameraControl::_loadRanges(const QGCCameraDefinition::Option& option, const QString& factName)
 {
-    QStringList exclusionList;
-    QDomElement optionElem = option.toElement();
-    QDomNodeList excRoot = optionElem.elementsByTagName(kExclusions);
-    if(excRoot.size()) {
-        //-- Iterate exclusions
-        QDomNode node = excRoot.item(0);
-        QDomElement elem = node.toElement();
-        QDomNodeList exclusions = elem.elementsByTagName(kExclusion);
-        for(int i = 0; i < exclusions.size(); i++) {
-            QString exclude = exclusions.item(i).toElement().text();
-            if(!exclude.isEmpty()) {
-                exclusionList << exclude;
-            }
-        }
-    }
-    return exclusionList;
-}
-
-QStringList
-VehicleCameraControl::_loadUpdates(QDomNode option)
-{
-    QStringList updateList;
-    QDomElement optionElem = option.toElement();
-    QDomNodeList updateRoot = optionElem.elementsByTagName(kUpdates);
-    if(updateRoot.size()) {
-        //-- Iterate updates
-        QDomNode node = updateRoot.item(0);
-        QDomElement elem = node.toElement();
-        QDomNodeList updates = elem.elementsByTagName(kUpdate);
-        for(int i = 0; i < updates.size(); i++) {
-            QString update = updates.item(i).toElement().text();
-            if(!update.isEmpty()) {
-                updateList << update;
-            }
-        }
+    for(const QGCCameraDefinition::ParameterRange& range : option.ranges) {
+        QGCCameraOptionRange* pRange = new QGCCameraOptionRange(this, factName, option.value, range.parameter, range.condition, range.optNames, range.optValues);
+        _optionRanges.append(pRange);
+        qCDebug(VehicleCameraControlVerboseLog) << "New range limit:" << factName << option.value << range.parameter << range.condition << range.optNames << range.optValues;
     }
-    return updateList;
-}
-
-bool VehicleCameraControl::_loadRanges(QDomNode option, const QString factName, QString paramValue)
-{
-    QDomElement optionElem = option.toElement();
-    QDomNodeList rangeRoot = optionElem.elementsByTagName(kParameterranges);
-    if(rangeRoot.size()) {
-        QDomNode node = rangeRoot.item(0);
-        QDomElement elem = node.toElement();
-        QDomNodeList parameterRanges = elem.elementsByTagName(kParameterrange);
-        //-- Iterate parameter ranges
-        for(int i = 0; i < parameterRanges.size(); i++) {
-            QString param;
-            QString condition;
-            QDomNode paramRange = parameterRanges.item(i);
-            if(!read_attribute(paramRange, kParameter, param)) {
-                qCritical() << QString("Malformed option range for parameter %1").arg(factName);
-                return false;
-            }
-            read_attribute(paramRange, kCondition, condition);
-            QDomElement pelem = paramRange.toElement();
-            QDomNodeList rangeOptions = pelem.elementsByTagName(kRoption);
-            QStringList  optNames;
-            QStringList  optValues;
-            //-- Iterate options
-            for(int rangeOptionIndex = 0; rangeOptionIndex < rangeOptions.size(); rangeOptionIndex++) {
-                QString optName;
-                QString optValue;
-                QDomNode roption = rangeOptions.item(rangeOptionIndex);
-                if(!read_attribute(roption, kName, optName)) {
-                    qCritical() << QString("Malformed roption for parameter %1").arg(factName);
-                    return false;
-                }
-                if(!read_attribute(roption, kValue, optValue)) {
-                    qCritical() << QString("Malformed rvalue for parameter %1").arg(factName);
-                    return false;
-                }
-                optNames  << optName;
-                optValues << optValue;
-            }
-            if(optNames.size()) {
-                QGCCameraOptionRange* pRange = new QGCCameraOptionRange(this, factName, paramValue, param, condition, optNames, optValues);
-                _optionRanges.append(pRange);
-                qCDebug(VehicleCameraControlVerboseLog) << "New range limit:" << factName << paramValue << param << condition << optNames << optValues;
-            }
-        }
-    }
-    return true;
 }
 
 void VehicleCameraControl::_processRanges()
@@ -2147,28 +1930,25 @@ void VehicleCameraControl::_processRanges()
     }
 }
 
-bool VehicleCameraControl::_loadNameValue(QDomNode option, const QString factName, FactMetaData* metaData, QString& optName, QString& optValue, QVariant& optVariant)
+void VehicleCameraControl::_loadNameValue(const QGCCameraDefinition::Option& option, const QString& factName, FactMetaData* metaData, QVariant& optVariant)
 {
-    if(!read_attribute(option, kName, optName)) {
-        qCritical() << QString("Malformed option for parameter %1").arg(factName);
-        return false;
-    }
-    if(!read_attribute(option, kValue, optValue)) {
-        qCritical() << QString("Malformed value for parameter %1").arg(factName);
-        return false;
-    }
     QString  errorString;
-    if (!metaData->convertAndValidateRaw(optValue, false, optVariant, errorString)) {
+    if (!metaData->convertAndValidateRaw(option.value, false, optVariant, errorString)) {
         qWarning() << "Invalid option value, name:" << factName
                    << " type:"  << metaData->type()
-                   << " value:" << optValue
+                   << " value:" << option.value
                    << " error:" << errorString;
     }
-    return true;
 }
 
 void VehicleCameraControl::_handleDefinitionFile(const QString &url)
 {
+    //-- A compiled definition loads straight into the fact tables
+    if (_loadCompiledCameraDefinition()) {
+        _initWhenReady();
+        return;
+    }
+
     //-- First check and see if we have it cached
     QFile xmlFile(_cacheFile);
 
@@ -2184,9 +1964,11 @@ void VehicleCameraControl::_handleDefinitionFile(const QString &url)
             _modelName.toStdString().c_str(),
             ver,
             ext.toStdString().c_str());
-        connect(_vehicle->ftpManager(), &FTPManager::downloadComplete, this, &VehicleCameraControl::_ftpDownloadComplete);
-        _vehicle->ftpManager()->download(_compID, url,
-            SettingsManager::instance()->appSettings()->parameterSavePath().toStdString().c_str(),
+        // Queued so that the fetch waits for parameter/metadata FTP traffic instead of being dropped
+        _vehicle->ftpManager()->queueDownload(FTPManager::Priority::Normal, this,
+            [this](const QString& downloadedFile, const QString& errorMsg) { _ftpDownloadComplete(downloadedFile, errorMsg); },
+            _compID, url,
+            SettingsManager::instance()->appSettings()->parameterSavePath(),
             fileName);
         return;
     }
@@ -2202,17 +1984,19 @@ void VehicleCameraControl::_handleDefinitionFile(const QString &url)
         return;
     }
     QByteArray bytes = xmlFile.readAll();
-    QDomDocument doc;
-    const QDomDocument::ParseResult result = doc.setContent(bytes, QDomDocument::ParseOption::Default);
-    if (!result) {
+    QGCCameraDefinition definition;
+    if (!_parseCameraDefinitionFile(bytes, definition)) {
         qWarning() << "Could not parse cached camera definition file:" << _cacheFile;
         _httpRequest(url);
         return;
     }
-    //-- We have it
+    //-- We have it. Load it here rather than through dataReady, which is not connected yet while constructing.
     qCDebug(VehicleCameraControlLog) << "Using cached camera definition file:" << _cacheFile;
     _cached = true;
-    emit dataReady(bytes);
+    if (_loadCameraDefinition(definition)) {
+        _saveCompiledCameraDefinition(definition);
+    }
+    _initWhenReady();
 }
 
 void VehicleCameraControl::_httpRequest(const QString &url)
@@ -2258,8 +2042,6 @@ void VehicleCameraControl::_ftpDownloadComplete(const QString& fileName, const Q
 {
     qCDebug(VehicleCameraControlLog) << "FTP Download completed: " << fileName << ", " << errorMsg;
 
-    disconnect(_vehicle->ftpManager(), &FTPManager::downloadComplete, this, &VehicleCameraControl::_ftpDownloadComplete);
-
     QString outputFileName = QGCCompression::decompressIfNeeded(fileName);
     if (outputFileName.isEmpty()) {
         qCWarning(VehicleCameraControlLog) << "Inflate of compressed xml failed" << fileName;
@@ -1,12 +1,11 @@
 #pragma once
 
 #include "MavlinkCameraControlInterface.h"
+#include "QGCCameraDefinition.h"
 #include "QmlObjectListModel.h"
 
 class QGCVideoStreamInfo;
 class QNetworkAccessManager;
-class QDomNode;
-class QDomNodeList;
 
 //-----------------------------------------------------------------------------
 /// Camera option exclusions
@@ -150,41 +149,6 @@ class VehicleCameraControl : public MavlinkCameraControlInterface
     bool    incomingParameter   (Fact* pFact, QVariant& newValue) override;
     bool    validateParameter   (Fact* pFact, QVariant& newValue) override;
 
-    static constexpr const char* kCondition       = "condition";
-    static constexpr const char* kControl         = "control";
-    static constexpr const char* kDefault         = "default";
-    static constexpr const char* kDefnition       = "definition";
-    static constexpr const char* kDescription     = "description";
-    static constexpr const char* kExclusion       = "exclude";
-    static constexpr const char* kExclusions      = "exclusions";
-    static constexpr const char* kLocale          = "locale";
-    static constexpr const char* kLocalization    = "localization";
-    static constexpr const char* kMax             = "max";
-    static constexpr const char* kMin             = "min";
-    static constexpr const char* kModel           = "model";
-    static constexpr const char* kName            = "name";
-    static constexpr const char* kOption          = "option";
-    static constexpr const char* kOptions         = "options";
-    static constexpr const char* kOriginal        = "original";
-    static constexpr const char* kParameter       = "parameter";
-    static constexpr const char* kParameterrange  = "parameterrange";
-    static constexpr const char* kParameterranges = "parameterranges";
-    static constexpr const char* kParameters      = "parameters";
-    static constexpr const char* kReadOnly        = "readonly";
-    static constexpr const char* kWriteOnly       = "writeonly";
-    static constexpr const char* kRoption         = "roption";
-    static constexpr const char* kStep            = "step";
-    static constexpr const char* kDecimalPlaces   = "decimalPlaces";
-    static constexpr const char* kStrings         = "strings";
-    static constexpr const char* kTranslated      = "translated";
-    static constexpr const char* kType            = "type";
-    static constexpr const char* kUnit            = "unit";
-    static constexpr const char* kUpdate          = "update";
-    static constexpr const char* kUpdates         = "updates";
-    static constexpr const char* kValue           = "value";
-    static constexpr const char* kVendor          = "vendor";
-    static constexpr const char* kVersion         = "version";
-
     static constexpr const char* kPhotoMode       = "PhotoCaptureMode";
     static constexpr const char* kPhotoLapse      = "PhotoLapse";
     static constexpr const char* kPhotoLapseCount = "PhotoLapseCount";
@@ -231,24 +195,24 @@ protected slots:
     void            _paramDone              () override;
 
 private:
-    bool    _handleLocalization             (QByteArray& bytes);
-    bool    _replaceLocaleStrings           (const QDomNode node, QByteArray& bytes);
-    bool    _loadCameraDefinitionFile       (QByteArray& bytes);
-    bool    _loadConstants                  (const QDomNodeList nodeList);
-    bool    _loadSettings                   (const QDomNodeList nodeList);
+    bool    _parseCameraDefinitionFile      (const QByteArray& bytes, QGCCameraDefinition& definition);
+    bool    _loadCameraDefinitionFile       (const QByteArray& bytes);
+    bool    _loadCameraDefinition           (const QGCCameraDefinition& definition);
+    bool    _loadCompiledCameraDefinition   ();
+    void    _saveCompiledCameraDefinition   (const QGCCameraDefinition& definition);
+    bool    _loadSettings                   (const QList<QGCCameraDefinition::Parameter>& parameters);
     void    _processRanges                  ();
     bool    _processCondition               (const QString condition);
     bool    _processConditionTest           (const QString conditionTest);
-    bool    _loadNameValue                  (QDomNode option, const QString factName, FactMetaData* metaData, QString& optName, QString& optValue, QVariant& optVariant);
-    bool    _loadRanges                     (QDomNode option, const QString factName, QString paramValue);
+    void    _loadNameValue                  (const QGCCameraDefinition::Option& option, const QString& factName, FactMetaData* metaData, QVariant& optVariant);
+    void    _loadRanges                     (const QGCCameraDefinition::Option& option, const QString& factName);
     void    _updateActiveList               ();
     void    _updateRanges                   (Fact* pFact);
     void    _httpRequest                    (const QString& url);
     void    _handleDefinitionFile           (const QString& url);
     void    _ftpDownloadComplete            (const QString& fileName, const QString& errorMsg);
 
-    QStringList     _loadExclusions         (QDomNode option);
-    QStringList     _loadUpdates            (QDomNode option);
+    static QString  _localeName             ();
     QString         _getParamName           (const char* param_id);
 
 protected:
@@ -266,6 +230,7 @@ protected slots:
     QString                             _modelName;
     QString                             _vendor;
     QString                             _cacheFile;
+    QString                             _compiledCacheFile;
     StorageStatus                       _storageStatus      = STORAGE_NOT_SUPPORTED;
     QStringList                         _activeSettings;
     QStringList                         _settings;
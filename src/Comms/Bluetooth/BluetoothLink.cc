@@ -1,5 +1,6 @@
 #include "BluetoothLink.h"
 #include "BluetoothWorker.h"
+#include "LinkControlLane.h"
 #include "QGCLoggingCategory.h"
 
 #include <QtCore/QCoreApplication>
@@ -29,6 +30,8 @@ BluetoothLink::BluetoothLink(SharedLinkConfigurationPtr &config, QObject *parent
         ? QStringLiteral("BLE_%1") : QStringLiteral("Bluetooth_%1");
     _workerThread->setObjectName(threadName.arg(_bluetoothConfig->name()));
 
+    _setControlLane(new LinkControlLane([worker = _worker.data()](const QByteArray &data) { worker->writeData(data); }, _worker.data()));
+
     _worker->moveToThread(_workerThread.data());
 
     (void) connect(_workerThread.data(), &QThread::started, _worker.data(), &BluetoothWorker::setupConnection);
@@ -53,6 +56,7 @@ BluetoothLink::~BluetoothLink()
             (void) QMetaObject::invokeMethod(_worker, "disconnectLink", Qt::QueuedConnection);
         }
 
+        _setControlLane(nullptr);
         _workerThread->quit();
         if (!_workerThread->wait(5000)) {
             qCWarning(BluetoothLinkLog) << "Worker thread did not stop within timeout, terminating";
@@ -175,6 +179,7 @@ void BluetoothLink::_handlePermissionStatus(Qt::PermissionStatus permissionStatu
         if (!_workerThread->isRunning()) {
             qCCritical(BluetoothLinkLog) << "Failed to start worker thread";
             _onErrorOccurred(tr("Failed to start Bluetooth worker thread"));
+            _setControlLane(nullptr);
             _worker->deleteLater();
             _worker = nullptr;
         }
@@ -27,6 +27,7 @@ LinkConfiguration::LinkConfiguration(const LinkConfiguration *copy, QObject *par
     , _dynamic(copy->isDynamic())
     , _autoConnect(copy->isAutoConnect())
     , _highLatency(copy->isHighLatency())
+    , _outboundBytesPerSecond(copy->outboundBytesPerSecond())
 {
     qCDebug(LinkConfigurationLog) << this;
 
@@ -47,6 +48,7 @@ void LinkConfiguration::copyFrom(const LinkConfiguration *source)
     setDynamic(source->isDynamic());
     setAutoConnect(source->isAutoConnect());
     setHighLatency(source->isHighLatency());
+    setOutboundBytesPerSecond(source->outboundBytesPerSecond());
 }
 
 LinkConfiguration *LinkConfiguration::createSettings(int type, const QString &name)
@@ -162,3 +164,12 @@ void LinkConfiguration::setHighLatency(bool hl)
         emit highLatencyChanged();
     }
 }
+
+void LinkConfiguration::setOutboundBytesPerSecond(int bytesPerSecond)
+{
+    bytesPerSecond = qMax(0, bytesPerSecond);
+    if (bytesPerSecond != _outboundBytesPerSecond) {
+        _outboundBytesPerSecond = bytesPerSecond;
+        emit outboundBytesPerSecondChanged();
+    }
+}
@@ -22,6 +22,7 @@ class LinkConfiguration : public QObject
     Q_PROPERTY(QString          settingsURL     READ settingsURL                            CONSTANT)
     Q_PROPERTY(QString          settingsTitle   READ settingsTitle                          CONSTANT)
     Q_PROPERTY(bool             highLatency     READ isHighLatency  WRITE setHighLatency    NOTIFY highLatencyChanged)
+    Q_PROPERTY(int              outboundBytesPerSecond READ outboundBytesPerSecond WRITE setOutboundBytesPerSecond NOTIFY outboundBytesPerSecondChanged)
 
 public:
     LinkConfiguration(const QString &name, QObject *parent = nullptr);
@@ -60,6 +61,11 @@ class LinkConfiguration : public QObject
     /// Set if this is this an High Latency configuration.
     void setHighLatency(bool hl = false);
 
+    /// Budget for traffic sent on the link, outgoing messages are queued by priority to stay within it.
+    ///     @return Bytes per second, 0 for unlimited
+    int outboundBytesPerSecond() const { return _outboundBytesPerSecond; }
+    void setOutboundBytesPerSecond(int bytesPerSecond);
+
     /// Copy instance data, When manipulating data, you create a copy of the configuration using the copy constructor,
     /// edit it and then transfer its content to the original using this method.
     ///     @param[in] source The source instance (the edited copy)
@@ -120,6 +126,7 @@ class LinkConfiguration : public QObject
     void dynamicChanged();
     void autoConnectChanged();
     void highLatencyChanged();
+    void outboundBytesPerSecondChanged();
 
 protected:
     std::weak_ptr<LinkInterface> _link; ///< Link currently using this configuration (if any)
@@ -130,6 +137,7 @@ class LinkConfiguration : public QObject
     bool _forwarding = false;  ///< Automatically added Mavlink forwarding connection
     bool _autoConnect = false; ///< This connection is started automatically at boot
     bool _highLatency = false;
+    int _outboundBytesPerSecond = 0;
 };
 
 typedef std::shared_ptr<LinkConfiguration> SharedLinkConfigurationPtr;
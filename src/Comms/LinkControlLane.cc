@@ -0,0 +1,102 @@
+#include "LinkControlLane.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QEvent>
+
+QGC_LOGGING_CATEGORY(LinkControlLaneLog, "Comms.LinkControlLane")
+
+namespace {
+
+const QEvent::Type kFlushEventType = static_cast<QEvent::Type>(QEvent::registerEventType());
+
+} // namespace
+
+LinkControlLane::LinkControlLane(Writer writer, QObject *parent)
+    : QObject(parent)
+    , _writer(std::move(writer))
+{
+    // qCDebug(LinkControlLaneLog) << this;
+
+    _logTimer.start();
+}
+
+LinkControlLane::~LinkControlLane()
+{
+    // qCDebug(LinkControlLaneLog) << this;
+}
+
+void LinkControlLane::post(quint64 key, const QByteArray &data, Clock::time_point sampleTime)
+{
+    QMutexLocker locker(&_mutex);
+
+    bool replaced = false;
+    for (Pending &pending : _pending) {
+        if (pending.key == key) {
+            pending.data = data;
+            pending.sampleTime = sampleTime;
+            _stats.supersededCount++;
+            replaced = true;
+            break;
+        }
+    }
+    if (!replaced) {
+        _pending.append(Pending{key, data, sampleTime});
+    }
+
+    if (!_flushPosted) {
+        _flushPosted = true;
+        // High priority puts the flush ahead of the normal priority queued writes already waiting for the worker
+        QCoreApplication::postEvent(this, new QEvent(kFlushEventType), Qt::HighEventPriority);
+    }
+}
+
+bool LinkControlLane::event(QEvent *event)
+{
+    if (event->type() == kFlushEventType) {
+        _flush();
+        return true;
+    }
+
+    return QObject::event(event);
+}
+
+void LinkControlLane::_flush()
+{
+    {
+        QMutexLocker locker(&_mutex);
+        _writing.swap(_pending);
+        _flushPosted = false;
+    }
+
+    for (const Pending &pending : std::as_const(_writing)) {
+        _writer(pending.data);
+
+        const double latencyUs = std::chrono::duration<double, std::micro>(Clock::now() - pending.sampleTime).count();
+
+        QMutexLocker locker(&_mutex);
+        _stats.count++;
+        _stats.meanUs += (latencyUs - _stats.meanUs) / _stats.count;
+        _stats.maxUs = std::max(_stats.maxUs, latencyUs);
+    }
+    _writing.clear();
+
+    if (LinkControlLaneLog().isDebugEnabled() && _logTimer.hasExpired(kLogIntervalMs)) {
+        _logTimer.restart();
+        const LatencyStats stats = latencyStats();
+        qCDebug(LinkControlLaneLog) << "Control latency mean" << stats.meanUs << "us max" << stats.maxUs << "us"
+                                    << "written" << stats.count << "superseded" << stats.supersededCount;
+    }
+}
+
+LinkControlLane::LatencyStats LinkControlLane::latencyStats() const
+{
+    QMutexLocker locker(&_mutex);
+    return _stats;
+}
+
+void LinkControlLane::resetLatencyStats()
+{
+    QMutexLocker locker(&_mutex);
+    _stats = LatencyStats();
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+
+#include <chrono>
+#include <functional>
+
+/// Low latency outbound path for control messages (manual control, gimbal rates) on one link.
+///
+/// The lane lives on the link's worker thread. Messages posted from any thread are handed to the worker as a
+/// high priority event, so they neither pass through the GUI thread nor wait behind queued bulk writes such as
+/// mission or FTP transfers and RTCM. Only the newest message per key is kept, a superseded stick sample is
+/// worthless once a newer one exists.
+///
+/// Messages are sequenced when they are packed, so lane messages overtake queued ones. Receivers only count
+/// that as a sequence gap, but signed messages would be rejected as replays and must not be posted here.
+class LinkControlLane : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Clock = std::chrono::steady_clock;
+    using Writer = std::function<void(const QByteArray &data)>;
+
+    struct LatencyStats {
+        quint64 count = 0;              ///< Messages written
+        quint64 supersededCount = 0;    ///< Messages replaced by a newer one before they were written
+        double meanUs = 0.;             ///< Sample to socket write
+        double maxUs = 0.;
+    };
+
+    /// @param writer Called on the lane's thread to put the bytes on the link
+    explicit LinkControlLane(Writer writer, QObject *parent = nullptr);
+    ~LinkControlLane() override;
+
+    /// Thread safe
+    /// @param key Identifies the control stream, a waiting message with the same key is replaced
+    /// @param sampleTime When the control input was sampled, for the latency statistics
+    void post(quint64 key, const QByteArray &data, Clock::time_point sampleTime);
+
+    LatencyStats latencyStats() const;
+    void resetLatencyStats();
+
+protected:
+    bool event(QEvent *event) override;
+
+private:
+    struct Pending {
+        quint64 key = 0;
+        QByteArray data;
+        Clock::time_point sampleTime;
+    };
+
+    void _flush();
+
+    Writer _writer;
+
+    mutable QMutex _mutex;
+    QList<Pending> _pending;
+    QList<Pending> _writing;
+    bool _flushPosted = false;
+    LatencyStats _stats;
+
+    QElapsedTimer _logTimer;
+
+    static constexpr qint64 kLogIntervalMs = 10000;
+};
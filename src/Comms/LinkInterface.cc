@@ -1,4 +1,5 @@
 #include "LinkInterface.h"
+#include "LinkControlLane.h"
 #include "MAVLinkLib.h"
 #include "LinkManager.h"
 #include "AppMessages.h"
@@ -6,6 +7,7 @@
 #include "QGCLoggingCategory.h"
 #include "MAVLinkSigning.h"
 
+#include <QtCore/QTimer>
 #include <QtQml/QQmlEngine>
 
 QGC_LOGGING_CATEGORY(LinkInterfaceLog, "Comms.LinkInterface")
@@ -13,8 +15,23 @@ QGC_LOGGING_CATEGORY(LinkInterfaceLog, "Comms.LinkInterface")
 LinkInterface::LinkInterface(SharedLinkConfigurationPtr &config, QObject *parent)
     : QObject(parent)
     , _config(config)
+    , _outboundTimer(new QTimer(this))
 {
     QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
+
+    _outboundClock.start();
+    _outboundLogTimer.start();
+
+    // Only runs while a shaped link has messages waiting for budget
+    _outboundTimer->setInterval(kOutboundServiceIntervalMs);
+    _outboundTimer->setTimerType(Qt::PreciseTimer);
+    (void) connect(_outboundTimer, &QTimer::timeout, this, &LinkInterface::_serviceOutbound);
+
+    if (_config) {
+        (void) connect(_config.get(), &LinkConfiguration::outboundBytesPerSecondChanged, this, &LinkInterface::_outboundBudgetChanged);
+        _outboundBytesPerSecond = _config->outboundBytesPerSecond();
+        _outboundScheduler.setBytesPerSecond(_outboundBytesPerSecond);
+    }
 }
 
 LinkInterface::~LinkInterface()
@@ -96,7 +113,102 @@ void LinkInterface::_freeMavlinkChannel()
 void LinkInterface::writeBytesThreadSafe(const char *bytes, int length)
 {
     const QByteArray data(bytes, length);
-    (void) QMetaObject::invokeMethod(this, "_writeBytes", Qt::AutoConnection, data);
+
+    if (_outboundBytesPerSecond == 0) {
+        (void) QMetaObject::invokeMethod(this, "_writeBytes", Qt::AutoConnection, data);
+        return;
+    }
+
+    {
+        QMutexLocker locker(&_outboundMutex);
+        _outboundScheduler.enqueue(data, _outboundClock.elapsed());
+    }
+
+    if (!_outboundServicePosted.exchange(true)) {
+        (void) QMetaObject::invokeMethod(this, &LinkInterface::_serviceOutbound, Qt::AutoConnection);
+    }
+}
+
+LinkOutboundScheduler::ClassStats LinkInterface::outboundStats(LinkOutboundScheduler::TrafficClass trafficClass) const
+{
+    QMutexLocker locker(&_outboundMutex);
+    return _outboundScheduler.classStats(trafficClass);
+}
+
+void LinkInterface::_outboundBudgetChanged()
+{
+    const int bytesPerSecond = _config->outboundBytesPerSecond();
+    qCDebug(LinkInterfaceLog) << _config->name() << "outbound budget" << bytesPerSecond << "B/s";
+
+    {
+        QMutexLocker locker(&_outboundMutex);
+        _outboundScheduler.setBytesPerSecond(bytesPerSecond);
+    }
+    _outboundBytesPerSecond = bytesPerSecond;
+
+    // Releases whatever waits under the old budget
+    _serviceOutbound();
+}
+
+void LinkInterface::_serviceOutbound()
+{
+    _outboundServicePosted = false;
+
+    bool backlog = false;
+    {
+        QMutexLocker locker(&_outboundMutex);
+        _outboundScheduler.takeReady(_outboundClock.elapsed(), _outboundReady);
+        backlog = !_outboundScheduler.isEmpty();
+    }
+
+    for (const QByteArray &data : std::as_const(_outboundReady)) {
+        _writeBytes(data);
+    }
+    _outboundReady.clear();
+
+    if (backlog && !_outboundTimer->isActive()) {
+        _outboundTimer->start();
+    } else if (!backlog) {
+        _outboundTimer->stop();
+    }
+
+    if (LinkInterfaceLog().isDebugEnabled() && (_outboundBytesPerSecond != 0) && _outboundLogTimer.hasExpired(kOutboundLogIntervalMs)) {
+        _outboundLogTimer.restart();
+        static constexpr const char *classNames[] = { "command", "correction", "telemetry", "bulk" };
+        for (int trafficClass = 0; trafficClass < LinkOutboundScheduler::TrafficClassCount; trafficClass++) {
+            const LinkOutboundScheduler::ClassStats stats = outboundStats(static_cast<LinkOutboundScheduler::TrafficClass>(trafficClass));
+            qCDebug(LinkInterfaceLog) << _config->name() << classNames[trafficClass]
+                                      << "queued" << stats.queuedMessages << "max" << stats.maxQueuedMessages
+                                      << "sent" << stats.sentMessages << "dropped" << stats.droppedMessages
+                                      << "latency mean" << stats.meanLatencyMs << "ms max" << stats.maxLatencyMs << "ms";
+        }
+    }
+}
+
+void LinkInterface::writeControlBytesThreadSafe(quint64 key, const char *bytes, int length, std::chrono::steady_clock::time_point sampleTime)
+{
+    {
+        // Held across post() so the lane can't be destroyed underneath us
+        QMutexLocker locker(&_controlLaneMutex);
+        if (_controlLane) {
+            _controlLane->post(key, QByteArray(bytes, length), sampleTime);
+            return;
+        }
+    }
+
+    writeBytesThreadSafe(bytes, length);
+}
+
+bool LinkInterface::hasControlLane() const
+{
+    QMutexLocker locker(&_controlLaneMutex);
+    return _controlLane != nullptr;
+}
+
+void LinkInterface::_setControlLane(LinkControlLane *controlLane)
+{
+    QMutexLocker locker(&_controlLaneMutex);
+    _controlLane = controlLane;
 }
 
 void LinkInterface::removeVehicleReference()
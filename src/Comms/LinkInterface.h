@@ -1,10 +1,18 @@
 #pragma once
 
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMutex>
 #include <QtQmlIntegration/QtQmlIntegration>
 
 #include "LinkConfiguration.h"
+#include "LinkOutboundScheduler.h"
 
+#include <atomic>
+#include <chrono>
+
+class LinkControlLane;
 class LinkManager;
+class QTimer;
 
 /// The link interface defines the interface for all links used to communicate with the ground station application.
 class LinkInterface : public QObject
@@ -29,7 +37,18 @@ class LinkInterface : public QObject
     bool mavlinkChannelIsSet() const;
     bool decodedFirstMavlinkPacket() const { return _decodedFirstMavlinkPacket; }
     void setDecodedFirstMavlinkPacket(bool decodedFirstMavlinkPacket) { _decodedFirstMavlinkPacket = decodedFirstMavlinkPacket; }
+    /// Queues bytes for the link. When the link configuration sets an outbound budget the bytes go through
+    /// the link's LinkOutboundScheduler, otherwise they are handed to the link right away.
     void writeBytesThreadSafe(const char *bytes, int length);
+    /// Outbound queue statistics for one traffic class, only collected while the link has an outbound budget
+    LinkOutboundScheduler::ClassStats outboundStats(LinkOutboundScheduler::TrafficClass trafficClass) const;
+    /// Writes a control message (manual control, gimbal rates) through the link's control lane, which skips the
+    /// GUI thread and goes ahead of bulk traffic. Links without one fall back to writeBytesThreadSafe.
+    ///     @param key Control stream, a waiting message with the same key is replaced
+    ///     @param sampleTime When the control input was sampled, used for latency statistics
+    void writeControlBytesThreadSafe(quint64 key, const char *bytes, int length, std::chrono::steady_clock::time_point sampleTime);
+    /// Thread safe. False if the link has no control lane.
+    bool hasControlLane() const;
     void addVehicleReference() { ++_vehicleReferenceCount; }
     void removeVehicleReference();
     bool initMavlinkSigning();
@@ -55,16 +74,37 @@ class LinkInterface : public QObject
 
     void _connectionRemoved();
 
+    /// Links with a worker thread set their control lane here, and clear it before the worker is destroyed
+    void _setControlLane(LinkControlLane *controlLane);
+
     SharedLinkConfigurationPtr _config;
 
 private slots:
     /// Not thread safe if called directly, only writeBytesThreadSafe is thread safe
     virtual void _writeBytes(const QByteArray &bytes) = 0;
 
+    void _outboundBudgetChanged();
+    void _serviceOutbound();
+
 private:
     /// connect is private since all links should be created through LinkManager::createConnectedLink calls
     virtual bool _connect() = 0;
 
+    mutable QMutex _controlLaneMutex;
+    LinkControlLane *_controlLane = nullptr;   ///< Owned by the link's worker, protected by _controlLaneMutex
+
+    mutable QMutex _outboundMutex;
+    LinkOutboundScheduler _outboundScheduler;   ///< Protected by _outboundMutex
+    std::atomic<int> _outboundBytesPerSecond = 0;
+    std::atomic<bool> _outboundServicePosted = false;
+    QElapsedTimer _outboundClock;
+    QTimer *_outboundTimer = nullptr;
+    QList<QByteArray> _outboundReady;
+    QElapsedTimer _outboundLogTimer;
+
+    static constexpr int kOutboundServiceIntervalMs = 10;
+    static constexpr qint64 kOutboundLogIntervalMs = 10000;
+
     uint8_t _mavlinkChannel = std::numeric_limits<uint8_t>::max();
     bool _decodedFirstMavlinkPacket = false;
     int _vehicleReferenceCount = 0;
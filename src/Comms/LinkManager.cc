@@ -296,6 +296,7 @@ void LinkManager::saveLinkConfigurationList()
         settings.setValue(root + "/type", linkConfig->type());
         settings.setValue(root + "/auto", linkConfig->isAutoConnect());
         settings.setValue(root + "/high_latency", linkConfig->isHighLatency());
+        settings.setValue(root + "/outbound_bytes_per_second", linkConfig->outboundBytesPerSecond());
         linkConfig->saveSettings(settings, root);
     }
 
@@ -368,6 +369,7 @@ void LinkManager::loadLinkConfigurationList()
                 link->setAutoConnect(autoConnect);
                 const bool highLatency = settings.value(root + "/high_latency").toBool();
                 link->setHighLatency(highLatency);
+                link->setOutboundBytesPerSecond(settings.value(root + "/outbound_bytes_per_second", 0).toInt());
                 link->loadSettings(settings, root);
                 addConfiguration(link);
             }
@@ -0,0 +1,243 @@
+#include "LinkOutboundScheduler.h"
+#include "MAVLinkLib.h"
+
+namespace {
+
+constexpr qsizetype kMavlink1MsgIdOffset = 5;
+constexpr qsizetype kMavlink2IncompatFlagsOffset = 2;
+constexpr qsizetype kMavlink2MsgIdOffset = 7;
+
+} // namespace
+
+LinkOutboundScheduler::LinkOutboundScheduler(qint64 bytesPerSecond)
+    : _bytesPerSecond(bytesPerSecond)
+{
+}
+
+void LinkOutboundScheduler::setBytesPerSecond(qint64 bytesPerSecond)
+{
+    _bytesPerSecond = bytesPerSecond;
+    _tokens = 0.;
+    _correctionTokens = 0.;
+    _refillStarted = false;
+}
+
+void LinkOutboundScheduler::enqueue(const QByteArray &frame, qint64 nowMs)
+{
+    const TrafficClass trafficClass = classify(frame);
+    QList<Queued> &queue = _queues[trafficClass];
+    ClassStats &stats = _stats[trafficClass];
+
+    if (queue.count() >= kMaxQueuedMessages[trafficClass]) {
+        // The oldest frame is the most likely to be stale already, and the protocols behind every class retry
+        const Queued &dropped = queue.first();
+        if (dropped.isSigned) {
+            _signedQueued--;
+        }
+        stats.queuedMessages--;
+        stats.queuedBytes -= dropped.data.size();
+        stats.droppedMessages++;
+        queue.removeFirst();
+    }
+
+    const bool signedFrame = isSigned(frame);
+    if (signedFrame) {
+        _signedQueued++;
+    }
+    queue.append(Queued{frame, nowMs, _nextOrder++, signedFrame});
+
+    stats.queuedMessages++;
+    stats.queuedBytes += frame.size();
+    stats.maxQueuedMessages = qMax(stats.maxQueuedMessages, stats.queuedMessages);
+}
+
+void LinkOutboundScheduler::takeReady(qint64 nowMs, QList<QByteArray> &ready)
+{
+    const bool unlimited = (_bytesPerSecond <= 0);
+    if (!unlimited) {
+        _refill(nowMs);
+    }
+
+    while (true) {
+        TrafficClass trafficClass = _nextClass(nowMs);
+        if (trafficClass == TrafficClassCount) {
+            break;
+        }
+
+        if (!unlimited && !_canSend(trafficClass)) {
+            if (_signedQueued > 0) {
+                // Nothing may overtake a waiting signed frame
+                break;
+            }
+            // Corrections draw on their own share, so they neither wait behind a blocked class nor block the others
+            if (trafficClass == CorrectionClass) {
+                trafficClass = _nextClass(nowMs, true /* skipCorrections */);
+            } else {
+                trafficClass = CorrectionClass;
+            }
+            if ((trafficClass == TrafficClassCount) || !_canSend(trafficClass)) {
+                break;
+            }
+        }
+
+        QList<Queued> &queue = _queues[trafficClass];
+        const Queued &queued = queue.first();
+
+        if (!unlimited) {
+            if (trafficClass == CorrectionClass) {
+                _correctionTokens -= queued.data.size();
+                // Charged to the link budget too, bounded so the debt is always paid off within two bursts
+                _tokens = qMax(-_capacity(), _tokens - queued.data.size());
+            } else {
+                _tokens -= queued.data.size();
+            }
+        }
+
+        if (queued.isSigned) {
+            _signedQueued--;
+        }
+        _recordSent(trafficClass, queued, nowMs);
+        ready.append(queued.data);
+        queue.removeFirst();
+    }
+}
+
+LinkOutboundScheduler::TrafficClass LinkOutboundScheduler::_nextClass(qint64 nowMs, bool skipCorrections) const
+{
+    TrafficClass highest = TrafficClassCount;
+    TrafficClass oldest = TrafficClassCount;
+    for (qsizetype index = 0; index < TrafficClassCount; index++) {
+        const TrafficClass trafficClass = static_cast<TrafficClass>(index);
+        if (_queues[trafficClass].isEmpty() || (skipCorrections && (trafficClass == CorrectionClass))) {
+            continue;
+        }
+        if (highest == TrafficClassCount) {
+            highest = trafficClass;
+        }
+        if ((oldest == TrafficClassCount) || (_queues[trafficClass].first().order < _queues[oldest].first().order)) {
+            oldest = trafficClass;
+        }
+    }
+
+    if (oldest == TrafficClassCount) {
+        return TrafficClassCount;
+    }
+
+    // Queue order while signed frames wait, or when the oldest frame has waited too long
+    if ((_signedQueued > 0) || ((nowMs - _queues[oldest].first().queuedMs) >= kMaxWaitMs)) {
+        return oldest;
+    }
+
+    return highest;
+}
+
+bool LinkOutboundScheduler::_canSend(TrafficClass trafficClass) const
+{
+    if (_queues[trafficClass].isEmpty()) {
+        return false;
+    }
+
+    const qsizetype size = _queues[trafficClass].first().data.size();
+    return (trafficClass == CorrectionClass) ? (_correctionTokens >= size) : (_tokens >= size);
+}
+
+bool LinkOutboundScheduler::isEmpty() const
+{
+    for (const QList<Queued> &queue : _queues) {
+        if (!queue.isEmpty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+LinkOutboundScheduler::TrafficClass LinkOutboundScheduler::classify(QByteArrayView frame)
+{
+    uint32_t msgId = 0;
+    if (!frame.isEmpty() && (static_cast<uint8_t>(frame[0]) == MAVLINK_STX) && (frame.size() > (kMavlink2MsgIdOffset + 2))) {
+        msgId = static_cast<uint8_t>(frame[kMavlink2MsgIdOffset])
+              | (static_cast<uint8_t>(frame[kMavlink2MsgIdOffset + 1]) << 8)
+              | (static_cast<uint32_t>(static_cast<uint8_t>(frame[kMavlink2MsgIdOffset + 2])) << 16);
+    } else if (!frame.isEmpty() && (static_cast<uint8_t>(frame[0]) == MAVLINK_STX_MAVLINK1) && (frame.size() > kMavlink1MsgIdOffset)) {
+        msgId = static_cast<uint8_t>(frame[kMavlink1MsgIdOffset]);
+    } else {
+        // Not MAVLink, e.g. the NSH console
+        return TelemetryClass;
+    }
+
+    switch (msgId) {
+    case MAVLINK_MSG_ID_HEARTBEAT:
+    case MAVLINK_MSG_ID_SET_MODE:
+    case MAVLINK_MSG_ID_COMMAND_INT:
+    case MAVLINK_MSG_ID_COMMAND_LONG:
+    case MAVLINK_MSG_ID_COMMAND_ACK:
+    case MAVLINK_MSG_ID_COMMAND_CANCEL:
+    case MAVLINK_MSG_ID_MANUAL_CONTROL:
+    case MAVLINK_MSG_ID_SET_POSITION_TARGET_LOCAL_NED:
+    case MAVLINK_MSG_ID_SET_POSITION_TARGET_GLOBAL_INT:
+    case MAVLINK_MSG_ID_GIMBAL_MANAGER_SET_ATTITUDE:
+        return CommandClass;
+    case MAVLINK_MSG_ID_PARAM_REQUEST_READ:
+    case MAVLINK_MSG_ID_PARAM_REQUEST_LIST:
+    case MAVLINK_MSG_ID_PARAM_SET:
+    case MAVLINK_MSG_ID_MISSION_REQUEST_LIST:
+    case MAVLINK_MSG_ID_MISSION_COUNT:
+    case MAVLINK_MSG_ID_MISSION_REQUEST_INT:
+    case MAVLINK_MSG_ID_MISSION_ITEM_INT:
+    case MAVLINK_MSG_ID_MISSION_ACK:
+    case MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL:
+    case MAVLINK_MSG_ID_LOG_REQUEST_LIST:
+    case MAVLINK_MSG_ID_LOG_REQUEST_DATA:
+    case MAVLINK_MSG_ID_LOGGING_ACK:
+        return BulkClass;
+    case MAVLINK_MSG_ID_GPS_RTCM_DATA:
+        return CorrectionClass;
+    default:
+        return TelemetryClass;
+    }
+}
+
+bool LinkOutboundScheduler::isSigned(QByteArrayView frame)
+{
+    return (frame.size() > kMavlink2IncompatFlagsOffset) && (static_cast<uint8_t>(frame[0]) == MAVLINK_STX)
+        && ((static_cast<uint8_t>(frame[kMavlink2IncompatFlagsOffset]) & MAVLINK_IFLAG_SIGNED) != 0);
+}
+
+double LinkOutboundScheduler::_capacity() const
+{
+    // Deep enough for the largest frame even on slow links, otherwise it would never fit
+    return qMax(static_cast<double>(_bytesPerSecond * kBurstMs) / 1000., static_cast<double>(MAVLINK_MAX_PACKET_LEN));
+}
+
+double LinkOutboundScheduler::_correctionCapacity() const
+{
+    return qMax((_bytesPerSecond * kCorrectionShare * kBurstMs) / 1000., static_cast<double>(MAVLINK_MAX_PACKET_LEN));
+}
+
+void LinkOutboundScheduler::_refill(qint64 nowMs)
+{
+    if (!_refillStarted) {
+        _tokens = _capacity();
+        _correctionTokens = _correctionCapacity();
+        _lastRefillMs = nowMs;
+        _refillStarted = true;
+        return;
+    }
+
+    const double refill = static_cast<double>(_bytesPerSecond * (nowMs - _lastRefillMs)) / 1000.;
+    _lastRefillMs = nowMs;
+    _tokens = qMin(_capacity(), _tokens + refill);
+    _correctionTokens = qMin(_correctionCapacity(), _correctionTokens + (refill * kCorrectionShare));
+}
+
+void LinkOutboundScheduler::_recordSent(TrafficClass trafficClass, const Queued &queued, qint64 nowMs)
+{
+    ClassStats &stats = _stats[trafficClass];
+    stats.queuedMessages--;
+    stats.queuedBytes -= queued.data.size();
+    stats.sentMessages++;
+
+    const double latencyMs = static_cast<double>(nowMs - queued.queuedMs);
+    stats.meanLatencyMs += (latencyMs - stats.meanLatencyMs) / stats.sentMessages;
+    stats.maxLatencyMs = qMax(stats.maxLatencyMs, latencyMs);
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QList>
+
+#include <array>
+
+/// Outgoing MAVLink frames for one bandwidth limited link.
+///
+/// Frames are sorted into traffic classes by message id and wait in one queue per class. A token bucket
+/// paces them to the link budget and the classes are served in priority order, so a parameter, mission or
+/// FTP burst can no longer hold back commands and heartbeats queued after it. A frame which has waited
+/// kMaxWaitMs goes out ahead of higher classes so a steady command stream can't starve the rest, and each
+/// class queue is capped, dropping its oldest frame when full.
+///
+/// Signed frames carry the timestamp they were packed with and the vehicle rejects one which is older than
+/// a frame it already accepted. While signed frames are queued every frame leaves in the order it was queued.
+///
+/// RTCM corrections have their own share of the budget, kCorrectionShare, which RTCMMavlink paces them to.
+/// Within it they go out without waiting behind the other classes, and the other classes don't wait behind
+/// them. What they send is charged against the link budget as well, so the other classes leave room for them,
+/// but the debt is bounded so heartbeats and commands keep going out however many corrections arrive.
+class LinkOutboundScheduler
+{
+public:
+    enum TrafficClass {
+        CommandClass,       ///< Heartbeats, commands and mode changes
+        CorrectionClass,    ///< RTCM corrections
+        TelemetryClass,     ///< Everything not listed in the other classes
+        BulkClass,          ///< Parameter, mission, FTP and log transfers
+        TrafficClassCount
+    };
+
+    struct ClassStats {
+        qsizetype queuedMessages = 0;
+        qsizetype queuedBytes = 0;
+        qsizetype maxQueuedMessages = 0;
+        quint64 sentMessages = 0;
+        quint64 droppedMessages = 0;    ///< Oldest frames dropped because the queue was full
+        double meanLatencyMs = 0.;  ///< Time spent waiting in the queue
+        double maxLatencyMs = 0.;
+    };
+
+    /// @param bytesPerSecond Link budget, 0 for unlimited
+    explicit LinkOutboundScheduler(qint64 bytesPerSecond = 0);
+
+    void setBytesPerSecond(qint64 bytesPerSecond);
+    qint64 bytesPerSecond() const { return _bytesPerSecond; }
+
+    void enqueue(const QByteArray &frame, qint64 nowMs);
+
+    /// Appends the frames which fit the budget at nowMs to ready, in the order they should be written
+    void takeReady(qint64 nowMs, QList<QByteArray> &ready);
+
+    bool isEmpty() const;
+
+    const ClassStats &classStats(TrafficClass trafficClass) const { return _stats[trafficClass]; }
+
+    static TrafficClass classify(QByteArrayView frame);
+    static bool isSigned(QByteArrayView frame);
+
+    static constexpr qint64 kBurstMs = 100;     ///< Token bucket depth
+    static constexpr qint64 kMaxWaitMs = 1000;  ///< Frames waiting longer go out ahead of higher classes
+    static constexpr double kCorrectionShare = 0.5; ///< Share of the budget corrections may use without waiting
+    static constexpr std::array<qsizetype, TrafficClassCount> kMaxQueuedMessages = { 64, 64, 256, 1024 };
+
+private:
+    struct Queued {
+        QByteArray data;
+        qint64 queuedMs = 0;
+        quint64 order = 0;
+        bool isSigned = false;
+    };
+
+    /// @return Class whose oldest frame goes next, TrafficClassCount when nothing is queued
+    TrafficClass _nextClass(qint64 nowMs, bool skipCorrections = false) const;
+    /// @return true if the class has a frame queued and the budget for it
+    bool _canSend(TrafficClass trafficClass) const;
+    double _capacity() const;
+    double _correctionCapacity() const;
+    void _refill(qint64 nowMs);
+    void _recordSent(TrafficClass trafficClass, const Queued &queued, qint64 nowMs);
+
+    std::array<QList<Queued>, TrafficClassCount> _queues;
+    std::array<ClassStats, TrafficClassCount> _stats;
+    qint64 _bytesPerSecond = 0;
+    double _tokens = 0.;
+    double _correctionTokens = 0.;
+    qint64 _lastRefillMs = 0;
+    bool _refillStarted = false;
+    quint64 _nextOrder = 0;
+    qsizetype _signedQueued = 0;
+};
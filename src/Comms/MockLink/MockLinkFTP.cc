@@ -1,6 +1,7 @@
 #include "MockLinkFTP.h"
 #include "MockLink.h"
 #include "QGCLoggingCategory.h"
+#include "QGCMath.h"
 
 #include <QtCore/QDataStream>
 #include <QtCore/QDir>
@@ -109,24 +110,7 @@ void MockLinkFTP::_openCommand(uint8_t senderSystemId, uint8_t senderComponentId
 
     _currentFile.close();
 
-    QString tmpFilename;
-    const QString sizePrefix = sizeFilenamePrefix;
-    if (path.startsWith(sizePrefix)) {
-        const QString sizeString = path.right(path.length() - sizePrefix.length());
-        tmpFilename = _createTestTempFile(sizeString.toInt());
-    } else if (path == "/general.json") {
-        tmpFilename = QStringLiteral(":MockLink/General.MetaData.json");
-    } else if (path == "/general.json.xz") {
-        tmpFilename = QStringLiteral(":MockLink/General.MetaData.json.xz");
-    } else if (path == "/parameter.json") {
-        tmpFilename = QStringLiteral(":MockLink/Parameter.MetaData.json");
-    } else if (path == "/parameter.json.xz") {
-        tmpFilename = QStringLiteral(":MockLink/Parameter.MetaData.json.xz");
-    } else if (path == "@PARAM/param.pck" || path.startsWith("@PARAM/param.pck?")) {
-        const bool withDefaults = path.contains(QStringLiteral("withdefaults=1"));
-        tmpFilename = _generateParamPck(withDefaults);
-    }
-
+    const QString tmpFilename = _readFilePath(path);
     if (!tmpFilename.isEmpty()) {
         _currentFile.setFileName(tmpFilename);
         if (!_currentFile.open(QIODevice::ReadOnly)) {
@@ -151,6 +135,37 @@ void MockLinkFTP::_openCommand(uint8_t senderSystemId, uint8_t senderComponentId
     _sendResponse(senderSystemId, senderComponentId, &response, outgoingSeqNumber);
 }
 
+void MockLinkFTP::_calcFileCRC32Command(uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request *request, uint16_t seqNumber)
+{
+    ensureNullTemination(request);
+    const QString path = reinterpret_cast<char*>(request->data);
+
+    const uint16_t outgoingSeqNumber = _nextSeqNumber(seqNumber);
+
+    const QString filename = _readFilePath(path);
+    if (filename.isEmpty()) {
+        _sendNak(senderSystemId, senderComponentId, MavlinkFTP::kErrFailFileNotFound, outgoingSeqNumber, MavlinkFTP::kCmdCalcFileCRC32);
+        return;
+    }
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        _sendNakErrno(senderSystemId, senderComponentId, file.error(), outgoingSeqNumber, MavlinkFTP::kCmdCalcFileCRC32);
+        return;
+    }
+
+    const QByteArray bytes = file.readAll();
+
+    MavlinkFTP::Request response{};
+    response.hdr.opcode = MavlinkFTP::kRspAck;
+    response.hdr.req_opcode = MavlinkFTP::kCmdCalcFileCRC32;
+    response.hdr.session = 0;
+    response.hdr.size = sizeof(uint32_t);
+    response.openFileLength = QGC::crc32(reinterpret_cast<const uint8_t*>(bytes.constData()), static_cast<unsigned>(bytes.size()), 0);
+
+    _sendResponse(senderSystemId, senderComponentId, &response, outgoingSeqNumber);
+}
+
 void MockLinkFTP::_createFileCommand(uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request *request, uint16_t seqNumber)
 {
     ensureNullTemination(request);
@@ -470,6 +485,9 @@ void MockLinkFTP::mavlinkMessageReceived(const mavlink_message_t &message)
     case MavlinkFTP::kCmdResetSessions:
         _resetCommand(message.sysid, message.compid, incomingSeqNumber);
         break;
+    case MavlinkFTP::kCmdCalcFileCRC32:
+        _calcFileCRC32Command(message.sysid, message.compid, request, incomingSeqNumber);
+        break;
     default:
         // nack for all NYI opcodes
         _sendNak(message.sysid, message.compid, MavlinkFTP::kErrUnknownCommand, outgoingSeqNumber, static_cast<MavlinkFTP::OpCode_t>(request->hdr.opcode));
@@ -557,6 +575,28 @@ uint16_t MockLinkFTP::_nextSeqNumber(uint16_t seqNumber) const
     return outgoingSeqNumber;
 }
 
+QString MockLinkFTP::_readFilePath(const QString &path)
+{
+    const QString sizePrefix = sizeFilenamePrefix;
+    if (path.startsWith(sizePrefix)) {
+        const QString sizeString = path.right(path.length() - sizePrefix.length());
+        return _createTestTempFile(sizeString.toInt());
+    } else if (path == "/general.json") {
+        return QStringLiteral(":MockLink/General.MetaData.json");
+    } else if (path == "/general.json.xz") {
+        return QStringLiteral(":MockLink/General.MetaData.json.xz");
+    } else if (path == "/parameter.json") {
+        return QStringLiteral(":MockLink/Parameter.MetaData.json");
+    } else if (path == "/parameter.json.xz") {
+        return QStringLiteral(":MockLink/Parameter.MetaData.json.xz");
+    } else if (path == "@PARAM/param.pck" || path.startsWith("@PARAM/param.pck?")) {
+        const bool withDefaults = path.contains(QStringLiteral("withdefaults=1"));
+        return _generateParamPck(withDefaults);
+    }
+
+    return QString();
+}
+
 QString MockLinkFTP::_createTestTempFile(int size)
 {
     QTemporaryFile tmpFile(QDir::tempPath() + QStringLiteral("/MockLinkFTPTestCaseXXXXXX"));
@@ -1,4 +1,5 @@
 #include "SerialLink.h"
+#include "LinkControlLane.h"
 #include "QGCLoggingCategory.h"
 #include "QGCSerialPortInfo.h"
 #include <QtCore/QSettings>
@@ -407,6 +408,8 @@ SerialLink::SerialLink(SharedLinkConfigurationPtr &config, QObject *parent)
 
     _workerThread->setObjectName(QStringLiteral("Serial_%1").arg(_serialConfig->name()));
 
+    _setControlLane(new LinkControlLane([worker = _worker](const QByteArray &data) { worker->writeData(data); }, _worker));
+
     (void) _worker->moveToThread(_workerThread);
 
     (void) connect(_workerThread, &QThread::started, _worker, &SerialWorker::setupPort);
@@ -428,6 +431,7 @@ SerialLink::~SerialLink()
         _onDisconnected();
     }
 
+    _setControlLane(nullptr);
     _workerThread->quit();
     if (!_workerThread->wait(DISCONNECT_TIMEOUT_MS)) {
         qCWarning(SerialLinkLog) << "Failed to wait for Serial Thread to close";
@@ -1,4 +1,5 @@
 #include "TCPLink.h"
+#include "LinkControlLane.h"
 #include "QGCLoggingCategory.h"
 #include "QGCNetworkHelper.h"
 
@@ -255,6 +256,8 @@ TCPLink::TCPLink(SharedLinkConfigurationPtr &config, QObject *parent)
 
     _workerThread->setObjectName(QStringLiteral("TCP_%1").arg(_tcpConfig->name()));
 
+    _setControlLane(new LinkControlLane([worker = _worker](const QByteArray &data) { worker->writeData(data); }, _worker));
+
     _worker->moveToThread(_workerThread);
 
     (void) connect(_workerThread, &QThread::started, _worker, &TCPWorker::setupSocket);
@@ -276,6 +279,7 @@ TCPLink::~TCPLink()
         _onDisconnected();
     }
 
+    _setControlLane(nullptr);
     _workerThread->quit();
     if (!_workerThread->wait(DISCONNECT_TIMEOUT_MS)) {
         qCWarning(TCPLinkLog) << "Failed to wait for TCP Thread to close";
@@ -1,4 +1,5 @@
 #include "UDPLink.h"
+#include "LinkControlLane.h"
 #include "AutoConnectSettings.h"
 #include "QGCLoggingCategory.h"
 #include "QGCNetworkHelper.h"
@@ -487,6 +488,8 @@ UDPLink::UDPLink(SharedLinkConfigurationPtr &config, QObject *parent)
 
     _workerThread->setObjectName(QStringLiteral("UDP_%1").arg(_udpConfig->name()));
 
+    _setControlLane(new LinkControlLane([worker = _worker](const QByteArray &data) { worker->writeData(data); }, _worker));
+
     _worker->moveToThread(_workerThread);
 
     (void) connect(_workerThread, &QThread::started, _worker, &UDPWorker::setupSocket);
@@ -508,6 +511,7 @@ UDPLink::~UDPLink()
         _onDisconnected();
     }
 
+    _setControlLane(nullptr);
     _workerThread->quit();
     if (!_workerThread->wait()) {
         qCWarning(UDPLinkLog) << "Failed to wait for UDP Thread to close";
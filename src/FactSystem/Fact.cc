@@ -352,6 +352,11 @@ QStringList Fact::selectedBitmaskStrings() const
 }
 
 QString Fact::_variantToString(const QVariant &variant, int decimalPlaces) const
+{
+    return variantToString(variant, type(), decimalPlaces);
+}
+
+QString Fact::variantToString(const QVariant &variant, FactMetaData::ValueType_t type, int decimalPlaces)
 {
     QString valueString;
 
@@ -363,12 +368,12 @@ QString Fact::_variantToString(const QVariant &variant, int decimalPlaces) const
         }
     };
 
-    switch (type()) {
+    switch (type) {
     case FactMetaData::valueTypeFloat:
     {
         const float fValue = variant.toFloat();
         if (qIsNaN(fValue)) {
-            valueString = invalidValueString(decimalPlaces);
+            valueString = invalidValueString(type, decimalPlaces);
         } else {
             valueString = QStringLiteral("%1").arg(fValue, 0, 'f', decimalPlaces);
             stripNegativeZero(valueString);
@@ -379,7 +384,7 @@ QString Fact::_variantToString(const QVariant &variant, int decimalPlaces) const
     {
         const double dValue = variant.toDouble();
         if (qIsNaN(dValue)) {
-            valueString = invalidValueString(decimalPlaces);
+            valueString = invalidValueString(type, decimalPlaces);
         } else {
             valueString = QStringLiteral("%1").arg(dValue, 0, 'f', decimalPlaces);
             stripNegativeZero(valueString);
@@ -393,7 +398,7 @@ QString Fact::_variantToString(const QVariant &variant, int decimalPlaces) const
     {
         const double dValue = variant.toDouble();
         if (qIsNaN(dValue)) {
-            valueString = invalidValueString(decimalPlaces);
+            valueString = invalidValueString(type, decimalPlaces);
         } else {
             QTime time(0, 0, 0, 0);
             time = time.addSecs(dValue);
@@ -409,8 +414,14 @@ QString Fact::_variantToString(const QVariant &variant, int decimalPlaces) const
     return valueString;
 }
 
-QString Fact::invalidValueString(int decimalPlaces) const {
-    switch (type()) {
+QString Fact::invalidValueString(int decimalPlaces) const
+{
+    return invalidValueString(type(), decimalPlaces);
+}
+
+QString Fact::invalidValueString(FactMetaData::ValueType_t type, int decimalPlaces)
+{
+    switch (type) {
     case FactMetaData::valueTypeFloat:
     case FactMetaData::valueTypeDouble:
         if (decimalPlaces <= 0) {
@@ -128,6 +128,10 @@ class Fact : public QObject
     QString rawValueString() const;
     QString cookedValueString() const;
     bool valueEqualsDefault() const;
+
+    /// Formats a value of the given type the way cookedValueString() does, without needing a Fact instance
+    static QString variantToString(const QVariant &variant, FactMetaData::ValueType_t type, int decimalPlaces);
+    static QString invalidValueString(FactMetaData::ValueType_t type, int decimalPlaces);
     bool vehicleRebootRequired() const;
     bool qgcRebootRequired() const;
     QString enumOrValueString();         // This is not const, since an unknown value can modify the enum lists
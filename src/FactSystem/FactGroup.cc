@@ -13,7 +13,7 @@ FactGroup::FactGroup(int updateRateMsecs, const QString &metaDataFile, QObject *
 {
     // qCDebug(FactGroupLog) << Q_FUNC_INFO << this;
     _setupTimer();
-    _nameToFactMetaDataMap = FactMetaData::createMapFromJsonFile(metaDataFile, this);
+    _nameToFactMetaDataMap = FactMetaData::sharedMapFromJsonFile(metaDataFile);
 }
 
 FactGroup::FactGroup(int updateRateMsecs, QObject *parent, bool ignoreCamelCase)
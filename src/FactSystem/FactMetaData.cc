@@ -7,6 +7,7 @@
 
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
 #include <QtCore/QtMath>
 
 QGC_LOGGING_CATEGORY(FactMetaDataLog, "FactSystem.FactMetaData")
@@ -1448,6 +1449,22 @@ QMap<QString, FactMetaData*> FactMetaData::createMapFromJsonFile(const QString &
     return createMapFromJsonArray(factArray, defineMap, metaDataParent);
 }
 
+QMap<QString, FactMetaData*> FactMetaData::sharedMapFromJsonFile(const QString &jsonFilename)
+{
+    static QMutex sharedMapsMutex;
+    static QHash<QString, QMap<QString, FactMetaData*>> sharedMaps;
+
+    QMutexLocker locker(&sharedMapsMutex);
+
+    auto it = sharedMaps.constFind(jsonFilename);
+    if (it == sharedMaps.constEnd()) {
+        qCDebug(FactMetaDataLog) << "Loading shared meta data" << jsonFilename;
+        it = sharedMaps.insert(jsonFilename, createMapFromJsonFile(jsonFilename, nullptr /* metaDataParent */));
+    }
+
+    return it.value();
+}
+
 QMap<QString, FactMetaData*> FactMetaData::createMapFromJsonArray(const QJsonArray &jsonArray, const QMap<QString, QString> &defineMap, QObject *metaDataParent)
 {
     QMap<QString, FactMetaData*> metaDataMap;
@@ -54,6 +54,11 @@ class FactMetaData : public QObject
     typedef QMap<QString, QString> DefineMap_t;
 
     static QMap<QString, FactMetaData*> createMapFromJsonFile(const QString &jsonFilename, QObject *metaDataParent);
+
+    /// Returns the process-wide meta data map for a json file. The file is parsed on first use only and the
+    /// returned instances live for the lifetime of the application. They are shared by every caller, so they
+    /// must be treated as read-only: take a copy of an entry before adjusting it for a single object.
+    static QMap<QString, FactMetaData*> sharedMapFromJsonFile(const QString &jsonFilename);
     static QMap<QString, FactMetaData*> createMapFromJsonArray(const QJsonArray &jsonArray, const DefineMap_t &defineMap, QObject *metaDataParent);
 
     static FactMetaData *createFromJsonObject(const QJsonObject &json, const QMap<QString, QString> &defineMap, QObject *metaDataParent);
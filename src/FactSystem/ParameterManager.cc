@@ -524,7 +524,7 @@ void ParameterManager::_ftpDownloadComplete(const QString &fileName, const QStri
     bool continueWithDefaultParameterdownload = true;
     bool immediateRetry = false;
 
-    (void) disconnect(_vehicle->ftpManager(), &FTPManager::downloadComplete, this, &ParameterManager::_ftpDownloadComplete);
+    _ftpDownloadPending = false;
     (void) disconnect(_vehicle->ftpManager(), &FTPManager::commandProgress, this, &ParameterManager::_ftpDownloadProgress);
 
     if (errorMsg.isEmpty()) {
@@ -569,6 +569,11 @@ void ParameterManager::_ftpDownloadComplete(const QString &fileName, const QStri
 
 void ParameterManager::_ftpDownloadProgress(float progress)
 {
+    if (_vehicle->ftpManager()->activeOperationContext() != this) {
+        // Progress of an operation queued ahead of ours
+        return;
+    }
+
     qCDebug(ParameterManagerVerbose1Log) << "ParameterManager::_ftpDownloadProgress:" << progress;
     _setLoadProgress(static_cast<double>(progress));
     if (progress > 0.001) {
@@ -638,18 +643,21 @@ void ParameterManager::_startParameterDownload(uint8_t componentId)
         if (!_initialLoadComplete) {
             _paramRequestListTimer.start();
         }
-        FTPManager *const ftpManager = _vehicle->ftpManager();
-        (void) connect(ftpManager, &FTPManager::downloadComplete, this, &ParameterManager::_ftpDownloadComplete);
         _waitingParamTimeoutTimer.stop();
-        if (ftpManager->download(MAV_COMP_ID_AUTOPILOT1,
-                                 QStringLiteral("@PARAM/param.pck?withdefaults=1"),
-                                 QStandardPaths::writableLocation(QStandardPaths::TempLocation),
-                                 QStringLiteral("param.pck"),
-                                 false /* No filesize check */)) {
-            (void) connect(ftpManager, &FTPManager::commandProgress, this, &ParameterManager::_ftpDownloadProgress);
+        if (_ftpDownloadPending) {
+            qCDebug(ParameterManagerLog) << _logVehiclePrefix(-1) << "Parameter file download already pending";
         } else {
-            qCWarning(ParameterManagerLog) << "ParameterManager::_startParameterDownload FTPManager::download returned failure";
-            (void) disconnect(ftpManager, &FTPManager::downloadComplete, this, &ParameterManager::_ftpDownloadComplete);
+            // Queued so that it waits for, or pauses, other FTP traffic such as log downloads instead of failing
+            FTPManager *const ftpManager = _vehicle->ftpManager();
+            _ftpDownloadPending = true;
+            (void) connect(ftpManager, &FTPManager::commandProgress, this, &ParameterManager::_ftpDownloadProgress);
+            ftpManager->queueDownload(FTPManager::Priority::Normal, this,
+                                      [this](const QString &fileName, const QString &errorMsg) { _ftpDownloadComplete(fileName, errorMsg); },
+                                      MAV_COMP_ID_AUTOPILOT1,
+                                      QStringLiteral("@PARAM/param.pck?withdefaults=1"),
+                                      QStandardPaths::writableLocation(QStandardPaths::TempLocation),
+                                      QStringLiteral("param.pck"),
+                                      false /* No filesize check */);
         }
     } else if (_vehicle->px4Firmware() && !_initialLoadComplete && !_hashCheckDone) {
         // PX4: Try _HASH_CHECK first to see if we can load from cache without a full parameter stream
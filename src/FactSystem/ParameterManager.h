@@ -221,4 +221,5 @@ private slots:
     Fact _defaultFact;   ///< Used to return default fact, when parameter not found
 
     bool _tryftp = false;
+    bool _ftpDownloadPending = false;   ///< Parameter file download is queued or running on the FTPManager
 };
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
 #include "ParameterMetaData.h"
 
 class PX4ParameterMetaData : public ParameterMetaData
@@ -12,5 +14,10 @@ class PX4ParameterMetaData : public ParameterMetaData
 
 protected:
     void parseParameterJson(const QJsonObject &json) override;
+    FactMetaData *_lookupMetaData(const QString &name, FactMetaData::ValueType_t type) override;
     void _postProcessMetaData(const QString &name, FactMetaData *metaData) override;
+
+private:
+    /// Parsed json for each parameter, FactMetaData is only built for a parameter when it is first requested
+    QHash<QString, QJsonObject> _rawParams;
 };
@@ -3,6 +3,7 @@
 #include "QGCCompression.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QRegularExpression>
@@ -37,6 +38,9 @@ void ParameterMetaData::loadParameterFactMetaDataFile(const QString &metaDataFil
 
     qCDebug(ParameterMetaDataLog) << "Loading parameter meta data:" << metaDataFile;
 
+    QElapsedTimer timer;
+    timer.start();
+
     QJsonDocument doc;
     QString errorString;
     if (!JsonParsing::isJsonFile(metaDataFile, doc, errorString)) {
@@ -50,6 +54,8 @@ void ParameterMetaData::loadParameterFactMetaDataFile(const QString &metaDataFil
 
     _parameterMetaDataLoaded = true;
     parseParameterJson(doc.object());
+
+    qCDebug(ParameterMetaDataLog) << "Parameter meta data indexed in" << timer.elapsed() << "ms:" << metaDataFile;
 }
 
 FactMetaData *ParameterMetaData::getMetaDataForFact(const QString &name, FactMetaData::ValueType_t type)
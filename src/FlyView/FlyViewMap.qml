@@ -70,6 +70,9 @@ FlightMap {
         QGroundControl.flightMapPosition = _root.center
     }
 
+    // ADS-B traffic outside the visible area is culled from the map
+    onVisibleRegionChanged: QGroundControl.adsbVehicleManager.setViewport(visibleRegion.boundingGeoRectangle())
+
     // We track whether the user has panned or not to correctly handle automatic map positioning
     onMapPanStart:  _disableVehicleTracking = true
     onMapPanStop:   panRecenterTimer.restart()
@@ -244,18 +247,20 @@ FlightMap {
         z:          QGroundControl.zOrderTrajectoryLines
         visible:    !pipMode
 
-        Connections {
-            target:                 QGroundControl.multiVehicleManager
-            function onActiveVehicleChanged(activeVehicle) {
-                trajectoryPolyline.path = _activeVehicle ? _activeVehicle.trajectoryPoints.list() : []
-            }
-        }
+        property var trajectoryPoints:  _activeVehicle ? _activeVehicle.trajectoryPoints : null
+        property int trajectoryLevel:   trajectoryPoints ? trajectoryPoints.levelForZoom(_root.zoomLevel, _root.center.latitude) : 0
+
+        function reloadPath() { path = trajectoryPoints ? trajectoryPoints.list(trajectoryLevel) : [] }
+
+        onTrajectoryPointsChanged:  reloadPath()
+        onTrajectoryLevelChanged:   reloadPath()
 
         Connections {
-            target:                             _activeVehicle ? _activeVehicle.trajectoryPoints : null
-            function onPointAdded(coordinate) { trajectoryPolyline.addCoordinate(coordinate) }
-            function onUpdateLastPoint(coordinate) { trajectoryPolyline.replaceCoordinate(trajectoryPolyline.pathLength() - 1, coordinate) }
-            function onPointsCleared() { trajectoryPolyline.path = [] }
+            target:                                     trajectoryPolyline.trajectoryPoints
+            function onPointAdded(level, coordinate)    { if (level === trajectoryPolyline.trajectoryLevel) trajectoryPolyline.addCoordinate(coordinate) }
+            function onUpdateLastPoint(level, coordinate) { if (level === trajectoryPolyline.trajectoryLevel) trajectoryPolyline.replaceCoordinate(trajectoryPolyline.pathLength() - 1, coordinate) }
+            function onPointsReset(level)               { if (level === trajectoryPolyline.trajectoryLevel) trajectoryPolyline.reloadPath() }
+            function onPointsCleared()                  { trajectoryPolyline.path = [] }
         }
     }
 
@@ -284,11 +289,11 @@ FlightMap {
     MapItemView {
         model: QGroundControl.adsbVehicleManager.adsbVehicles
         delegate: VehicleMapItem {
-            coordinate:     object.coordinate
-            altitude:       object.altitude
-            callsign:       object.callsign
-            heading:        object.heading
-            alert:          object.alert
+            coordinate:     model.coordinate
+            altitude:       model.altitude
+            callsign:       model.callsign
+            heading:        model.heading
+            alert:          model.alert || model.conflict
             map:            _root
             size:           pipMode ? ScreenTools.defaultFontPixelHeight : ScreenTools.defaultFontPixelHeight * 2.5
             z:              QGroundControl.zOrderVehicles
@@ -13,6 +13,10 @@ ColumnLayout {
         Layout.fillWidth: true
     }
 
+    TrafficThreats {
+        Layout.fillWidth: true
+    }
+
     // We use a Loader to load the photoVideoControlComponent only when we have an active vehicle and a camera manager.
     // This make it easier to implement PhotoVideoControl without having to check for the mavlink camera
     // to be null all over the place
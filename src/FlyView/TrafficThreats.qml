@@ -0,0 +1,70 @@
+import QtQuick
+import QtQuick.Layouts
+
+import QGroundControl
+import QGroundControl.Controls
+
+// ADS-B traffic in conflict with the own vehicles, most urgent first
+Rectangle {
+    implicitWidth:  mainLayout.width + (_margins * 2)
+    implicitHeight: mainLayout.height + (_margins * 2)
+    color:          qgcPal.window
+    border.color:   qgcPal.colorRed
+    border.width:   _margins / 2
+    radius:         ScreenTools.defaultBorderRadius
+    visible:        _threats.length > 0
+
+    property var    _threats:       QGroundControl.adsbVehicleManager.threats
+    property real   _margins:       ScreenTools.defaultFontPixelWidth / 2
+    property int    _maxShown:      3
+
+    function _distanceString(meters) {
+        return QGroundControl.unitsConversion.metersToAppSettingsHorizontalDistanceUnits(meters).toFixed(0) + " " + QGroundControl.unitsConversion.appSettingsHorizontalDistanceUnitsString
+    }
+
+    QGCPalette { id: qgcPal }
+
+    ColumnLayout {
+        id:                 mainLayout
+        anchors.margins:    _margins
+        anchors.top:        parent.top
+        anchors.left:       parent.left
+        spacing:            _margins
+
+        QGCLabel {
+            Layout.alignment:   Qt.AlignHCenter
+            text:               qsTr("Traffic Conflicts (%1)").arg(_threats.length)
+            font.pointSize:     ScreenTools.smallFontPointSize
+            font.bold:          true
+        }
+
+        GridLayout {
+            columns:        3
+            columnSpacing:  ScreenTools.defaultFontPixelWidth
+            rowSpacing:     0
+
+            Repeater {
+                model: Math.min(_threats.length, _maxShown) * 3
+
+                QGCLabel {
+                    property var _threat:   _threats[Math.floor(index / 3)]
+                    property int _column:   index % 3
+
+                    Layout.alignment:   _column === 0 ? Qt.AlignLeft : Qt.AlignRight
+                    font.pointSize:     ScreenTools.smallFontPointSize
+                    color:              _threat.tcpa < 15 ? qgcPal.colorRed : qgcPal.text
+                    text: {
+                        switch (_column) {
+                        case 0:
+                            return _threat.callsign !== "" ? _threat.callsign : _threat.icaoAddress.toString(16).toUpperCase()
+                        case 1:
+                            return _distanceString(_threat.distance)
+                        default:
+                            return qsTr("CPA %1 in %2 s").arg(_distanceString(_threat.cpaDistance)).arg(_threat.tcpa.toFixed(0))
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -1,6 +1,5 @@
 #include "GPSProvider.h"
 #include "QGCLoggingCategory.h"
-#include "RTCMMavlink.h"
 
 #include <ashtech.h>
 #include <base_station.h>
@@ -246,14 +245,14 @@ GPSBaseStationSupport *GPSProvider::_connectGPS()
 
 void GPSProvider::_sendRTCMData()
 {
-    RTCMMavlink *const rtcm = new RTCMMavlink(this);
-
+    // This thread has no event loop, so the corrections go through the signal to the RTCMMavlink owned by
+    // GPSRtk on the main thread, where its pacing timers run
     const int fakeMsgLengths[3] = { 30, 170, 240 };
     const uint8_t* const fakeData = new uint8_t[fakeMsgLengths[2]];
     while (!_requestStop) {
         for (int i = 0; i < 3; ++i) {
             const QByteArray message(reinterpret_cast<const char*>(fakeData), fakeMsgLengths[i]);
-            rtcm->RTCMDataUpdate(message);
+            emit RTCMDataUpdate(message);
             msleep(4);
         }
         msleep(100);
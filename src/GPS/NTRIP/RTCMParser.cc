@@ -1,5 +1,20 @@
 #include "RTCMParser.h"
 
+namespace {
+
+/// Big endian bit field starting bitOffset bits into data, count at most 32
+uint32_t readBits(const uint8_t* data, size_t bitOffset, int count)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < count; i++) {
+        const size_t bit = bitOffset + i;
+        value = (value << 1) | ((data[bit / 8] >> (7 - (bit % 8))) & 0x01);
+    }
+    return value;
+}
+
+} // namespace
+
 RTCMParser::RTCMParser()
 {
     reset();
@@ -95,3 +110,67 @@ bool RTCMParser::validateCrc() const
                                static_cast<uint32_t>(_crcBytes[2]);
     return computed == received;
 }
+
+RTCMParser::MessageClass RTCMParser::messageClass(uint16_t messageId)
+{
+    // GPS and GLONASS legacy observations
+    if ((messageId >= 1001 && messageId <= 1004) || (messageId >= 1009 && messageId <= 1012)) {
+        return Observation;
+    }
+
+    // MSM1-7 for GPS, GLONASS, Galileo, SBAS, QZSS, BeiDou and NavIC
+    if (messageId >= 1071 && messageId <= 1137 && (messageId % 10) >= 1 && (messageId % 10) <= 7) {
+        return Observation;
+    }
+
+    switch (messageId) {
+    case 1005:
+    case 1006:
+    case 1007:
+    case 1008:
+    case 1033:
+    case 1230:
+        return StationInfo;
+    case 1019:
+    case 1020:
+    case 1041:
+    case 1042:
+    case 1044:
+    case 1045:
+    case 1046:
+        return Ephemeris;
+    default:
+        return Other;
+    }
+}
+
+uint16_t RTCMParser::frameMessageId(const uint8_t* frame, size_t len)
+{
+    if (len < kHeaderSize + 2 || frame[0] != RTCM3_PREAMBLE) {
+        return 0;
+    }
+    return ((frame[3] << 4) | (frame[4] >> 4)) & 0xFFF;
+}
+
+bool RTCMParser::frameObservationHeader(const uint8_t* frame, size_t len, ObservationHeader& header)
+{
+    const uint16_t messageId = frameMessageId(frame, len);
+    if (messageClass(messageId) != Observation) {
+        return false;
+    }
+
+    // Message number and reference station id take 24 bits, the epoch time follows. GLONASS legacy
+    // observations send the 27 bit time of day, all others 30 bits. The flag follows the epoch time.
+    static constexpr size_t kEpochOffset = 24;
+    const bool glonassLegacy = (messageId >= 1009) && (messageId <= 1012);
+    const int epochBits = glonassLegacy ? 27 : 30;
+    if (len < kHeaderSize + ((kEpochOffset + epochBits + 1 + 7) / 8)) {
+        return false;
+    }
+
+    const uint8_t* const payload = frame + kHeaderSize;
+    header.epoch = readBits(payload, kEpochOffset, epochBits);
+    header.epochBits = static_cast<uint8_t>(epochBits);
+    header.multipleMessage = readBits(payload, kEpochOffset + epochBits, 1) != 0;
+    return true;
+}
@@ -20,6 +20,29 @@ class RTCMParser
     bool validateCrc() const;
     static uint32_t crc24q(const uint8_t* data, size_t len);
 
+    /// How time critical a message is for an RTK rover
+    enum MessageClass {
+        Observation,    ///< Legacy and MSM observations, only useful for the current epoch
+        StationInfo,    ///< Reference station position, antenna and receiver description, GLONASS biases
+        Ephemeris,      ///< Satellite orbits, valid for hours
+        Other
+    };
+
+    static MessageClass messageClass(uint16_t messageId);
+
+    /// Message id of a complete frame, 0 if the frame is too short or does not start with the preamble
+    static uint16_t frameMessageId(const uint8_t* frame, size_t len);
+
+    struct ObservationHeader {
+        uint32_t epoch = 0;             ///< Epoch time field as sent, wraps at 1 << epochBits
+        uint8_t epochBits = 0;
+        bool multipleMessage = false;   ///< More messages with this id follow for the same epoch
+    };
+
+    /// Reads the epoch time and the multiple message (legacy: synchronous GNSS) flag of an observation frame
+    /// @return false if the frame is not a legacy or MSM observation or is too short
+    static bool frameObservationHeader(const uint8_t* frame, size_t len, ObservationHeader& header);
+
 private:
     enum State {
         WaitingForPreamble,
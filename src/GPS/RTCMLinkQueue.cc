@@ -0,0 +1,178 @@
+#include "RTCMLinkQueue.h"
+#include "MAVLinkLib.h"
+#include "QGCLoggingCategory.h"
+#include "RTCMParser.h"
+
+#include <algorithm>
+#include <iterator>
+
+QGC_LOGGING_CATEGORY(RTCMLinkQueueLog, "GPS.RTCMLinkQueue")
+
+namespace {
+
+constexpr qsizetype kMaxFrameLength = 3 + 1023 + RTCMParser::kCrcSize; ///< Header, largest payload and CRC
+
+} // namespace
+
+RTCMLinkQueue::RTCMLinkQueue(qint64 bytesPerSecond)
+    : _bytesPerSecond(bytesPerSecond)
+{
+}
+
+void RTCMLinkQueue::setBytesPerSecond(qint64 bytesPerSecond)
+{
+    _bytesPerSecond = bytesPerSecond;
+    _tokens = 0.;
+    _refillStarted = false;
+}
+
+void RTCMLinkQueue::enqueue(const QByteArray &data, uint8_t sequenceId, qint64 nowMs)
+{
+    const uint16_t messageId = RTCMParser::frameMessageId(reinterpret_cast<const uint8_t*>(data.constData()), static_cast<size_t>(data.size()));
+
+    Priority priority = LowPriority;
+    switch (RTCMParser::messageClass(messageId)) {
+    case RTCMParser::Observation:
+        priority = HighPriority;
+        break;
+    case RTCMParser::StationInfo:
+        priority = NormalPriority;
+        break;
+    default:
+        break;
+    }
+
+    Message message{data, messageId, sequenceId, nowMs};
+    RTCMParser::ObservationHeader observation;
+    if (RTCMParser::frameObservationHeader(reinterpret_cast<const uint8_t*>(data.constData()), static_cast<size_t>(data.size()), observation)) {
+        message.epoch = observation.epoch;
+        message.epochBits = observation.epochBits;
+        message.multipleMessage = observation.multipleMessage;
+    }
+
+    QList<Message> &queue = _queues[priority];
+
+    // A newer epoch or station description makes a waiting one worthless. Ephemerides share one message id
+    // across satellites so they are never replaced.
+    if ((priority != LowPriority) && (messageId != 0)) {
+        const auto superseded = [&message](const Message &queued) {
+            return (queued.messageId == message.messageId) && _supersedes(message, queued);
+        };
+        const auto first = std::find_if(queue.cbegin(), queue.cend(), superseded);
+        if (first != queue.cend()) {
+            // The newer message takes the place of the oldest one it replaces
+            const qsizetype index = std::distance(queue.cbegin(), first);
+            const qsizetype count = queue.removeIf(superseded);
+            qCDebug(RTCMLinkQueueLog) << "Superseded" << count << "RTCM" << messageId;
+            _droppedCount += count;
+            queue.insert(index, std::move(message));
+            return;
+        }
+    }
+
+    queue.append(std::move(message));
+}
+
+bool RTCMLinkQueue::_supersedes(const Message &message, const Message &queued)
+{
+    if ((message.epochBits == 0) || (queued.epochBits == 0)) {
+        // Station description, or an observation whose epoch could not be read
+        return true;
+    }
+
+    if (message.epoch == queued.epoch) {
+        // Another message of the same epoch, unless the queued one said it was the last
+        return !queued.multipleMessage;
+    }
+
+    // Epoch times wrap at the end of the week or day, newer is less than half the range ahead
+    const uint32_t mask = (1U << message.epochBits) - 1;
+    const uint32_t ahead = (message.epoch - queued.epoch) & mask;
+    return ahead < (1U << (message.epochBits - 1));
+}
+
+void RTCMLinkQueue::takeReady(qint64 nowMs, QList<Message> &ready)
+{
+    _dropStale(nowMs);
+
+    if (_bytesPerSecond <= 0) {
+        for (QList<Message> &queue : _queues) {
+            ready.append(queue);
+            queue.clear();
+        }
+        return;
+    }
+
+    _refill(nowMs);
+
+    // Strict priority, lower priorities wait until the more time critical messages are out
+    for (QList<Message> &queue : _queues) {
+        qsizetype taken = 0;
+        while (taken < queue.count()) {
+            const qsizetype size = wireSize(queue[taken].data.size());
+            if (_tokens < size) {
+                break;
+            }
+            _tokens -= size;
+            ready.append(std::move(queue[taken]));
+            taken++;
+        }
+        queue.remove(0, taken);
+
+        if (!queue.isEmpty()) {
+            break;
+        }
+    }
+}
+
+bool RTCMLinkQueue::isEmpty() const
+{
+    for (const QList<Message> &queue : _queues) {
+        if (!queue.isEmpty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+qsizetype RTCMLinkQueue::wireSize(qsizetype rtcmLength)
+{
+    static constexpr qsizetype maxFragmentLength = MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN;
+    static constexpr qsizetype fragmentOverhead = MAVLINK_NUM_NON_PAYLOAD_BYTES + 2; // flags and len fields
+
+    const qsizetype fragments = qMax<qsizetype>(1, (rtcmLength + maxFragmentLength - 1) / maxFragmentLength);
+    return rtcmLength + (fragments * fragmentOverhead);
+}
+
+void RTCMLinkQueue::_refill(qint64 nowMs)
+{
+    // Deep enough for a full size message even on slow links, otherwise it would never fit
+    const double capacity = qMax(static_cast<double>(_bytesPerSecond * kBurstMs) / 1000., static_cast<double>(wireSize(kMaxFrameLength)));
+
+    if (!_refillStarted) {
+        _tokens = capacity;
+        _lastRefillMs = nowMs;
+        _refillStarted = true;
+        return;
+    }
+
+    const qint64 elapsedMs = nowMs - _lastRefillMs;
+    _lastRefillMs = nowMs;
+    _tokens = qMin(capacity, _tokens + (static_cast<double>(_bytesPerSecond * elapsedMs) / 1000.));
+}
+
+void RTCMLinkQueue::_dropStale(qint64 nowMs)
+{
+    for (qsizetype priority = 0; priority < PriorityCount; priority++) {
+        QList<Message> &queue = _queues[priority];
+        const qint64 maxAgeMs = (priority == HighPriority) ? kMaxObservationAgeMs : kMaxAgeMs;
+
+        const qsizetype staleCount = queue.removeIf([nowMs, maxAgeMs](const Message &message) {
+            return (nowMs - message.queuedMs) > maxAgeMs;
+        });
+        if (staleCount > 0) {
+            qCDebug(RTCMLinkQueueLog) << "Dropped" << staleCount << "stale RTCM messages";
+        }
+        _droppedCount += staleCount;
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+
+#include <array>
+
+/// Outgoing RTCM corrections for one link.
+///
+/// Messages wait in one queue per priority: observations first, then station information, then
+/// ephemerides and everything else. A token bucket paces them to the link budget, and when the link
+/// falls behind a newer station message replaces the older one with the same message id. Observations of
+/// one epoch can span several messages with the same id, so they are only replaced by a newer epoch.
+/// Messages which wait longer than they stay useful to the rover are dropped.
+class RTCMLinkQueue
+{
+public:
+    struct Message {
+        QByteArray data;
+        uint16_t messageId = 0;
+        uint8_t sequenceId = 0;
+        qint64 queuedMs = 0;
+        uint32_t epoch = 0;             ///< Observation epoch time, see RTCMParser::ObservationHeader
+        uint8_t epochBits = 0;          ///< 0 if the message carries no epoch
+        bool multipleMessage = false;
+    };
+
+    /// @param bytesPerSecond Link budget for corrections on the wire, 0 for unlimited
+    explicit RTCMLinkQueue(qint64 bytesPerSecond = 0);
+
+    void setBytesPerSecond(qint64 bytesPerSecond);
+    qint64 bytesPerSecond() const { return _bytesPerSecond; }
+
+    void enqueue(const QByteArray &data, uint8_t sequenceId, qint64 nowMs);
+
+    /// Appends the messages which fit the budget at nowMs to ready, most time critical first
+    void takeReady(qint64 nowMs, QList<Message> &ready);
+
+    bool isEmpty() const;
+
+    /// Messages dropped because they went stale or were superseded
+    quint64 droppedCount() const { return _droppedCount; }
+
+    /// Bytes on the wire for an RTCM message of rtcmLength bytes, including the GPS_RTCM_DATA fragments' framing
+    static qsizetype wireSize(qsizetype rtcmLength);
+
+    static constexpr qint64 kMaxObservationAgeMs = 2000;    ///< Older observations no longer help the RTK solution
+    static constexpr qint64 kMaxAgeMs = 10000;
+    static constexpr qint64 kBurstMs = 250;                 ///< Token bucket depth
+
+private:
+    enum Priority {
+        HighPriority,
+        NormalPriority,
+        LowPriority,
+        PriorityCount
+    };
+
+    void _refill(qint64 nowMs);
+    void _dropStale(qint64 nowMs);
+    /// @return true if queued is worthless once message, which has the same message id, is queued
+    static bool _supersedes(const Message &message, const Message &queued);
+
+    std::array<QList<Message>, PriorityCount> _queues;
+    qint64 _bytesPerSecond = 0;
+    double _tokens = 0.;
+    qint64 _lastRefillMs = 0;
+    bool _refillStarted = false;
+    quint64 _droppedCount = 0;
+};
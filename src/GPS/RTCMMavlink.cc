@@ -1,19 +1,32 @@
 #include "QmlObjectListModel.h"
 #include "RTCMMavlink.h"
+#include "LinkConfiguration.h"
 #include "MAVLinkProtocol.h"
 #include "MultiVehicleManager.h"
 #include "QGCLoggingCategory.h"
+#include "SerialLink.h"
 #include "Vehicle.h"
 #include "VehicleLinkManager.h"
 
+#include <QtCore/QTimer>
+
 QGC_LOGGING_CATEGORY(RTCMMavlinkLog, "GPS.RTCMMavlink")
 
 RTCMMavlink::RTCMMavlink(QObject *parent)
     : QObject(parent)
+    , _serviceTimer(new QTimer(this))
+    , _statisticsTimer(new QTimer(this))
 {
     // qCDebug(RTCMMavlinkLog) << Q_FUNC_INFO << this;
 
-    _bandwidthTimer.start();
+    _clock.start();
+
+    // Only runs while a paced link has corrections waiting
+    _serviceTimer->setInterval(kServiceIntervalMs);
+    (void) connect(_serviceTimer, &QTimer::timeout, this, &RTCMMavlink::_service);
+
+    _statisticsTimer->setInterval(kStatisticsIntervalMs);
+    (void) connect(_statisticsTimer, &QTimer::timeout, this, &RTCMMavlink::_updateStatistics);
 }
 
 RTCMMavlink::~RTCMMavlink()
@@ -21,71 +34,223 @@ RTCMMavlink::~RTCMMavlink()
     // qCDebug(RTCMMavlinkLog) << Q_FUNC_INFO << this;
 }
 
+QList<RTCMMavlink::LinkStatistics> RTCMMavlink::linkStatistics() const
+{
+    const qint64 nowMs = _clock.elapsed();
+
+    QList<LinkStatistics> statistics;
+    for (const LinkState &state : _links) {
+        const SharedLinkInterfacePtr link = state.link.lock();
+        if (!link) {
+            continue;
+        }
+
+        LinkStatistics linkStatistics;
+        linkStatistics.name = link->linkConfiguration()->name();
+        linkStatistics.correctionAgeMs = (state.lastQueuedMs >= 0) ? (nowMs - state.lastQueuedMs) : -1;
+        linkStatistics.bytesPerSecond = state.bytesPerSecond;
+        linkStatistics.droppedCount = state.queue.droppedCount();
+        statistics.append(linkStatistics);
+    }
+    return statistics;
+}
+
 void RTCMMavlink::RTCMDataUpdate(QByteArrayView data)
 {
-    _calculateBandwith(data.size());
+    if (data.isEmpty()) {
+        return;
+    }
+
+    _updateLinks();
+
+    const QByteArray message = data.toByteArray();
+    const qint64 nowMs = _clock.elapsed();
+    for (LinkState &state : _links) {
+        state.queue.enqueue(message, _sequenceId, nowMs);
+    }
+
+    ++_sequenceId;
+
+    _service();
+
+    if (!_statisticsTimer->isActive()) {
+        _statisticsWindowStartMs = nowMs;
+        _statisticsTimer->start();
+    }
+}
+
+void RTCMMavlink::_updateLinks()
+{
+    for (LinkState &state : _links) {
+        state.vehicle = nullptr;
+    }
+
+    // Vehicles sharing a radio share its primary link, corrections only need to go out once per link
+    QmlObjectListModel* const vehicles = MultiVehicleManager::instance()->vehicles();
+    for (qsizetype i = 0; i < vehicles->count(); i++) {
+        Vehicle* const vehicle = qobject_cast<Vehicle*>(vehicles->get(i));
+        const SharedLinkInterfacePtr sharedLink = vehicle->vehicleLinkManager()->primaryLink().lock();
+        if (!sharedLink) {
+            continue;
+        }
+
+        auto it = _links.find(sharedLink.get());
+        if ((it != _links.end()) && (it->link.lock() != sharedLink)) {
+            // A deleted link's address was reused by a new one, its queue and statistics don't carry over
+            (void) _links.erase(it);
+            it = _links.end();
+        }
+        if (it == _links.end()) {
+            it = _links.insert(sharedLink.get(), LinkState{});
+            it->link = sharedLink;
+            it->queue.setBytesPerSecond(_linkBytesPerSecond(sharedLink.get()));
+            qCDebug(RTCMMavlinkLog) << "Sending corrections on" << sharedLink->linkConfiguration()->name()
+                                    << "budget" << it->queue.bytesPerSecond() << "B/s";
+        } else {
+            // The outbound budget can be changed while the link is up
+            const qint64 bytesPerSecond = _linkBytesPerSecond(sharedLink.get());
+            if (bytesPerSecond != it->queue.bytesPerSecond()) {
+                it->queue.setBytesPerSecond(bytesPerSecond);
+            }
+        }
+        if (!it->vehicle) {
+            it->vehicle = vehicle;
+        }
+    }
+
+    // Forget links which no vehicle uses as primary link anymore
+    for (auto it = _links.begin(); it != _links.end();) {
+        if (!it->vehicle || it->link.expired()) {
+            it = _links.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void RTCMMavlink::_service()
+{
+    const qint64 nowMs = _clock.elapsed();
+
+    bool backlog = false;
+    for (LinkState &state : _links) {
+        const SharedLinkInterfacePtr link = state.link.lock();
+        if (!link || !state.vehicle) {
+            continue;
+        }
 
+        _ready.clear();
+        state.queue.takeReady(nowMs, _ready);
+        for (const RTCMLinkQueue::Message &message : std::as_const(_ready)) {
+            _sendMessage(state, link.get(), message);
+        }
+
+        backlog |= !state.queue.isEmpty();
+    }
+
+    if (backlog && !_serviceTimer->isActive()) {
+        _serviceTimer->start();
+    } else if (!backlog) {
+        _serviceTimer->stop();
+    }
+}
+
+void RTCMMavlink::_sendMessage(LinkState &state, LinkInterface *link, const RTCMLinkQueue::Message &message)
+{
     mavlink_gps_rtcm_data_t gpsRtcmData{};
+    mavlink_message_t mavlinkMessage;
+
+    const auto send = [&]() {
+        (void) mavlink_msg_gps_rtcm_data_encode_chan(
+            MAVLinkProtocol::instance()->getSystemId(),
+            MAVLinkProtocol::getComponentId(),
+            link->mavlinkChannel(),
+            &mavlinkMessage,
+            &gpsRtcmData
+        );
+        (void) state.vehicle->sendMessageOnLinkThreadSafe(link, mavlinkMessage);
+    };
+
+    const QByteArray &data = message.data;
 
     static constexpr qsizetype maxMessageLength = MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN;
     if (data.size() < maxMessageLength) {
         gpsRtcmData.len = data.size();
-        gpsRtcmData.flags = (_sequenceId & 0x1FU) << 3;
-        (void) memcpy(&gpsRtcmData.data, data.data(), data.size());
-        _sendMessageToVehicle(gpsRtcmData);
+        gpsRtcmData.flags = (message.sequenceId & 0x1FU) << 3;
+        (void) memcpy(&gpsRtcmData.data, data.constData(), data.size());
+        send();
     } else {
         uint8_t fragmentId = 0;
         qsizetype start = 0;
         while (start < data.size()) {
             gpsRtcmData.flags = 0x01U; // LSB set indicates message is fragmented
             gpsRtcmData.flags |= fragmentId++ << 1; // Next 2 bits are fragment id
-            gpsRtcmData.flags |= (_sequenceId & 0x1FU) << 3; // Next 5 bits are sequence id
+            gpsRtcmData.flags |= (message.sequenceId & 0x1FU) << 3; // Next 5 bits are sequence id
 
             const qsizetype length = std::min(data.size() - start, maxMessageLength);
             gpsRtcmData.len = length;
 
             (void) memcpy(gpsRtcmData.data, data.constData() + start, length);
-            _sendMessageToVehicle(gpsRtcmData);
+            send();
 
             start += length;
         }
     }
 
-    ++_sequenceId;
+    state.windowBytes += RTCMLinkQueue::wireSize(data.size());
+    state.lastQueuedMs = qMax(state.lastQueuedMs, message.queuedMs);
 }
 
-void RTCMMavlink::_sendMessageToVehicle(const mavlink_gps_rtcm_data_t &data)
+void RTCMMavlink::_updateStatistics()
 {
-    QmlObjectListModel* const vehicles = MultiVehicleManager::instance()->vehicles();
-    for (qsizetype i = 0; i < vehicles->count(); i++) {
-        Vehicle* const vehicle = qobject_cast<Vehicle*>(vehicles->get(i));
-        const SharedLinkInterfacePtr sharedLink = vehicle->vehicleLinkManager()->primaryLink().lock();
-        if (sharedLink) {
-            mavlink_message_t message;
-            (void) mavlink_msg_gps_rtcm_data_encode_chan(
-                MAVLinkProtocol::instance()->getSystemId(),
-                MAVLinkProtocol::getComponentId(),
-                sharedLink->mavlinkChannel(),
-                &message,
-                &data
-            );
-            (void) vehicle->sendMessageOnLinkThreadSafe(sharedLink.get(), message);
+    const qint64 nowMs = _clock.elapsed();
+    const qint64 windowMs = qMax<qint64>(1, nowMs - _statisticsWindowStartMs);
+    _statisticsWindowStartMs = nowMs;
+
+    for (LinkState &state : _links) {
+        state.bytesPerSecond = (state.windowBytes * 1000.) / windowMs;
+        state.windowBytes = 0;
+    }
+
+    if (RTCMMavlinkLog().isDebugEnabled()) {
+        for (const LinkStatistics &statistics : linkStatistics()) {
+            qCDebug(RTCMMavlinkLog) << statistics.name
+                                    << QStringLiteral("RTCM %1 kB/s, age %2 ms, dropped %3")
+                                        .arg(statistics.bytesPerSecond / 1024., 0, 'f', 2)
+                                        .arg(statistics.correctionAgeMs)
+                                        .arg(statistics.droppedCount);
         }
     }
+
+    emit linkStatisticsChanged();
+
+    if (_links.isEmpty()) {
+        _statisticsTimer->stop();
+    }
 }
 
-void RTCMMavlink::_calculateBandwith(qsizetype bytes)
+qint64 RTCMMavlink::_linkBytesPerSecond(const LinkInterface *link)
 {
-    if (!_bandwidthTimer.isValid()) {
-        return;
+    const SharedLinkConfigurationPtr config = link->linkConfiguration();
+    if (!config) {
+        return 0;
     }
 
-    _bandwidthByteCounter += bytes;
+    qint64 bytesPerSecond = 0;
+    if (config->type() == LinkConfiguration::TypeSerial) {
+        const SerialConfiguration *const serialConfig = qobject_cast<const SerialConfiguration*>(config.get());
+        if (serialConfig && (serialConfig->baud() > 0)) {
+            // 8N1 framing puts ten bits on the wire per byte
+            bytesPerSecond = serialConfig->baud() / 10;
+        }
+    }
 
-    const qint64 elapsed = _bandwidthTimer.elapsed();
-    if (elapsed > 1000) {
-        qCDebug(RTCMMavlinkLog) << QStringLiteral("RTCM bandwidth: %1 kB/s").arg(((_bandwidthByteCounter / elapsed) * 1000.f) / 1024.f);
-        (void) _bandwidthTimer.restart();
-        _bandwidthByteCounter = 0;
+    // A shaped link can be slower than its serial port, and network links are only limited by their shaping
+    const qint64 outboundBytesPerSecond = config->outboundBytesPerSecond();
+    if ((outboundBytesPerSecond > 0) && ((bytesPerSecond <= 0) || (outboundBytesPerSecond < bytesPerSecond))) {
+        bytesPerSecond = outboundBytesPerSecond;
     }
+
+    // Unlimited links send corrections as they arrive
+    return static_cast<qint64>(bytesPerSecond * kLinkShare);
 }
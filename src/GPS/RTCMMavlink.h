@@ -1,26 +1,75 @@
 #pragma once
 
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QList>
 #include <QtCore/QObject>
+#include <QtCore/QPointer>
 
-typedef struct __mavlink_gps_rtcm_data_t mavlink_gps_rtcm_data_t;
+#include "LinkInterface.h"
+#include "RTCMLinkQueue.h"
 
+class QTimer;
+class Vehicle;
+
+/// Forwards RTCM corrections to the vehicles as GPS_RTCM_DATA.
+///
+/// GPS_RTCM_DATA carries no target ids, so each correction is sent once per link no matter how many vehicles
+/// share it. Every link has its own RTCMLinkQueue which paces corrections to their share of a serial link's
+/// capacity or of the link's outbound budget, and prefers observations when the link cannot keep up.
 class RTCMMavlink : public QObject
 {
     Q_OBJECT
 
 public:
+    struct LinkStatistics {
+        QString name;
+        qint64 correctionAgeMs = -1;    ///< Time since the newest correction sent on the link arrived, -1 before the first
+        double bytesPerSecond = 0.;     ///< Corrections sent on the wire, averaged over the last second
+        quint64 droppedCount = 0;
+    };
+
     RTCMMavlink(QObject *parent = nullptr);
     ~RTCMMavlink();
 
+    QList<LinkStatistics> linkStatistics() const;
+
+    /// Share of a link's capacity given to corrections, the rest is left for telemetry. Matches the share the
+    /// link's outbound scheduler lets corrections use without waiting.
+    static constexpr double kLinkShare = LinkOutboundScheduler::kCorrectionShare;
+
+signals:
+    void linkStatisticsChanged();
+
 public slots:
     void RTCMDataUpdate(QByteArrayView data);
 
+private slots:
+    void _service();
+    void _updateStatistics();
+
 private:
-    void _calculateBandwith(qsizetype bytes);
-    static void _sendMessageToVehicle(const mavlink_gps_rtcm_data_t &data);
+    struct LinkState {
+        WeakLinkInterfacePtr link;
+        QPointer<Vehicle> vehicle;      ///< Any vehicle on the link, used to send
+        RTCMLinkQueue queue;
+        qint64 lastQueuedMs = -1;       ///< Queue time of the newest correction sent
+        qsizetype windowBytes = 0;
+        double bytesPerSecond = 0.;
+    };
+
+    void _updateLinks();
+    void _sendMessage(LinkState &state, LinkInterface *link, const RTCMLinkQueue::Message &message);
+    static qint64 _linkBytesPerSecond(const LinkInterface *link);
 
     uint8_t _sequenceId = 0;
-    qsizetype _bandwidthByteCounter = 0;
-    QElapsedTimer _bandwidthTimer;
+    QHash<const LinkInterface*, LinkState> _links;   ///< Entries are checked against LinkState::link, the address can be reused
+    QList<RTCMLinkQueue::Message> _ready;
+    QElapsedTimer _clock;
+    qint64 _statisticsWindowStartMs = 0;
+    QTimer *_serviceTimer = nullptr;
+    QTimer *_statisticsTimer = nullptr;
+
+    static constexpr int kServiceIntervalMs = 20;
+    static constexpr int kStatisticsIntervalMs = 1000;
 };
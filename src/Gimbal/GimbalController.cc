@@ -644,7 +644,7 @@ void GimbalController::_sendGimbalAttitudeRates(float pitch_rate_deg_s,
         qDegreesToRadians(yaw_rate_deg_s)
     );
 
-    _vehicle->sendMessageOnLinkThreadSafe(sharedLink.get(), msg);
+    _vehicle->sendControlMessageOnLinkThreadSafe(sharedLink.get(), msg, {}, static_cast<uint8_t>(_activeGimbal->deviceId()->rawValue().toUInt()));
 }
 
 void GimbalController::_rateSenderTimeout()
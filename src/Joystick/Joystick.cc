@@ -16,6 +16,8 @@
 
 #include <QtCore/QCoreApplication>
 #include <algorithm>
+#include <cmath>
+#include <QtCore/QDeadlineTimer>
 #include <QtCore/QSettings>
 #include <QtCore/QThread>
 
@@ -108,6 +110,16 @@ Joystick::Joystick(const QString &name, int axisCount, int buttonCount, int hatC
         ensureFactThread(_joystickSettings.enableManualControlAux6());
     }
 
+    _axisFrequencyHz = _joystickSettings.axisFrequencyHz()->rawValue().toDouble();
+    _buttonFrequencyHz = _joystickSettings.buttonFrequencyHz()->rawValue().toDouble();
+    connect(_joystickSettings.axisFrequencyHz(), &Fact::rawValueChanged, this, [this](const QVariant &value) {
+        _axisFrequencyHz = value.toDouble();
+        _wakeThread();
+    });
+    connect(_joystickSettings.buttonFrequencyHz(), &Fact::rawValueChanged, this, [this](const QVariant &value) {
+        _buttonFrequencyHz = value.toDouble();
+    });
+
     // Changes to manual control extension settings require re-calibration
     connect(_joystickSettings.enableManualControlPitchExtension(), &Fact::rawValueChanged, this, [this]() {
         _joystickSettings.calibrated()->setRawValue(false);
@@ -147,6 +159,7 @@ Joystick::Joystick(const QString &name, int axisCount, int buttonCount, int hatC
 Joystick::~Joystick()
 {
     _exitThread = true;
+    _wakeThread();
     if (isRunning()) {
         if (QThread::currentThread() == this) {
             qCWarning(JoystickLog) << "Skipping wait() on joystick thread";
@@ -632,35 +645,73 @@ void Joystick::run()
     }
 
     if (!openFailed) {
-        _axisElapsedTimer.start();
-
         for (int buttonIndex = 0; buttonIndex < _totalButtonCount; buttonIndex++) {
             if (_assignedButtonActions[buttonIndex]) {
                 _assignedButtonActions[buttonIndex]->buttonElapsedTimer.start();
             }
         }
 
+        resetSendIntervalStats();
+
+        // Axis sends are scheduled on absolute deadlines so the period does not stretch by the time spent
+        // polling and sending, and oversleeping one cycle is absorbed by the next instead of accumulating.
+        double scheduledAxisHz = 0.;
+        Clock::duration axisPeriod{};
+        Clock::time_point nextAxisDeadline = Clock::now();
+        Clock::time_point lastAxisSend{};
+
         while (!_exitThread) {
             if (!_update()) {
                 qCWarning(JoystickLog) << "Joystick disconnected or update failed:" << _name;
                 updateFailed = true;
                 break;
             }
+            _sampleTime = Clock::now();
 
             _handleButtons();
 
-            if (axisCount() != 0) {
-                _handleAxis();
+            Clock::time_point now = Clock::now();
+
+            const double axisHz = _axisFrequencyHz;
+            if (axisHz != scheduledAxisHz) {
+                scheduledAxisHz = axisHz;
+                axisPeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / axisHz));
+                nextAxisDeadline = now;
+                lastAxisSend = {};
             }
 
-            const double axisFrequencyHz = _joystickSettings.axisFrequencyHz()->rawValue().toDouble();
-            const double buttonFrequencyHz = _joystickSettings.buttonFrequencyHz()->rawValue().toDouble();
+            Clock::time_point wakeTime = now + kButtonPollInterval;
+            if (axisCount() != 0) {
+                if (now >= nextAxisDeadline) {
+                    _handleAxis();
+
+                    if (lastAxisSend != Clock::time_point{}) {
+                        _recordSendInterval(now - lastAxisSend, now - nextAxisDeadline, axisPeriod);
+                    }
+                    lastAxisSend = now;
+
+                    nextAxisDeadline += axisPeriod;
+                    now = Clock::now();
+                    if (nextAxisDeadline <= now) {
+                        // More than a period behind, resync instead of sending a burst to catch up
+                        nextAxisDeadline = now + axisPeriod;
+                    }
+                }
+                wakeTime = std::min(wakeTime, nextAxisDeadline);
+            }
 
-            const int sleep = qMin(static_cast<int>(1000.0 / axisFrequencyHz), static_cast<int>(1000.0 / buttonFrequencyHz)) / 2;
-            QThread::msleep(sleep);
+            _waitUntil(wakeTime);
         }
 
         _close();
+
+        const SendIntervalStats stats = sendIntervalStats();
+        if (stats.count > 0) {
+            qCDebug(JoystickLog) << _name << "axis send interval target" << stats.targetMs << "ms"
+                                 << "mean" << stats.meanMs << "min" << stats.minMs << "max" << stats.maxMs
+                                 << "jitter" << stats.jitterMs << "max lateness" << stats.maxLatenessMs
+                                 << "over" << stats.count << "sends";
+        }
     }
 
     if ((openFailed || updateFailed) && !_exitThread) {
@@ -669,6 +720,64 @@ void Joystick::run()
     }
 }
 
+void Joystick::_waitUntil(Clock::time_point deadline)
+{
+    QMutexLocker locker(&_wakeMutex);
+
+    if (!_wakeRequested && !_exitThread) {
+        (void) _wakeCondition.wait(&_wakeMutex, QDeadlineTimer(deadline, Qt::PreciseTimer));
+    }
+    _wakeRequested = false;
+}
+
+void Joystick::_wakeThread()
+{
+    QMutexLocker locker(&_wakeMutex);
+
+    _wakeRequested = true;
+    _wakeCondition.wakeAll();
+}
+
+void Joystick::_recordSendInterval(Clock::duration interval, Clock::duration lateness, Clock::duration period)
+{
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    const double intervalMs = std::chrono::duration_cast<Milliseconds>(interval).count();
+    const double latenessMs = std::chrono::duration_cast<Milliseconds>(lateness).count();
+
+    QMutexLocker locker(&_sendIntervalMutex);
+
+    SendIntervalStats &stats = _sendIntervalStats;
+    stats.targetMs = std::chrono::duration_cast<Milliseconds>(period).count();
+    if (stats.count == 0) {
+        stats.minMs = intervalMs;
+        stats.maxMs = intervalMs;
+    } else {
+        stats.minMs = std::min(stats.minMs, intervalMs);
+        stats.maxMs = std::max(stats.maxMs, intervalMs);
+    }
+    stats.maxLatenessMs = std::max(stats.maxLatenessMs, latenessMs);
+
+    // Welford's running variance
+    stats.count++;
+    const double delta = intervalMs - stats.meanMs;
+    stats.meanMs += delta / stats.count;
+    _sendIntervalM2 += delta * (intervalMs - stats.meanMs);
+    stats.jitterMs = (stats.count > 1) ? std::sqrt(_sendIntervalM2 / (stats.count - 1)) : 0.;
+}
+
+Joystick::SendIntervalStats Joystick::sendIntervalStats() const
+{
+    QMutexLocker locker(&_sendIntervalMutex);
+    return _sendIntervalStats;
+}
+
+void Joystick::resetSendIntervalStats()
+{
+    QMutexLocker locker(&_sendIntervalMutex);
+    _sendIntervalStats = SendIntervalStats();
+    _sendIntervalM2 = 0.;
+}
+
 void Joystick::_updateButtonEventState(int buttonIndex, const bool buttonPressed, ButtonEvent_t &buttonEventState)
 {
     if (buttonPressed) {
@@ -750,7 +859,7 @@ void Joystick::_handleButtons()
         }
 
         //-- Process button press/release
-        const int buttonDelay = static_cast<int>(1000.0 / _joystickSettings.buttonFrequencyHz()->rawValue().toDouble());
+        const int buttonDelay = static_cast<int>(1000.0 / _buttonFrequencyHz);
         for (int buttonIndex = 0; buttonIndex < _totalButtonCount; buttonIndex++) {
             if (!_assignedButtonActions[buttonIndex]) {
                 continue;
@@ -845,13 +954,6 @@ float Joystick::_adjustRange(int value, const AxisCalibration_t &calibration, bo
 
 void Joystick::_handleAxis()
 {
-    const int axisDelay = static_cast<int>(1000.0 / _joystickSettings.axisFrequencyHz()->rawValue().toDouble());
-    if (_axisElapsedTimer.elapsed() <= axisDelay) {
-        return;
-    }
-
-    _axisElapsedTimer.start();
-
     if (_currentPollingType == NotPolling) {
         qCWarning(JoystickLog) << "Internal Error: Joystick not polling!";
         return;
@@ -1042,7 +1144,7 @@ void Joystick::_handleAxis()
         const uint16_t highButtons = static_cast<uint16_t>((buttonPressedBits >> 16) & 0xFFFF);
 
 
-        vehicle->sendJoystickDataThreadSafe(roll, pitch, yaw, throttle, lowButtons, highButtons, pitchExtension, rollExtension, aux1, aux2, aux3, aux4, aux5, aux6);
+        vehicle->sendJoystickDataThreadSafe(roll, pitch, yaw, throttle, lowButtons, highButtons, pitchExtension, rollExtension, aux1, aux2, aux3, aux4, aux5, aux6, _sampleTime);
     }
 }
 
@@ -1140,6 +1242,7 @@ void Joystick::_stopPollingForConfiguration()
 
     if (_currentPollingType == NotPolling) {
         _exitThread = true;
+        _wakeThread();
     }
 }
 
@@ -1161,6 +1264,7 @@ void Joystick::_stopAllPolling()
 
     if (isRunning()) {
         _exitThread = true;
+        _wakeThread();
     }
 }
 
@@ -1674,6 +1778,7 @@ Joystick::AxisFunction_t Joystick::_getAxisFunctionForJoystickAxis(int joystickA
 void Joystick::stop()
 {
     _exitThread = true;
+    _wakeThread();
     if (isRunning()) {
         if (QThread::currentThread() == this) {
             qCWarning(JoystickLog) << "Skipping wait() on joystick thread";
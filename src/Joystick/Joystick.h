@@ -2,15 +2,20 @@
 
 #include "QGCMAVLink.h"
 
+#include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QThread>
 #include <QtCore/QVariantMap>
+#include <QtCore/QWaitCondition>
 #include <QtGui/QVector3D>
 #include <QtQmlIntegration/QtQmlIntegration>
 
 #include "RemoteControlCalibrationController.h"
 #include "JoystickSettings.h"
 
+#include <atomic>
+#include <chrono>
+
 class MavlinkActionManager;
 class QmlObjectListModel;
 class Vehicle;
@@ -322,6 +327,19 @@ class Joystick : public QThread
 
     void stop();
 
+    /// Timing of the axis sends made by the joystick thread
+    struct SendIntervalStats {
+        quint64 count = 0;          ///< Number of intervals measured
+        double targetMs = 0.;       ///< Period requested by axisFrequencyHz
+        double meanMs = 0.;
+        double minMs = 0.;
+        double maxMs = 0.;
+        double jitterMs = 0.;       ///< Standard deviation of the interval
+        double maxLatenessMs = 0.;  ///< Largest delay of a send past its deadline
+    };
+    SendIntervalStats sendIntervalStats() const;
+    void resetSendIntervalStats();
+
 signals:
     void buttonActionsChanged();
     void assignableActionsChanged();
@@ -398,6 +416,13 @@ private slots:
 
     void run() override;
 
+    using Clock = std::chrono::steady_clock;
+
+    /// Sleeps until deadline unless woken earlier by _wakeThread
+    void _waitUntil(Clock::time_point deadline);
+    void _wakeThread();
+    void _recordSendInterval(Clock::duration interval, Clock::duration lateness, Clock::duration period);
+
     void _startPollingForVehicle(Vehicle &vehicle);
     void _startPollingForActiveVehicle();
     void _startPollingForConfiguration();
@@ -457,10 +482,25 @@ private slots:
     AxisFunctionMap_t _axisFunctionToJoystickAxisMap; ///< Map from AxisFunction_t to axis index, kJoystickAxisNotAssigned if not assigned
     static constexpr const int kJoystickAxisNotAssigned = -1;
 
-    QElapsedTimer _axisElapsedTimer;
     QStringList _availableActionTitles;
     std::atomic<bool> _exitThread = false;    ///< true: signal thread to exit
 
+    // Cached from the settings so the joystick thread does not go through the Facts every cycle
+    std::atomic<double> _axisFrequencyHz = 25.;
+    std::atomic<double> _buttonFrequencyHz = 5.;
+
+    QMutex _wakeMutex;
+    QWaitCondition _wakeCondition;
+    bool _wakeRequested = false;
+
+    Clock::time_point _sampleTime;            ///< When the joystick state was last updated from the device
+
+    mutable QMutex _sendIntervalMutex;
+    SendIntervalStats _sendIntervalStats;
+    double _sendIntervalM2 = 0.;              ///< Running sum of squared deviations for the jitter
+
+    static constexpr std::chrono::milliseconds kButtonPollInterval{20}; ///< Button scan rate between axis sends
+
     // HOTAS/Multi-device linking
     QString _linkedGroupId;
     QString _linkedGroupRole;
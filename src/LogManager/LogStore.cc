@@ -131,38 +131,69 @@ QList<LogEntry> LogStore::query(const QueryParams& params) const
 
     QSqlDatabase db = conn.database();
 
+    // Category and text filters go through the trigram full-text index, which matches substrings
+    // case-insensitively just like LIKE. Terms too short for a trigram fall back to LIKE.
+    const bool ftsAvailable = _ftsAvailable.load(std::memory_order_relaxed);
+    const bool ftsCategory = ftsAvailable && _ftsSearchable(params.category);
+    const bool ftsText = ftsAvailable && _ftsSearchable(params.textFilter);
+    const bool likeCategory = !params.category.isEmpty() && !ftsCategory;
+    const bool likeText = !params.textFilter.isEmpty() && !ftsText;
+    const bool useFts = ftsCategory || ftsText;
+
+    QStringList matchTerms;
+    if (ftsCategory) {
+        matchTerms << _ftsPhrase(QStringLiteral("category"), params.category);
+    }
+    if (ftsText) {
+        matchTerms << _ftsPhrase(QStringLiteral("message"), params.textFilter);
+    }
+
     QString sql;
-    sql.reserve(256);
+    sql.reserve(384);
     sql += QStringLiteral(
-        "SELECT timestamp, level, category, message, file, function, line, formatted "
-        "FROM log_entries WHERE 1=1");
+        "SELECT e.timestamp, e.level, e.category, e.message, e.file, e.function, e.line, e.formatted "
+        "FROM log_entries e");
+    if (useFts) {
+        sql += QStringLiteral(" JOIN log_entries_fts f ON f.rowid = e.id");
+    }
+    sql += QStringLiteral(" WHERE 1=1");
 
     // Build parameterized WHERE clause; bind values added in order below
     QSqlQuery q(db);
 
+    if (useFts) {
+        sql += QStringLiteral(" AND log_entries_fts MATCH ?");
+    }
     if (!params.sessionId.isEmpty()) {
-        sql += QStringLiteral(" AND session_id = ?");
+        sql += QStringLiteral(" AND e.session_id = ?");
     }
     if (params.fromTime.isValid()) {
-        sql += QStringLiteral(" AND timestamp >= ?");
+        sql += QStringLiteral(" AND e.timestamp >= ?");
     }
     if (params.toTime.isValid()) {
-        sql += QStringLiteral(" AND timestamp <= ?");
+        sql += QStringLiteral(" AND e.timestamp <= ?");
     }
     if (params.minLevel > LogEntry::Debug) {
-        sql += QStringLiteral(" AND level >= ?");
+        sql += QStringLiteral(" AND e.level >= ?");
     }
-    if (!params.category.isEmpty()) {
-        sql += QStringLiteral(" AND category LIKE ? ESCAPE '\\'");
+    if (likeCategory) {
+        sql += QStringLiteral(" AND e.category LIKE ? ESCAPE '\\'");
     }
-    if (!params.textFilter.isEmpty()) {
-        sql += QStringLiteral(" AND message LIKE ? ESCAPE '\\'");
+    if (likeText) {
+        sql += QStringLiteral(" AND e.message LIKE ? ESCAPE '\\'");
     }
 
-    sql += QStringLiteral(" ORDER BY id ASC LIMIT ? OFFSET ?");
+    if (useFts && params.rankByRelevance) {
+        sql += QStringLiteral(" ORDER BY f.rank, e.id ASC LIMIT ? OFFSET ?");
+    } else {
+        sql += QStringLiteral(" ORDER BY e.id ASC LIMIT ? OFFSET ?");
+    }
     q.prepare(sql);
 
     // Bind values in same order as WHERE clauses above
+    if (useFts) {
+        q.addBindValue(matchTerms.join(QStringLiteral(" AND ")));
+    }
     if (!params.sessionId.isEmpty()) {
         q.addBindValue(params.sessionId);
     }
@@ -175,10 +206,10 @@ QList<LogEntry> LogStore::query(const QueryParams& params) const
     if (params.minLevel > LogEntry::Debug) {
         q.addBindValue(params.minLevel);
     }
-    if (!params.category.isEmpty()) {
+    if (likeCategory) {
         q.addBindValue(QLatin1Char('%') + QGCSqlHelper::escapeLikePattern(params.category) + QLatin1Char('%'));
     }
-    if (!params.textFilter.isEmpty()) {
+    if (likeText) {
         q.addBindValue(QLatin1Char('%') + QGCSqlHelper::escapeLikePattern(params.textFilter) + QLatin1Char('%'));
     }
     q.addBindValue(params.limit);
@@ -197,11 +228,21 @@ QList<LogEntry> LogStore::query(const QueryParams& params) const
             entry.formatted = q.value(7).toString();
             result.append(std::move(entry));
         }
+    } else {
+        qCWarning(LogStoreLog) << "Query failed:" << q.lastError().text();
     }
 
     return result;
 }
 
+QString LogStore::_ftsPhrase(const QString& column, const QString& text)
+{
+    // Quote as a single phrase so FTS5 query syntax in user input is matched literally
+    QString escaped = text;
+    escaped.replace(QLatin1Char('"'), QStringLiteral("\"\""));
+    return column + QStringLiteral(" : \"") + escaped + QLatin1Char('"');
+}
+
 QStringList LogStore::sessions() const
 {
     QStringList result;
@@ -215,7 +256,7 @@ QStringList LogStore::sessions() const
     }
 
     QSqlQuery q(conn.database());
-    q.exec(QStringLiteral("SELECT DISTINCT session_id FROM log_entries ORDER BY id ASC"));
+    q.exec(QStringLiteral("SELECT session_id FROM log_sessions ORDER BY first_id ASC"));
     while (q.next()) {
         result << q.value(0).toString();
     }
@@ -235,7 +276,7 @@ qint64 LogStore::sessionEntryCount(const QString& sessionId) const
     }
 
     QSqlQuery q(conn.database());
-    q.prepare(QStringLiteral("SELECT COUNT(*) FROM log_entries WHERE session_id = ?"));
+    q.prepare(QStringLiteral("SELECT entry_count FROM log_sessions WHERE session_id = ?"));
     q.addBindValue(sessionId);
     if (q.exec() && q.next()) {
         return q.value(0).toLongLong();
@@ -261,10 +302,37 @@ bool LogStore::deleteSession(const QString& sessionId)
         return false;
     }
 
-    QSqlQuery q(conn.database());
+    QSqlDatabase db = conn.database();
+    QGCSqlHelper::Transaction txn(db);
+    if (!txn.ok()) {
+        return false;
+    }
+
+    QSqlQuery q(db);
+    if (_ftsAvailable.load(std::memory_order_relaxed)) {
+        // External content index needs the old values to remove the rows
+        q.prepare(QStringLiteral(
+            "INSERT INTO log_entries_fts (log_entries_fts, rowid, category, message) "
+            "SELECT 'delete', id, category, message FROM log_entries WHERE session_id = ?"));
+        q.addBindValue(sessionId);
+        if (!q.exec()) {
+            return false;
+        }
+    }
+
     q.prepare(QStringLiteral("DELETE FROM log_entries WHERE session_id = ?"));
     q.addBindValue(sessionId);
-    return q.exec();
+    if (!q.exec()) {
+        return false;
+    }
+
+    q.prepare(QStringLiteral("DELETE FROM log_sessions WHERE session_id = ?"));
+    q.addBindValue(sessionId);
+    if (!q.exec()) {
+        return false;
+    }
+
+    return txn.commit();
 }
 
 void LogStore::exportSession(const QString& sessionId, const QString& destFile, int format)
@@ -324,6 +392,85 @@ void LogStore::_bindAndExec(QSqlQuery& q, const QString& sessionId, const LogEnt
     q.exec();
 }
 
+QString LogStore::_insertBatch(QSqlQuery& insertQuery, QSqlQuery* ftsQuery, QSqlQuery& sessionQuery,
+                               const QString& sessionId, const std::vector<LogEntry>& batch)
+{
+    qint64 firstId = -1;
+    for (const auto& entry : batch) {
+        _bindAndExec(insertQuery, sessionId, entry);
+        if (insertQuery.lastError().isValid()) {
+            return insertQuery.lastError().text();
+        }
+
+        const qint64 id = insertQuery.lastInsertId().toLongLong();
+        if (firstId < 0) {
+            firstId = id;
+        }
+
+        if (ftsQuery) {
+            ftsQuery->addBindValue(id);
+            ftsQuery->addBindValue(entry.category);
+            ftsQuery->addBindValue(entry.message);
+            if (!ftsQuery->exec()) {
+                return ftsQuery->lastError().text();
+            }
+        }
+    }
+
+    sessionQuery.addBindValue(sessionId);
+    sessionQuery.addBindValue(firstId);
+    sessionQuery.addBindValue(batch.front().timestamp.toMSecsSinceEpoch());
+    sessionQuery.addBindValue(static_cast<qint64>(batch.size()));
+    if (!sessionQuery.exec()) {
+        return sessionQuery.lastError().text();
+    }
+
+    return QString();
+}
+
+bool LogStore::_createFullTextIndex(QSqlDatabase& db)
+{
+    QSqlQuery q(db);
+    if (q.exec(QStringLiteral("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'log_entries_fts'")) && q.next()) {
+        return true;
+    }
+
+    // Trigram tokens keep the substring semantics of the LIKE filters the index replaces
+    if (!q.exec(QStringLiteral(
+            "CREATE VIRTUAL TABLE log_entries_fts USING fts5("
+            "  category, message, content='log_entries', content_rowid='id', tokenize='trigram'"
+            ")"))) {
+        qCWarning(LogStoreLog) << "Full-text index unavailable, filters use LIKE:" << q.lastError().text();
+        return false;
+    }
+
+    // Index entries written before the index existed
+    if (!q.exec(QStringLiteral("INSERT INTO log_entries_fts (log_entries_fts) VALUES ('rebuild')"))) {
+        qCWarning(LogStoreLog) << "Full-text index rebuild failed:" << q.lastError().text();
+        (void) q.exec(QStringLiteral("DROP TABLE log_entries_fts"));
+        return false;
+    }
+
+    return true;
+}
+
+void LogStore::_createSessionIndex(QSqlDatabase& db)
+{
+    QSqlQuery q(db);
+    if (q.exec(QStringLiteral("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'log_sessions'")) && q.next()) {
+        return;
+    }
+
+    q.exec(QStringLiteral("CREATE TABLE log_sessions ("
+                          "  session_id TEXT PRIMARY KEY,"
+                          "  first_id INTEGER NOT NULL,"
+                          "  started INTEGER NOT NULL,"
+                          "  entry_count INTEGER NOT NULL DEFAULT 0"
+                          ")"));
+    q.exec(QStringLiteral("INSERT INTO log_sessions (session_id, first_id, started, entry_count) "
+                          "SELECT session_id, MIN(id), MIN(timestamp), COUNT(*) FROM log_entries GROUP BY session_id"));
+}
+
 void LogStore::_startWorker()
 {
     const QMutexLocker locker(&_mutex);
@@ -393,6 +540,9 @@ void LogStore::_workerLoop()
             q.exec(QStringLiteral("CREATE INDEX IF NOT EXISTS idx_level ON log_entries(level)"));
             q.exec(QStringLiteral("CREATE INDEX IF NOT EXISTS idx_category ON log_entries(category)"));
         }
+        _createSessionIndex(db);
+        const bool ftsAvailable = _createFullTextIndex(db);
+        _ftsAvailable.store(ftsAvailable, std::memory_order_relaxed);
         QGCSqlHelper::applySqlitePragmas(db);
 
         _isOpen.store(true, std::memory_order_relaxed);
@@ -409,6 +559,17 @@ void LogStore::_workerLoop()
             "INSERT INTO log_entries (session_id, timestamp, level, category, message, file, function, line, formatted) "
             "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)"));
 
+        std::optional<QSqlQuery> ftsQuery;
+        if (ftsAvailable) {
+            ftsQuery.emplace(db);
+            ftsQuery->prepare(QStringLiteral("INSERT INTO log_entries_fts (rowid, category, message) VALUES (?, ?, ?)"));
+        }
+
+        QSqlQuery sessionQuery(db);
+        sessionQuery.prepare(QStringLiteral(
+            "INSERT INTO log_sessions (session_id, first_id, started, entry_count) VALUES (?, ?, ?, ?) "
+            "ON CONFLICT(session_id) DO UPDATE SET entry_count = entry_count + excluded.entry_count"));
+
         while (!_quit.load(std::memory_order_relaxed)) {
             std::vector<LogEntry> batch;
 
@@ -428,23 +589,17 @@ void LogStore::_workerLoop()
             }
 
             QGCSqlHelper::Transaction txn(db);
-            bool batchOk = txn.ok();
-            for (const auto& entry : batch) {
-                if (!batchOk) {
-                    break;
-                }
-                _bindAndExec(insertQuery, _sessionId, entry);
-                if (insertQuery.lastError().isValid()) {
-                    batchOk = false;
-                }
+            QString batchError = txn.ok() ? QString() : db.lastError().text();
+            if (batchError.isEmpty()) {
+                batchError = _insertBatch(insertQuery, ftsQuery ? &*ftsQuery : nullptr, sessionQuery, _sessionId, batch);
             }
-            if (batchOk) {
+            if (batchError.isEmpty()) {
                 txn.commit();
             } else {
                 // Transaction destructor rolls back if commit() wasn't called.
                 QMetaObject::invokeMethod(
                     this,
-                    [this, err = insertQuery.lastError().text()]() { emit errorOccurred(err); },
+                    [this, err = batchError]() { emit errorOccurred(err); },
                     Qt::QueuedConnection);
             }
 
@@ -457,10 +612,9 @@ void LogStore::_workerLoop()
             const QMutexLocker locker(&_mutex);
             if (!_pendingWrites.empty()) {
                 QGCSqlHelper::Transaction txn(db);
-                for (const auto& entry : _pendingWrites) {
-                    _bindAndExec(insertQuery, _sessionId, entry);
+                if (_insertBatch(insertQuery, ftsQuery ? &*ftsQuery : nullptr, sessionQuery, _sessionId, _pendingWrites).isEmpty()) {
+                    txn.commit();
                 }
-                txn.commit();
                 _pendingWrites.clear();
             }
         }
@@ -470,4 +624,5 @@ void LogStore::_workerLoop()
     // All QSqlQuery objects are destroyed — safe to remove the connection.
     QSqlDatabase::removeDatabase(_writeConnName);
     _isOpen.store(false, std::memory_order_relaxed);
+    _ftsAvailable.store(false, std::memory_order_relaxed);
 }
@@ -12,6 +12,7 @@
 
 #include "LogEntry.h"
 
+class QSqlDatabase;
 class QSqlQuery;
 class QThread;
 
@@ -35,6 +36,9 @@ class LogStore : public QObject
 
     bool isOpen() const { return _isOpen.load(std::memory_order_relaxed); }
 
+    /// True when category and text filters are served by the full-text index
+    bool isFullTextSearchAvailable() const { return _ftsAvailable.load(std::memory_order_relaxed); }
+
     QString databasePath() const;
 
     qint64 entryCount() const { return _entryCount.load(std::memory_order_relaxed); }
@@ -52,6 +56,7 @@ class LogStore : public QObject
         int minLevel = LogEntry::Debug;
         QString category;
         QString textFilter;
+        bool rankByRelevance = false;  ///< Order text/category matches by relevance instead of by time
         int limit = 10000;
         int offset = 0;
     };
@@ -76,6 +81,12 @@ class LogStore : public QObject
     void _startWorker();
     void _stopWorker();
     static void _bindAndExec(QSqlQuery& q, const QString& sessionId, const LogEntry& entry);
+    static QString _insertBatch(QSqlQuery& insertQuery, QSqlQuery* ftsQuery, QSqlQuery& sessionQuery,
+                                const QString& sessionId, const std::vector<LogEntry>& batch);
+    static bool _createFullTextIndex(QSqlDatabase& db);
+    static void _createSessionIndex(QSqlDatabase& db);
+    static QString _ftsPhrase(const QString& column, const QString& text);
+    static bool _ftsSearchable(const QString& text) { return text.size() >= kFtsMinTermLength; }
 
     mutable QMutex _mutex;
     QWaitCondition _condition;
@@ -89,8 +100,10 @@ class LogStore : public QObject
 
     QFuture<void> _exportFuture;
     std::atomic<bool> _isOpen{false};
+    std::atomic<bool> _ftsAvailable{false};
     std::atomic<bool> _quit{false};
     std::atomic<qint64> _entryCount{0};
     static constexpr int kBatchSize = 500;
     static constexpr int kFlushIntervalMs = 2000;
+    static constexpr int kFtsMinTermLength = 3;  ///< Trigram tokenizer can't match shorter terms, those use LIKE
 };
@@ -6,7 +6,7 @@
 CameraSpec::CameraSpec(const QString& settingsGroup, QObject* parent)
     : QObject                   (parent)
     , _dirty                    (false)
-    , _metaDataMap              (FactMetaData::createMapFromJsonFile(QStringLiteral(":/json/CameraSpec.FactMetaData.json"), this))
+    , _metaDataMap              (FactMetaData::sharedMapFromJsonFile(QStringLiteral(":/json/CameraSpec.FactMetaData.json")))
     , _sensorWidthFact          (settingsGroup, _metaDataMap[_sensorWidthName])
     , _sensorHeightFact         (settingsGroup, _metaDataMap[_sensorHeightName])
     , _imageWidthFact           (settingsGroup, _metaDataMap[_imageWidthName])
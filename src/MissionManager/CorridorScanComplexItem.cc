@@ -16,7 +16,7 @@ const QString CorridorScanComplexItem::name(CorridorScanComplexItem::tr("Corrido
 CorridorScanComplexItem::CorridorScanComplexItem(PlanMasterController* masterController, bool flyView, const QString& kmlOrShpFile)
     : TransectStyleComplexItem  (masterController, flyView, settingsGroup)
     , _entryPointLocation       (EntryPointDefaultOrder)
-    , _metaDataMap              (FactMetaData::createMapFromJsonFile(QStringLiteral(":/json/CorridorScan.SettingsGroup.json"), this))
+    , _metaDataMap              (FactMetaData::sharedMapFromJsonFile(QStringLiteral(":/json/CorridorScan.SettingsGroup.json")))
     , _corridorWidthFact        (settingsGroup, _metaDataMap[corridorWidthName])
 {
     _editorQml = "qrc:/qml/QGroundControl/PlanView/CorridorScanEditor.qml";
@@ -17,7 +17,7 @@ const QString StructureScanComplexItem::name(StructureScanComplexItem::tr("Struc
 
 StructureScanComplexItem::StructureScanComplexItem(PlanMasterController* masterController, bool flyView, const QString& kmlOrShpFile)
     : ComplexMissionItem        (masterController, flyView)
-    , _metaDataMap              (FactMetaData::createMapFromJsonFile(QStringLiteral(":/json/StructureScan.SettingsGroup.json"), this /* QObject parent */))
+    , _metaDataMap              (FactMetaData::sharedMapFromJsonFile(QStringLiteral(":/json/StructureScan.SettingsGroup.json")))
     , _sequenceNumber           (0)
     , _entryVertex              (0)
 , _ignoreRecalc             (false)
@@ -17,7 +17,7 @@ const QString VTOLLandingComplexItem::name(VTOLLandingComplexItem::tr("VTOL Land
 
 VTOLLandingComplexItem::VTOLLandingComplexItem(PlanMasterController* masterController, bool flyView)
     : LandingComplexItem        (masterController, flyView)
-    , _metaDataMap              (FactMetaData::createMapFromJsonFile(QStringLiteral(":/json/VTOLLandingPattern.FactMetaData.json"), this))
+    , _metaDataMap              (FactMetaData::sharedMapFromJsonFile(QStringLiteral(":/json/VTOLLandingPattern.FactMetaData.json")))
     , _landingDistanceFact      (settingsGroup, _metaDataMap[finalApproachToLandDistanceName])
     , _finalApproachAltitudeFact(settingsGroup, _metaDataMap[finalApproachAltitudeName])
     , _useDoChangeSpeedFact     (settingsGroup, _metaDataMap[useDoChangeSpeedName])
@@ -39,6 +39,8 @@ VTOLLandingComplexItem::VTOLLandingComplexItem(PlanMasterController* masterContr
     if (QGC::fuzzyCompare(_landingDistanceFact.rawValue().toDouble(), _landingDistanceFact.rawDefaultValue().toDouble())) {
         Fact* vtolTransitionDistanceFact = SettingsManager::instance()->planViewSettings()->vtolTransitionDistance();
         double vtolTransitionDistance = vtolTransitionDistanceFact->rawValue().toDouble();
+        // Meta data is shared between all items, so adjust a private copy
+        _landingDistanceFact.setMetaData(new FactMetaData(*_landingDistanceFact.metaData(), this));
         _landingDistanceFact.metaData()->setRawDefaultValue(vtolTransitionDistance);
         _landingDistanceFact.setRawValue(vtolTransitionDistance);
         _landingDistanceFact.metaData()->setRawMin(vtolTransitionDistanceFact->metaData()->rawMin());
@@ -680,6 +680,74 @@ void QGCApplication::removeCompressedSignal(const QMetaMethod &method)
     _compressedSignals.remove(method);
 }
 
+QGCApplication::CompressedSignalStats QGCApplication::compressedSignalStats()
+{
+    QMutexLocker locker(&_pendingCallsMutex);
+    return _compressedSignalStats;
+}
+
+void QGCApplication::resetCompressedSignalStats()
+{
+    QMutexLocker locker(&_pendingCallsMutex);
+    _compressedSignalStats = CompressedSignalStats();
+}
+
+void QGCApplication::_trackPendingCall(const PendingCallKey &key, QEvent *event, qsizetype position)
+{
+    if (_pendingCalls.size() >= kMaxPendingCalls) {
+        // Entries for receivers which went away with calls still queued are never delivered, drop them all
+        _pendingCalls.clear();
+        _pendingCallKeys.clear();
+        _pendingCallsPerReceiver.clear();
+    }
+
+    const auto it = _pendingCalls.constFind(key);
+    if (it == _pendingCalls.constEnd()) {
+        _pendingCallsPerReceiver[key.receiver]++;
+    } else if (it->event != event) {
+        _pendingCallKeys.remove(it->event);
+    }
+    _pendingCalls.insert(key, PendingCall{event, position});
+    _pendingCallKeys.insert(event, key);
+    _pendingCallCount.store(_pendingCalls.size(), std::memory_order_relaxed);
+}
+
+void QGCApplication::_untrackPendingEvent(const QEvent *event)
+{
+    const auto it = _pendingCallKeys.constFind(event);
+    if (it == _pendingCallKeys.constEnd()) {
+        return;
+    }
+
+    const auto call = _pendingCalls.constFind(*it);
+    if ((call != _pendingCalls.constEnd()) && (call->event == event)) {
+        _pendingCalls.erase(call);
+        const auto receiverCount = _pendingCallsPerReceiver.find(it->receiver);
+        if ((receiverCount != _pendingCallsPerReceiver.end()) && (--(*receiverCount) <= 0)) {
+            _pendingCallsPerReceiver.erase(receiverCount);
+        }
+    }
+    _pendingCallKeys.erase(it);
+    _pendingCallCount.store(_pendingCalls.size(), std::memory_order_relaxed);
+}
+
+QT_WARNING_PUSH
+QT_WARNING_DISABLE_DEPRECATED
+void QGCApplication::_indexPostedCall(const QPostEvent &postEvent, qsizetype position)
+{
+    if (!postEvent.event || (postEvent.event->type() != QEvent::MetaCall) || _pendingCallKeys.contains(postEvent.event)) {
+        return;
+    }
+
+    const QMetaCallEvent *mce = static_cast<QMetaCallEvent*>(postEvent.event);
+    if (!mce->sender() || !_compressedSignals.contains(mce->sender()->metaObject(), mce->signalId())) {
+        return;
+    }
+
+    _trackPendingCall(PendingCallKey{postEvent.receiver, mce->sender(), mce->signalId(), mce->id()}, postEvent.event, position);
+}
+QT_WARNING_POP
+
 QT_WARNING_PUSH
 QT_WARNING_DISABLE_DEPRECATED
 bool QGCApplication::compressEvent(QEvent *event, QObject *receiver, QPostEventList *postedEvents)
@@ -693,35 +761,92 @@ bool QGCApplication::compressEvent(QEvent *event, QObject *receiver, QPostEventL
         return QApplication::compressEvent(event, receiver, postedEvents);
     }
 
-    for (QPostEventList::iterator it = postedEvents->begin(); it != postedEvents->end(); ++it) {
-        QPostEvent &cur = *it;
+    const PendingCallKey key{receiver, mce->sender(), mce->signalId(), mce->id()};
+
+    const auto isSameCall = [receiver, event, mce](const QPostEvent &cur) {
         if (cur.receiver != receiver || cur.event == 0 || cur.event->type() != event->type()) {
-            continue;
+            return false;
         }
         const QMetaCallEvent *cur_mce = static_cast<QMetaCallEvent*>(cur.event);
-        if (cur_mce->sender() != mce->sender() || cur_mce->signalId() != mce->signalId() || cur_mce->id() != mce->id()) {
-            continue;
+        return (cur_mce->sender() == mce->sender()) && (cur_mce->signalId() == mce->signalId()) && (cur_mce->id() == mce->id());
+    };
+
+    QMutexLocker locker(&_pendingCallsMutex);
+
+    // Only trust the index if the slot it points at still holds the indexed event, the list is compacted between
+    // event loop passes. The address of a delivered event can be reused by a new one, so the call is checked too.
+    qsizetype position = -1;
+    bool scan = true;
+    const auto pending = _pendingCalls.constFind(key);
+    if (pending != _pendingCalls.constEnd()) {
+        if (pending->position < postedEvents->size()) {
+            const QPostEvent &cur = postedEvents->at(pending->position);
+            if ((cur.event == pending->event) && isSameCall(cur)) {
+                position = pending->position;
+                scan = false;
+            }
         }
-        /* Keep The Newest Call */
-        // We can't merely qSwap the existing posted event with the new one, since QEvent
-        // keeps track of whether it has been posted. Deletion of a formerly posted event
-        // takes the posted event list mutex and does a useless search of the posted event
-        // list upon deletion. We thus clear the QEvent::posted flag before deletion.
-        struct EventHelper : private QEvent {
-            static void clearPostedFlag(QEvent * ev) {
-                (&static_cast<EventHelper*>(ev)->t)[1] &= ~0x8001; // Hack to clear QEvent::posted
+    } else if (_pendingCallsPerReceiver.value(receiver) == QObjectPrivate::get(receiver)->postedEvents.loadRelaxed()) {
+        // Everything queued for the receiver is indexed, so the call isn't pending
+        scan = false;
+    }
+
+    if (scan) {
+        // Index the receiver's other calls on the way so the next miss for it can be trusted without a scan
+        _compressedSignalStats.indexMisses++;
+        for (qsizetype i = 0; i < postedEvents->size(); i++) {
+            const QPostEvent &cur = postedEvents->at(i);
+            if (cur.receiver != receiver) {
+                continue;
             }
-        };
-        EventHelper::clearPostedFlag(cur.event);
-        delete cur.event;
-        cur.event = event;
-        return true;
+            if (isSameCall(cur)) {
+                if (position < 0) {
+                    position = i;
+                }
+            } else {
+                _indexPostedCall(cur, i);
+            }
+        }
     }
 
-    return false;
+    if (position < 0) {
+        // Normal priority events are appended by QCoreApplication::postEvent
+        _trackPendingCall(key, event, postedEvents->size());
+        return false;
+    }
+
+    /* Keep The Newest Call */
+    // We can't merely qSwap the existing posted event with the new one, since QEvent
+    // keeps track of whether it has been posted. Deletion of a formerly posted event
+    // takes the posted event list mutex and does a useless search of the posted event
+    // list upon deletion. We thus clear the QEvent::posted flag before deletion.
+    struct EventHelper : private QEvent {
+        static void clearPostedFlag(QEvent * ev) {
+            (&static_cast<EventHelper*>(ev)->t)[1] &= ~0x8001; // Hack to clear QEvent::posted
+        }
+    };
+    QPostEvent &cur = (*postedEvents)[position];
+    _untrackPendingEvent(cur.event);
+    EventHelper::clearPostedFlag(cur.event);
+    delete cur.event;
+    cur.event = event;
+    _trackPendingCall(key, event, position);
+    _compressedSignalStats.coalesced++;
+    return true;
 }
 QT_WARNING_POP
 
+bool QGCApplication::notify(QObject *receiver, QEvent *event)
+{
+    if ((event->type() == QEvent::MetaCall) && (_pendingCallCount.load(std::memory_order_relaxed) > 0)) {
+        // Delivered calls leave the posted event list, later duplicates must be posted again
+        QMutexLocker locker(&_pendingCallsMutex);
+        _untrackPendingEvent(event);
+    }
+
+    return QApplication::notify(receiver, event);
+}
+
 bool QGCApplication::event(QEvent *e)
 {
     if (e->type() == QEvent::Quit) {
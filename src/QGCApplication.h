@@ -1,12 +1,16 @@
 #pragma once
 
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
 #include <QtCore/QMap>
+#include <QtCore/QMutex>
 #include <QtCore/QSet>
 #include <QtCore/QTimer>
 #include <QtCore/QTranslator>
 #include <QtWidgets/QApplication>
 
+#include <atomic>
+
 namespace QGCCommandLineParser {
     struct CommandLineParseResult;
 }
@@ -16,6 +20,7 @@ class QQuickWindow;
 class QGCImageProvider;
 class QGCApplication;
 class QEvent;
+class QPostEvent;
 class QPostEventList;
 class QMetaMethod;
 struct QMetaObject;
@@ -68,7 +73,15 @@ class QGCApplication : public QApplication
 
     void removeCompressedSignal(const QMetaMethod &method);
 
+    struct CompressedSignalStats {
+        quint64 coalesced = 0;      ///< Queued calls dropped in favour of a newer duplicate
+        quint64 indexMisses = 0;    ///< Compressed posts which had to scan the posted event list
+    };
+    CompressedSignalStats compressedSignalStats();
+    void resetCompressedSignalStats();
+
     bool event(QEvent *e) final;
+    bool notify(QObject *receiver, QEvent *event) final;
 
     static QString cachedParameterMetaDataFile();
     static QString cachedAirframeMetaDataFile();
@@ -114,6 +127,28 @@ private slots:
 private:
     bool compressEvent(QEvent *event, QObject *receiver, QPostEventList *postedEvents) final;
 
+    /// Identifies queued calls which replace each other when their signal is compressed
+    struct PendingCallKey {
+        const QObject *receiver = nullptr;
+        const QObject *sender = nullptr;
+        int signalId = -1;
+        int slotId = -1;
+
+        bool operator==(const PendingCallKey &other) const = default;
+        friend size_t qHash(const PendingCallKey &key, size_t seed = 0) noexcept
+        {
+            return qHashMulti(seed, key.receiver, key.sender, key.signalId, key.slotId);
+        }
+    };
+    struct PendingCall {
+        QEvent *event = nullptr;
+        qsizetype position = -1;    ///< Index in the posted event list when last seen, shifts when Qt compacts the list
+    };
+    void _trackPendingCall(const PendingCallKey &key, QEvent *event, qsizetype position);
+    void _untrackPendingEvent(const QEvent *event);
+    /// Adds a compressed call found while scanning the posted event list to the index, if it isn't indexed yet
+    void _indexPostedCall(const QPostEvent &postEvent, qsizetype position);
+
     bool _initVideo();
 
     /// Initialize the application for normal application boot. Or in other words we are not going to run unit tests.
@@ -168,6 +203,21 @@ private slots:
 
     CompressedSignalList _compressedSignals;
 
+    // Index of compressed calls still waiting in a posted event list. Entries are only hints: they are checked against
+    // the list before use and compressEvent falls back to a scan when they are stale. Guarded by the mutex since
+    // compressEvent runs on the posting thread.
+    //
+    // A call missing from the index is only known not to be pending when every event queued for the receiver is
+    // indexed. Qt doesn't consult compressEvent for a receiver with nothing queued, and the index is dropped when it
+    // overflows, so _pendingCallsPerReceiver is compared with the receiver's queued event count before trusting a miss.
+    QMutex _pendingCallsMutex;
+    QHash<PendingCallKey, PendingCall> _pendingCalls;
+    QHash<const QEvent*, PendingCallKey> _pendingCallKeys;
+    QHash<const QObject*, qsizetype> _pendingCallsPerReceiver;
+    std::atomic<qsizetype> _pendingCallCount = 0;
+    CompressedSignalStats _compressedSignalStats;
+    static constexpr qsizetype kMaxPendingCalls = 4096;
+
     const QString _settingsVersionKey = QStringLiteral("SettingsVersion"); ///< Settings key which hold settings version
 
     const QString _qgcImageProviderId = QStringLiteral("QGCImages");
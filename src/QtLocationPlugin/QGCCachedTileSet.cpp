@@ -11,6 +11,8 @@
 #include "QGeoFileTileCacheQGC.h"
 #include "QGeoTileFetcherQGC.h"
 
+#include <QtCore/QTimer>
+
 QGC_LOGGING_CATEGORY(QGCCachedTileSetLog, "QtLocationPlugin.QGCCachedTileSet")
 
 QGCCachedTileSet::QGCCachedTileSet(const QString &name, QObject *parent)
@@ -83,14 +85,27 @@ void QGCCachedTileSet::cancelDownloadTask()
     _cancelPending = true;
 }
 
-void QGCCachedTileSet::_tileListFetched(const QQueue<QGCTile*> &tiles)
+void QGCCachedTileSet::_tileListFetched(const QQueue<QGCTile*> &tiles, quint32 linkedTileCount, quint64 linkedTileSize, bool moreTiles)
 {
     _batchRequested = false;
-    if (tiles.size() < kTileBatchSize) {
+
+    // Tiles already in the cache are linked to the set while walking its ranges, they count as saved
+    if (linkedTileCount > 0) {
+        setSavedTileCount(_savedTileCount + linkedTileCount);
+        setSavedTileSize(_savedTileSize + linkedTileSize);
+    }
+
+    if ((tiles.size() < kTileBatchSize) && !moreTiles) {
         _noMoreTiles = true;
     }
 
     if (tiles.isEmpty()) {
+        if (moreTiles) {
+            // This pass only linked cached tiles, keep walking the ranges on the next event loop pass
+            _batchRequested = true;
+            QTimer::singleShot(0, this, &QGCCachedTileSet::createDownloadTask);
+            return;
+        }
         _doneWithDownload();
         return;
     }
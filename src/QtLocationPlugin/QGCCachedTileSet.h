@@ -133,7 +133,7 @@ class QGCCachedTileSet : public QObject
     void nameChanged();
 
 private slots:
-    void _tileListFetched(const QQueue<QGCTile*> &tiles);
+    void _tileListFetched(const QQueue<QGCTile*> &tiles, quint32 linkedTileCount, quint64 linkedTileSize, bool moreTiles);
     void _networkReplyFinished();
     void _networkReplyError(QNetworkReply::NetworkError error);
 
@@ -126,13 +126,15 @@ class QGCGetTileDownloadListTask : public QGCMapTask
     quint64 setID() const { return m_setID; }
     int count() const { return m_count; }
 
-    void setTileListFetched(const QQueue<QGCTile*> &tiles)
+    /// @param linkedTileCount Tiles of the set which were already cached and got linked instead of downloaded
+    /// @param moreTiles The set's ranges are not fully walked yet, a short or empty list does not mean done
+    void setTileListFetched(const QQueue<QGCTile*> &tiles, quint32 linkedTileCount = 0, quint64 linkedTileSize = 0, bool moreTiles = false)
     {
-        emit tileListFetched(tiles);
+        emit tileListFetched(tiles, linkedTileCount, linkedTileSize, moreTiles);
     }
 
 signals:
-    void tileListFetched(QQueue<QGCTile*> tiles);
+    void tileListFetched(QQueue<QGCTile*> tiles, quint32 linkedTileCount, quint64 linkedTileSize, bool moreTiles);
 
 private:
     const quint64 m_setID = 0;
@@ -4,12 +4,14 @@
 #include <QtCore/QDateTime>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#include <QtCore/QHash>
 #include <QtCore/QSettings>
 #include <QtCore/QUuid>
 #include <QtSql/QSqlDatabase>
 #include <QtSql/QSqlError>
 #include <QtSql/QSqlQuery>
 
+#include <algorithm>
 #include <atomic>
 
 #include "QGCCacheTile.h"
@@ -76,17 +78,29 @@ bool QGCTileCacheDatabase::_checkSchemaVersion()
         if (query.exec("SELECT COUNT(*) FROM Tiles") && query.next() && query.value(0).toInt() > 0) {
             qCWarning(QGCTileCacheDatabaseLog) << "Legacy database detected (no schema version). Discarding cached tiles and rebuilding.";
             _defaultSet = kInvalidTileSet;
+            query.exec("DROP TABLE IF EXISTS CacheStats");
+            query.exec("DROP TABLE IF EXISTS TileSetRanges");
             query.exec("DROP TABLE IF EXISTS TilesDownload");
             query.exec("DROP TABLE IF EXISTS SetTiles");
             query.exec("DROP TABLE IF EXISTS Tiles");
             query.exec("DROP TABLE IF EXISTS TileSets");
+            return true;
         }
-        return true;
+        return _migrateAccessTracking(db);
+    }
+
+    if (version < kSchemaVersion) {
+        // v1 listed every tile of a set in TilesDownload. Those rows are still served before any range,
+        // so sets created by v1 resume as before; _createDB adds TileSetRanges and bumps the version.
+        // v2 had no access tracking, the LRU columns are added and backfilled here.
+        qCDebug(QGCTileCacheDatabaseLog) << "Migrating tile cache schema from version" << version;
+        return _migrateAccessTracking(db);
     }
 
-    // Future: handle incremental migrations here (version < kSchemaVersion).
     qCWarning(QGCTileCacheDatabaseLog) << "Unknown schema version" << version << "(expected" << kSchemaVersion << "). Resetting cache.";
     _defaultSet = kInvalidTileSet;
+    query.exec("DROP TABLE IF EXISTS CacheStats");
+    query.exec("DROP TABLE IF EXISTS TileSetRanges");
     query.exec("DROP TABLE IF EXISTS TilesDownload");
     query.exec("DROP TABLE IF EXISTS SetTiles");
     query.exec("DROP TABLE IF EXISTS Tiles");
@@ -94,6 +108,46 @@ bool QGCTileCacheDatabase::_checkSchemaVersion()
     return true;
 }
 
+bool QGCTileCacheDatabase::_migrateAccessTracking(QSqlDatabase db)
+{
+    QSqlQuery query(db);
+    QSet<QString> columns;
+    if (query.exec("PRAGMA table_info(Tiles)")) {
+        while (query.next()) {
+            columns.insert(query.value(1).toString());
+        }
+    }
+
+    if (columns.isEmpty()) {
+        // Fresh database, _createDB creates Tiles with the columns
+        return true;
+    }
+
+    QGCSqlHelper::Transaction txn(db);
+    if (!txn.ok()) {
+        return false;
+    }
+
+    if (!columns.contains(QStringLiteral("lastAccess"))) {
+        if (!query.exec("ALTER TABLE Tiles ADD COLUMN lastAccess INTEGER DEFAULT 0") ||
+            !query.exec("UPDATE Tiles SET lastAccess = date")) {
+            qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (add lastAccess):" << query.lastError().text();
+            return false;
+        }
+    }
+    if (!columns.contains(QStringLiteral("pinned"))) {
+        if (!query.exec("ALTER TABLE Tiles ADD COLUMN pinned INTEGER DEFAULT 0") ||
+            !query.exec("UPDATE Tiles SET pinned = (SELECT COUNT(*) FROM SetTiles S JOIN TileSets T ON S.setID = T.setID "
+                        "WHERE S.tileID = Tiles.tileID AND T.defaultSet = 0)")) {
+            qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (add pinned):" << query.lastError().text();
+            return false;
+        }
+    }
+    (void) query.exec("DROP INDEX IF EXISTS idx_tiles_date");
+
+    return txn.commit();
+}
+
 bool QGCTileCacheDatabase::init()
 {
     _failed = false;
@@ -146,6 +200,7 @@ void QGCTileCacheDatabase::disconnectDB()
     if (!_connected) {
         return;
     }
+    (void) _flushTileAccess();
     _connected = false;
 
     if (!QCoreApplication::instance()) {
@@ -174,16 +229,18 @@ bool QGCTileCacheDatabase::saveTile(const QString &hash, const QString &format,
     }
 
     QSqlQuery query(_database());
-    if (!query.prepare("INSERT OR IGNORE INTO Tiles(hash, format, tile, size, type, date) VALUES(?, ?, ?, ?, ?, ?)")) {
+    if (!query.prepare("INSERT OR IGNORE INTO Tiles(hash, format, tile, size, type, date, lastAccess) VALUES(?, ?, ?, ?, ?, ?, ?)")) {
         qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (prepare saveTile):" << query.lastError().text();
         return false;
     }
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
     query.addBindValue(hash);
     query.addBindValue(format);
     query.addBindValue(img);
     query.addBindValue(img.size());
     query.addBindValue(UrlFactory::getQtMapIdFromProviderType(type));
-    query.addBindValue(QDateTime::currentSecsSinceEpoch());
+    query.addBindValue(now);
+    query.addBindValue(now);
     if (!query.exec()) {
         qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (saveTile INSERT):" << query.lastError().text();
         return false;
@@ -232,7 +289,7 @@ std::unique_ptr<QGCCacheTile> QGCTileCacheDatabase::getTile(const QString &hash)
     }
 
     QSqlQuery query(_database());
-    if (!query.prepare("SELECT tile, format, type FROM Tiles WHERE hash = ?")) {
+    if (!query.prepare("SELECT tile, format, type, tileID FROM Tiles WHERE hash = ?")) {
         return nullptr;
     }
     query.addBindValue(hash);
@@ -240,6 +297,7 @@ std::unique_ptr<QGCCacheTile> QGCTileCacheDatabase::getTile(const QString &hash)
         const QByteArray tileData = query.value(0).toByteArray();
         const QString format = query.value(1).toString();
         const QString type = UrlFactory::getProviderTypeFromQtMapId(query.value(2).toInt());
+        _recordTileAccess(query.value(3).toULongLong());
         qCDebug(QGCTileCacheDatabaseLog) << "(Found in DB) HASH:" << hash;
         return std::make_unique<QGCCacheTile>(hash, tileData, format, type);
     }
@@ -342,78 +400,22 @@ std::optional<quint64> QGCTileCacheDatabase::createTileSet(const QString &name,
 
     const quint64 setID = query.lastInsertId().toULongLong();
 
-    // Process tiles in streaming batches to avoid holding all coordinates in memory
-    constexpr int kHashBatchSize = 500;
-    const int mapTypeId = UrlFactory::getQtMapIdFromProviderType(type);
-
-    struct TileCoord { int x, y; QString hash; };
-
-    auto processBatch = [&](const QList<TileCoord> &tiles, int z) -> bool {
-        QHash<QString, quint64> existingTiles;
-        QSqlQuery lookup(_database());
-        lookup.setForwardOnly(true);
-        if (lookup.prepare(QStringLiteral("SELECT hash, tileID FROM Tiles WHERE hash IN (%1)").arg(QGCSqlHelper::placeholders(tiles.size())))) {
-            for (const auto &tc : tiles) {
-                lookup.addBindValue(tc.hash);
-            }
-            if (lookup.exec()) {
-                while (lookup.next()) {
-                    existingTiles.insert(lookup.value(0).toString(), lookup.value(1).toULongLong());
-                }
-            }
-        }
-
-        for (const auto &tc : tiles) {
-            auto it = existingTiles.find(tc.hash);
-            if (it != existingTiles.end()) {
-                if (!query.prepare("INSERT OR IGNORE INTO SetTiles(tileID, setID) VALUES(?, ?)")) {
-                    return false;
-                }
-                query.addBindValue(it.value());
-                query.addBindValue(setID);
-                if (!query.exec()) {
-                    qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (add tile into SetTiles):" << query.lastError().text();
-                    return false;
-                }
-            } else {
-                if (!query.prepare("INSERT OR IGNORE INTO TilesDownload(setID, hash, type, x, y, z, state) VALUES(?, ?, ?, ?, ?, ?, ?)")) {
-                    return false;
-                }
-                query.addBindValue(setID);
-                query.addBindValue(tc.hash);
-                query.addBindValue(mapTypeId);
-                query.addBindValue(tc.x);
-                query.addBindValue(tc.y);
-                query.addBindValue(z);
-                query.addBindValue(static_cast<int>(QGCTile::StatePending));
-                if (!query.exec()) {
-                    qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (add tile into TilesDownload):" << query.lastError().text();
-                    return false;
-                }
-            }
-        }
-        return true;
-    };
-
+    // One row per zoom level, the tiles themselves are only enumerated as they are handed out for download
+    if (!query.prepare("INSERT INTO TileSetRanges(setID, z, x0, x1, y0, y1, nextIndex) VALUES(?, ?, ?, ?, ?, ?, 0)")) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (prepare TileSetRanges):" << query.lastError().text();
+        return std::nullopt;
+    }
     for (int z = minZoom; z <= maxZoom; z++) {
         const QGCTileSet set = UrlFactory::getTileCount(z, topleftLon, topleftLat, bottomRightLon, bottomRightLat, type);
-
-        QList<TileCoord> batch;
-        batch.reserve(kHashBatchSize);
-
-        for (int x = set.tileX0; x <= set.tileX1; x++) {
-            for (int y = set.tileY0; y <= set.tileY1; y++) {
-                batch.append({x, y, UrlFactory::getTileHash(type, x, y, z)});
-
-                if (batch.size() >= kHashBatchSize) {
-                    if (!processBatch(batch, z)) return std::nullopt;
-                    batch.clear();
-                }
-            }
-        }
-
-        if (!batch.isEmpty()) {
-            if (!processBatch(batch, z)) return std::nullopt;
+        query.addBindValue(setID);
+        query.addBindValue(z);
+        query.addBindValue(set.tileX0);
+        query.addBindValue(set.tileX1);
+        query.addBindValue(set.tileY0);
+        query.addBindValue(set.tileY1);
+        if (!query.exec()) {
+            qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (add range into TileSetRanges):" << query.lastError().text();
+            return std::nullopt;
         }
     }
 
@@ -449,6 +451,15 @@ bool QGCTileCacheDatabase::deleteTileSet(quint64 id)
         return false;
     }
 
+    if (!query.prepare("DELETE FROM TileSetRanges WHERE setID = ?")) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Failed to prepare range delete:" << query.lastError().text();
+        return false;
+    }
+    query.addBindValue(id);
+    if (!query.exec()) {
+        return false;
+    }
+
     // Find tiles unique to this set (not shared with other sets)
     // Must collect IDs before deleting SetTiles links
     QList<quint64> uniqueTileIDs;
@@ -547,8 +558,12 @@ bool QGCTileCacheDatabase::resetDatabase()
         qCWarning(QGCTileCacheDatabaseLog) << "Failed to start transaction for resetDatabase";
         return false;
     }
+    _accessedTiles.clear();
+
     QSqlQuery query(_database());
-    if (!query.exec("DROP TABLE IF EXISTS TilesDownload") ||
+    if (!query.exec("DROP TABLE IF EXISTS CacheStats") ||
+        !query.exec("DROP TABLE IF EXISTS TileSetRanges") ||
+        !query.exec("DROP TABLE IF EXISTS TilesDownload") ||
         !query.exec("DROP TABLE IF EXISTS SetTiles") ||
         !query.exec("DROP TABLE IF EXISTS Tiles") ||
         !query.exec("DROP TABLE IF EXISTS TileSets")) {
@@ -563,9 +578,15 @@ bool QGCTileCacheDatabase::resetDatabase()
     return _valid;
 }
 
-QList<QGCTile> QGCTileCacheDatabase::getTileDownloadList(quint64 setID, int count)
+QList<QGCTile> QGCTileCacheDatabase::getTileDownloadList(quint64 setID, int count, quint32 *linkedTileCount, quint64 *linkedTileSize, bool *moreTiles)
 {
     QList<QGCTile> tiles;
+    quint32 linkedCount = 0;
+    quint64 linkedSize = 0;
+    bool rangesPending = false;
+    if (moreTiles) {
+        *moreTiles = false;
+    }
     if (!_ensureConnected()) {
         return tiles;
     }
@@ -613,9 +634,25 @@ QList<QGCTile> QGCTileCacheDatabase::getTileDownloadList(quint64 setID, int coun
         }
     }
 
+    if ((tiles.size() < count) && !_takeRangeTiles(setID, count - static_cast<int>(tiles.size()), tiles, linkedCount, linkedSize, rangesPending)) {
+        tiles.clear();
+        return tiles;
+    }
+
     if (!txn.commit()) {
         qCWarning(QGCTileCacheDatabaseLog) << "Failed to commit getTileDownloadList transaction";
         tiles.clear();
+        return tiles;
+    }
+
+    if (linkedTileCount) {
+        *linkedTileCount = linkedCount;
+    }
+    if (linkedTileSize) {
+        *linkedTileSize = linkedSize;
+    }
+    if (moreTiles) {
+        *moreTiles = rangesPending;
     }
 
     return tiles;
@@ -678,15 +715,18 @@ bool QGCTileCacheDatabase::pruneCache(quint64 amount)
         return false;
     }
 
+    // Recent reads must be visible to the ordering below
+    (void) _flushTileAccess();
+
     quint64 remaining = amount;
     while (remaining > 0) {
+        // Walks idx_tiles_lru: tiles no offline set holds on to, least recently used first
         QSqlQuery query(_database());
         query.setForwardOnly(true);
-        if (!query.prepare(QStringLiteral("SELECT tileID, size, hash FROM Tiles WHERE tileID IN (%1) ORDER BY date ASC LIMIT ?").arg(kUniqueTilesSubquery))) {
+        if (!query.prepare("SELECT tileID, size, hash FROM Tiles WHERE pinned = 0 ORDER BY lastAccess ASC LIMIT ?")) {
             qCWarning(QGCTileCacheDatabaseLog) << "Failed to prepare prune query:" << query.lastError().text();
             return false;
         }
-        query.addBindValue(_getDefaultTileSet());
         query.addBindValue(kPruneBatchSize);
         if (!query.exec()) {
             return false;
@@ -793,19 +833,13 @@ TotalsResult QGCTileCacheDatabase::computeTotals()
     }
 
     QSqlQuery query(_database());
-
-    if (query.exec("SELECT COUNT(size), SUM(size) FROM Tiles") && query.next()) {
+    if (query.exec("SELECT tileCount, tileSize, unpinnedCount, unpinnedSize FROM CacheStats WHERE id = 0") && query.next()) {
         result.totalCount = query.value(0).toUInt();
         result.totalSize = query.value(1).toULongLong();
-    }
-
-    if (!query.prepare(QStringLiteral("SELECT COUNT(size), SUM(size) FROM Tiles WHERE tileID IN (%1)").arg(kUniqueTilesSubquery))) {
-        return result;
-    }
-    query.addBindValue(_getDefaultTileSet());
-    if (query.exec() && query.next()) {
-        result.defaultCount = query.value(0).toUInt();
-        result.defaultSize = query.value(1).toULongLong();
+        result.defaultCount = query.value(2).toUInt();
+        result.defaultSize = query.value(3).toULongLong();
+    } else {
+        qCWarning(QGCTileCacheDatabaseLog) << "Failed to read CacheStats:" << query.lastError().text();
     }
 
     return result;
@@ -1149,7 +1183,7 @@ DatabaseResult QGCTileCacheDatabase::exportSets(const QList<TileSetRecord> &sets
             const quint64 tileDate = query.value(4).toULongLong();
 
             quint64 exportTileID = 0;
-            if (!exportQuery.prepare("INSERT INTO Tiles(hash, format, tile, size, type, date) VALUES(?, ?, ?, ?, ?, ?)")) {
+            if (!exportQuery.prepare("INSERT INTO Tiles(hash, format, tile, size, type, date, lastAccess) VALUES(?, ?, ?, ?, ?, ?, ?)")) {
                 qCWarning(QGCTileCacheDatabaseLog) << "Failed to prepare tile INSERT for export:" << exportQuery.lastError().text();
                 skippedTiles++;
                 continue;
@@ -1160,6 +1194,7 @@ DatabaseResult QGCTileCacheDatabase::exportSets(const QList<TileSetRecord> &sets
             exportQuery.addBindValue(img.size());
             exportQuery.addBindValue(tileType);
             exportQuery.addBindValue(tileDate);
+            exportQuery.addBindValue(tileDate);
             if (exportQuery.exec()) {
                 exportTileID = exportQuery.lastInsertId().toULongLong();
             } else {
@@ -1218,7 +1253,9 @@ bool QGCTileCacheDatabase::_createDB(QSqlDatabase db, bool createDefault)
         "tile BLOB NULL, "
         "size INTEGER, "
         "type INTEGER, "
-        "date INTEGER DEFAULT 0)"))
+        "date INTEGER DEFAULT 0, "
+        "lastAccess INTEGER DEFAULT 0, "
+        "pinned INTEGER DEFAULT 0)"))
     {
         qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (create Tiles db):" << query.lastError().text();
         return false;
@@ -1267,13 +1304,75 @@ bool QGCTileCacheDatabase::_createDB(QSqlDatabase db, bool createDefault)
         return false;
     }
 
+    if (!query.exec(
+        "CREATE TABLE IF NOT EXISTS TileSetRanges ("
+        "setID INTEGER NOT NULL REFERENCES TileSets(setID) ON DELETE CASCADE, "
+        "z INTEGER NOT NULL, "
+        "x0 INTEGER NOT NULL, "
+        "x1 INTEGER NOT NULL, "
+        "y0 INTEGER NOT NULL, "
+        "y1 INTEGER NOT NULL, "
+        "nextIndex INTEGER DEFAULT 0, "
+        "PRIMARY KEY(setID, z))"))
+    {
+        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (create TileSetRanges db):" << query.lastError().text();
+        return false;
+    }
+
+    // Single row of running totals. Seeded from Tiles the first time so migrated databases start out right.
+    if (!query.exec(
+        "CREATE TABLE IF NOT EXISTS CacheStats ("
+        "id INTEGER PRIMARY KEY CHECK (id = 0), "
+        "tileCount INTEGER NOT NULL DEFAULT 0, "
+        "tileSize INTEGER NOT NULL DEFAULT 0, "
+        "unpinnedCount INTEGER NOT NULL DEFAULT 0, "
+        "unpinnedSize INTEGER NOT NULL DEFAULT 0)") ||
+        !query.exec(
+        "INSERT OR IGNORE INTO CacheStats(id, tileCount, tileSize, unpinnedCount, unpinnedSize) "
+        "SELECT 0, COUNT(*), COALESCE(SUM(size), 0), COALESCE(SUM(pinned = 0), 0), "
+        "COALESCE(SUM(CASE WHEN pinned = 0 THEN size ELSE 0 END), 0) FROM Tiles"))
+    {
+        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (create CacheStats db):" << query.lastError().text();
+        return false;
+    }
+
+    // Tiles.pinned counts the non default sets holding a tile, only unpinned tiles can be evicted.
+    // deleteTileSet() removes SetTiles rows before their set, the lookup in TileSets relies on that.
+    static const char *triggerStatements[] = {
+        "CREATE TRIGGER IF NOT EXISTS trg_settiles_pin AFTER INSERT ON SetTiles "
+        "WHEN EXISTS (SELECT 1 FROM TileSets WHERE setID = NEW.setID AND defaultSet = 0) "
+        "BEGIN UPDATE Tiles SET pinned = pinned + 1 WHERE tileID = NEW.tileID; END",
+        "CREATE TRIGGER IF NOT EXISTS trg_settiles_unpin AFTER DELETE ON SetTiles "
+        "WHEN EXISTS (SELECT 1 FROM TileSets WHERE setID = OLD.setID AND defaultSet = 0) "
+        "BEGIN UPDATE Tiles SET pinned = pinned - 1 WHERE tileID = OLD.tileID AND pinned > 0; END",
+        "CREATE TRIGGER IF NOT EXISTS trg_tiles_stats_insert AFTER INSERT ON Tiles "
+        "BEGIN UPDATE CacheStats SET tileCount = tileCount + 1, tileSize = tileSize + COALESCE(NEW.size, 0), "
+        "unpinnedCount = unpinnedCount + (NEW.pinned = 0), "
+        "unpinnedSize = unpinnedSize + CASE WHEN NEW.pinned = 0 THEN COALESCE(NEW.size, 0) ELSE 0 END; END",
+        "CREATE TRIGGER IF NOT EXISTS trg_tiles_stats_delete AFTER DELETE ON Tiles "
+        "BEGIN UPDATE CacheStats SET tileCount = tileCount - 1, tileSize = tileSize - COALESCE(OLD.size, 0), "
+        "unpinnedCount = unpinnedCount - (OLD.pinned = 0), "
+        "unpinnedSize = unpinnedSize - CASE WHEN OLD.pinned = 0 THEN COALESCE(OLD.size, 0) ELSE 0 END; END",
+        "CREATE TRIGGER IF NOT EXISTS trg_tiles_stats_pin AFTER UPDATE OF pinned ON Tiles "
+        "WHEN (OLD.pinned = 0) <> (NEW.pinned = 0) "
+        "BEGIN UPDATE CacheStats SET "
+        "unpinnedCount = unpinnedCount + CASE WHEN NEW.pinned = 0 THEN 1 ELSE -1 END, "
+        "unpinnedSize = unpinnedSize + CASE WHEN NEW.pinned = 0 THEN COALESCE(NEW.size, 0) ELSE -COALESCE(NEW.size, 0) END; END",
+    };
+    for (const char *sql : triggerStatements) {
+        if (!query.exec(QLatin1String(sql))) {
+            qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (create trigger):" << query.lastError().text();
+            return false;
+        }
+    }
+
     static const char *indexStatements[] = {
         "CREATE UNIQUE INDEX IF NOT EXISTS idx_settiles_unique ON SetTiles(tileID, setID)",
         "CREATE INDEX IF NOT EXISTS idx_settiles_setid ON SetTiles(setID)",
         "CREATE INDEX IF NOT EXISTS idx_settiles_tileid ON SetTiles(tileID)",
         "CREATE UNIQUE INDEX IF NOT EXISTS idx_tilesdownload_setid_hash ON TilesDownload(setID, hash)",
         "CREATE INDEX IF NOT EXISTS idx_tilesdownload_setid_state ON TilesDownload(setID, state)",
-        "CREATE INDEX IF NOT EXISTS idx_tiles_date ON Tiles(date)",
+        "CREATE INDEX IF NOT EXISTS idx_tiles_lru ON Tiles(pinned, lastAccess)",
     };
     for (const char *sql : indexStatements) {
         if (!query.exec(QLatin1String(sql))) {
@@ -1353,6 +1452,179 @@ bool QGCTileCacheDatabase::_deleteTilesByIDs(const QList<quint64> &ids)
     return query.exec();
 }
 
+void QGCTileCacheDatabase::_recordTileAccess(quint64 tileID)
+{
+    // Batched so a map pan does not turn every cache hit into a write
+    _accessedTiles.insert(tileID);
+    if (_accessedTiles.size() >= kAccessFlushBatchSize) {
+        (void) _flushTileAccess();
+    }
+}
+
+bool QGCTileCacheDatabase::_flushTileAccess()
+{
+    if (_accessedTiles.isEmpty() || !_connected) {
+        return true;
+    }
+
+    const QList<quint64> ids(_accessedTiles.cbegin(), _accessedTiles.cend());
+    _accessedTiles.clear();
+
+    QSqlQuery query(_database());
+    if (!query.prepare(QStringLiteral("UPDATE Tiles SET lastAccess = ? WHERE tileID IN (%1)").arg(QGCSqlHelper::placeholders(ids.size())))) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Failed to prepare access update:" << query.lastError().text();
+        return false;
+    }
+    query.addBindValue(QDateTime::currentSecsSinceEpoch());
+    for (const quint64 id : ids) {
+        query.addBindValue(id);
+    }
+    if (!query.exec()) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (update lastAccess):" << query.lastError().text();
+        return false;
+    }
+
+    return true;
+}
+
+bool QGCTileCacheDatabase::_takeRangeTiles(quint64 setID, int count, QList<QGCTile> &tiles, quint32 &linkedTileCount, quint64 &linkedTileSize, bool &moreTiles)
+{
+    QSqlQuery query(_database());
+    if (!query.prepare("SELECT type FROM TileSets WHERE setID = ?")) {
+        return false;
+    }
+    query.addBindValue(setID);
+    if (!query.exec() || !query.next()) {
+        return false;
+    }
+    const int mapTypeId = query.value(0).toInt();
+    const QString type = UrlFactory::getProviderTypeFromQtMapId(mapTypeId);
+
+    struct Range { int z, x0, x1, y0, y1; qint64 nextIndex; };
+    QList<Range> ranges;
+    query.setForwardOnly(true);
+    if (!query.prepare("SELECT z, x0, x1, y0, y1, nextIndex FROM TileSetRanges "
+                       "WHERE setID = ? AND nextIndex < (x1 - x0 + 1) * (y1 - y0 + 1) ORDER BY z")) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Failed to prepare range query:" << query.lastError().text();
+        return false;
+    }
+    query.addBindValue(setID);
+    if (!query.exec()) {
+        return false;
+    }
+    while (query.next()) {
+        ranges.append({query.value(0).toInt(), query.value(1).toInt(), query.value(2).toInt(),
+                       query.value(3).toInt(), query.value(4).toInt(), query.value(5).toLongLong()});
+    }
+
+    struct TileCoord { int x, y; QString hash; };
+
+    int remaining = count;
+    // Mostly cached sets would otherwise be linked in one go, stop early and let the next call carry on
+    qint64 walkBudget = kRangeTilesPerCall;
+    for (Range &range : ranges) {
+        const qint64 height = range.y1 - range.y0 + 1;
+        const qint64 rangeCount = (range.x1 - range.x0 + 1) * height;
+
+        while ((remaining > 0) && (walkBudget > 0) && (range.nextIndex < rangeCount)) {
+            // Same x-major order the tile sets were always downloaded in
+            QList<TileCoord> batch;
+            const qint64 batchEnd = qMin(rangeCount, range.nextIndex + qMin<qint64>(kRangeLookupBatchSize, walkBudget));
+            for (qint64 index = range.nextIndex; index < batchEnd; index++) {
+                const int x = range.x0 + static_cast<int>(index / height);
+                const int y = range.y0 + static_cast<int>(index % height);
+                batch.append({x, y, UrlFactory::getTileHash(type, x, y, range.z)});
+            }
+
+            struct ExistingTile { quint64 tileID; quint64 size; };
+            QHash<QString, ExistingTile> existingTiles;
+            if (query.prepare(QStringLiteral("SELECT hash, tileID, size FROM Tiles WHERE hash IN (%1)").arg(QGCSqlHelper::placeholders(batch.size())))) {
+                for (const TileCoord &tc : std::as_const(batch)) {
+                    query.addBindValue(tc.hash);
+                }
+                if (query.exec()) {
+                    while (query.next()) {
+                        existingTiles.insert(query.value(0).toString(), ExistingTile{query.value(1).toULongLong(), query.value(2).toULongLong()});
+                    }
+                }
+            }
+
+            qsizetype consumed = 0;
+            for (const TileCoord &tc : std::as_const(batch)) {
+                const auto it = existingTiles.constFind(tc.hash);
+                if (it != existingTiles.constEnd()) {
+                    // Already cached, it only needs to become part of the set
+                    if (!query.prepare("INSERT OR IGNORE INTO SetTiles(tileID, setID) VALUES(?, ?)")) {
+                        return false;
+                    }
+                    query.addBindValue(it->tileID);
+                    query.addBindValue(setID);
+                    if (!query.exec()) {
+                        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (add tile into SetTiles):" << query.lastError().text();
+                        return false;
+                    }
+                    if (query.numRowsAffected() > 0) {
+                        linkedTileCount++;
+                        linkedTileSize += it->size;
+                    }
+                } else {
+                    if (remaining == 0) {
+                        break;
+                    }
+                    if (!query.prepare("INSERT OR IGNORE INTO TilesDownload(setID, hash, type, x, y, z, state) VALUES(?, ?, ?, ?, ?, ?, ?)")) {
+                        return false;
+                    }
+                    query.addBindValue(setID);
+                    query.addBindValue(tc.hash);
+                    query.addBindValue(mapTypeId);
+                    query.addBindValue(tc.x);
+                    query.addBindValue(tc.y);
+                    query.addBindValue(range.z);
+                    query.addBindValue(static_cast<int>(QGCTile::StateDownloading));
+                    if (!query.exec()) {
+                        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (add tile into TilesDownload):" << query.lastError().text();
+                        return false;
+                    }
+                    if (query.numRowsAffected() > 0) {
+                        QGCTile tile;
+                        tile.hash = tc.hash;
+                        tile.type = mapTypeId;
+                        tile.x = tc.x;
+                        tile.y = tc.y;
+                        tile.z = range.z;
+                        tiles.append(std::move(tile));
+                        remaining--;
+                    }
+                }
+                consumed++;
+            }
+            range.nextIndex += consumed;
+            walkBudget -= consumed;
+        }
+
+        if (!query.prepare("UPDATE TileSetRanges SET nextIndex = ? WHERE setID = ? AND z = ?")) {
+            return false;
+        }
+        query.addBindValue(range.nextIndex);
+        query.addBindValue(setID);
+        query.addBindValue(range.z);
+        if (!query.exec()) {
+            qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (advance TileSetRanges cursor):" << query.lastError().text();
+            return false;
+        }
+
+        if ((remaining == 0) || (walkBudget <= 0)) {
+            break;
+        }
+    }
+
+    moreTiles = std::any_of(ranges.cbegin(), ranges.cend(), [](const Range &range) {
+        return range.nextIndex < (static_cast<qint64>(range.x1 - range.x0 + 1) * (range.y1 - range.y0 + 1));
+    });
+
+    return true;
+}
+
 QString QGCTileCacheDatabase::_deduplicateSetName(const QString &name)
 {
     if (!findTileSetID(name).has_value()) {
@@ -1426,13 +1698,14 @@ quint64 QGCTileCacheDatabase::_copyTilesForSet(QSqlDatabase srcDB, quint64 srcSe
         const quint64 tileDate = subQuery.value(4).toULongLong();
 
         quint64 importTileID = 0;
-        if (cQuery.prepare("INSERT INTO Tiles(hash, format, tile, size, type, date) VALUES(?, ?, ?, ?, ?, ?)")) {
+        if (cQuery.prepare("INSERT INTO Tiles(hash, format, tile, size, type, date, lastAccess) VALUES(?, ?, ?, ?, ?, ?, ?)")) {
             cQuery.addBindValue(hash);
             cQuery.addBindValue(format);
             cQuery.addBindValue(img);
             cQuery.addBindValue(img.size());
             cQuery.addBindValue(tileType);
             cQuery.addBindValue(tileDate);
+            cQuery.addBindValue(tileDate);
             if (cQuery.exec()) {
                 importTileID = cQuery.lastInsertId().toULongLong();
             } else {
@@ -2,6 +2,7 @@
 
 #include <QtCore/QByteArray>
 #include <QtCore/QList>
+#include <QtCore/QSet>
 #include <QtCore/QString>
 
 #include <memory>
@@ -17,7 +18,8 @@ class QGCTileCacheDatabase
 {
 public:
     static constexpr quint64 kInvalidTileSet = UINT64_MAX;
-    static constexpr int kSchemaVersion = 1;
+    static constexpr int kSchemaVersion = 3;      ///< 2: per zoom ranges (TileSetRanges), 3: LRU access tracking (CacheStats)
+    static constexpr int kRangeTilesPerCall = 2000;   ///< Range tiles walked per getTileDownloadList call, bounds the transaction when most are cached
 
     explicit QGCTileCacheDatabase(const QString &databasePath);
     ~QGCTileCacheDatabase();
@@ -46,15 +48,21 @@ class QGCTileCacheDatabase
     bool resetDatabase();
 
     // Downloads
-    QList<QGCTile> getTileDownloadList(quint64 setID, int count);
+    /// Hands out up to count tiles to download. Pending retries come first, then the set's ranges are walked
+    /// from their cursors; tiles found in the cache on the way are linked to the set instead and reported
+    /// through linkedTileCount/linkedTileSize. A call walks at most kRangeTilesPerCall range tiles, so fewer
+    /// tiles than requested, even none, may be returned while moreTiles says the ranges are not exhausted yet.
+    QList<QGCTile> getTileDownloadList(quint64 setID, int count, quint32 *linkedTileCount = nullptr, quint64 *linkedTileSize = nullptr, bool *moreTiles = nullptr);
     bool updateTileDownloadState(quint64 setID, int state, const QString &hash);
     bool updateAllTileDownloadStates(quint64 setID, int state);
 
     // Cache
+    /// Evicts the least recently used tiles which belong to no offline set until amount bytes are freed
     bool pruneCache(quint64 amount);
     void deleteBingNoTileTiles();
 
     // Stats
+    /// Reads the running counters kept up to date by the CacheStats triggers
     TotalsResult computeTotals();
     SetTotalsResult computeSetTotals(quint64 setID, bool isDefault, quint32 totalTileCount, const QString &type);
 
@@ -72,9 +80,13 @@ class QGCTileCacheDatabase
     bool _ensureConnected() const;
     QSqlDatabase _database() const;
     bool _checkSchemaVersion();
+    bool _migrateAccessTracking(QSqlDatabase db);
     bool _createDB(QSqlDatabase db, bool createDefault = true);
     quint64 _getDefaultTileSet();
     bool _deleteTilesByIDs(const QList<quint64> &ids);
+    void _recordTileAccess(quint64 tileID);
+    bool _flushTileAccess();
+    bool _takeRangeTiles(quint64 setID, int count, QList<QGCTile> &tiles, quint32 &linkedTileCount, quint64 &linkedTileSize, bool &moreTiles);
     QString _deduplicateSetName(const QString &name);
     quint64 _copyTilesForSet(QSqlDatabase srcDB, quint64 srcSetID, quint64 dstSetID,
                               quint64 &currentCount, quint64 tileCount,
@@ -87,7 +99,10 @@ class QGCTileCacheDatabase
     bool _connected = false;
     bool _valid = false;
     bool _failed = false;
+    QSet<quint64> _accessedTiles;     ///< Tiles read since the last lastAccess flush
     static constexpr int kPruneBatchSize = 128;
+    static constexpr int kAccessFlushBatchSize = 256;
+    static constexpr int kRangeLookupBatchSize = 500;
     static constexpr const char *kUniqueTilesSubquery =
         "SELECT A.tileID FROM SetTiles A JOIN SetTiles B ON A.tileID = B.tileID "
         "WHERE B.setID = ? GROUP BY A.tileID HAVING COUNT(A.tileID) = 1";
@@ -302,12 +302,15 @@ void QGCCacheWorker::_getTileDownloadList(QGCMapTask *mtask)
     }
 
     QGCGetTileDownloadListTask *task = static_cast<QGCGetTileDownloadListTask*>(mtask);
-    const QList<QGCTile> tileValues = _database->getTileDownloadList(task->setID(), task->count());
+    quint32 linkedTileCount = 0;
+    quint64 linkedTileSize = 0;
+    bool moreTiles = false;
+    const QList<QGCTile> tileValues = _database->getTileDownloadList(task->setID(), task->count(), &linkedTileCount, &linkedTileSize, &moreTiles);
     QQueue<QGCTile*> tiles;
     for (const auto &t : tileValues) {
         tiles.enqueue(new QGCTile(t));
     }
-    task->setTileListFetched(tiles);
+    task->setTileListFetched(tiles, linkedTileCount, linkedTileSize, moreTiles);
 }
 
 void QGCCacheWorker::_updateTileDownloadState(QGCMapTask *mtask)
@@ -8,3 +8,7 @@ DECLARE_SETTINGGROUP(ADSBVehicleManager, "ADSBVehicleManager")
 DECLARE_SETTINGSFACT(ADSBVehicleManagerSettings, adsbServerConnectEnabled)
 DECLARE_SETTINGSFACT(ADSBVehicleManagerSettings, adsbServerHostAddress)
 DECLARE_SETTINGSFACT(ADSBVehicleManagerSettings, adsbServerPort)
+DECLARE_SETTINGSFACT(ADSBVehicleManagerSettings, adsbDisplayRange)
+DECLARE_SETTINGSFACT(ADSBVehicleManagerSettings, adsbConflictHorizontalSeparation)
+DECLARE_SETTINGSFACT(ADSBVehicleManagerSettings, adsbConflictVerticalSeparation)
+DECLARE_SETTINGSFACT(ADSBVehicleManagerSettings, adsbConflictLookahead)
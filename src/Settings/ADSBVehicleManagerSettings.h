@@ -16,4 +16,8 @@ class ADSBVehicleManagerSettings : public SettingsGroup
     DEFINE_SETTINGFACT(adsbServerConnectEnabled)
     DEFINE_SETTINGFACT(adsbServerHostAddress)
     DEFINE_SETTINGFACT(adsbServerPort)
+    DEFINE_SETTINGFACT(adsbDisplayRange)
+    DEFINE_SETTINGFACT(adsbConflictHorizontalSeparation)
+    DEFINE_SETTINGFACT(adsbConflictVerticalSeparation)
+    DEFINE_SETTINGFACT(adsbConflictLookahead)
 };
@@ -157,6 +157,20 @@ SettingsGroupLayout {
                     onCheckedChanged:   editingConfig.highLatency = checked
                 }
 
+                RowLayout {
+                    Layout.fillWidth:   true
+                    spacing:            ScreenTools.defaultFontPixelWidth
+
+                    QGCLabel { text: qsTr("Outbound Limit (bytes/s, 0 = unlimited)") }
+                    QGCTextField {
+                        Layout.fillWidth:   true
+                        text:               editingConfig.outboundBytesPerSecond.toString()
+                        inputMethodHints:   Qt.ImhDigitsOnly
+                        validator:          IntValidator { bottom: 0 }
+                        onEditingFinished:  editingConfig.outboundBytesPerSecond = parseInt(text) || 0
+                    }
+                }
+
                 LabelledComboBox {
                     label:                  qsTr("Type")
                     enabled:                originalConfig == null
@@ -48,6 +48,18 @@ QString QGCFileWriter::filePath() const
     return _filePath;
 }
 
+void QGCFileWriter::setTextMode(bool textMode)
+{
+    const QMutexLocker locker(&_mutex);
+    _textMode = textMode;
+}
+
+bool QGCFileWriter::textMode() const
+{
+    const QMutexLocker locker(&_mutex);
+    return _textMode;
+}
+
 bool QGCFileWriter::isRunning() const
 {
     const QMutexLocker locker(&_mutex);
@@ -165,13 +177,17 @@ void QGCFileWriter::_stop()
 void QGCFileWriter::_workerLoop()
 {
     QString path;
+    QIODevice::OpenMode openMode = QIODevice::WriteOnly | QIODevice::Append;
     {
         const QMutexLocker locker(&_mutex);
         path = _filePath;
+        if (_textMode) {
+            openMode |= QIODevice::Text;
+        }
     }
 
     QFile file(path);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+    if (!file.open(openMode)) {
         const QMutexLocker locker(&_mutex);
         _lastError = file.errorString();
         _hasError.store(true, std::memory_order_relaxed);
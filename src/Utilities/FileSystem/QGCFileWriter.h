@@ -39,6 +39,10 @@ class QGCFileWriter : public QObject
     void close();
     void clearError();
 
+    /// Text mode (the default) translates line endings, turn it off for binary files. Takes effect when the file is next opened.
+    void setTextMode(bool textMode);
+    bool textMode() const;
+
     void setMaxPendingBytes(qint64 max) { _maxPendingBytes = max; }
     qint64 maxPendingBytes() const { return _maxPendingBytes; }
 
@@ -62,6 +66,7 @@ class QGCFileWriter : public QObject
 
     QString _filePath;
     QString _lastError;
+    bool _textMode = true;
 
     QThread *_thread = nullptr;
     std::atomic<bool> _isOpen{false};
@@ -7,6 +7,7 @@
 
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 #include <QtCore/QRegularExpression>
 
 QGC_LOGGING_CATEGORY(CompInfoParamLog, "ComponentInformation.CompInfoParam")
@@ -56,16 +57,21 @@ void CompInfoParam::setJson(const QString &metadataJsonFileName)
             return;
         }
 
-        FactMetaData *newMetaData = FactMetaData::createFromJsonObject(parameterValue.toObject(), ParameterMetaData::kEmptyDefines, this);
+        const QJsonObject parameterObject = parameterValue.toObject();
+        const QString name = parameterObject.value(QStringLiteral("name")).toString();
 
-        if (newMetaData->name().contains(kIndexedNameTag)) {
+        if (name.contains(kIndexedNameTag)) {
+            FactMetaData *newMetaData = FactMetaData::createFromJsonObject(parameterObject, ParameterMetaData::kEmptyDefines, this);
             QString regexPattern = QRegularExpression::escape(newMetaData->name());
             regexPattern.replace(escapedTag, QStringLiteral("(\\d+)"));
             _indexedNameMetaDataList.append({QRegularExpression(QStringLiteral("^%1$").arg(regexPattern)), newMetaData});
-        } else {
-            _nameToMetaDataMap[newMetaData->name()] = newMetaData;
+        } else if (!name.isEmpty()) {
+            // Built on first request, most parameters are never displayed
+            _nameToJsonMap[name] = parameterObject;
         }
     }
+
+    qCDebug(CompInfoParamLog) << "Indexed" << _nameToJsonMap.count() << "parameters" << _indexedNameMetaDataList.count() << "indexed names: compid:" << compId;
 }
 
 FactMetaData *CompInfoParam::factMetaDataForName(const QString &name, FactMetaData::ValueType_t valueType)
@@ -107,6 +113,16 @@ FactMetaData *CompInfoParam::_resolveMetaData(const QString &name, FactMetaData:
 
 FactMetaData *CompInfoParam::_lookupJsonMetaData(const QString &name)
 {
+    auto it = _nameToJsonMap.constFind(name);
+    if (it != _nameToJsonMap.constEnd()) {
+        FactMetaData *factMetaData = FactMetaData::createFromJsonObject(*it, ParameterMetaData::kEmptyDefines, this);
+        if (!factMetaData->name().isEmpty()) {
+            return factMetaData;
+        }
+        qCWarning(CompInfoParamLog) << "Invalid metadata json for" << name << "compid:" << compId;
+        delete factMetaData;
+    }
+
     // Try indexed name patterns (e.g. "CAL_GYRO{n}_ID" matches "CAL_GYRO0_ID")
     for (const auto &[regex, templateMeta] : _indexedNameMetaDataList) {
         const QRegularExpressionMatch match = regex.match(name);
@@ -3,6 +3,8 @@
 #include "CompInfo.h"
 #include "FactMetaData.h"
 
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
 #include <QtCore/QRegularExpression>
 
 class ParameterMetaData;
@@ -30,6 +32,7 @@ class CompInfoParam : public CompInfo
 
     bool _noJsonMetadata = true;
     FactMetaData::NameToMetaDataMap_t _nameToMetaDataMap;
+    QHash<QString, QJsonObject> _nameToJsonMap;     ///< Vehicle provided json per parameter, materialized on first request
     QList<IndexedParamEntry> _indexedNameMetaDataList;
     ParameterMetaData *_parameterMetaData = nullptr;
 
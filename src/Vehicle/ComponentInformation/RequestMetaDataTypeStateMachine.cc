@@ -500,15 +500,13 @@ void RequestMetaDataTypeStateMachine::_requestFile(const QString& cacheFileTag,
             _metadataSource = MetadataSource::FTP;
             _metadataUri = uri;
         }
-        connect(ftpManager, &FTPManager::downloadComplete, this, &RequestMetaDataTypeStateMachine::_ftpDownloadComplete);
-        if (ftpManager->download(MAV_COMP_ID_AUTOPILOT1, uri, QStandardPaths::writableLocation(QStandardPaths::TempLocation))) {
-            _downloadStartTime.start();
-            connect(ftpManager, &FTPManager::commandProgress, this, &RequestMetaDataTypeStateMachine::_ftpDownloadProgress);
-        } else {
-            qCWarning(RequestMetaDataTypeStateMachineLog) << "FTPManager::download returned failure";
-            disconnect(ftpManager, &FTPManager::downloadComplete, this, &RequestMetaDataTypeStateMachine::_ftpDownloadComplete);
-            completeCurrentState();
-        }
+        // Queued so that it waits for, or pauses, other FTP traffic such as log downloads instead of failing.
+        // The download time used to detect slow links only starts with the first progress of our download.
+        _downloadStartTime.invalidate();
+        connect(ftpManager, &FTPManager::commandProgress, this, &RequestMetaDataTypeStateMachine::_ftpDownloadProgress);
+        ftpManager->queueDownload(FTPManager::Priority::Normal, this,
+                                  [this](const QString& fileName, const QString& errorMsg) { _ftpDownloadComplete(fileName, errorMsg); },
+                                  MAV_COMP_ID_AUTOPILOT1, uri, QStandardPaths::writableLocation(QStandardPaths::TempLocation));
     } else {
         if (trackMetadataSource) {
             _metadataSource = MetadataSource::HTTP;
@@ -546,7 +544,6 @@ void RequestMetaDataTypeStateMachine::_ftpDownloadComplete(const QString& fileNa
 {
     qCDebug(RequestMetaDataTypeStateMachineLog) << "_ftpDownloadComplete fileName:errorMsg" << fileName << errorMsg;
 
-    disconnect(_compInfo->vehicle->ftpManager(), &FTPManager::downloadComplete, this, &RequestMetaDataTypeStateMachine::_ftpDownloadComplete);
     disconnect(_compInfo->vehicle->ftpManager(), &FTPManager::commandProgress, this, &RequestMetaDataTypeStateMachine::_ftpDownloadProgress);
 
     if (errorMsg.isEmpty()) {
@@ -566,6 +563,15 @@ void RequestMetaDataTypeStateMachine::_ftpDownloadComplete(const QString& fileNa
 
 void RequestMetaDataTypeStateMachine::_ftpDownloadProgress(float progress)
 {
+    FTPManager* ftpManager = _compInfo->vehicle->ftpManager();
+    if (ftpManager->activeOperationContext() != this) {
+        // Progress of an operation queued ahead of ours
+        return;
+    }
+    if (!_downloadStartTime.isValid()) {
+        _downloadStartTime.start();
+    }
+
     int elapsedSec = _downloadStartTime.elapsed() / 1000;
     float totalDownloadTime = elapsedSec / progress;
 
@@ -573,7 +579,7 @@ void RequestMetaDataTypeStateMachine::_ftpDownloadProgress(float progress)
     const int maxDownloadTimeSec = 40;
     if (elapsedSec > 10 && progress < 0.5 && totalDownloadTime > maxDownloadTimeSec) {
         qCDebug(RequestMetaDataTypeStateMachineLog) << "Slow download, aborting. Total time (s):" << totalDownloadTime;
-        _compInfo->vehicle->ftpManager()->cancelDownload();
+        ftpManager->cancelQueuedOperations(this);
     }
 }
 
@@ -22,12 +22,10 @@ FTPController::FTPController(QObject *parent)
     , _ftpManager(_vehicle->ftpManager())
     , _archiveModel(new QGCArchiveModel(this))
 {
-    connect(_ftpManager, &FTPManager::downloadComplete, this, &FTPController::_handleDownloadComplete);
-    connect(_ftpManager, &FTPManager::downloadComplete, this, &FTPController::downloadComplete);
-    connect(_ftpManager, &FTPManager::uploadComplete, this, &FTPController::_handleUploadComplete);
-    connect(_ftpManager, &FTPManager::uploadComplete, this, &FTPController::uploadComplete);
-    connect(_ftpManager, &FTPManager::listDirectoryComplete, this, &FTPController::_handleDirectoryComplete);
+    // Downloads, uploads and directory listings are queued with interactive priority and report back through
+    // callbacks, so completions of other clients' FTP operations are never mistaken for ours.
     connect(_ftpManager, &FTPManager::commandProgress, this, &FTPController::_handleCommandProgress);
+    connect(_ftpManager, &FTPManager::transferStatsChanged, this, &FTPController::_handleTransferStatsChanged);
     connect(_ftpManager, &FTPManager::deleteComplete, this, &FTPController::_handleDeleteComplete);
     connect(_ftpManager, &FTPManager::deleteComplete, this, &FTPController::deleteComplete);
 }
@@ -39,8 +37,6 @@ bool FTPController::listDirectory(const QString &uri, int componentId)
         return false;
     }
 
-    const QString previousPath = _currentPath;
-
     _resetDirectoryState();
     _currentPath = uri;
     emit currentPathChanged();
@@ -52,15 +48,11 @@ bool FTPController::listDirectory(const QString &uri, int componentId)
     emit progressChanged();
 
     const uint8_t compId = _componentIdForRequest(componentId);
-    if (!_ftpManager->listDirectory(compId, uri)) {
-        qCWarning(FTPControllerLog) << "Failed to start list operation for" << uri;
-        _setErrorString(tr("Failed to list %1").arg(uri));
-        _currentPath = previousPath;
-        emit currentPathChanged();
-        _setBusy(false);
-        _clearOperation();
-        return false;
-    }
+    _ftpManager->queueListDirectory(FTPManager::Priority::Interactive, this,
+        [this](const QStringList &entries, const QString &error) {
+            _handleDirectoryComplete(entries, error);
+        },
+        compId, uri);
 
     return true;
 }
@@ -91,17 +83,17 @@ bool FTPController::downloadFile(const QString &uri, const QString &localDir, co
     _setOperation(Operation::Download);
     _progress = 0.0F;
     emit progressChanged();
+    _transferRate = 0.0;
+    _retransmitCount = 0;
+    emit transferStatsChanged();
 
     const uint8_t compId = _componentIdForRequest(componentId);
-    if (!_ftpManager->download(compId, uri, absoluteLocalDir, fileName)) {
-        qCWarning(FTPControllerLog) << "Failed to start download" << uri << absoluteLocalDir;
-        const QString error = tr("Failed to download %1").arg(uri);
-        _setErrorString(error);
-        _setBusy(false);
-        _clearOperation();
-        emit downloadComplete(QString(), error);
-        return false;
-    }
+    _ftpManager->queueDownload(FTPManager::Priority::Interactive, this,
+        [this](const QString &filePath, const QString &error) {
+            _handleDownloadComplete(filePath, error);
+            emit downloadComplete(filePath, error);
+        },
+        compId, uri, absoluteLocalDir, fileName);
 
     return true;
 }
@@ -131,17 +123,17 @@ bool FTPController::uploadFile(const QString &localFile, const QString &uri, int
     _setOperation(Operation::Upload);
     _progress = 0.0F;
     emit progressChanged();
+    _transferRate = 0.0;
+    _retransmitCount = 0;
+    emit transferStatsChanged();
 
     const uint8_t compId = _componentIdForRequest(componentId);
-    if (!_ftpManager->upload(compId, uri, sourceInfo.absoluteFilePath())) {
-        qCWarning(FTPControllerLog) << "Failed to start upload" << sourceInfo.absoluteFilePath() << uri;
-        const QString error = tr("Failed to upload %1").arg(sourceInfo.fileName());
-        _setErrorString(error);
-        _setBusy(false);
-        _clearOperation();
-        emit uploadComplete(QString(), error);
-        return false;
-    }
+    _ftpManager->queueUpload(FTPManager::Priority::Interactive, this,
+        [this](const QString &remotePath, const QString &error) {
+            _handleUploadComplete(remotePath, error);
+            emit uploadComplete(remotePath, error);
+        },
+        compId, uri, sourceInfo.absoluteFilePath());
 
     return true;
 }
@@ -177,13 +169,9 @@ void FTPController::cancelActiveOperation()
 {
     switch (_operation) {
     case Operation::Download:
-        _ftpManager->cancelDownload();
-        break;
     case Operation::Upload:
-        _ftpManager->cancelUpload();
-        break;
     case Operation::List:
-        _ftpManager->cancelListDirectory();
+        _ftpManager->cancelQueuedOperations(this);
         break;
     case Operation::Delete:
         _ftpManager->cancelDelete();
@@ -282,7 +270,8 @@ void FTPController::_handleDeleteComplete(const QString &remotePath, const QStri
 
 void FTPController::_handleCommandProgress(float value)
 {
-    if (_operation == Operation::Download || _operation == Operation::Upload) {
+    // A queued transfer may still be waiting behind another client's transfer
+    if (_ownsActiveTransfer()) {
         if (std::fabs(_progress - value) > std::numeric_limits<float>::epsilon()) {
             _progress = value;
             emit progressChanged();
@@ -290,6 +279,27 @@ void FTPController::_handleCommandProgress(float value)
     }
 }
 
+void FTPController::_handleTransferStatsChanged()
+{
+    if (!_ownsActiveTransfer()) {
+        return;
+    }
+
+    const FTPManager::TransferStats_t &stats = _ftpManager->transferStats();
+    const int retransmits = static_cast<int>(stats.retransmits);
+    const double rate = stats.bytesPerSecond();
+    if ((_retransmitCount != retransmits) || (std::fabs(_transferRate - rate) > std::numeric_limits<double>::epsilon())) {
+        _retransmitCount = retransmits;
+        _transferRate = rate;
+        emit transferStatsChanged();
+    }
+}
+
+bool FTPController::_ownsActiveTransfer() const
+{
+    return ((_operation == Operation::Download) || (_operation == Operation::Upload)) && (_ftpManager->activeOperationContext() == this);
+}
+
 void FTPController::_setBusy(bool busy)
 {
     if (_busy == busy) {
@@ -27,6 +27,8 @@ class FTPController : public QObject
     Q_PROPERTY(bool uploadInProgress READ uploadInProgress NOTIFY activeOperationChanged)
     Q_PROPERTY(bool deleteInProgress READ deleteInProgress NOTIFY activeOperationChanged)
     Q_PROPERTY(float progress READ progress NOTIFY progressChanged)
+    Q_PROPERTY(double transferRate READ transferRate NOTIFY transferStatsChanged)
+    Q_PROPERTY(int retransmitCount READ retransmitCount NOTIFY transferStatsChanged)
     Q_PROPERTY(QString errorString READ errorString NOTIFY errorStringChanged)
     Q_PROPERTY(QString currentPath READ currentPath NOTIFY currentPathChanged)
     Q_PROPERTY(QStringList directoryEntries READ directoryEntries NOTIFY directoryEntriesChanged)
@@ -46,6 +48,10 @@ class FTPController : public QObject
     bool uploadInProgress() const { return _operation == Operation::Upload; }
     bool deleteInProgress() const { return _operation == Operation::Delete; }
     float progress() const { return _progress; }
+    /// Average transfer rate of the active (or last) download/upload in bytes per second
+    double transferRate() const { return _transferRate; }
+    /// Number of requests which had to be re-sent during the active (or last) download/upload
+    int retransmitCount() const { return _retransmitCount; }
     QString errorString() const { return _errorString; }
     QString currentPath() const { return _currentPath; }
     QStringList directoryEntries() const { return _directoryEntries; }
@@ -80,6 +86,7 @@ class FTPController : public QObject
     void busyChanged();
     void activeOperationChanged();
     void progressChanged();
+    void transferStatsChanged();
     void errorStringChanged();
     void currentPathChanged();
     void directoryEntriesChanged();
@@ -98,6 +105,7 @@ private slots:
     void _handleDirectoryComplete(const QStringList &entries, const QString &error);
     void _handleDeleteComplete(const QString &remotePath, const QString &error);
     void _handleCommandProgress(float value);
+    void _handleTransferStatsChanged();
     void _handleExtractionProgress(qreal progress);
     void _handleExtractionFinished(bool success);
 
@@ -110,6 +118,7 @@ private slots:
         Delete,
     };
 
+    bool _ownsActiveTransfer() const;
     void _setBusy(bool busy);
     void _setOperation(Operation operation);
     void _clearOperation();
@@ -122,6 +131,8 @@ private slots:
     Operation _operation = Operation::None;
     bool _busy = false;
     float _progress = 0.0F;
+    double _transferRate = 0.0;
+    int _retransmitCount = 0;
     QString _errorString;
     QString _currentPath;
     QStringList _directoryEntries;
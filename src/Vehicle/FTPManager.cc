@@ -28,11 +28,17 @@ FTPManager::FTPManager(Vehicle* vehicle)
 }
 
 bool FTPManager::download(uint8_t fromCompId, const QString& fromURI, const QString& toDir, const QString& fileName, bool checksize)
+{
+    return _download(fromCompId, fromURI, toDir, fileName, checksize, 0 /* resumeOffset */);
+}
+
+bool FTPManager::_download(uint8_t fromCompId, const QString& fromURI, const QString& toDir, const QString& fileName, bool checksize, uint32_t resumeOffset)
 {
     qCDebug(FTPManagerLog) << "Download fromCompId:" << fromCompId
         << "fromURI:" << fromURI
         << "to:" << toDir
-        << "fileName:" << fileName;
+        << "fileName:" << fileName
+        << "resumeOffset:" << resumeOffset;
 
     if (!_rgStateMachine.isEmpty()) {
         qCDebug(FTPManagerLog) << "Cannot download. Already in another operation";
@@ -51,11 +57,14 @@ bool FTPManager::download(uint8_t fromCompId, const QString& fromURI, const QStr
     }
 
     _downloadState.reset();
+    _resetTransferStats();
     _downloadState.toDir.setPath(toDir);
     _downloadState.checksize = checksize;
+    _downloadState.resumeOffset = resumeOffset;
 
     if (!_parseURI(fromCompId, fromURI, _downloadState.fullPathOnVehicle, _ftpCompId)) {
         qCWarning(FTPManagerLog) << "_parseURI failed";
+        _rgStateMachine.clear();
         return false;
     }
 
@@ -103,6 +112,7 @@ bool FTPManager::upload(uint8_t toCompId, const QString& toURI, const QString& f
     }
 
     _uploadState.reset();
+    _resetTransferStats();
     _uploadState.localFilePath = fromFile;
     _uploadState.file.setFileName(fromFile);
     if (!_uploadState.file.open(QFile::ReadOnly)) {
@@ -160,6 +170,8 @@ bool FTPManager::listDirectory(uint8_t fromCompId, const QString& fromURI)
 
     if (!_parseURI(fromCompId, fromURI, _listDirectoryState.fullPathOnVehicle, _ftpCompId)) {
         qCWarning(FTPManagerLog) << "_parseURI failed";
+        _rgStateMachine.clear();
+        _listDirectoryState.reset();
         return false;
     }
 
@@ -202,6 +214,246 @@ bool FTPManager::deleteFile(uint8_t fromCompId, const QString& fromURI)
     return true;
 }
 
+bool FTPManager::calcFileCRC32(uint8_t fromCompId, const QString& fromURI)
+{
+    qCDebug(FTPManagerLog) << "calc file crc32 fromURI:" << fromURI << "fromCompId:" << fromCompId;
+
+    if (!_rgStateMachine.isEmpty()) {
+        qCDebug(FTPManagerLog) << "Cannot calc file crc32. Already in another operation";
+        return false;
+    }
+
+    static const StateFunctions_t rgStateMachine[] = {
+        { &FTPManager::_calcFileCRC32Begin,             &FTPManager::_calcFileCRC32AckOrNak,    &FTPManager::_calcFileCRC32Timeout },
+        { &FTPManager::_calcFileCRC32CompleteNoError,   nullptr,                                nullptr },
+    };
+    for (size_t i=0; i<sizeof(rgStateMachine)/sizeof(rgStateMachine[0]); i++) {
+        _rgStateMachine.append(rgStateMachine[i]);
+    }
+
+    _calcFileCRC32State.reset();
+
+    if (!_parseURI(fromCompId, fromURI, _calcFileCRC32State.fullPathOnVehicle, _ftpCompId)) {
+        qCWarning(FTPManagerLog) << "_parseURI failed";
+        _rgStateMachine.clear();
+        return false;
+    }
+
+    _startStateMachine();
+
+    return true;
+}
+
+void FTPManager::queueDownload(Priority priority, QObject* context, DownloadCallback callback, uint8_t fromCompId, const QString& fromURI, const QString& toDir, const QString& fileName, bool checksize)
+{
+    if (!context) {
+        qCWarning(FTPManagerLog) << "queueDownload requires a context";
+        return;
+    }
+
+    QueuedOperation_t operation;
+    operation.priority  = priority;
+    operation.context   = context;
+    operation.startFn   = [this, context, callback, fromCompId, fromURI, toDir, fileName, checksize](uint32_t resumeOffset) {
+        _activeContext          = context;
+        _activeDownloadCallback = callback;
+        if (!_download(fromCompId, fromURI, toDir, fileName, checksize, resumeOffset)) {
+            _activeContext.clear();
+            _activeDownloadCallback = nullptr;
+            return false;
+        }
+        return true;
+    };
+    operation.abortFn   = [callback](const QString& errorMsg) {
+        callback(QString(), errorMsg);
+    };
+
+    _queueOperation(operation);
+}
+
+void FTPManager::queueListDirectory(Priority priority, QObject* context, ListDirectoryCallback callback, uint8_t fromCompId, const QString& fromURI)
+{
+    if (!context) {
+        qCWarning(FTPManagerLog) << "queueListDirectory requires a context";
+        return;
+    }
+
+    QueuedOperation_t operation;
+    operation.priority  = priority;
+    operation.context   = context;
+    operation.startFn   = [this, context, callback, fromCompId, fromURI](uint32_t /* resumeOffset */) {
+        _activeContext               = context;
+        _activeListDirectoryCallback = callback;
+        if (!listDirectory(fromCompId, fromURI)) {
+            _activeContext.clear();
+            _activeListDirectoryCallback = nullptr;
+            return false;
+        }
+        return true;
+    };
+    operation.abortFn   = [callback](const QString& errorMsg) {
+        callback(QStringList(), errorMsg);
+    };
+
+    _queueOperation(operation);
+}
+
+void FTPManager::queueCalcFileCRC32(Priority priority, QObject* context, CalcFileCRC32Callback callback, uint8_t fromCompId, const QString& fromURI)
+{
+    if (!context) {
+        qCWarning(FTPManagerLog) << "queueCalcFileCRC32 requires a context";
+        return;
+    }
+
+    QueuedOperation_t operation;
+    operation.priority  = priority;
+    operation.context   = context;
+    operation.startFn   = [this, context, callback, fromCompId, fromURI](uint32_t /* resumeOffset */) {
+        _activeContext               = context;
+        _activeCalcFileCRC32Callback = callback;
+        if (!calcFileCRC32(fromCompId, fromURI)) {
+            _activeContext.clear();
+            _activeCalcFileCRC32Callback = nullptr;
+            return false;
+        }
+        return true;
+    };
+    operation.abortFn   = [callback](const QString& errorMsg) {
+        callback(0, errorMsg);
+    };
+
+    _queueOperation(operation);
+}
+
+void FTPManager::queueUpload(Priority priority, QObject* context, UploadCallback callback, uint8_t toCompId, const QString& toURI, const QString& fromFile)
+{
+    if (!context) {
+        qCWarning(FTPManagerLog) << "queueUpload requires a context";
+        return;
+    }
+
+    QueuedOperation_t operation;
+    operation.priority  = priority;
+    operation.context   = context;
+    operation.startFn   = [this, context, callback, toCompId, toURI, fromFile](uint32_t /* resumeOffset */) {
+        _activeContext        = context;
+        _activeUploadCallback = callback;
+        if (!upload(toCompId, toURI, fromFile)) {
+            _activeContext.clear();
+            _activeUploadCallback = nullptr;
+            return false;
+        }
+        return true;
+    };
+    operation.abortFn   = [callback](const QString& errorMsg) {
+        callback(QString(), errorMsg);
+    };
+
+    _queueOperation(operation);
+}
+
+void FTPManager::cancelQueuedOperations(QObject* context)
+{
+    if (!context) {
+        return;
+    }
+
+    QList<QueuedOperation_t> rgRemoved;
+    for (int i=_operationQueue.count()-1; i>=0; i--) {
+        if (_operationQueue[i].context == context) {
+            rgRemoved.prepend(_operationQueue.takeAt(i));
+        }
+    }
+
+    if (_activeContext == context) {
+        if (_activeDownloadCallback) {
+            cancelDownload();
+        } else if (_activeListDirectoryCallback) {
+            cancelListDirectory();
+        } else if (_activeCalcFileCRC32Callback) {
+            _calcFileCRC32Complete(tr("Aborted"));
+        } else if (_activeUploadCallback) {
+            cancelUpload();
+        }
+    }
+
+    for (const QueuedOperation_t& operation: rgRemoved) {
+        operation.abortFn(tr("Aborted"));
+    }
+}
+
+void FTPManager::_queueOperation(const QueuedOperation_t& operation)
+{
+    // Insert behind everything of the same or higher priority
+    int index = 0;
+    while ((index < _operationQueue.count()) && (_operationQueue[index].priority <= operation.priority)) {
+        index++;
+    }
+    _operationQueue.insert(index, operation);
+
+    qCDebug(FTPManagerLog) << "_queueOperation priority:index:queued" << static_cast<int>(operation.priority) << index << _operationQueue.count();
+
+    _preemptBulkDownload();
+    _startNextQueuedOperation();
+}
+
+void FTPManager::_preemptBulkDownload(void)
+{
+    // Only a bulk download which has its file open can be paused, anything else is short enough to wait for
+    if (!_activeContext || (_activeOperation.priority != Priority::Bulk) || !_activeDownloadCallback ||
+            !_downloadState.inProgress() || _downloadState.terminating ||
+            _operationQueue.isEmpty() || (_operationQueue.first().priority >= Priority::Bulk)) {
+        return;
+    }
+
+    // Everything before the first hole is safely on disk
+    uint32_t resumeOffset = _downloadState.expectedOffset;
+    for (const MissingData_t& missingData: std::as_const(_downloadState.rgMissingData)) {
+        resumeOffset = qMin(resumeOffset, missingData.offset);
+    }
+    for (const PendingRead_t& pendingRead: std::as_const(_downloadState.rgPendingReads)) {
+        resumeOffset = qMin(resumeOffset, pendingRead.offset);
+    }
+
+    qCDebug(FTPManagerLog) << "_preemptBulkDownload: pausing" << _downloadState.fileName << "at offset" << resumeOffset;
+
+    // Resumes ahead of other bulk operations once the higher priority ones are done
+    QueuedOperation_t resumed = _activeOperation;
+    resumed.resumeOffset = resumeOffset;
+    int index = 0;
+    while ((index < _operationQueue.count()) && (_operationQueue[index].priority < resumed.priority)) {
+        index++;
+    }
+    _operationQueue.insert(index, resumed);
+
+    _preempting = true;
+    cancelDownload();
+}
+
+void FTPManager::_startNextQueuedOperation(void)
+{
+    while (!busy() && !_operationQueue.isEmpty()) {
+        const QueuedOperation_t operation = _operationQueue.takeFirst();
+        if (!operation.context) {
+            qCDebug(FTPManagerLog) << "_startNextQueuedOperation: context destroyed, dropping operation";
+            continue;
+        }
+        _activeOperation = operation;
+        if (!operation.startFn(operation.resumeOffset)) {
+            operation.abortFn(tr("Failed to start"));
+        }
+    }
+}
+
+void FTPManager::_scheduleNextQueuedOperation(void)
+{
+    // Deferred so that completion handlers run first. Handlers which chain a new operation directly keep
+    // working, the queue simply waits behind it.
+    if (!_operationQueue.isEmpty()) {
+        QTimer::singleShot(0, this, &FTPManager::_startNextQueuedOperation);
+    }
+}
+
 void FTPManager::cancelDownload()
 {
     if (!_downloadState.inProgress()) {
@@ -210,6 +462,7 @@ void FTPManager::cancelDownload()
 
     _ackOrNakTimeoutTimer.stop();
     _rgStateMachine.clear();
+    _downloadState.terminating = true;
     static const StateFunctions_t rgTerminateStateMachine[] = {
         { &FTPManager::_terminateSessionBegin,  &FTPManager::_terminateSessionAckOrNak,     &FTPManager::_terminateSessionTimeout },
         { &FTPManager::_terminateComplete,      nullptr,                                    nullptr },
@@ -322,6 +575,19 @@ void FTPManager::_downloadComplete(const QString& errorMsg)
     _ackOrNakTimeoutTimer.stop();
     _rgStateMachine.clear();
     _currentStateMachineIndex = -1;
+    _downloadState.rgPendingReads.clear();
+
+    if (_preempting) {
+        // Paused, the partial file is kept for the resumed download which is already queued
+        _preempting = false;
+        _downloadState.file.close();
+        _downloadState.reset();
+        _activeDownloadCallback = nullptr;
+        _activeContext.clear();
+        _scheduleNextQueuedOperation();
+        return;
+    }
+
     if (_downloadState.file.isOpen()) {
         _downloadState.file.close();
         if (!errorMsg.isEmpty()) {
@@ -329,7 +595,19 @@ void FTPManager::_downloadComplete(const QString& errorMsg)
         }
     }
 
+    const DownloadCallback callback = _activeDownloadCallback;
+    const QPointer<QObject> context = _activeContext;
+    _activeDownloadCallback = nullptr;
+    _activeContext.clear();
+
+    emit transferStatsChanged();
     emit downloadComplete(downloadFilePath, errorMsg);
+
+    if (callback && context) {
+        callback(downloadFilePath, errorMsg);
+    }
+
+    _scheduleNextQueuedOperation();
 }
 
 /// Closes out a list directory sequence
@@ -349,7 +627,18 @@ void FTPManager::_listDirectoryComplete(const QString& errorMsg)
 
     _listDirectoryState.reset();
 
-    emit listDirectoryComplete(errorMsg.isEmpty() ? rgDirectoryList : QStringList(), errorMsg);
+    const ListDirectoryCallback callback = _activeListDirectoryCallback;
+    const QPointer<QObject> context = _activeContext;
+    _activeListDirectoryCallback = nullptr;
+    _activeContext.clear();
+
+    emit listDirectoryComplete(rgDirectoryList, errorMsg);
+
+    if (callback && context) {
+        callback(rgDirectoryList, errorMsg);
+    }
+
+    _scheduleNextQueuedOperation();
 }
 
 void FTPManager::_deleteFileBegin(void)
@@ -411,6 +700,87 @@ void FTPManager::_deleteComplete(const QString& errorMsg)
     _deleteState.reset();
 
     emit deleteComplete(deletedPath, errorMsg);
+
+    _scheduleNextQueuedOperation();
+}
+
+void FTPManager::_calcFileCRC32Begin(void)
+{
+    qCDebug(FTPManagerLog) << "file" << _calcFileCRC32State.fullPathOnVehicle;
+
+    MavlinkFTP::Request request{};
+    request.hdr.session = 0;
+    request.hdr.opcode  = MavlinkFTP::kCmdCalcFileCRC32;
+    request.hdr.offset  = 0;
+    request.hdr.size    = 0;
+    _fillRequestDataWithString(&request, _calcFileCRC32State.fullPathOnVehicle);
+    _sendRequestExpectAck(&request);
+}
+
+void FTPManager::_calcFileCRC32AckOrNak(const MavlinkFTP::Request* ackOrNak)
+{
+    MavlinkFTP::OpCode_t requestOpCode = static_cast<MavlinkFTP::OpCode_t>(ackOrNak->hdr.req_opcode);
+    if (requestOpCode != MavlinkFTP::kCmdCalcFileCRC32) {
+        qCDebug(FTPManagerLog) << "_calcFileCRC32AckOrNak: Ack disregarding ack for incorrect requestOpCode" << MavlinkFTP::opCodeToString(requestOpCode);
+        return;
+    }
+    if (ackOrNak->hdr.seqNumber != _expectedIncomingSeqNumber) {
+        qCDebug(FTPManagerLog) << "_calcFileCRC32AckOrNak: Ack disregarding ack for incorrect sequence actual:expected" << ackOrNak->hdr.seqNumber << _expectedIncomingSeqNumber;
+        return;
+    }
+
+    _ackOrNakTimeoutTimer.stop();
+
+    if (ackOrNak->hdr.opcode == MavlinkFTP::kRspAck) {
+        if (ackOrNak->hdr.size != sizeof(uint32_t)) {
+            qCDebug(FTPManagerLog) << "_calcFileCRC32AckOrNak: Ack size incorrect" << ackOrNak->hdr.size;
+            _calcFileCRC32Complete(tr("CRC32 failed") + ": " + tr("Invalid response"));
+            return;
+        }
+        _calcFileCRC32State.crc32 = ackOrNak->openFileLength;
+        _advanceStateMachine();
+    } else if (ackOrNak->hdr.opcode == MavlinkFTP::kRspNak) {
+        qCDebug(FTPManagerLog) << "_calcFileCRC32AckOrNak: Nak -" << _errorMsgFromNak(ackOrNak);
+        _calcFileCRC32Complete(tr("CRC32 failed") + ": " + _errorMsgFromNak(ackOrNak));
+    }
+}
+
+void FTPManager::_calcFileCRC32Timeout(void)
+{
+    if (++_calcFileCRC32State.retryCount > _maxRetry) {
+        qCDebug(FTPManagerLog) << QString("_calcFileCRC32Timeout retries exceeded");
+        _calcFileCRC32Complete(tr("CRC32 failed"));
+    } else {
+        qCDebug(FTPManagerLog) << QString("_calcFileCRC32Timeout: retrying - retryCount(%1)").arg(_calcFileCRC32State.retryCount);
+        _calcFileCRC32Begin();
+    }
+}
+
+void FTPManager::_calcFileCRC32Complete(const QString& errorMsg)
+{
+    qCDebug(FTPManagerLog) << QString("_calcFileCRC32Complete: crc32(%1) errorMsg(%2)").arg(_calcFileCRC32State.crc32, 8, 16, QLatin1Char('0')).arg(errorMsg);
+
+    const QString path = _calcFileCRC32State.fullPathOnVehicle;
+    const uint32_t crc32 = errorMsg.isEmpty() ? _calcFileCRC32State.crc32 : 0;
+
+    _ackOrNakTimeoutTimer.stop();
+    _rgStateMachine.clear();
+    _currentStateMachineIndex = -1;
+
+    _calcFileCRC32State.reset();
+
+    const CalcFileCRC32Callback callback = _activeCalcFileCRC32Callback;
+    const QPointer<QObject> context = _activeContext;
+    _activeCalcFileCRC32Callback = nullptr;
+    _activeContext.clear();
+
+    emit calcFileCRC32Complete(path, crc32, errorMsg);
+
+    if (callback && context) {
+        callback(crc32, errorMsg);
+    }
+
+    _scheduleNextQueuedOperation();
 }
 
 void FTPManager::_createFileBegin(void)
@@ -541,6 +911,7 @@ void FTPManager::_writeFileAckOrNak(const MavlinkFTP::Request* ackOrNak)
         _uploadState.lastChunkSize = 0;
         _expectedIncomingSeqNumber = ackOrNak->hdr.seqNumber;
 
+        _updateTransferStats(_uploadState.totalBytesSent);
         if (_uploadState.fileSize != 0) {
             emit commandProgress(static_cast<float>(_uploadState.totalBytesSent) / static_cast<float>(_uploadState.fileSize));
         }
@@ -563,6 +934,8 @@ void FTPManager::_writeFileTimeout(void)
         _uploadComplete(tr("Upload failed for: %1 - no response from vehicle").arg(_uploadState.fullPathOnVehicle));
     } else {
         qCDebug(FTPManagerLog) << QString("_writeFileTimeout: retrying - retryCount(%1) offset(%2)").arg(_uploadState.retryCount).arg(_uploadState.totalBytesSent);
+        _transferStats.retransmits++;
+        emit transferStatsChanged();
         _writeFileWorker(false /* firstRequest */);
     }
 }
@@ -639,7 +1012,19 @@ void FTPManager::_uploadComplete(const QString& errorMsg)
 
     _uploadState.reset();
 
+    const UploadCallback callback = _activeUploadCallback;
+    const QPointer<QObject> context = _activeContext;
+    _activeUploadCallback = nullptr;
+    _activeContext.clear();
+
+    emit transferStatsChanged();
     emit uploadComplete(remotePath, errorMsg);
+
+    if (callback && context) {
+        callback(remotePath, errorMsg);
+    }
+
+    _scheduleNextQueuedOperation();
 }
 
 void FTPManager::_mavlinkMessageReceived(const mavlink_message_t& message)
@@ -671,8 +1056,9 @@ void FTPManager::_mavlinkMessageReceived(const mavlink_message_t& message)
     }
 
     // Ignore old/reordered packets (handle wrap-around properly)
+    // Gap fill responses for the outstanding read window arrive with sequence numbers below the latest expected one
     uint16_t actualIncomingSeqNumber = request->hdr.seqNumber;
-    if ((uint16_t)((_expectedIncomingSeqNumber - 1) - actualIncomingSeqNumber) < (std::numeric_limits<uint16_t>::max()/2)) {
+    if (((uint16_t)((_expectedIncomingSeqNumber - 1) - actualIncomingSeqNumber) < (std::numeric_limits<uint16_t>::max()/2)) && !_isPendingReadResponse(actualIncomingSeqNumber)) {
         qCDebug(FTPManagerLog) << "_mavlinkMessageReceived: Received old packet seqNum expected:actual" << _expectedIncomingSeqNumber << actualIncomingSeqNumber
                                << "hdr.opcode:hdr.req_opcode" << MavlinkFTP::opCodeToString(static_cast<MavlinkFTP::OpCode_t>(request->hdr.opcode)) <<  MavlinkFTP::opCodeToString(static_cast<MavlinkFTP::OpCode_t>(request->hdr.req_opcode));
 
@@ -768,11 +1154,22 @@ void FTPManager::_openFileROAckOrNak(const MavlinkFTP::Request* ackOrNak)
 
         _downloadState.sessionId        = ackOrNak->hdr.session;
         _downloadState.fileSize         = ackOrNak->openFileLength;
-        _downloadState.expectedOffset   = 0;
+        _transferTimer.start();
 
         _downloadState.file.setFileName(_downloadState.toDir.filePath(_downloadState.fileName));
-        if (_downloadState.file.open(QFile::WriteOnly | QFile::Truncate)) {
+
+        // A paused download continues after the data it already has, unless the file is no longer the same
+        if ((_downloadState.resumeOffset > _downloadState.fileSize) || (_downloadState.file.size() < _downloadState.resumeOffset)) {
+            _downloadState.resumeOffset = 0;
+        }
+        _downloadState.expectedOffset   = _downloadState.resumeOffset;
+        _downloadState.bytesWritten     = _downloadState.resumeOffset;
+
+        const QIODevice::OpenMode openMode = (_downloadState.resumeOffset > 0) ? QIODevice::ReadWrite : (QIODevice::WriteOnly | QIODevice::Truncate);
+        if (_downloadState.file.open(openMode)) {
             _advanceStateMachine();
+            // Operations queued while the file was being opened could not pause the download yet
+            _preemptBulkDownload();
         } else {
             qCDebug(FTPManagerLog) << "_openFileROAckOrNak: Ack _downloadState.file open failed" << _downloadState.file.errorString();
             _downloadComplete(tr("Download failed"));
@@ -838,6 +1235,7 @@ void FTPManager::_burstReadFileAckOrNak(const MavlinkFTP::Request* ackOrNak)
                 missingData.offset          = _downloadState.expectedOffset;
                 missingData.cBytesMissing   = ackOrNak->hdr.offset - _downloadState.expectedOffset;
                 _downloadState.rgMissingData.append(missingData);
+                _transferStats.missingBlocks++;
                 qCDebug(FTPManagerLog) << "_handleBurstReadFileAck: adding missing data offset:cBytesMissing" << missingData.offset << missingData.cBytesMissing;
             } else {
                 // Offset is past what we have already seen, disregard and wait for something usefule
@@ -867,6 +1265,7 @@ void FTPManager::_burstReadFileAckOrNak(const MavlinkFTP::Request* ackOrNak)
         }
 
         // Emit progress last, as cancel could be called in there
+        _updateTransferStats(_downloadState.bytesWritten - _downloadState.resumeOffset);
         if (_downloadState.fileSize != 0) {
             emit commandProgress((float)(_downloadState.bytesWritten) / (float)_downloadState.fileSize);
         }
@@ -901,6 +1300,8 @@ void FTPManager::_burstReadFileTimeout(void)
     } else {
         // Try again
         qCDebug(FTPManagerLog) << QString("_burstReadFileTimeout: retrying - retryCount(%1) offset(%2)").arg(_downloadState.retryCount).arg(_downloadState.expectedOffset);
+        _transferStats.retransmits++;
+        emit transferStatsChanged();
         _burstReadFileWorker(false /* firstReqeust */);
     }
 }
@@ -994,31 +1395,40 @@ void FTPManager::_listDirectoryTimeout(void)
     }
 }
 
-void FTPManager::_fillMissingBlocksWorker(bool firstRequest)
+/// Keeps up to fillWindow kCmdReadFile requests outstanding for the missing ranges. Each request uses its own
+/// sequence number so responses can be matched back to the range they fill, regardless of arrival order.
+void FTPManager::_fillMissingBlocksWorker(void)
 {
-    if (_downloadState.rgMissingData.count()) {
+    while ((_downloadState.rgPendingReads.count() < _downloadState.fillWindow) && !_downloadState.rgMissingData.isEmpty()) {
         MavlinkFTP::Request request{};
         MissingData_t&      missingData = _downloadState.rgMissingData.first();
 
         uint32_t cBytesToRead = qMin((uint32_t)sizeof(request.data), missingData.cBytesMissing);
 
-        qCDebug(FTPManagerLog) << "_fillMissingBlocksBegin: offset:cBytesToRead" << missingData.offset << cBytesToRead;
+        qCDebug(FTPManagerLog) << "_fillMissingBlocksWorker: offset:cBytesToRead:window" << missingData.offset << cBytesToRead << _downloadState.fillWindow;
 
         request.hdr.session                 = _downloadState.sessionId;
         request.hdr.opcode                  = MavlinkFTP::kCmdReadFile;
         request.hdr.offset                  = missingData.offset;
         request.hdr.size                    = cBytesToRead;
 
-        if (firstRequest) {
-            _downloadState.retryCount = 0;
-        } else {
-            // Must used same sequence number as previous request
-            _expectedIncomingSeqNumber -= 2;
+        PendingRead_t pendingRead;
+        pendingRead.offset  = missingData.offset;
+        pendingRead.cBytes  = cBytesToRead;
+
+        missingData.offset          += cBytesToRead;
+        missingData.cBytesMissing   -= cBytesToRead;
+        if (missingData.cBytesMissing == 0) {
+            _downloadState.rgMissingData.removeFirst();
         }
-        _downloadState.expectedOffset = request.hdr.offset;
 
         _sendRequestExpectAck(&request);
-    } else {
+
+        pendingRead.seqNumber = _expectedIncomingSeqNumber;
+        _downloadState.rgPendingReads.append(pendingRead);
+    }
+
+    if (_downloadState.rgPendingReads.isEmpty()) {
         // We should have the full file now
         if (_downloadState.checksize == false || _downloadState.bytesWritten == _downloadState.fileSize) {
             _advanceStateMachine();
@@ -1029,9 +1439,42 @@ void FTPManager::_fillMissingBlocksWorker(bool firstRequest)
     }
 }
 
+/// Returns a range to the missing list, keeping the list ordered by offset
+void FTPManager::_requeueMissingData(uint32_t offset, uint32_t cBytes)
+{
+    if (cBytes == 0) {
+        return;
+    }
+
+    MissingData_t missingData;
+    missingData.offset          = offset;
+    missingData.cBytesMissing   = cBytes;
+
+    int index = 0;
+    while ((index < _downloadState.rgMissingData.count()) && (_downloadState.rgMissingData[index].offset < offset)) {
+        index++;
+    }
+    _downloadState.rgMissingData.insert(index, missingData);
+}
+
+bool FTPManager::_isPendingReadResponse(uint16_t seqNumber) const
+{
+    for (const PendingRead_t& pendingRead: _downloadState.rgPendingReads) {
+        if (pendingRead.seqNumber == seqNumber) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void FTPManager::_fillMissingBlocksBegin(void)
 {
-    _fillMissingBlocksWorker(true /* firstRequest */);
+    _downloadState.retryCount       = 0;
+    _downloadState.fillWindow       = _initialFillWindow;
+    _downloadState.fillAcksInWindow = 0;
+    _downloadState.rgPendingReads.clear();
+    _fillMissingBlocksWorker();
 }
 
 void FTPManager::_fillMissingBlocksAckOrNak(const MavlinkFTP::Request* ackOrNak)
@@ -1042,30 +1485,42 @@ void FTPManager::_fillMissingBlocksAckOrNak(const MavlinkFTP::Request* ackOrNak)
         qCDebug(FTPManagerLog) << "_fillMissingBlocksAckOrNak: Disregarding due to incorrect requestOpCode" << MavlinkFTP::opCodeToString(requestOpCode);
         return;
     }
-    if (ackOrNak->hdr.seqNumber != _expectedIncomingSeqNumber) {
-        qCDebug(FTPManagerLog) << "_fillMissingBlocksAckOrNak: Disregarding due to incorrect sequence actual:expected" << ackOrNak->hdr.seqNumber << _expectedIncomingSeqNumber;
+
+    int pendingIndex = -1;
+    for (int i=0; i<_downloadState.rgPendingReads.count(); i++) {
+        if (_downloadState.rgPendingReads[i].seqNumber == ackOrNak->hdr.seqNumber) {
+            pendingIndex = i;
+            break;
+        }
+    }
+    if (pendingIndex == -1) {
+        qCDebug(FTPManagerLog) << "_fillMissingBlocksAckOrNak: Disregarding due to sequence not outstanding actual:expected" << ackOrNak->hdr.seqNumber << _expectedIncomingSeqNumber;
         return;
     }
+
     if (ackOrNak->hdr.session != _downloadState.sessionId) {
         qCDebug(FTPManagerLog) << "_fillMissingBlocksAckOrNak: Disregarding due to incorrect session id actual:expected" << ackOrNak->hdr.session << _downloadState.sessionId;
         return;
     }
 
-    _ackOrNakTimeoutTimer.stop();
+    const PendingRead_t pendingRead = _downloadState.rgPendingReads.takeAt(pendingIndex);
 
     if (ackOrNak->hdr.opcode == MavlinkFTP::kRspAck) {
         qCDebug(FTPManagerLog) << "_fillMissingBlocksAckOrNak: Ack offset:size" << ackOrNak->hdr.offset << ackOrNak->hdr.size;
 
-        if (ackOrNak->hdr.offset != _downloadState.expectedOffset) {
+        if ((ackOrNak->hdr.offset != pendingRead.offset) || (ackOrNak->hdr.size > pendingRead.cBytes)) {
             if (++_downloadState.retryCount > _maxRetry) {
                 qCDebug(FTPManagerLog) << QString("_fillMissingBlocksAckOrNak: offset mismatch, retries exceeded");
                 _downloadComplete(tr("Download failed"));
                 return;
             }
 
-            // Ask for current offset again
-            qCDebug(FTPManagerLog) << QString("_fillMissingBlocksAckOrNak: Ack offset mismatch retry, retryCount(%1) offset(%2)").arg(_downloadState.retryCount).arg(_downloadState.expectedOffset);
-            _fillMissingBlocksWorker(false /* firstReqeust */);
+            // Ask for this range again
+            qCDebug(FTPManagerLog) << QString("_fillMissingBlocksAckOrNak: Ack offset mismatch retry, retryCount(%1) offset(%2)").arg(_downloadState.retryCount).arg(pendingRead.offset);
+            _requeueMissingData(pendingRead.offset, pendingRead.cBytes);
+            _transferStats.retransmits++;
+            emit transferStatsChanged();
+            _fillMissingBlocksWorker();
             return;
         }
 
@@ -1076,19 +1531,22 @@ void FTPManager::_fillMissingBlocksAckOrNak(const MavlinkFTP::Request* ackOrNak)
             return;
         }
         _downloadState.bytesWritten += ackOrNak->hdr.size;
+        _downloadState.retryCount = 0;
 
-        MissingData_t& missingData = _downloadState.rgMissingData.first();
-        missingData.offset += ackOrNak->hdr.size;
-        missingData.cBytesMissing -= ackOrNak->hdr.size;
-        if (missingData.cBytesMissing == 0) {
-            // This block is finished, remove it
-            _downloadState.rgMissingData.takeFirst();
+        // Short read, ask for the remainder
+        _requeueMissingData(pendingRead.offset + ackOrNak->hdr.size, pendingRead.cBytes - ackOrNak->hdr.size);
+
+        _downloadState.fillAcked();
+
+        if (_downloadState.rgPendingReads.isEmpty()) {
+            _ackOrNakTimeoutTimer.stop();
         }
 
         // Move on to fill in possible next hole
-        _fillMissingBlocksWorker(true /* firstReqeust */);
+        _fillMissingBlocksWorker();
 
         // Emit progress last, as cancel could be called in there
+        _updateTransferStats(_downloadState.bytesWritten - _downloadState.resumeOffset);
         if (_downloadState.fileSize != 0) {
             emit commandProgress((float)(_downloadState.bytesWritten) / (float)_downloadState.fileSize);
         }
@@ -1098,8 +1556,11 @@ void FTPManager::_fillMissingBlocksAckOrNak(const MavlinkFTP::Request* ackOrNak)
         if (errorCode == MavlinkFTP::kErrEOF) {
             qCDebug(FTPManagerLog) << "_fillMissingBlocksAckOrNak EOF";
             if (_downloadState.checksize == false || _downloadState.bytesWritten == _downloadState.fileSize) {
-                // We've successfully complete filling in all missing blocks
-                _advanceStateMachine();
+                // Range is past the end of the file, nothing left to read there
+                if (_downloadState.rgPendingReads.isEmpty()) {
+                    _ackOrNakTimeoutTimer.stop();
+                }
+                _fillMissingBlocksWorker();
                 return;
             }
         }
@@ -1115,9 +1576,18 @@ void FTPManager::_fillMissingBlocksTimeout(void)
         qCDebug(FTPManagerLog) << QString("_fillMissingBlocksTimeout retries exceeded");
         _downloadComplete(tr("Download failed"));
     } else {
-        // Ask for current offset again
-        qCDebug(FTPManagerLog) << QString("_fillMissingBlocksTimeout: retrying - retryCount(%1) offset(%2)").arg(_downloadState.retryCount).arg(_downloadState.expectedOffset);
-        _fillMissingBlocksWorker(false /* firstReqeust */);
+        _downloadState.fillTimedOut();
+
+        qCDebug(FTPManagerLog) << QString("_fillMissingBlocksTimeout: retrying - retryCount(%1) outstanding(%2) window(%3)").arg(_downloadState.retryCount).arg(_downloadState.rgPendingReads.count()).arg(_downloadState.fillWindow);
+
+        _transferStats.retransmits += static_cast<uint32_t>(_downloadState.rgPendingReads.count());
+        for (const PendingRead_t& pendingRead: _downloadState.rgPendingReads) {
+            _requeueMissingData(pendingRead.offset, pendingRead.cBytes);
+        }
+        _downloadState.rgPendingReads.clear();
+        emit transferStatsChanged();
+
+        _fillMissingBlocksWorker();
     }
 }
 
@@ -1217,3 +1687,22 @@ bool FTPManager::_parseURI(uint8_t fromCompId, const QString& uri, QString& pars
 
     return true;
 }
+
+void FTPManager::_resetTransferStats(void)
+{
+    _transferStats = TransferStats_t();
+    _transferTimer.start();
+    _transferStatsSignalTimer.invalidate();
+}
+
+void FTPManager::_updateTransferStats(uint32_t bytesTransferred)
+{
+    _transferStats.bytesTransferred = bytesTransferred;
+    _transferStats.elapsedMsecs     = _transferTimer.elapsed();
+
+    // Called for every packet, the final values are signalled when the transfer ends
+    if (!_transferStatsSignalTimer.isValid() || _transferStatsSignalTimer.hasExpired(kTransferStatsIntervalMs)) {
+        _transferStatsSignalTimer.start();
+        emit transferStatsChanged();
+    }
+}
@@ -4,8 +4,13 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
+#include <QtCore/QPointer>
 #include <QtCore/QTimer>
+
+#include <functional>
+
 class Vehicle;
 
 class FTPManager : public QObject
@@ -13,10 +18,23 @@ class FTPManager : public QObject
     Q_OBJECT
 
     friend class Vehicle;
+    friend class FTPManagerTest;
 
 public:
     FTPManager(Vehicle* vehicle);
 
+    /// Relative priority of queued operations. Operations of equal priority run in the order they were queued.
+    enum class Priority {
+        Interactive,    ///< User initiated operations, e.g. the FTP browser
+        Normal,         ///< Connect time loading such as camera definitions
+        Bulk,           ///< Large transfers such as onboard logs
+    };
+
+    using DownloadCallback      = std::function<void(const QString& file, const QString& errorMsg)>;
+    using ListDirectoryCallback = std::function<void(const QStringList& dirList, const QString& errorMsg)>;
+    using CalcFileCRC32Callback = std::function<void(uint32_t crc32, const QString& errorMsg)>;
+    using UploadCallback        = std::function<void(const QString& remotePath, const QString& errorMsg)>;
+
 	/// Downloads the specified file.
     ///     @param fromCompId Component id of the component to download from. If fromCompId is MAV_COMP_ID_ALL, then MAV_COMP_ID_AUTOPILOT1 is used.
     ///     @param fromURI    File to download from component, fully qualified path. May be in the format "mftp://[;comp=<id>]..." where the component id
@@ -55,6 +73,44 @@ class FTPManager : public QObject
     /// Signals deleteComplete
     bool deleteFile(uint8_t fromCompId, const QString& fromURI);
 
+    /// Asks the vehicle to calculate the CRC32 of a file, so a local copy can be verified without downloading it again.
+    ///     @param fromCompId Component id of the component which holds the file. If fromCompId is MAV_COMP_ID_ALL, then MAV_COMP_ID_AUTOPILOT1 is used.
+    ///     @param fromURI    File path on the component. May include mftp:// scheme and optional component id selector.
+    /// @return true: process has started, false: error
+    /// Signals calcFileCRC32Complete. The value matches QGC::crc32() of the file contents.
+    bool calcFileCRC32(uint8_t fromCompId, const QString& fromURI);
+
+    /// Queues a download instead of failing when another operation is in progress. The download starts once all
+    /// operations queued ahead of it at the same or higher priority have completed. A running Bulk download is
+    /// paused for operations of higher priority and resumes from where it stopped afterwards. Other parameters
+    /// match download().
+    ///     @param context  Owner of the request. If it is destroyed before the download starts the request is dropped,
+    ///                     if it is destroyed while the download runs the callback is not called.
+    ///     @param callback Called only for this download. downloadComplete is signalled as well.
+    void queueDownload(Priority priority, QObject* context, DownloadCallback callback, uint8_t fromCompId, const QString& fromURI, const QString& toDir, const QString& fileName = QString(), bool checksize = true);
+
+    /// Queued version of listDirectory(). See queueDownload() for how queueing works.
+    void queueListDirectory(Priority priority, QObject* context, ListDirectoryCallback callback, uint8_t fromCompId, const QString& fromURI);
+
+    /// Queued version of calcFileCRC32(). See queueDownload() for how queueing works.
+    void queueCalcFileCRC32(Priority priority, QObject* context, CalcFileCRC32Callback callback, uint8_t fromCompId, const QString& fromURI);
+
+    /// Queued version of upload(). See queueDownload() for how queueing works. Uploads are never paused.
+    void queueUpload(Priority priority, QObject* context, UploadCallback callback, uint8_t toCompId, const QString& toURI, const QString& fromFile);
+
+    /// Removes all queued operations for the specified context, calling their callbacks with an error. If the
+    /// active operation was queued by the context it is cancelled as well.
+    void cancelQueuedOperations(QObject* context);
+
+    /// @return true: an operation is in progress
+    bool busy() const { return !_rgStateMachine.isEmpty(); }
+
+    /// @return Number of queued operations waiting to start
+    int queuedOperationCount() const { return _operationQueue.count(); }
+
+    /// @return Context which queued the active operation, nullptr if none or the operation was started directly
+    QObject* activeOperationContext() const { return _activeContext.data(); }
+
     /// Cancel the download operation
     /// This will emit downloadComplete() when done, and if there's currently a download in progress
     void cancelDownload();
@@ -71,6 +127,18 @@ class FTPManager : public QObject
     /// This will emit uploadComplete() when done, and if there's currently an upload in progress
     void cancelUpload();
 
+    /// Throughput and retransmit counters for the current (or last) download/upload
+    struct TransferStats_t {
+        uint32_t    bytesTransferred    = 0;    ///< Payload bytes received (download) or acked (upload)
+        uint32_t    retransmits         = 0;    ///< Requests re-sent due to timeout or bad response
+        uint32_t    missingBlocks       = 0;    ///< Holes detected in burst reads which required gap filling
+        qint64      elapsedMsecs        = 0;
+
+        double bytesPerSecond() const { return elapsedMsecs > 0 ? (bytesTransferred * 1000.0) / elapsedMsecs : 0.0; }
+    };
+
+    const TransferStats_t& transferStats() const { return _transferStats; }
+
     static constexpr const char* mavlinkFTPScheme = "mftp";
 
 signals:
@@ -78,11 +146,16 @@ class FTPManager : public QObject
     void uploadComplete         (const QString& file, const QString& errorMsg);
     void listDirectoryComplete  (const QStringList& dirList, const QString& errorMsg);
     void deleteComplete         (const QString& file, const QString& errorMsg);
+    void calcFileCRC32Complete  (const QString& file, uint32_t crc32, const QString& errorMsg);
 
     /// Signalled during a lengthy command to show progress
     ///     @param value Amount of progress: 0.0 = none, 1.0 = complete
     void commandProgress(float value);
 
+    /// Signalled at most every kTransferStatsIntervalMs while data moves, as well as when retransmits occur and
+    /// when a transfer ends. Use transferStats() for values.
+    void transferStatsChanged();
+
 private slots:
     void _ackOrNakTimeout(void);
 
@@ -102,11 +175,29 @@ private slots:
         uint32_t cBytesMissing;
     };
 
+    struct QueuedOperation_t {
+        Priority                                    priority = Priority::Normal;
+        QPointer<QObject>                           context;
+        std::function<bool(uint32_t resumeOffset)>  startFn;    ///< Starts the operation, false if it could not be started
+        std::function<void(const QString& error)>   abortFn;    ///< Reports an operation which never ran
+        uint32_t                                    resumeOffset = 0;   ///< Bytes a paused download already has on disk
+    };
+
+    /// kCmdReadFile request which is outstanding while filling missing blocks
+    struct PendingRead_t {
+        uint16_t seqNumber;     ///< Sequence number of the expected response
+        uint32_t offset;
+        uint32_t cBytes;
+    };
+
     struct DownloadState_t {
         uint8_t                 sessionId;
         uint32_t                expectedOffset;         ///< offset which should be coming next
         uint32_t                bytesWritten;
         QList<MissingData_t>    rgMissingData;
+        QList<PendingRead_t>    rgPendingReads;         ///< Outstanding gap fill requests
+        int                     fillWindow;             ///< Maximum number of outstanding gap fill requests
+        int                     fillAcksInWindow;       ///< Acks received since the window was last grown
         QString                 fullPathOnVehicle;      ///< Fully qualified path to file on vehicle
         QDir                    toDir;                  ///< Directory to download file to
         QString                 fileName;               ///< Filename (no path) for download file
@@ -114,18 +205,39 @@ private slots:
         QFile                   file;
         int                     retryCount;
         bool                    checksize;
+        uint32_t                resumeOffset;           ///< Start of the download, data before it is already in the file
+        bool                    terminating;            ///< Session is being closed down
 
         bool inProgress() const { return fileSize > 0; }
 
+        /// Additive increase: grow the window by one after a full window of successful reads
+        void fillAcked() {
+            if (++fillAcksInWindow >= fillWindow) {
+                fillAcksInWindow = 0;
+                fillWindow = qMin(fillWindow + 1, _maxFillWindow);
+            }
+        }
+
+        /// Multiplicative decrease: the link is dropping packets, so back off before asking again
+        void fillTimedOut() {
+            fillWindow       = qMax(1, fillWindow / 2);
+            fillAcksInWindow = 0;
+        }
+
         void reset() {
             sessionId       = 0;
             expectedOffset  = 0;
             bytesWritten    = 0;
             retryCount      = 0;
             fileSize        = 0;
+            resumeOffset    = 0;
+            terminating     = false;
+            fillWindow      = 1;
+            fillAcksInWindow = 0;
             fullPathOnVehicle.clear();
             fileName.clear();
             rgMissingData.clear();
+            rgPendingReads.clear();
             file.close();
         }
     };
@@ -160,6 +272,20 @@ private slots:
         }
     };
 
+    struct CalcFileCRC32State_t {
+        QString     fullPathOnVehicle;      ///< Fully qualified path to file on vehicle
+        uint32_t    crc32       = 0;
+        int         retryCount  = 0;
+
+        bool inProgress() const { return !fullPathOnVehicle.isEmpty(); }
+
+        void reset() {
+            fullPathOnVehicle.clear();
+            crc32       = 0;
+            retryCount  = 0;
+        }
+    };
+
     struct UploadState_t {
         uint8_t     sessionId;
         uint32_t    totalBytesSent;
@@ -209,7 +335,16 @@ private slots:
     void    _downloadCompleteNoError    (void) { _downloadComplete(QString()); }
     void    _downloadComplete           (const QString& errorMsg);
     void    _fillRequestDataWithString(MavlinkFTP::Request* request, const QString& str);
-    void    _fillMissingBlocksWorker    (bool firstRequest);
+    void    _fillMissingBlocksWorker    (void);
+    void    _requeueMissingData         (uint32_t offset, uint32_t cBytes);
+    bool    _isPendingReadResponse      (uint16_t seqNumber) const;
+    void    _resetTransferStats         (void);
+    bool    _download                   (uint8_t fromCompId, const QString& fromURI, const QString& toDir, const QString& fileName, bool checksize, uint32_t resumeOffset);
+    void    _queueOperation             (const QueuedOperation_t& operation);
+    void    _preemptBulkDownload        (void);
+    void    _startNextQueuedOperation   (void);
+    void    _scheduleNextQueuedOperation(void);
+    void    _updateTransferStats        (uint32_t bytesTransferred);
     void    _burstReadFileWorker        (bool firstRequest);
     void    _listDirectoryWorker        (bool firstRequest);
     bool    _parseURI                   (uint8_t fromCompId, const QString& uri, QString& parsedURI, uint8_t& compId);
@@ -220,6 +355,11 @@ private slots:
     void    _deleteFileTimeout          (void);
     void    _deleteCompleteNoError      (void) { _deleteComplete(QString()); }
     void    _deleteComplete             (const QString& errorMsg);
+    void    _calcFileCRC32Begin         (void);
+    void    _calcFileCRC32AckOrNak      (const MavlinkFTP::Request* ackOrNak);
+    void    _calcFileCRC32Timeout       (void);
+    void    _calcFileCRC32CompleteNoError(void) { _calcFileCRC32Complete(QString()); }
+    void    _calcFileCRC32Complete      (const QString& errorMsg);
 
     void    _createFileBegin            (void);
     void    _createFileAckOrNak         (const MavlinkFTP::Request* ackOrNak);
@@ -245,13 +385,28 @@ private slots:
     DownloadState_t         _downloadState;
     ListDirectoryState_t    _listDirectoryState;
     DeleteFileState_t       _deleteState;
+    CalcFileCRC32State_t    _calcFileCRC32State;
     UploadState_t           _uploadState;
     QTimer                  _ackOrNakTimeoutTimer;
+    QList<QueuedOperation_t> _operationQueue;
+    QPointer<QObject>       _activeContext;                 ///< Context of the running queued operation
+    QueuedOperation_t       _activeOperation;               ///< Running queued operation, only valid while _activeContext is set
+    bool                    _preempting = false;            ///< Active download is being paused for a higher priority operation
+    DownloadCallback        _activeDownloadCallback;
+    ListDirectoryCallback   _activeListDirectoryCallback;
+    CalcFileCRC32Callback   _activeCalcFileCRC32Callback;
+    UploadCallback          _activeUploadCallback;
+    TransferStats_t         _transferStats;
+    QElapsedTimer           _transferTimer;
+    QElapsedTimer           _transferStatsSignalTimer;      ///< Limits transferStatsChanged while data moves
     int                     _currentStateMachineIndex   = -1;
     uint16_t                _expectedIncomingSeqNumber  = 0;
 
     static const int _ackOrNakTimeoutMsecs  = 1000;
     static const int _maxRetry              = 3;
+    static constexpr int _initialFillWindow = 4;    ///< Starting number of concurrent gap fill reads
+    static constexpr int _maxFillWindow     = 16;   ///< Upper bound for the adaptive gap fill window
+    static constexpr qint64 kTransferStatsIntervalMs = 250;
 
 public:
     /// Ack timeout used in unit tests (much shorter for faster tests)
@@ -1,9 +1,11 @@
 #include "MAVLinkLogManager.h"
 #include "QGCFileHelper.h"
+#include "QGCFileWriter.h"
 #include "QGCLoggingCategory.h"
 #include "QmlObjectListModel.h"
 #include "SettingsManager.h"
 #include "AppSettings.h"
+#include "MAVLinkLib.h"
 #include "Vehicle.h"
 
 #include <QtCore/QDirIterator>
@@ -105,8 +107,18 @@ MAVLinkLogProcessor::~MAVLinkLogProcessor()
 
 void MAVLinkLogProcessor::close()
 {
-    if (_file.isOpen()) {
-        _file.close();
+    if (!_writer) {
+        return;
+    }
+
+    _flushStaging();
+    _writer->close();
+    if (_record) {
+        _record->setSize(_written);
+    }
+
+    if (_backlogDrops > 0) {
+        qCWarning(MAVLinkLogManagerLog) << "Writer backlog dropped" << _backlogDrops << "packets from" << _fileName;
     }
 }
 
@@ -120,14 +132,26 @@ bool MAVLinkLogProcessor::create(MAVLinkLogManager *manager, QStringView path, u
         manager->logExtension().toLocal8Bit().constData()
     );
 
-    _file.setFileName(_fileName);
-    if (!_file.open(QIODevice::WriteOnly)) {
-        qCWarning(MAVLinkLogManagerLog) << "Failed to open file for writing:" << _file.errorString();
+    // Create the file up front so failures are reported now rather than from the writer thread
+    QFile file(_fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(MAVLinkLogManagerLog) << "Failed to open file for writing:" << file.errorString();
         return false;
     }
+    file.close();
+
+    _writer = std::make_unique<QGCFileWriter>();
+    _writer->setTextMode(false);
+    // Processor drops packets at kMaxPendingBytes, the writer limit is only a backstop
+    _writer->setMaxPendingBytes(2 * kMaxPendingBytes);
+    _writer->setFilePath(_fileName);
+    _staging.reserve(kWriteBatchSize + MAVLINK_MSG_LOGGING_DATA_FIELD_DATA_LEN);
 
     _record = new MAVLinkLogFiles(manager, _fileName, true);
     _record->setWriting(true);
+    (void) QObject::connect(_writer.get(), &QGCFileWriter::fileSizeChanged, _record, [record = _record](qint64 size) {
+        record->setSize(static_cast<quint32>(size));
+    });
     _sequence = -1;
 
     return true;
@@ -169,38 +193,46 @@ bool MAVLinkLogProcessor::_checkSequence(uint16_t seq, int &num_drops)
     return false;
 }
 
-void MAVLinkLogProcessor::_writeData(const void *data, int len)
+qint64 MAVLinkLogProcessor::pendingBytes() const
 {
-    if (_error) {
-        return;
+    return (_writer ? _writer->pendingBytes() : 0) + _staging.size();
+}
+
+void MAVLinkLogProcessor::_writeData(QByteArrayView data)
+{
+    (void) _staging.append(data);
+    _written += data.size();
+
+    if (_staging.size() >= kWriteBatchSize) {
+        _flushStaging();
     }
+}
 
-    const qint64 bytesWritten = _file.write(reinterpret_cast<const char*>(data), len);
-    if (bytesWritten != len) {
-        _error = true;
-        qCDebug(MAVLinkLogManagerLog) << "File IO error:" << len << "bytes into" << _fileName;
+void MAVLinkLogProcessor::_flushStaging()
+{
+    if (_staging.isEmpty()) {
         return;
     }
 
-    _written += len;
-    if (_record) {
-        _record->setSize(_written);
-    }
+    // The writer keeps a shallow copy, start a new buffer rather than detaching it
+    _writer->write(_staging);
+    _staging = QByteArray();
+    _staging.reserve(kWriteBatchSize + MAVLINK_MSG_LOGGING_DATA_FIELD_DATA_LEN);
 }
 
-QByteArray MAVLinkLogProcessor::_writeUlogMessage(QByteArray &data)
+QByteArrayView MAVLinkLogProcessor::_writeUlogMessages(QByteArrayView data)
 {
     // Write ulog data w/o integrity checking, assuming data starts with a
     // valid ulog message. returns the remaining data at the end.
-    while (data.length() > 2) {
+    while (data.size() > 2) {
         const uint8_t *const ptr = reinterpret_cast<const uint8_t*>(data.constData());
         const int message_length = ptr[0] + (ptr[1] * 256) + kUlogMessageHeader;
-        if (message_length > data.length()) {
+        if (message_length > data.size()) {
             break;
         }
 
-        _writeData(data.constData(), message_length);
-        (void) data.remove(0, message_length);
+        _writeData(data.first(message_length));
+        data = data.sliced(message_length);
     }
 
     return data;
@@ -208,71 +240,87 @@ QByteArray MAVLinkLogProcessor::_writeUlogMessage(QByteArray &data)
 
 bool MAVLinkLogProcessor::processStreamData(uint16_t sequence, uint8_t first_message, const QByteArray &in)
 {
+    if (_writer->hasError()) {
+        qCDebug(MAVLinkLogManagerLog) << "File IO error:" << _writer->lastError() << _fileName;
+        return false;
+    }
+
     int num_drops = 0;
-    _error = false;
-
-    QByteArray data(in);
-    while (_checkSequence(sequence, num_drops)) {
-        if (!_gotHeader) {
-            if (data.size() < 16) {
-                qCWarning(MAVLinkLogManagerLog) << "Corrupt log header. Canceling log download.";
-                return false;
-            }
+    if (!_checkSequence(sequence, num_drops)) {
+        return true;
+    }
+
+    if (_gotHeader && (pendingBytes() > kMaxPendingBytes)) {
+        // Counted as a gap, so the next accepted packet logs a dropout and resyncs
+        // on its first message just like after a packet lost on the link
+        _backlogDrops++;
+        _backlogGap += num_drops + 1;
+        return true;
+    }
+
+    num_drops += _backlogGap;
+    _backlogGap = 0;
 
-            _writeData(data.constData(), 16);
-            (void) data.remove(0, 16);
-            _gotHeader = true;
-            // What about data start offset now that we removed 16 bytes off the start?
+    QByteArrayView data(in);
+    if (!_gotHeader) {
+        if (data.size() < kUlogHeaderSize) {
+            qCWarning(MAVLinkLogManagerLog) << "Corrupt log header. Canceling log download.";
+            return false;
         }
 
-        if (_gotHeader && (num_drops > 0)) {
-            if (num_drops > 25) {
-                num_drops = 25;
-            }
+        _writeData(data.first(kUlogHeaderSize));
+        data = data.sliced(kUlogHeaderSize);
+        _gotHeader = true;
+        // What about data start offset now that we removed 16 bytes off the start?
+    }
 
-            // Write a dropout message. We don't really know the actual duration,
-            // so just use the number of drops * 10 ms
-            const uint8_t duration = static_cast<uint8_t>(num_drops) * 10;
-            const uint8_t bogus[] = {2, 0, 79, duration, 0};
-            _writeData(bogus, sizeof(bogus));
+    if (num_drops > 0) {
+        if (num_drops > 25) {
+            num_drops = 25;
         }
 
-        if (num_drops > 0) {
-            (void) _writeUlogMessage(_ulogMessage);
-            _ulogMessage.clear();
+        // Write a dropout message. We don't really know the actual duration,
+        // so just use the number of drops * 10 ms
+        const uint8_t duration = static_cast<uint8_t>(num_drops) * 10;
+        const uint8_t bogus[] = {2, 0, 79, duration, 0};
+        _writeData(QByteArrayView(bogus, sizeof(bogus)));
 
-            if (first_message == 255) {
-                break;
-            }
+        (void) _writeUlogMessages(_ulogMessage);
+        _ulogMessage.clear();
 
-            if (first_message > 0) {
-                (void) data.remove(0, first_message);
-                first_message = 0;
-            }
+        if (first_message == 255) {
+            return true;
         }
 
-        if ((first_message == 255) && (!_ulogMessage.isEmpty())) {
-            (void) _ulogMessage.append(data);
-            break;
+        if (first_message > 0) {
+            data = data.sliced(qMin<qsizetype>(first_message, data.size()));
+            first_message = 0;
         }
+    }
 
-        if (_ulogMessage.length()) {
-            _writeData(_ulogMessage.constData(), _ulogMessage.length());
-            if (first_message) {
-                _writeData(data.left(first_message).constData(), first_message);
-            }
+    if ((first_message == 255) && !_ulogMessage.isEmpty()) {
+        if ((_ulogMessage.size() + data.size()) > kMaxUlogMessageSize) {
+            qCDebug(MAVLinkLogManagerLog) << "Discarding oversized ulog message continuation";
             _ulogMessage.clear();
+            return true;
         }
+        (void) _ulogMessage.append(data);
+        return true;
+    }
 
-        if (first_message) {
-            (void) data.remove(0, first_message);
-        }
-
-        _ulogMessage = _writeUlogMessage(data);
-        break;
+    const qsizetype continuationLength = qMin<qsizetype>(first_message, data.size());
+    if (!_ulogMessage.isEmpty()) {
+        _writeData(_ulogMessage);
+        _writeData(data.first(continuationLength));
     }
 
-    return !_error;
+    data = data.sliced(continuationLength);
+
+    // clear() frees the buffer in Qt 6, resize(0) keeps its capacity so the carry buffer is only allocated once
+    _ulogMessage.resize(0);
+    (void) _ulogMessage.append(_writeUlogMessages(data));
+
+    return true;
 }
 
 /*===========================================================================*/
@@ -1,13 +1,17 @@
 #pragma once
 
+#include <QtCore/QByteArrayView>
 #include <QtCore/QFile>
 #include <QtCore/QObject>
 #include <QtNetwork/QHttpPart>
 #include <QtQmlIntegration/QtQmlIntegration>
 
+#include <memory>
+
 class QmlObjectListModel;
 class QNetworkAccessManager;
 class MAVLinkLogManager;
+class QGCFileWriter;
 class Vehicle;
 
 class MAVLinkLogFiles : public QObject
@@ -61,36 +65,54 @@ class MAVLinkLogFiles : public QObject
 
 /*===========================================================================*/
 
+/// Reassembles the ULog stream carried by LOGGING_DATA messages. Output is batched and written to disk by a
+/// background QGCFileWriter so high rate logging does not block the GUI thread. Memory use is bounded: if the
+/// writer falls more than kMaxPendingBytes behind, packets are discarded and logged as a ULog dropout.
 class MAVLinkLogProcessor
 {
 public:
     MAVLinkLogProcessor();
     ~MAVLinkLogProcessor();
 
+    /// Writes out all buffered data and closes the file
     void close();
-    bool valid() const { return ((_file.exists()) && (_record != nullptr)); }
+    bool valid() const { return ((_writer != nullptr) && (_record != nullptr)); }
     bool create(MAVLinkLogManager *manager, QStringView path, uint8_t id);
     MAVLinkLogFiles *record() { return _record; }
     QString fileName() const { return _fileName; }
     bool processStreamData(uint16_t _sequence, uint8_t first_message, const QByteArray &in);
 
+    /// Bytes accepted from the stream which are not on disk yet
+    qint64 pendingBytes() const;
+
+    /// Number of packets discarded because the writer could not keep up
+    int backlogDrops() const { return _backlogDrops; }
+
+    static constexpr qint64 kMaxPendingBytes = 4 * 1024 * 1024;
+
 private:
     bool _checkSequence(uint16_t seq, int &num_drops);
-    QByteArray _writeUlogMessage(QByteArray &data);
-    void _writeData(const void* data, int len);
+    QByteArrayView _writeUlogMessages(QByteArrayView data);
+    void _writeData(QByteArrayView data);
+    void _flushStaging();
 
-    bool _error = false;
     bool _gotHeader = false;
     int _numDrops = 0;
+    int _backlogDrops = 0;
+    int _backlogGap = 0;                            ///< Packets dropped for backlog since the last accepted packet
     int _sequence = -1;
     MAVLinkLogFiles *_record = nullptr;
-    QByteArray _ulogMessage;
-    QFile _file;
+    QByteArray _ulogMessage;                        ///< Partial ulog message continued in the next packet
+    QByteArray _staging;                            ///< Output collected for the next hand-off to the writer
+    std::unique_ptr<QGCFileWriter> _writer;
     QString _fileName;
     quint32 _written = 0;
 
     static constexpr int kUlogMessageHeader = 3;
+    static constexpr int kUlogHeaderSize = 16;
+    static constexpr qsizetype kMaxUlogMessageSize = 0xFFFF + kUlogMessageHeader;
     static constexpr int kSequenceSize = 1 << 15;
+    static constexpr qsizetype kWriteBatchSize = 16 * 1024;
 };
 
 /*===========================================================================*/
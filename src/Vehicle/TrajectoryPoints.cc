@@ -1,47 +1,132 @@
 #include "TrajectoryPoints.h"
 #include "Vehicle.h"
 
+#include <QtCore/QtMath>
+
+#include <cmath>
+
 TrajectoryPoints::TrajectoryPoints(Vehicle* vehicle, QObject* parent)
     : QObject       (parent)
     , _vehicle      (vehicle)
-    , _lastAzimuth  (qQNaN())
 {
 }
 
 void TrajectoryPoints::_vehicleCoordinateChanged(QGeoCoordinate coordinate)
 {
-    // The goal of this algorithm is to limit the number of trajectory points whic represent the vehicle path.
-    // Fewer points means higher performance of map display.
+    if (!coordinate.isValid()) {
+        return;
+    }
 
-    if (_lastPoint.isValid()) {
-        double distance = _lastPoint.distanceTo(coordinate);
+    //-- Update flight distance using the most detailed level
+    const QGeoCoordinate& lastPoint = _levels[0].lastPoint;
+    if (lastPoint.isValid() && _vehicle) {
+        const double distance = lastPoint.distanceTo(coordinate);
         if (distance > _distanceTolerance) {
-            //-- Update flight distance
             _vehicle->updateFlightDistance(distance);
+        }
+    }
+
+    for (int level = 0; level < levelCount; level++) {
+        _addToLevel(level, coordinate);
+    }
+}
+
+void TrajectoryPoints::_addToLevel(int level, const QGeoCoordinate& coordinate)
+{
+    // The goal of this algorithm is to limit the number of trajectory points which represent the vehicle path.
+    // Fewer points means higher performance of map display. Coarser levels use a larger distance tolerance.
+
+    Level& trajectory = _levels[level];
+
+    if (trajectory.lastPoint.isValid()) {
+        if (trajectory.lastPoint.distanceTo(coordinate) > _levelTolerance(level)) {
             // Vehicle has moved far enough from previous point for an update
-            double newAzimuth = _lastPoint.azimuthTo(coordinate);
-            if (qIsNaN(_lastAzimuth) || qAbs(newAzimuth - _lastAzimuth) > _azimuthTolerance) {
+            const double newAzimuth = trajectory.lastPoint.azimuthTo(coordinate);
+            if (qIsNaN(trajectory.lastAzimuth) || qAbs(newAzimuth - trajectory.lastAzimuth) > _azimuthTolerance) {
                 // The new position IS NOT colinear with the last segment. Append the new position to the list.
-                _lastAzimuth = _lastPoint.azimuthTo(coordinate);
-                _lastPoint = coordinate;
-                _points.append(QVariant::fromValue(coordinate));
-                emit pointAdded(coordinate);
+                trajectory.lastAzimuth = newAzimuth;
+                trajectory.lastPoint = coordinate;
+                trajectory.points.append(_pack(coordinate));
+                emit pointAdded(level, coordinate);
+
+                if (trajectory.points.count() > _maxLevelPoints) {
+                    _thinLevel(level);
+                }
             } else {
                 // The new position IS colinear with the last segment. Don't add a new point, just update
                 // the last point to be the new position.
-                _lastPoint = coordinate;
-                _points[_points.count() - 1] = QVariant::fromValue(coordinate);
-                emit updateLastPoint(coordinate);
+                trajectory.lastPoint = coordinate;
+                trajectory.points.last() = _pack(coordinate);
+                emit updateLastPoint(level, coordinate);
             }
         }
     } else {
         // Add the very first trajectory point to the list
-        _lastPoint = coordinate;
-        _points.append(QVariant::fromValue(coordinate));
-        emit pointAdded(coordinate);
+        trajectory.lastPoint = coordinate;
+        trajectory.points.append(_pack(coordinate));
+        emit pointAdded(level, coordinate);
     }
 }
 
+void TrajectoryPoints::_thinLevel(int level)
+{
+    // Drop every other point from the older half of the track. The recent part, which is what the
+    // user is most likely looking at, keeps its full detail.
+    QList<PackedCoordinate>& points = _levels[level].points;
+
+    const qsizetype half = points.count() / 2;
+    qsizetype kept = 1;
+    for (qsizetype i = 2; i < half; i += 2) {
+        points[kept++] = points[i];
+    }
+    for (qsizetype i = half; i < points.count(); i++) {
+        points[kept++] = points[i];
+    }
+    points.resize(kept);
+
+    emit pointsReset(level);
+}
+
+QVariantList TrajectoryPoints::list(int level) const
+{
+    QVariantList coordinates;
+
+    if (level < 0 || level >= levelCount) {
+        return coordinates;
+    }
+
+    const QList<PackedCoordinate>& points = _levels[level].points;
+    coordinates.reserve(points.count());
+    for (const PackedCoordinate& packed : points) {
+        coordinates.append(QVariant::fromValue(_unpack(packed)));
+    }
+
+    return coordinates;
+}
+
+int TrajectoryPoints::levelForZoom(double zoomLevel, double latitude) const
+{
+    // Web mercator ground resolution at the equator for zoom level 0 is 156543.03 meters/pixel
+    const double metersPerPixel = 156543.03392 * qCos(qDegreesToRadians(latitude)) / std::pow(2.0, zoomLevel);
+    const double allowedError = metersPerPixel * _pixelTolerance;
+
+    int level = 0;
+    while (level + 1 < levelCount && _levelTolerance(level + 1) <= allowedError) {
+        level++;
+    }
+
+    return level;
+}
+
+int TrajectoryPoints::pointCount(int level) const
+{
+    if (level < 0 || level >= levelCount) {
+        return 0;
+    }
+
+    return static_cast<int>(_levels[level].points.count());
+}
+
 void TrajectoryPoints::start(void)
 {
     clear();
@@ -55,8 +140,28 @@ void TrajectoryPoints::stop(void)
 
 void TrajectoryPoints::clear(void)
 {
-    _points.clear();
-    _lastPoint = QGeoCoordinate();
-    _lastAzimuth = qQNaN();
+    for (Level& level : _levels) {
+        level.points.clear();
+        level.lastPoint = QGeoCoordinate();
+        level.lastAzimuth = qQNaN();
+    }
     emit pointsCleared();
 }
+
+TrajectoryPoints::PackedCoordinate TrajectoryPoints::_pack(const QGeoCoordinate& coordinate)
+{
+    return PackedCoordinate{
+        static_cast<qint32>(std::lround(coordinate.latitude() * 1e7)),
+        static_cast<qint32>(std::lround(coordinate.longitude() * 1e7))
+    };
+}
+
+QGeoCoordinate TrajectoryPoints::_unpack(const PackedCoordinate& packed)
+{
+    return QGeoCoordinate(packed.latitude * 1e-7, packed.longitude * 1e-7);
+}
+
+double TrajectoryPoints::_levelTolerance(int level)
+{
+    return _distanceTolerance * std::pow(_levelScale, level);
+}
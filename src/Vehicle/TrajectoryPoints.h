@@ -1,42 +1,81 @@
 #pragma once
 
+#include <QtCore/QList>
 #include <QtCore/QObject>
 #include <QtCore/QVariantList>
 #include <QtPositioning/QGeoCoordinate>
 #include <QtQmlIntegration/QtQmlIntegration>
 
+#include <array>
+
 class Vehicle;
 
+/// Flown track of a vehicle, kept at several resolution levels so the map can show a polyline with
+/// a point density that matches the current zoom. Each level is simplified online as positions arrive
+/// and is held to a fixed point budget, so memory use is bounded however long the flight.
 class TrajectoryPoints : public QObject
 {
     Q_OBJECT
     QML_ELEMENT
     QML_UNCREATABLE("")
+
+    friend class TrajectoryPointsTest;
+
 public:
     TrajectoryPoints(Vehicle* vehicle, QObject* parent = nullptr);
 
-    Q_INVOKABLE QVariantList list(void) const { return _points; }
+    /// @return Track at the specified resolution level, 0 being the most detailed
+    Q_INVOKABLE QVariantList list(int level = 0) const;
+
+    /// @return Coarsest resolution level which still looks smooth at the specified map zoom level and latitude
+    Q_INVOKABLE int levelForZoom(double zoomLevel, double latitude) const;
+
+    int pointCount(int level) const;
 
     void start  (void);
     void stop   (void);
 
+    static constexpr int levelCount = 4;
+
 public slots:
     void clear  (void);
 
 signals:
-    void pointAdded     (QGeoCoordinate coordinate);
-    void updateLastPoint(QGeoCoordinate coordinate);
+    void pointAdded     (int level, QGeoCoordinate coordinate);
+    void updateLastPoint(int level, QGeoCoordinate coordinate);
     void pointsCleared  (void);
+    /// Older points of a level were thinned to stay within budget, views showing that level must reload it
+    void pointsReset    (int level);
 
 private slots:
     void _vehicleCoordinateChanged(QGeoCoordinate coordinate);
 
 private:
-    Vehicle*        _vehicle;
-    QVariantList    _points;
-    QGeoCoordinate  _lastPoint;
-    double          _lastAzimuth;
+    /// Latitude/longitude in 1e-7 degrees, same resolution as MAVLink positions
+    struct PackedCoordinate {
+        qint32 latitude;
+        qint32 longitude;
+    };
+
+    struct Level {
+        QList<PackedCoordinate> points;
+        QGeoCoordinate          lastPoint;
+        double                  lastAzimuth = qQNaN();
+    };
+
+    void _addToLevel        (int level, const QGeoCoordinate& coordinate);
+    void _thinLevel         (int level);
+
+    static PackedCoordinate _pack           (const QGeoCoordinate& coordinate);
+    static QGeoCoordinate   _unpack         (const PackedCoordinate& packed);
+    static double           _levelTolerance (int level);
+
+    Vehicle*                        _vehicle;
+    std::array<Level, levelCount>   _levels;
 
-    static constexpr double _distanceTolerance = 2.0;
-    static constexpr double _azimuthTolerance = 1.5;
+    static constexpr double _distanceTolerance  = 2.0;     ///< Level 0 tolerance in meters, multiplied by _levelScale for each coarser level
+    static constexpr double _levelScale         = 4.0;
+    static constexpr double _azimuthTolerance   = 1.5;
+    static constexpr double _pixelTolerance     = 2.0;     ///< Simplification error allowed on screen when selecting a level
+    static constexpr int    _maxLevelPoints     = 16384;   ///< 128KB per level
 };
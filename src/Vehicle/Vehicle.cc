@@ -1402,6 +1402,50 @@ bool Vehicle::sendMessageOnLinkThreadSafe(LinkInterface* link, mavlink_message_t
     return true;
 }
 
+bool Vehicle::sendControlMessageOnLinkThreadSafe(LinkInterface* link, mavlink_message_t message, std::chrono::steady_clock::time_point sampleTime, uint8_t streamId)
+{
+    if (!link->isConnected()) {
+        qCDebug(VehicleLog) << "sendControlMessageOnLinkThreadSafe" << link << "not connected!";
+        return false;
+    }
+
+    if (sampleTime == std::chrono::steady_clock::time_point{}) {
+        sampleTime = std::chrono::steady_clock::now();
+    }
+
+    _firmwarePlugin->adjustOutgoingMavlinkMessageThreadSafe(this, link, &message);
+
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    int len = mavlink_msg_to_send_buffer(buffer, &message);
+
+    if (MAVLinkSigning::isMessageSigned(message)) {
+        // The signature timestamp was assigned when the message was packed. Going ahead of messages packed
+        // earlier would make the vehicle reject those as replays, so signed messages stay in order.
+        link->writeBytesThreadSafe((const char*)buffer, len);
+    } else {
+        uint8_t targetSystem = 0;
+        uint8_t targetComponent = 0;
+        if (const mavlink_msg_entry_t* entry = mavlink_get_msg_entry(message.msgid)) {
+            const uint8_t* payload = reinterpret_cast<const uint8_t*>(_MAV_PAYLOAD(&message));
+            if ((entry->flags & MAV_MSG_ENTRY_FLAG_HAVE_TARGET_SYSTEM) && (entry->target_system_ofs < message.len)) {
+                targetSystem = payload[entry->target_system_ofs];
+            }
+            if ((entry->flags & MAV_MSG_ENTRY_FLAG_HAVE_TARGET_COMPONENT) && (entry->target_component_ofs < message.len)) {
+                targetComponent = payload[entry->target_component_ofs];
+            }
+        }
+
+        // msgid is 24 bits
+        const quint64 key = (static_cast<quint64>(message.msgid) << 24) | (static_cast<quint64>(targetSystem) << 16) | (static_cast<quint64>(targetComponent) << 8) | streamId;
+        link->writeControlBytesThreadSafe(key, (const char*)buffer, len, sampleTime);
+    }
+
+    _messagesSent++;
+    emit messagesSentChanged();
+
+    return true;
+}
+
 int Vehicle::motorCount()
 {
     uint8_t frameType = 0;
@@ -2986,7 +3030,8 @@ void Vehicle::clearAllParamMapRC(void)
     }
 }
 
-void Vehicle::sendJoystickDataThreadSafe(float roll, float pitch, float yaw, float thrust, quint16 buttons, quint16 buttons2, float pitchExtension, float rollExtension, float aux1, float aux2, float aux3, float aux4, float aux5, float aux6)
+void Vehicle::sendJoystickDataThreadSafe(float roll, float pitch, float yaw, float thrust, quint16 buttons, quint16 buttons2, float pitchExtension, float rollExtension, float aux1, float aux2, float aux3, float aux4, float aux5, float aux6,
+                                         std::chrono::steady_clock::time_point sampleTime)
 {
     SharedLinkInterfacePtr sharedLink = vehicleLinkManager()->primaryLink().lock();
     if (!sharedLink) {
@@ -3041,7 +3086,7 @@ void Vehicle::sendJoystickDataThreadSafe(float roll, float pitch, float yaw, flo
         outgoingExtensionValues[6],
         outgoingExtensionValues[7]
     );
-    sendMessageOnLinkThreadSafe(sharedLink.get(), message);
+    sendControlMessageOnLinkThreadSafe(sharedLink.get(), message, sampleTime);
 }
 
 void Vehicle::triggerSimpleCamera()
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <memory>
 
@@ -417,7 +418,9 @@ class Vehicle : public VehicleFactGroup, public VehicleTypes
 
     void updateFlightDistance(double distance);
 
-    void sendJoystickDataThreadSafe (float roll, float pitch, float yaw, float thrust, quint16 buttons, quint16 buttons2, float pitchExtension, float rollExtension, float aux1, float aux2, float aux3, float aux4, float aux5, float aux6);
+    /// @param sampleTime When the inputs were sampled, defaults to now
+    void sendJoystickDataThreadSafe (float roll, float pitch, float yaw, float thrust, quint16 buttons, quint16 buttons2, float pitchExtension, float rollExtension, float aux1, float aux2, float aux3, float aux4, float aux5, float aux6,
+                                     std::chrono::steady_clock::time_point sampleTime = {});
 
     // Property accesors
     int id() const{ return _systemID; }
@@ -431,6 +434,15 @@ class Vehicle : public VehicleFactGroup, public VehicleTypes
     /// @return true: message sent, false: Link no longer connected
     bool sendMessageOnLinkThreadSafe(LinkInterface* link, mavlink_message_t message);
 
+    /// Sends a control message (manual control, gimbal rates) through the link's low latency control lane.
+    /// A waiting message of the same type for the same target system, component and stream is replaced instead
+    /// of queued behind. Signed messages keep their place in the normal queue, the vehicle rejects signed
+    /// messages which arrive with an older timestamp than one already received.
+    ///     @param sampleTime When the control input was sampled, defaults to now
+    ///     @param streamId Separates streams to the same target component, e.g. the gimbal device id
+    /// @return true: message sent, false: Link no longer connected
+    bool sendControlMessageOnLinkThreadSafe(LinkInterface* link, mavlink_message_t message, std::chrono::steady_clock::time_point sampleTime = {}, uint8_t streamId = 0);
+
     /// Sends the specified messages multiple times to the vehicle in order to attempt to
     /// guarantee that it makes it to the vehicle.
     void sendMessageMultiple(mavlink_message_t message);
@@ -5,21 +5,55 @@
 #include "HorizontalFactValueGrid.h"
 #include "InstrumentValueData.h"
 #include "MultiVehicleManager.h"
+#include "QGCFileWriter.h"
 #include "QGCLoggingCategory.h"
 #include "QmlObjectListModel.h"
+#include "SettingsManager.h"
+#include "VideoSettings.h"
 
-#include <QtCore/QDateTime>
+#include <QtCore/QDataStream>
+#include <QtCore/QDate>
+#include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#include <QtCore/QLocale>
 #include <QtCore/QString>
+#include <QtCore/QTime>
+
+#include <cmath>
 
 QGC_LOGGING_CATEGORY(SubtitleWriterLog, "Video.SubtitleWriter")
 
+namespace {
+
+QString assTime(qint64 ms)
+{
+    return QTime(0, 0).addMSecs(static_cast<int>(ms)).toString(QStringLiteral("H:mm:ss.zzz")).chopped(2);
+}
+
+void setupStream(QDataStream &stream)
+{
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream.setByteOrder(QDataStream::LittleEndian);
+}
+
+} // namespace
+
 SubtitleWriter::SubtitleWriter(QObject *parent)
     : QObject(parent)
+    , _subtitleFileWriter(new QGCFileWriter(this))
+    , _trackFileWriter(new QGCFileWriter(this))
 {
     // qCDebug(SubtitleWriterLog) << Q_FUNC_INFO << this;
 
+    _trackFileWriter->setTextMode(false);
+
     (void) connect(&_timer, &QTimer::timeout, this, &SubtitleWriter::_captureTelemetry);
+    (void) connect(_subtitleFileWriter, &QGCFileWriter::errorOccurred, this, [](const QString &message) {
+        qCWarning(SubtitleWriterLog) << "Unable to write subtitle data to file:" << message;
+    });
+    (void) connect(_trackFileWriter, &QGCFileWriter::errorOccurred, this, [](const QString &message) {
+        qCWarning(SubtitleWriterLog) << "Unable to write telemetry track to file:" << message;
+    });
 }
 
 SubtitleWriter::~SubtitleWriter()
@@ -29,7 +63,10 @@ SubtitleWriter::~SubtitleWriter()
 
 void SubtitleWriter::startCapturingTelemetry(const QString &videoFile, QSize size)
 {
-    _size = size;
+    if (_timer.isActive()) {
+        stopCapturingTelemetry();
+    }
+
     _facts.clear();
 
     // Gather the facts currently displayed into _facts
@@ -47,28 +84,147 @@ void SubtitleWriter::startCapturingTelemetry(const QString &videoFile, QSize siz
     }
     grid->deleteLater();
 
-    // One subtitle always starts where the previous ended
-    _lastEndTime = QTime(0, 0);
+    // Everything needed to format the values is captured once, so the writer threads never touch the Facts
+    auto layout = std::make_shared<Layout>();
+    layout->size = size;
+    layout->fields.reserve(_facts.count());
+    for (const Fact *fact : std::as_const(_facts)) {
+        Field field;
+        field.name = fact->shortDescription();
+        field.units = fact->cookedUnits();
+        field.type = fact->type();
+        field.decimalPlaces = fact->decimalPlaces();
+        if ((field.type == FactMetaData::valueTypeFloat) || (field.type == FactMetaData::valueTypeDouble)) {
+            field.changeScale = std::pow(10., qMax(field.decimalPlaces, 0));
+        }
+        layout->fields.append(field);
+    }
+    _layout = layout;
+
+    _current.resize(_facts.count());
+    _emitted.resize(_facts.count());
+    _hasEntry = false;
+    _entryStartMs = 0;
 
     const QFileInfo videoFileInfo(videoFile);
-    const QString subtitleFilePath = QStringLiteral("%1/%2.ass").arg(videoFileInfo.path(), videoFileInfo.completeBaseName());
+    const QString basePath = QStringLiteral("%1/%2").arg(videoFileInfo.path(), videoFileInfo.completeBaseName());
+
+    const QString subtitleFilePath = basePath + QStringLiteral(".ass");
     qCDebug(SubtitleWriterLog) << "Writing overlay to file:" << subtitleFilePath;
-    _file.setFileName(subtitleFilePath);
+    (void) QFile::remove(subtitleFilePath);
+    _subtitleFileWriter->setFilePath(subtitleFilePath);
+    _subtitleFileWriter->clearError();
+    _subtitleFileWriter->writeDeferred([size]() { return formatSubtitleHeader(size); });
+
+    _writeTrack = SettingsManager::instance()->videoSettings()->recordTelemetryTrack()->rawValue().toBool();
+    if (_writeTrack) {
+        const QString trackFilePath = basePath + QStringLiteral(".tlm");
+        qCDebug(SubtitleWriterLog) << "Writing telemetry track to file:" << trackFilePath;
+        (void) QFile::remove(trackFilePath);
+        _trackFileWriter->setFilePath(trackFilePath);
+        _trackFileWriter->clearError();
+        _trackFileWriter->writeDeferred([layout]() { return formatTrackHeader(*layout); });
+    }
+
+    _elapsed.start();
+    _timer.start(1000 / _kSampleRate);
+}
+
+void SubtitleWriter::stopCapturingTelemetry()
+{
+    qCDebug(SubtitleWriterLog) << "Stopping writing";
+    _timer.stop();
+
+    if (_hasEntry) {
+        _finishEntry(_elapsed.elapsed());
+        _hasEntry = false;
+    }
+
+    _subtitleFileWriter->close();
+    _trackFileWriter->close();
+    _facts.clear();
+    _layout.reset();
+}
+
+void SubtitleWriter::_captureTelemetry()
+{
+    if (!MultiVehicleManager::instance()->activeVehicle()) {
+        qCWarning(SubtitleWriterLog) << "Attempting to capture fact data with no active vehicle!";
+        return;
+    }
 
-    if (!_file.open(QIODevice::ReadWrite)) {
-        qCWarning(SubtitleWriterLog) << "Unable to write subtitle data to file";
+    // Snapshot into the preallocated buffer, the cooked values of numeric facts are stored inline in the QVariant
+    bool changed = !_hasEntry;
+    for (qsizetype i = 0; i < _facts.count(); i++) {
+        _current[i] = _facts[i]->cookedValue();
+        if (!changed && valuesDiffer(_layout->fields[i], _current[i], _emitted[i])) {
+            changed = true;
+        }
+    }
+
+    if (!changed) {
+        // Nothing visible changed, the current entry just runs longer
         return;
     }
 
-    QTextStream stream(&_file);
+    const qint64 nowMs = _elapsed.elapsed();
+    const QList<QVariant> previous = _hasEntry ? _emitted : QList<QVariant>();
+    if (_hasEntry) {
+        _finishEntry(nowMs);
+    }
+
+    for (qsizetype i = 0; i < _current.count(); i++) {
+        _emitted[i] = _current[i];
+    }
+
+    if (_writeTrack) {
+        _trackFileWriter->writeDeferred([layout = _layout, previous, values = _emitted, nowMs]() {
+            return formatTrackRecord(*layout, previous, values, nowMs);
+        });
+    }
+
+    // The first entry starts with the recording so the overlay is never blank
+    _entryStartMs = _hasEntry ? nowMs : 0;
+    _hasEntry = true;
+}
+
+void SubtitleWriter::_finishEntry(qint64 endMs)
+{
+    _subtitleFileWriter->writeDeferred([layout = _layout, values = _emitted, startMs = _entryStartMs, endMs]() {
+        return formatSubtitleEntry(*layout, values, startMs, endMs);
+    });
+}
 
+bool SubtitleWriter::valuesDiffer(const Field &field, const QVariant &value1, const QVariant &value2)
+{
+    switch (field.type) {
+    case FactMetaData::valueTypeFloat:
+    case FactMetaData::valueTypeDouble:
+    case FactMetaData::valueTypeElapsedTimeInSeconds:
+    {
+        const double double1 = value1.toDouble();
+        const double double2 = value2.toDouble();
+        if (qIsNaN(double1) || qIsNaN(double2)) {
+            return qIsNaN(double1) != qIsNaN(double2);
+        }
+        return std::llround(double1 * field.changeScale) != std::llround(double2 * field.changeScale);
+    }
+    default:
+        return value1 != value2;
+    }
+}
+
+QByteArray SubtitleWriter::formatSubtitleHeader(QSize size)
+{
     // Calculate the scaled font size based on the recording width
     static constexpr int baseWidth = 640;
     static constexpr int baseFontSize = 12;
-    const int scaledFontSize = (_size.width() * baseFontSize) / baseWidth;
+    const int scaledFontSize = (size.width() * baseFontSize) / baseWidth;
 
-    // This is file header
-    stream << QStringLiteral(
+    // TODO: Find a good way to input title
+    // "Dialogue: 0,0:00:00.00,999:00:00.00,Default,,0,0,0,,{\\pos(5,35)}%1\n"
+
+    return QStringLiteral(
         "[Script Info]\n"
         "Title: QGroundControl Subtitle Telemetry file\n"
         "ScriptType: v4.00+\n"
@@ -84,89 +240,95 @@ void SubtitleWriter::startCapturingTelemetry(const QString &videoFile, QSize siz
         "\n"
         "[Events]\n"
         "Format: Layer, Start, End, Style, Name, MarginL, MarginR, MarginV, Effect, Text\n"
-    ).arg(_size.width()).arg(_size.height()).arg(scaledFontSize);
-
-    // TODO: Find a good way to input title
-    // stream << QStringLiteral("Dialogue: 0,0:00:00.00,999:00:00.00,Default,,0,0,0,,{\\pos(5,35)}%1\n");
-
-    _timer.start(1000 / _kSampleRate);
+    ).arg(size.width()).arg(size.height()).arg(scaledFontSize).toUtf8();
 }
 
-void SubtitleWriter::stopCapturingTelemetry()
-{
-    qCDebug(SubtitleWriterLog) << "Stopping writing";
-    _timer.stop();
-    _file.close();
-}
-
-void SubtitleWriter::_captureTelemetry()
+QByteArray SubtitleWriter::formatSubtitleEntry(const Layout &layout, const QList<QVariant> &values, qint64 startMs, qint64 endMs)
 {
-    if (!MultiVehicleManager::instance()->activeVehicle()) {
-        qCWarning(SubtitleWriterLog) << "Attempting to capture fact data with no active vehicle!";
-        return;
-    }
-
-    // Each list corresponds to a column in the subtitles
-    QStringList namesStrings;
-    QStringList valuesStrings;
-
-    // Make a list of "factname:" strings and other with the values, so one can be aligned left and the other right
-    for (const Fact *fact : std::as_const(_facts)) {
-        valuesStrings << QStringLiteral("%2 %3").arg(fact->cookedValueString(), fact->cookedUnits());
-        namesStrings << QStringLiteral("%1:").arg(fact->shortDescription());
-    }
-
-    // The time to start displaying this subtitle text
-    const QTime start = _lastEndTime;
-
-    // The time to stop displaying this subtitle text
-    const QTime end = start.addMSecs(1000 / _kSampleRate);
-    _lastEndTime = end;
-
     // This splits the screen in N parts and uses the N-1 internal parts to align the subtitles to.
     // Should we try to get the resolution from the pipeline? This seems to work fine with other resolutions too.
     static constexpr int offsetFactor = 100; // Used to reduce the borders in the layout
-    static constexpr float nRows = 3; // number of rows used for displaying data
-    static const int rowWidth = (_size.width() + offsetFactor) / (nRows + 1);
-    const int nValuesByRow = ceil(_facts.length() / nRows);
+    static constexpr int nRows = 3; // number of rows used for displaying data
+    const int rowWidth = (layout.size.width() + offsetFactor) / (nRows + 1);
+    const qsizetype nValuesByRow = (values.count() + nRows - 1) / nRows;
 
-    QStringList stringColumns;
+    const QString start = assTime(startMs);
+    const QString end = assTime(endMs);
+    const QString yPos = QString::number(layout.size.height() - 30);
 
     // These templates are used for the data columns, one right-aligned for names and one for
-    // the facts values. The arguments expected are: start time, end time, xposition, and string content.
-    static const QString namesLine = QStringLiteral("Dialogue: 0,%3,%4,Default,,0,0,0,,{\\an3\\pos(%1,%2)}%5\n");
-    static const QString valuesLine = QStringLiteral("Dialogue: 0,%3,%4,Default,,0,0,0,,{\\pos(%1,%2)}%5\n");
+    // the facts values. The arguments expected are: start time, end time, xposition, ypos and string content.
+    static const QString namesLine = QStringLiteral("Dialogue: 0,%1,%2,Default,,0,0,0,,{\\an3\\pos(%3,%4)}%5\n");
+    static const QString valuesLine = QStringLiteral("Dialogue: 0,%1,%2,Default,,0,0,0,,{\\pos(%3,%4)}%5\n");
+
+    QString text;
 
     // Split values into N columns and create a subtitle entry for each column
     for (int i = 0; i < nRows; i++) {
-        const QStringList currentColumnNameStrings = namesStrings.mid(i * nValuesByRow, nValuesByRow);
-        const QStringList currentColumnValueStrings = valuesStrings.mid(i * nValuesByRow, nValuesByRow);
-
-        // Fill templates for names of column i
-        const QString names = namesLine.arg(QString::number((-offsetFactor / 2) + (rowWidth * (i + 1)) - 10),
-                                            QString::number(_size.height() - 30),
-                                            start.toString("H:mm:ss.zzz").chopped(2),
-                                            end.toString("H:mm:ss.zzz").chopped(2),
-                                            currentColumnNameStrings.join("\\N"));
-        stringColumns << names;
-
-        // Fill templates for values of column i
-        const QString values = valuesLine.arg(QString::number((-offsetFactor / 2) + (rowWidth * (i + 1))),
-                                              QString::number(_size.height() - 30),
-                                              start.toString("H:mm:ss.zzz").chopped(2),
-                                              end.toString("H:mm:ss.zzz").chopped(2),
-                                              currentColumnValueStrings.join("\\N"));
-        stringColumns << values;
+        QString names;
+        QString valueStrings;
+        const qsizetype first = i * nValuesByRow;
+        const qsizetype last = qMin(first + nValuesByRow, values.count());
+        for (qsizetype index = first; index < last; index++) {
+            if (index > first) {
+                names += QStringLiteral("\\N");
+                valueStrings += QStringLiteral("\\N");
+            }
+            const Field &field = layout.fields[index];
+            names += field.name + QLatin1Char(':');
+            valueStrings += Fact::variantToString(values[index], field.type, field.decimalPlaces) + QLatin1Char(' ') + field.units;
+        }
+
+        const int xPos = (-offsetFactor / 2) + (rowWidth * (i + 1));
+        text += namesLine.arg(start, end, QString::number(xPos - 10), yPos, names);
+        text += valuesLine.arg(start, end, QString::number(xPos), yPos, valueStrings);
     }
 
     // Write the date to the corner
-    stringColumns << QStringLiteral("Dialogue: 0,%1,%2,Default,,0,0,0,,{\\pos(10,35)}%3\n").arg(
-                                    start.toString("H:mm:ss.zzz").chopped(2),
-                                    end.toString("H:mm:ss.zzz").chopped(2),
-                                    QDateTime::currentDateTime().toString(QLocale::system().dateFormat(QLocale::ShortFormat)));
-    // Write new data
-    QTextStream stream(&_file);
-    for (const QString &col : std::as_const(stringColumns)) {
-        stream << col;
+    text += QStringLiteral("Dialogue: 0,%1,%2,Default,,0,0,0,,{\\pos(10,35)}%3\n").arg(
+                start, end, QDate::currentDate().toString(QLocale::system().dateFormat(QLocale::ShortFormat)));
+
+    return text.toUtf8();
+}
+
+QByteArray SubtitleWriter::formatTrackHeader(const Layout &layout)
+{
+    QByteArray bytes;
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    setupStream(stream);
+
+    (void) stream.writeRawData("QGCT", 4);
+    stream << kTrackVersion << static_cast<quint16>(layout.fields.count());
+    for (const Field &field : layout.fields) {
+        stream << field.name << field.units << static_cast<quint8>(field.type);
+    }
+
+    return bytes;
+}
+
+QByteArray SubtitleWriter::formatTrackRecord(const Layout &layout, const QList<QVariant> &previousValues, const QList<QVariant> &values, qint64 timeMs)
+{
+    QList<quint16> changed;
+    changed.reserve(values.count());
+    for (qsizetype i = 0; i < values.count(); i++) {
+        if (previousValues.isEmpty() || valuesDiffer(layout.fields[i], previousValues[i], values[i])) {
+            changed.append(static_cast<quint16>(i));
+        }
+    }
+
+    QByteArray bytes;
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    setupStream(stream);
+
+    stream << static_cast<quint32>(timeMs) << static_cast<quint16>(changed.count());
+    for (const quint16 index : std::as_const(changed)) {
+        stream << index;
+        if (layout.fields[index].type == FactMetaData::valueTypeString) {
+            stream << values[index].toString();
+        } else {
+            stream << values[index].toDouble();
+        }
     }
+
+    return bytes;
 }
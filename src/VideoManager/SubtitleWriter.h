@@ -1,13 +1,30 @@
 #pragma once
 
-#include <QtCore/QFile>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QList>
 #include <QtCore/QObject>
 #include <QtCore/QSize>
-#include <QtCore/QTime>
 #include <QtCore/QTimer>
+#include <QtCore/QVariant>
+
+#include <memory>
+
+#include "FactMetaData.h"
 
 class Fact;
+class QGCFileWriter;
 
+/// Saves the telemetry bar values next to a video recording as an ASS subtitle file and, optionally, as a
+/// compact binary telemetry track (.tlm).
+///
+/// Fact values are snapshotted into preallocated buffers on the GUI thread. All string formatting and file
+/// I/O happen on the writer threads. A subtitle entry is only written when a displayed value changes,
+/// otherwise the current entry is extended.
+///
+/// Telemetry track layout (QDataStream, little endian):
+///     header: magic "QGCT", quint16 version, quint16 field count, then per field QString name, QString units, quint8 type
+///     record: quint32 ms since recording start, quint16 changed count, then per changed field quint16 index and
+///             QString for string fields or double for all others
 class SubtitleWriter : public QObject
 {
     Q_OBJECT
@@ -19,14 +36,48 @@ class SubtitleWriter : public QObject
     void startCapturingTelemetry(const QString &videoFile, QSize size);
     void stopCapturingTelemetry();
 
+    struct Field {
+        QString name;
+        QString units;
+        FactMetaData::ValueType_t type = FactMetaData::valueTypeDouble;
+        int decimalPlaces = FactMetaData::kDefaultDecimalPlaces;
+        double changeScale = 1.;  ///< Values are compared after scaling by this and rounding, so changes hidden by the display precision are ignored
+    };
+
+    /// Immutable description of the captured fields, shared with the writer threads
+    struct Layout {
+        QList<Field> fields;
+        QSize size;
+    };
+
+    /// @return true if the two values of field would be displayed differently
+    static bool valuesDiffer(const Field &field, const QVariant &value1, const QVariant &value2);
+
+    static QByteArray formatSubtitleHeader(QSize size);
+    static QByteArray formatSubtitleEntry(const Layout &layout, const QList<QVariant> &values, qint64 startMs, qint64 endMs);
+    static QByteArray formatTrackHeader(const Layout &layout);
+
+    /// Record holding the fields of values which differ from previousValues, or all fields if previousValues is empty
+    static QByteArray formatTrackRecord(const Layout &layout, const QList<QVariant> &previousValues, const QList<QVariant> &values, qint64 timeMs);
+
+    static constexpr quint16 kTrackVersion = 1;
+
 private slots:
     void _captureTelemetry();
 
 private:
-    QFile _file;
+    void _finishEntry(qint64 endMs);
+
     QList<Fact*> _facts;
-    QSize _size;
-    QTime _lastEndTime;
+    std::shared_ptr<const Layout> _layout;
+    QList<QVariant> _current;   ///< Latest snapshot, never shared so unchanged ticks do not allocate
+    QList<QVariant> _emitted;   ///< Values of the subtitle entry currently being extended
+    bool _hasEntry = false;
+    qint64 _entryStartMs = 0;
+    QElapsedTimer _elapsed;
+    QGCFileWriter *_subtitleFileWriter = nullptr;
+    QGCFileWriter *_trackFileWriter = nullptr;
+    bool _writeTrack = false;
     QTimer _timer;
 
     static constexpr int _kSampleRate = 1; ///< Sample rate in Hz for getting telemetry data, most players do weird stuff when > 1Hz
@@ -440,6 +440,28 @@ double VideoManager::aspectRatio() const
     return _videoSettings->aspectRatio()->rawValue().toDouble();
 }
 
+VideoStreamStats *VideoManager::videoStats() const
+{
+    for (VideoReceiver *receiver : _videoReceivers) {
+        if (!receiver->isThermal()) {
+            return receiver->stats();
+        }
+    }
+
+    return nullptr;
+}
+
+VideoStreamStats *VideoManager::thermalVideoStats() const
+{
+    for (VideoReceiver *receiver : _videoReceivers) {
+        if (receiver->isThermal()) {
+            return receiver->stats();
+        }
+    }
+
+    return nullptr;
+}
+
 double VideoManager::thermalAspectRatio() const
 {
     for (VideoReceiver *receiver : _videoReceivers) {
@@ -1019,6 +1041,7 @@ void VideoManager::_initVideoReceiver(VideoReceiver *receiver, QQuickWindow *win
     (void) _updateSettings(receiver);
 
     _videoReceivers.append(receiver);
+    emit videoStatsChanged();
 
     if (hasVideo()) {
         _startReceiver(receiver);
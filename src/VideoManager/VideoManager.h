@@ -14,6 +14,7 @@ class SubtitleWriter;
 class Vehicle;
 class VideoReceiver;
 class VideoSettings;
+class VideoStreamStats;
 
 class VideoManager : public QObject
 {
@@ -43,6 +44,9 @@ class VideoManager : public QObject
     Q_PROPERTY(QSize    videoSize               READ videoSize                                  NOTIFY videoSizeChanged)
     Q_PROPERTY(QString  imageFile               READ imageFile                                  NOTIFY imageFileChanged)
     Q_PROPERTY(QString  uvcVideoSourceID        READ uvcVideoSourceID                           NOTIFY uvcVideoSourceIDChanged)
+    Q_PROPERTY(VideoStreamStats *videoStats         READ videoStats                                 NOTIFY videoStatsChanged)
+    Q_PROPERTY(VideoStreamStats *thermalVideoStats  READ thermalVideoStats                          NOTIFY videoStatsChanged)
+    Q_MOC_INCLUDE("VideoStreamStats.h")
 
     friend class VideoManagerInitTest;
 
@@ -78,6 +82,8 @@ class VideoManager : public QObject
     QSize videoSize() const { return _videoSize; }
     QString imageFile() const { return _imageFile; }
     QString uvcVideoSourceID() const { return _uvcVideoSourceID; }
+    VideoStreamStats *videoStats() const;
+    VideoStreamStats *thermalVideoStats() const;
     void setfullScreen(bool on);
     static bool gstreamerEnabled();
     static bool gstreamerD3D11Sink();
@@ -100,6 +106,7 @@ class VideoManager : public QObject
     void streamingChanged();
     void uvcVideoSourceIDChanged();
     void videoSizeChanged();
+    void videoStatsChanged();
 
 private slots:
     void _communicationLostChanged(bool communicationLost);
@@ -1,13 +1,12 @@
 #include "GstAppSinkAdapter.h"
+#include "GstVideoFrameBuffer.h"
 #include "QGCLoggingCategory.h"
 
 #include <QtCore/QMetaObject>
 #include <QtMultimedia/QVideoFrame>
-#include <QtMultimedia/QVideoFrameFormat>
 #include <QtMultimedia/QVideoSink>
 
 #include <gst/app/gstappsink.h>
-#include <gst/video/video-info.h>
 
 QGC_LOGGING_CATEGORY(GstAppSinkAdapterLog, "Video.GstAppSinkAdapter")
 
@@ -66,89 +65,13 @@ GstFlowReturn GstAppSinkAdapter::onNewSample(GstElement *appsink, gpointer userD
         return GST_FLOW_ERROR;
     }
 
-    GstBuffer *buffer = gst_sample_get_buffer(sample);
-    GstCaps *caps = gst_sample_get_caps(sample);
-    if (!buffer || !caps) {
-        gst_sample_unref(sample);
-        return GST_FLOW_ERROR;
-    }
-
-    GstVideoInfo videoInfo;
-    if (!gst_video_info_from_caps(&videoInfo, caps)) {
-        qCWarning(GstAppSinkAdapterLog) << "Failed to parse video info from caps";
-        gst_sample_unref(sample);
-        return GST_FLOW_ERROR;
-    }
-
-    if (GST_VIDEO_INFO_FORMAT(&videoInfo) != GST_VIDEO_FORMAT_BGRA) {
-        qCWarning(GstAppSinkAdapterLog) << "Unexpected video format (expected BGRA)";
-        gst_sample_unref(sample);
-        return GST_FLOW_ERROR;
-    }
-
-    const int width = GST_VIDEO_INFO_WIDTH(&videoInfo);
-    const int height = GST_VIDEO_INFO_HEIGHT(&videoInfo);
-    if (width <= 0 || height <= 0) {
-        gst_sample_unref(sample);
-        return GST_FLOW_ERROR;
-    }
-
-    GstMapInfo mapInfo;
-    if (!gst_buffer_map(buffer, &mapInfo, GST_MAP_READ)) {
-        qCWarning(GstAppSinkAdapterLog) << "Failed to map GStreamer buffer";
-        gst_sample_unref(sample);
-        return GST_FLOW_ERROR;
-    }
-
-    const QSize frameSize(width, height);
-    const QVideoFrameFormat format(frameSize, QVideoFrameFormat::Format_BGRA8888);
-    QVideoFrame videoFrame(format);
-
-    if (!videoFrame.map(QVideoFrame::WriteOnly)) {
-        qCWarning(GstAppSinkAdapterLog) << "Failed to map QVideoFrame for writing";
-        gst_buffer_unmap(buffer, &mapInfo);
-        gst_sample_unref(sample);
-        return GST_FLOW_ERROR;
-    }
-
-    const int dstStride = videoFrame.bytesPerLine(0);
-    const int srcStride = GST_VIDEO_INFO_PLANE_STRIDE(&videoInfo, 0);
-    const uchar *src = mapInfo.data;
-    uchar *dst = videoFrame.bits(0);
-
-    const int rowBytes = width * 4; // BGRA = 4 bytes per pixel
-    if (rowBytes > srcStride || rowBytes > dstStride) {
-        qCWarning(GstAppSinkAdapterLog) << "Stride smaller than row size:"
-                                        << "rowBytes" << rowBytes
-                                        << "srcStride" << srcStride
-                                        << "dstStride" << dstStride;
-        videoFrame.unmap();
-        gst_buffer_unmap(buffer, &mapInfo);
-        gst_sample_unref(sample);
-        return GST_FLOW_ERROR;
-    }
-
-    const gsize requiredSize = static_cast<gsize>(height - 1) * srcStride + rowBytes;
-    if (mapInfo.size < requiredSize) {
-        qCWarning(GstAppSinkAdapterLog) << "Buffer too small:" << mapInfo.size << "<" << requiredSize;
-        videoFrame.unmap();
-        gst_buffer_unmap(buffer, &mapInfo);
-        gst_sample_unref(sample);
+    // The frame keeps its own reference on the GstBuffer, so the sample can go right away
+    QVideoFrame videoFrame = GstVideoFrameBuffer::createFrame(sample);
+    gst_sample_unref(sample);
+    if (!videoFrame.isValid()) {
         return GST_FLOW_ERROR;
     }
 
-    if (srcStride == dstStride) {
-        memcpy(dst, src, static_cast<size_t>(height) * srcStride);
-    } else {
-        for (int y = 0; y < height; ++y) {
-            memcpy(dst + y * dstStride, src + y * srcStride, rowBytes);
-        }
-    }
-
-    videoFrame.unmap();
-    gst_buffer_unmap(buffer, &mapInfo);
-    gst_sample_unref(sample);
-
     // Dispatch to the QVideoSink's owning thread — onNewSample runs on a
     // GStreamer streaming thread, but QVideoSink is a QObject bound to the
     // main/Qt thread.
@@ -8,9 +8,10 @@ class QVideoSink;
 
 /// Bridges a GStreamer appsink to a Qt QVideoSink.
 ///
-/// Each decoded frame arriving at the appsink is copied into a QVideoFrame
-/// and pushed to the QVideoSink, which renders through Qt's native RHI
-/// backend (Metal on macOS, Vulkan/D3D elsewhere).
+/// Each decoded frame arriving at the appsink is wrapped in a QVideoFrame
+/// without copying (see GstVideoFrameBuffer) and pushed to the QVideoSink,
+/// which renders through Qt's native RHI backend (Metal on macOS,
+/// Vulkan/D3D elsewhere). Planar YUV formats are passed through as-is.
 class GstAppSinkAdapter : public QObject
 {
     Q_OBJECT
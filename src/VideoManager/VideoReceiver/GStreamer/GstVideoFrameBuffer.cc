@@ -0,0 +1,165 @@
+#include "GstVideoFrameBuffer.h"
+#include "QGCLoggingCategory.h"
+
+QGC_LOGGING_CATEGORY(GstVideoFrameBufferLog, "Video.GstVideoFrameBuffer")
+
+namespace {
+
+QVideoFrameFormat::ColorSpace colorSpace(const GstVideoColorimetry &colorimetry)
+{
+    switch (colorimetry.matrix) {
+    case GST_VIDEO_COLOR_MATRIX_BT709:
+        return QVideoFrameFormat::ColorSpace_BT709;
+    case GST_VIDEO_COLOR_MATRIX_BT601:
+        return QVideoFrameFormat::ColorSpace_BT601;
+    case GST_VIDEO_COLOR_MATRIX_BT2020:
+        return QVideoFrameFormat::ColorSpace_BT2020;
+    default:
+        return QVideoFrameFormat::ColorSpace_Undefined;
+    }
+}
+
+QVideoFrameFormat::ColorRange colorRange(const GstVideoColorimetry &colorimetry)
+{
+    switch (colorimetry.range) {
+    case GST_VIDEO_COLOR_RANGE_0_255:
+        return QVideoFrameFormat::ColorRange_Full;
+    case GST_VIDEO_COLOR_RANGE_16_235:
+        return QVideoFrameFormat::ColorRange_Video;
+    default:
+        return QVideoFrameFormat::ColorRange_Unknown;
+    }
+}
+
+} // namespace
+
+GstVideoFrameBuffer::GstVideoFrameBuffer(GstBuffer *buffer, const GstVideoInfo &videoInfo, const QVideoFrameFormat &format)
+    : _buffer(gst_buffer_ref(buffer))
+    , _videoInfo(videoInfo)
+    , _format(format)
+{
+}
+
+GstVideoFrameBuffer::~GstVideoFrameBuffer()
+{
+    unmap();
+    gst_buffer_unref(_buffer);
+}
+
+QAbstractVideoBuffer::MapData GstVideoFrameBuffer::map(QVideoFrame::MapMode mode)
+{
+    MapData mapData;
+
+    // Decoder output may be shared with other branches of the pipeline, so it is never written to
+    if (mode != QVideoFrame::ReadOnly) {
+        qCWarning(GstVideoFrameBufferLog) << "Only read-only mapping is supported";
+        return mapData;
+    }
+
+    if (!_mapped) {
+        // gst_video_frame_map honours GstVideoMeta, so padded decoder strides and plane offsets are used as-is
+        if (!gst_video_frame_map(&_videoFrame, &_videoInfo, _buffer, GST_MAP_READ)) {
+            qCWarning(GstVideoFrameBufferLog) << "Failed to map GStreamer video frame";
+            return mapData;
+        }
+        _mapped = true;
+    }
+
+    const int planes = qMin(static_cast<int>(GST_VIDEO_FRAME_N_PLANES(&_videoFrame)), 4);
+    const int height = GST_VIDEO_FRAME_HEIGHT(&_videoFrame);
+    mapData.planeCount = planes;
+    for (int plane = 0; plane < planes; ++plane) {
+        const int stride = GST_VIDEO_FRAME_PLANE_STRIDE(&_videoFrame, plane);
+        const int component = GST_VIDEO_FORMAT_INFO_PLANE(_videoInfo.finfo, plane);
+        const int planeHeight = GST_VIDEO_FORMAT_INFO_SCALE_HEIGHT(_videoInfo.finfo, component, height);
+        mapData.data[plane] = static_cast<uchar *>(GST_VIDEO_FRAME_PLANE_DATA(&_videoFrame, plane));
+        mapData.bytesPerLine[plane] = stride;
+        mapData.dataSize[plane] = stride * planeHeight;
+    }
+
+    return mapData;
+}
+
+void GstVideoFrameBuffer::unmap()
+{
+    if (_mapped) {
+        gst_video_frame_unmap(&_videoFrame);
+        _mapped = false;
+    }
+}
+
+QVideoFrame GstVideoFrameBuffer::createFrame(GstSample *sample)
+{
+    GstBuffer *buffer = gst_sample_get_buffer(sample);
+    GstCaps *caps = gst_sample_get_caps(sample);
+    if (!buffer || !caps) {
+        return QVideoFrame();
+    }
+
+    GstVideoInfo videoInfo;
+    if (!gst_video_info_from_caps(&videoInfo, caps)) {
+        qCWarning(GstVideoFrameBufferLog) << "Failed to parse video info from caps";
+        return QVideoFrame();
+    }
+
+    const QVideoFrameFormat::PixelFormat qtFormat = pixelFormat(GST_VIDEO_INFO_FORMAT(&videoInfo));
+    if (qtFormat == QVideoFrameFormat::Format_Invalid) {
+        qCWarning(GstVideoFrameBufferLog) << "Unsupported video format:" << gst_video_format_to_string(GST_VIDEO_INFO_FORMAT(&videoInfo));
+        return QVideoFrame();
+    }
+
+    const int width = GST_VIDEO_INFO_WIDTH(&videoInfo);
+    const int height = GST_VIDEO_INFO_HEIGHT(&videoInfo);
+    if ((width <= 0) || (height <= 0)) {
+        return QVideoFrame();
+    }
+
+    QVideoFrameFormat format(QSize(width, height), qtFormat);
+    format.setColorSpace(colorSpace(videoInfo.colorimetry));
+    format.setColorRange(colorRange(videoInfo.colorimetry));
+    if (GST_VIDEO_INFO_FPS_D(&videoInfo) > 0) {
+        format.setStreamFrameRate(static_cast<qreal>(GST_VIDEO_INFO_FPS_N(&videoInfo)) / GST_VIDEO_INFO_FPS_D(&videoInfo));
+    }
+
+    QVideoFrame frame(std::make_unique<GstVideoFrameBuffer>(buffer, videoInfo, format));
+    if (GST_BUFFER_PTS_IS_VALID(buffer)) {
+        frame.setStartTime(static_cast<qint64>(GST_BUFFER_PTS(buffer) / GST_USECOND));
+        if (GST_BUFFER_DURATION_IS_VALID(buffer)) {
+            frame.setEndTime(static_cast<qint64>((GST_BUFFER_PTS(buffer) + GST_BUFFER_DURATION(buffer)) / GST_USECOND));
+        }
+    }
+
+    return frame;
+}
+
+QVideoFrameFormat::PixelFormat GstVideoFrameBuffer::pixelFormat(GstVideoFormat format)
+{
+    switch (format) {
+    case GST_VIDEO_FORMAT_NV12:
+        return QVideoFrameFormat::Format_NV12;
+    case GST_VIDEO_FORMAT_NV21:
+        return QVideoFrameFormat::Format_NV21;
+    case GST_VIDEO_FORMAT_I420:
+        return QVideoFrameFormat::Format_YUV420P;
+    case GST_VIDEO_FORMAT_YV12:
+        return QVideoFrameFormat::Format_YV12;
+    case GST_VIDEO_FORMAT_UYVY:
+        return QVideoFrameFormat::Format_UYVY;
+    case GST_VIDEO_FORMAT_YUY2:
+        return QVideoFrameFormat::Format_YUYV;
+    case GST_VIDEO_FORMAT_P010_10LE:
+        return QVideoFrameFormat::Format_P010;
+    case GST_VIDEO_FORMAT_BGRA:
+        return QVideoFrameFormat::Format_BGRA8888;
+    case GST_VIDEO_FORMAT_BGRx:
+        return QVideoFrameFormat::Format_BGRX8888;
+    case GST_VIDEO_FORMAT_RGBA:
+        return QVideoFrameFormat::Format_RGBA8888;
+    case GST_VIDEO_FORMAT_RGBx:
+        return QVideoFrameFormat::Format_RGBX8888;
+    case GST_VIDEO_FORMAT_GRAY8:
+        return QVideoFrameFormat::Format_Y8;
+    default:
+        return QVideoFrameFormat::Format_Invalid;
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QtMultimedia/QAbstractVideoBuffer>
+#include <QtMultimedia/QVideoFrame>
+#include <QtMultimedia/QVideoFrameFormat>
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+/// QAbstractVideoBuffer backed directly by a decoded GstBuffer.
+///
+/// The buffer holds a reference on the GstBuffer until Qt releases the
+/// QVideoFrame, and maps the GStreamer planes in place, so frames reach
+/// the QVideoSink without an intermediate copy or colour conversion.
+class GstVideoFrameBuffer : public QAbstractVideoBuffer
+{
+public:
+    GstVideoFrameBuffer(GstBuffer *buffer, const GstVideoInfo &videoInfo, const QVideoFrameFormat &format);
+    ~GstVideoFrameBuffer() override;
+
+    MapData map(QVideoFrame::MapMode mode) override;
+    void unmap() override;
+    QVideoFrameFormat format() const override { return _format; }
+
+    /// Wraps the buffer of @p sample in a QVideoFrame without copying.
+    /// Returns an invalid frame if the caps describe a format Qt cannot render.
+    static QVideoFrame createFrame(GstSample *sample);
+
+    /// Qt pixel format for a raw GStreamer format, Format_Invalid if there is no direct equivalent
+    static QVideoFrameFormat::PixelFormat pixelFormat(GstVideoFormat format);
+
+    /// Raw formats createFrame() can pass through, in order of preference, as a caps string for appsink
+    static constexpr const char *kSupportedCaps = "video/x-raw,format=(string){ NV12, I420, YV12, BGRA, BGRx, RGBA, RGBx }";
+
+private:
+    GstBuffer *_buffer = nullptr;
+    GstVideoInfo _videoInfo;
+    GstVideoFrame _videoFrame;
+    bool _mapped = false;
+    QVideoFrameFormat _format;
+};
@@ -64,6 +64,7 @@ void GstVideoReceiver::start(uint32_t timeout)
     qCDebug(GstVideoReceiverLog) << "Starting" << _uri << ", lowLatency" << lowLatency() << ", timeout" << _timeout;
 
     _endOfStream = false;
+    _stats->reset();
 
     bool running = false;
     bool pipelineUp = false;
@@ -535,6 +536,8 @@ void GstVideoReceiver::_watchdog()
             return;
         }
 
+        _stats->publish(g_get_monotonic_time() * 1000);
+
         const qint64 now = QDateTime::currentSecsSinceEpoch();
         if (_lastSourceFrameTime == 0) {
             _lastSourceFrameTime = now;
@@ -1139,10 +1142,22 @@ bool GstVideoReceiver::_addVideoSink(GstPad *pad)
 void GstVideoReceiver::_noteTeeFrame()
 {
     _lastSourceFrameTime = QDateTime::currentSecsSinceEpoch();
+    if (_decoding) {
+        _stats->noteDecodedFrame(g_get_monotonic_time() * 1000);
+    }
 }
 
-void GstVideoReceiver::_noteVideoSinkFrame()
+void GstVideoReceiver::_noteVideoSinkFrame(GstPad *pad, GstBuffer *buffer)
 {
+    if (!_decoding) {
+        // New decoding session, the gap since the previous one is not jitter
+        _stats->reset();
+        _stats->setFrameInterval(_frameInterval(pad));
+    }
+
+    const qint64 latencyNs = buffer ? _bufferLatency(pad, buffer) : -1;
+    _stats->noteDisplayedFrame(g_get_monotonic_time() * 1000, latencyNs);
+
     _lastVideoFrameTime = QDateTime::currentSecsSinceEpoch();
     if (!_decoding) {
         _decoding = true;
@@ -1312,6 +1327,16 @@ gboolean GstVideoReceiver::_onBusMessage(GstBus * /* bus */, GstMessage *msg, gp
             pThis->_handleEOS();
         });
         break;
+    case GST_MESSAGE_QOS: {
+        GstFormat format = GST_FORMAT_UNDEFINED;
+        guint64 processed = 0;
+        guint64 dropped = 0;
+        gst_message_parse_qos_stats(msg, &format, &processed, &dropped);
+        if ((format == GST_FORMAT_BUFFERS) || (format == GST_FORMAT_DEFAULT)) {
+            pThis->_stats->setDroppedFrames(dropped);
+        }
+        break;
+    }
     case GST_MESSAGE_ELEMENT: {
         const GstStructure *structure = gst_message_get_structure(msg);
         if (!gst_structure_has_name(structure, "GstBinForwarded")) {
@@ -1419,6 +1444,63 @@ gboolean GstVideoReceiver::_padProbe(GstElement *element, GstPad *pad, gpointer
     return TRUE;
 }
 
+qint64 GstVideoReceiver::_frameInterval(GstPad *pad)
+{
+    GstCaps *caps = gst_pad_get_current_caps(pad);
+    if (!caps) {
+        return 0;
+    }
+
+    qint64 frameIntervalNs = 0;
+    const GstStructure *structure = gst_caps_get_structure(caps, 0);
+    gint numerator = 0;
+    gint denominator = 0;
+    if (structure && gst_structure_get_fraction(structure, "framerate", &numerator, &denominator) && (numerator > 0) && (denominator > 0)) {
+        frameIntervalNs = static_cast<qint64>(gst_util_uint64_scale_int(GST_SECOND, denominator, numerator));
+    }
+    gst_caps_unref(caps);
+
+    return frameIntervalNs;
+}
+
+qint64 GstVideoReceiver::_bufferLatency(GstPad *pad, GstBuffer *buffer)
+{
+    if (!GST_BUFFER_PTS_IS_VALID(buffer)) {
+        return -1;
+    }
+
+    GstEvent *segmentEvent = gst_pad_get_sticky_event(pad, GST_EVENT_SEGMENT, 0);
+    if (!segmentEvent) {
+        return -1;
+    }
+    const GstSegment *segment = nullptr;
+    gst_event_parse_segment(segmentEvent, &segment);
+    const GstClockTime runningTime = (segment && (segment->format == GST_FORMAT_TIME))
+        ? gst_segment_to_running_time(segment, GST_FORMAT_TIME, GST_BUFFER_PTS(buffer))
+        : GST_CLOCK_TIME_NONE;
+    gst_event_unref(segmentEvent);
+    if (!GST_CLOCK_TIME_IS_VALID(runningTime)) {
+        return -1;
+    }
+
+    GstElement *element = gst_pad_get_parent_element(pad);
+    if (!element) {
+        return -1;
+    }
+    qint64 latencyNs = -1;
+    GstClock *clock = gst_element_get_clock(element);
+    if (clock) {
+        const GstClockTime now = gst_clock_get_time(clock);
+        const GstClockTime baseTime = gst_element_get_base_time(element);
+        latencyNs = static_cast<qint64>(now) - static_cast<qint64>(baseTime + runningTime);
+        gst_object_unref(clock);
+    }
+    gst_object_unref(element);
+
+    // Timestamps in the future mean the source clock is not mapped to ours
+    return (latencyNs >= 0) ? latencyNs : -1;
+}
+
 GstPadProbeReturn GstVideoReceiver::_teeProbe(GstPad *pad, GstPadProbeInfo *info, gpointer user_data)
 {
     Q_UNUSED(pad); Q_UNUSED(info)
@@ -1433,8 +1515,6 @@ GstPadProbeReturn GstVideoReceiver::_teeProbe(GstPad *pad, GstPadProbeInfo *info
 
 GstPadProbeReturn GstVideoReceiver::_videoSinkProbe(GstPad *pad, GstPadProbeInfo *info, gpointer user_data)
 {
-    Q_UNUSED(pad); Q_UNUSED(info)
-
     if (user_data) {
         GstVideoReceiver *pThis = static_cast<GstVideoReceiver*>(user_data);
 
@@ -1466,7 +1546,7 @@ GstPadProbeReturn GstVideoReceiver::_videoSinkProbe(GstPad *pad, GstPadProbeInfo
 #endif
         }
 
-        pThis->_noteVideoSinkFrame();
+        pThis->_noteVideoSinkFrame(pad, info ? gst_pad_probe_info_get_buffer(info) : nullptr);
     }
 
     return GST_PAD_PROBE_OK;
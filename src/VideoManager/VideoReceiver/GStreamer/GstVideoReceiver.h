@@ -72,7 +72,12 @@ private slots:
     void _ensureVideoSinkInPipeline();
     bool _addVideoSink(GstPad *pad);
     void _noteTeeFrame();
-    void _noteVideoSinkFrame();
+    void _noteVideoSinkFrame(GstPad *pad, GstBuffer *buffer);
+    /// Nominal frame interval from the pad's caps, 0 for variable or unknown frame rates
+    static qint64 _frameInterval(GstPad *pad);
+    /// Time between the buffer's source timestamp, mapped to the pipeline clock through its running time, and now.
+    /// Returns -1 if the buffer or segment carries no usable timestamp.
+    static qint64 _bufferLatency(GstPad *pad, GstBuffer *buffer);
     void _noteEndOfStream();
     /// -Unlink the branch from the src pad
     /// -Send an EOS event at the beginning of that branch
@@ -3,6 +3,8 @@
 
 #include <gst/gl/gl.h>
 #if defined(__APPLE__) && defined(__MACH__)
+#include "GstVideoFrameBuffer.h"
+
 #include <gst/app/gstappsink.h>
 #endif
 
@@ -185,8 +187,9 @@ gst_qgc_video_sink_bin_init(GstQgcVideoSinkBin *self)
     self->videoconvert = gst_element_factory_make("videoconvert", NULL);
     self->appsink = gst_element_factory_make("appsink", "qgcappsink");
     if (self->videoconvert && self->appsink) {
-        // Accept BGRA so QVideoFrame can use a simple single-plane copy
-        GstCaps *caps = gst_caps_from_string("video/x-raw,format=BGRA");
+        // Offer the decoder's native planar formats first so videoconvert runs in passthrough
+        // and GstVideoFrameBuffer hands the decoded buffer to Qt without a conversion or copy.
+        GstCaps *caps = gst_caps_from_string(GstVideoFrameBuffer::kSupportedCaps);
         g_object_set(self->appsink,
                      "caps", caps,
                      "emit-signals", TRUE,
@@ -5,6 +5,8 @@
 #include <QtCore/QTimer>
 #include <QtQmlIntegration/QtQmlIntegration>
 
+#include "VideoStreamStats.h"
+
 class QGCVideoStreamInfo;
 class QQuickItem;
 
@@ -16,6 +18,7 @@ class VideoReceiver : public QObject
 public:
     explicit VideoReceiver(QObject *parent = nullptr)
         : QObject(parent)
+        , _stats(new VideoStreamStats(this))
     {}
 
     bool isThermal() const { return (_name == QStringLiteral("thermalVideo")); }
@@ -28,6 +31,7 @@ class VideoReceiver : public QObject
     bool lowLatency() const { return _lowLatency; }
     QGCVideoStreamInfo *videoStreamInfo() { return _videoStreamInfo; }
     QString recordingOutput() const { return _recordingOutput; }
+    VideoStreamStats *stats() const { return _stats; }
 
     virtual void setSink(void *sink) { if (sink != _sink) { _sink = sink; emit sinkChanged(_sink); } }
     virtual void setWidget(QQuickItem *widget) { if (widget != _widget) { _widget = widget; emit widgetChanged(_widget); } }
@@ -119,6 +123,7 @@ public slots:
     uint32_t _signalDepth = 0;
     uint32_t _timeout = 0;
     QString _recordingOutput;
+    VideoStreamStats *_stats = nullptr;
 
     // bool _initialized = false;
     // bool _fullScreen = false;
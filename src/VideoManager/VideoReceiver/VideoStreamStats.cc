@@ -0,0 +1,159 @@
+#include "VideoStreamStats.h"
+
+#include <QtCore/QMutexLocker>
+
+VideoStreamStats::VideoStreamStats(QObject *parent)
+    : QObject(parent)
+{
+}
+
+double VideoStreamStats::decodeFps() const
+{
+    QMutexLocker locker(&_mutex);
+    return _decodeFps;
+}
+
+double VideoStreamStats::displayFps() const
+{
+    QMutexLocker locker(&_mutex);
+    return _displayFps;
+}
+
+double VideoStreamStats::jitterMs() const
+{
+    QMutexLocker locker(&_mutex);
+    return _jitterNs / 1e6;
+}
+
+double VideoStreamStats::latencyMs() const
+{
+    QMutexLocker locker(&_mutex);
+    return _latencyMs;
+}
+
+quint64 VideoStreamStats::droppedFrames() const
+{
+    QMutexLocker locker(&_mutex);
+    return _droppedFrames;
+}
+
+quint64 VideoStreamStats::lateFrames() const
+{
+    QMutexLocker locker(&_mutex);
+    return _lateFrames;
+}
+
+QList<int> VideoStreamStats::jitterHistogram() const
+{
+    QMutexLocker locker(&_mutex);
+    return QList<int>(_histogram.cbegin(), _histogram.cend());
+}
+
+QList<int> VideoStreamStats::jitterBucketsMs() const
+{
+    return QList<int>(kJitterBucketsMs.cbegin(), kJitterBucketsMs.cend());
+}
+
+void VideoStreamStats::reset()
+{
+    {
+        QMutexLocker locker(&_mutex);
+        _windowStartNs = -1;
+        _windowDecoded = 0;
+        _windowDisplayed = 0;
+        _windowLatencySumNs = 0;
+        _windowLatencyCount = 0;
+        _lastDisplayNs = -1;
+        _meanIntervalNs = 0.;
+        _jitterNs = 0.;
+        _frameIntervalNs = 0;
+        _histogram.fill(0);
+        _droppedFrames = 0;
+        _lateFrames = 0;
+        _decodeFps = 0.;
+        _displayFps = 0.;
+        _latencyMs = -1.;
+    }
+    emit statsChanged();
+}
+
+void VideoStreamStats::noteDecodedFrame(qint64 timestampNs)
+{
+    QMutexLocker locker(&_mutex);
+    if (_windowStartNs < 0) {
+        _windowStartNs = timestampNs;
+    }
+    _windowDecoded++;
+}
+
+void VideoStreamStats::noteDisplayedFrame(qint64 timestampNs, qint64 latencyNs)
+{
+    QMutexLocker locker(&_mutex);
+    if (_windowStartNs < 0) {
+        _windowStartNs = timestampNs;
+    }
+    _windowDisplayed++;
+
+    if (latencyNs >= 0) {
+        _windowLatencySumNs += latencyNs;
+        _windowLatencyCount++;
+    }
+
+    if (_lastDisplayNs >= 0) {
+        const double intervalNs = static_cast<double>(timestampNs - _lastDisplayNs);
+        const double expectedIntervalNs = (_frameIntervalNs > 0) ? static_cast<double>(_frameIntervalNs) : _meanIntervalNs;
+        if ((expectedIntervalNs > 0.) && (intervalNs > (expectedIntervalNs * 1.5))) {
+            _lateFrames++;
+        }
+        if (_meanIntervalNs <= 0.) {
+            _meanIntervalNs = intervalNs;
+        }
+        const double deviationNs = qAbs(intervalNs - _meanIntervalNs);
+        _meanIntervalNs += (intervalNs - _meanIntervalNs) / 16.;
+        _jitterNs += (deviationNs - _jitterNs) / 16.;
+
+        size_t bucket = 0;
+        while ((bucket < kJitterBucketsMs.size()) && (deviationNs >= (kJitterBucketsMs[bucket] * 1e6))) {
+            bucket++;
+        }
+        _histogram[bucket]++;
+    }
+    _lastDisplayNs = timestampNs;
+}
+
+void VideoStreamStats::setFrameInterval(qint64 frameIntervalNs)
+{
+    QMutexLocker locker(&_mutex);
+    _frameIntervalNs = qMax(frameIntervalNs, qint64(0));
+}
+
+void VideoStreamStats::setDroppedFrames(quint64 droppedFrames)
+{
+    QMutexLocker locker(&_mutex);
+    _droppedFrames = droppedFrames;
+}
+
+void VideoStreamStats::publish(qint64 timestampNs)
+{
+    {
+        QMutexLocker locker(&_mutex);
+        if (_windowStartNs < 0) {
+            _windowStartNs = timestampNs;
+        }
+        const qint64 elapsedNs = timestampNs - _windowStartNs;
+        if (elapsedNs <= 0) {
+            return;
+        }
+
+        _decodeFps = (_windowDecoded * 1e9) / elapsedNs;
+        _displayFps = (_windowDisplayed * 1e9) / elapsedNs;
+        _latencyMs = (_windowLatencyCount > 0) ? ((_windowLatencySumNs / static_cast<double>(_windowLatencyCount)) / 1e6) : -1.;
+
+        _windowStartNs = timestampNs;
+        _windowDecoded = 0;
+        _windowDisplayed = 0;
+        _windowLatencySumNs = 0;
+        _windowLatencyCount = 0;
+    }
+    emit statsChanged();
+}
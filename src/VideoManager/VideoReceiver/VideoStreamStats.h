@@ -0,0 +1,89 @@
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtQmlIntegration/QtQmlIntegration>
+
+#include <array>
+
+/// Frame timing statistics for one video stream.
+///
+/// The note*() methods are called from the streaming threads of the video backend for every frame,
+/// publish() folds the samples gathered since its previous call into the values exposed to QML.
+/// All timestamps are monotonic nanoseconds.
+class VideoStreamStats : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("")
+    Q_PROPERTY(double       decodeFps           READ decodeFps          NOTIFY statsChanged)
+    Q_PROPERTY(double       displayFps          READ displayFps         NOTIFY statsChanged)
+    Q_PROPERTY(double       jitterMs            READ jitterMs           NOTIFY statsChanged)
+    Q_PROPERTY(double       latencyMs           READ latencyMs          NOTIFY statsChanged)
+    Q_PROPERTY(quint64      droppedFrames       READ droppedFrames      NOTIFY statsChanged)
+    Q_PROPERTY(quint64      lateFrames          READ lateFrames         NOTIFY statsChanged)
+    Q_PROPERTY(QList<int>   jitterHistogram     READ jitterHistogram    NOTIFY statsChanged)
+    Q_PROPERTY(QList<int>   jitterBucketsMs     READ jitterBucketsMs    CONSTANT)
+
+public:
+    explicit VideoStreamStats(QObject *parent = nullptr);
+
+    /// Upper bounds of the inter-frame jitter histogram buckets, the last bucket is open ended
+    static constexpr std::array<int, 6> kJitterBucketsMs = { 1, 2, 5, 10, 20, 50 };
+
+    double decodeFps() const;
+    double displayFps() const;
+    /// Smoothed deviation of the display inter-frame interval (RFC 3550 style)
+    double jitterMs() const;
+    /// Mean source-to-display latency over the last publish interval, -1 if the stream carries no usable timestamps
+    double latencyMs() const;
+    quint64 droppedFrames() const;
+    quint64 lateFrames() const;
+    /// Display frame counts per kJitterBucketsMs bucket since the last reset
+    QList<int> jitterHistogram() const;
+    QList<int> jitterBucketsMs() const;
+
+    void reset();
+
+    /// A frame entered the decoder
+    void noteDecodedFrame(qint64 timestampNs);
+    /// A frame reached the display sink. It is counted as late when it arrives more than half a frame interval
+    /// after the previous frame's slot ended, i.e. the viewer saw the previous frame for at least 1.5 intervals.
+    ///     @param latencyNs Time since the frame's source timestamp, -1 if unknown
+    void noteDisplayedFrame(qint64 timestampNs, qint64 latencyNs = -1);
+    /// Nominal frame interval from the stream caps, 0 if unknown. Late frames are then judged against the
+    /// smoothed measured interval instead.
+    void setFrameInterval(qint64 frameIntervalNs);
+    /// Total frames the sinks reported as dropped (GStreamer QoS)
+    void setDroppedFrames(quint64 droppedFrames);
+
+    void publish(qint64 timestampNs);
+
+signals:
+    void statsChanged();
+
+private:
+    mutable QMutex _mutex;
+
+    // Current publish window
+    qint64 _windowStartNs = -1;
+    quint64 _windowDecoded = 0;
+    quint64 _windowDisplayed = 0;
+    qint64 _windowLatencySumNs = 0;
+    quint64 _windowLatencyCount = 0;
+
+    // Running state
+    qint64 _lastDisplayNs = -1;
+    double _meanIntervalNs = 0.;
+    double _jitterNs = 0.;
+    qint64 _frameIntervalNs = 0;
+    std::array<int, kJitterBucketsMs.size() + 1> _histogram{};
+    quint64 _droppedFrames = 0;
+    quint64 _lateFrames = 0;
+
+    // Published
+    double _decodeFps = 0.;
+    double _displayFps = 0.;
+    double _latencyMs = -1.;
+};
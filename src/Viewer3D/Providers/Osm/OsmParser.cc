@@ -6,10 +6,11 @@
 #include "SettingsManager.h"
 #include "Viewer3DSettings.h"
 
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QStandardPaths>
 #include <QtCore/QThread>
 
-#include <mapbox/earcut.hpp>
-
 #include <array>
 
 QGC_LOGGING_CATEGORY(OsmParserLog, "Viewer3d.OsmParser")
@@ -22,6 +23,8 @@ OsmParser::OsmParser(QObject *parent)
     _setBuildingLevelHeight(viewer3DSettings->buildingLevelHeight()->rawValue());
     connect(viewer3DSettings->buildingLevelHeight(), &Fact::rawValueChanged, this, &OsmParser::_setBuildingLevelHeight);
     connect(_osmParserWorker, &OsmParserThread::fileParsed, this, &OsmParser::_onOsmParserFinished);
+
+    _osmParserWorker->setCacheDirectory(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/QGCOsmMeshCache"));
 }
 
 OsmParser::~OsmParser()
@@ -80,80 +83,83 @@ void OsmParser::parseOsmFile(const QString &filePath)
 
 QByteArray OsmParser::buildingToMesh()
 {
-    QByteArray vertexData;
-    const auto &buildings = _osmParserWorker->mapBuildings();
-    vertexData.reserve(static_cast<qsizetype>(buildings.size()) * 1000);
-
-    for (auto it = buildings.begin(), end = buildings.end(); it != end; ++it) {
-        const auto &building = it.value();
-        float buildingHeight = 0;
-
-        std::vector<std::array<float, 2>> allPoints;
-        std::vector<std::array<float, 2>> ringPoints;
-        std::vector<std::vector<std::array<float, 2>>> polygon;
-        std::vector<QVector3D> mesh;
-
-        if (building.height > 0) {
-            buildingHeight = building.height;
-        } else if (building.levels > 0) {
-            buildingHeight = static_cast<float>(building.levels) * _buildingLevelHeight;
-        } else {
-            continue;
+    QElapsedTimer meshTimer;
+    meshTimer.start();
+
+    QList<const OsmParserThread::BuildingType_t *> buildings;
+    const auto &mapBuildings = _osmParserWorker->mapBuildings();
+    buildings.reserve(mapBuildings.size());
+    for (const OsmParserThread::BuildingType_t &building : mapBuildings) {
+        if (building.hasHeight()) {
+            buildings.append(&building);
         }
+    }
 
-        for (const auto &pt : building.points_local) {
-            ringPoints.push_back({pt.x(), pt.y()});
-            allPoints.push_back({pt.x(), pt.y()});
-        }
-        polygon.push_back(ringPoints);
+    const float levelHeight = _buildingLevelHeight;
+    const QList<QByteArray> buildingMeshes = QtConcurrent::blockingMapped<QList<QByteArray>>(buildings, [levelHeight](const OsmParserThread::BuildingType_t *building) {
+        return _buildingMesh(*building, levelHeight);
+    });
 
-        ringPoints.clear();
-        for (const auto &pt : building.points_local_inner) {
-            ringPoints.push_back({pt.x(), pt.y()});
-            allPoints.push_back({pt.x(), pt.y()});
-        }
-        if (!ringPoints.empty()) {
-            polygon.push_back(ringPoints);
-        }
+    qsizetype totalSize = 0;
+    for (const QByteArray &buildingMesh : buildingMeshes) {
+        totalSize += buildingMesh.size();
+    }
 
-        const std::vector<uint32_t> indices = mapbox::earcut<uint32_t>(polygon);
-
-        for (size_t i = 0; i < indices.size(); i += 3) {
-            uint32_t idx = indices[i];
-            mesh.push_back(QVector3D(allPoints[idx][0], allPoints[idx][1], buildingHeight));
-            idx = indices[i + 1];
-            mesh.push_back(QVector3D(allPoints[idx][0], allPoints[idx][1], buildingHeight));
-            idx = indices[i + 2];
-            mesh.push_back(QVector3D(allPoints[idx][0], allPoints[idx][1], buildingHeight));
-
-            idx = indices[i + 2];
-            mesh.push_back(QVector3D(allPoints[idx][0], allPoints[idx][1], 0));
-            idx = indices[i + 1];
-            mesh.push_back(QVector3D(allPoints[idx][0], allPoints[idx][1], 0));
-            idx = indices[i];
-            mesh.push_back(QVector3D(allPoints[idx][0], allPoints[idx][1], 0));
-        }
+    QByteArray vertexData;
+    vertexData.reserve(totalSize);
+    for (const QByteArray &buildingMesh : buildingMeshes) {
+        vertexData.append(buildingMesh);
+    }
+
+    qCDebug(OsmParserLog) << "Meshed" << buildings.size() << "buildings in" << meshTimer.elapsed() << "ms";
+    return vertexData;
+}
 
-        if (buildingHeight > 0) {
-            _triangulateWallsExtrudedPolygon(mesh, building.points_local, buildingHeight, false);
-            _triangulateWallsExtrudedPolygon(mesh, building.points_local, buildingHeight, true);
+QByteArray OsmParser::_buildingMesh(const OsmParserThread::BuildingType_t &building, float levelHeight)
+{
+    const float buildingHeight = (building.height > 0) ? building.height : (building.levels * levelHeight);
 
-            _triangulateWallsExtrudedPolygon(mesh, building.points_local_inner, buildingHeight, false);
-            _triangulateWallsExtrudedPolygon(mesh, building.points_local_inner, buildingHeight, true);
-        }
+    const auto point = [&building](uint32_t idx) -> const QVector2D & {
+        const size_t outerCount = building.points_local.size();
+        return (idx < outerCount) ? building.points_local[idx] : building.points_local_inner[idx - outerCount];
+    };
 
-        QByteArray buildingData(mesh.size() * 3 * sizeof(float), Qt::Initialization::Uninitialized);
-        float *p = reinterpret_cast<float *>(buildingData.data());
+    std::vector<QVector3D> mesh;
+    mesh.reserve((building.roof_indices.size() * 2) + ((building.points_local.size() + building.points_local_inner.size() + 2) * 12));
 
-        for (const auto &vertex : mesh) {
-            *p++ = vertex.x();
-            *p++ = vertex.y();
-            *p++ = vertex.z();
-        }
+    const std::vector<uint32_t> &indices = building.roof_indices;
+    for (size_t i = 0; (i + 2) < indices.size(); i += 3) {
+        const QVector2D &p0 = point(indices[i]);
+        const QVector2D &p1 = point(indices[i + 1]);
+        const QVector2D &p2 = point(indices[i + 2]);
 
-        vertexData.append(buildingData);
+        mesh.push_back(QVector3D(p0, buildingHeight));
+        mesh.push_back(QVector3D(p1, buildingHeight));
+        mesh.push_back(QVector3D(p2, buildingHeight));
+
+        mesh.push_back(QVector3D(p2, 0));
+        mesh.push_back(QVector3D(p1, 0));
+        mesh.push_back(QVector3D(p0, 0));
     }
-    return vertexData;
+
+    if (buildingHeight > 0) {
+        _triangulateWallsExtrudedPolygon(mesh, building.points_local, buildingHeight, false);
+        _triangulateWallsExtrudedPolygon(mesh, building.points_local, buildingHeight, true);
+
+        _triangulateWallsExtrudedPolygon(mesh, building.points_local_inner, buildingHeight, false);
+        _triangulateWallsExtrudedPolygon(mesh, building.points_local_inner, buildingHeight, true);
+    }
+
+    QByteArray buildingData(mesh.size() * 3 * sizeof(float), Qt::Initialization::Uninitialized);
+    float *p = reinterpret_cast<float *>(buildingData.data());
+
+    for (const auto &vertex : mesh) {
+        *p++ = vertex.x();
+        *p++ = vertex.y();
+        *p++ = vertex.z();
+    }
+
+    return buildingData;
 }
 
 void OsmParser::_triangulateWallsExtrudedPolygon(std::vector<QVector3D> &triangulatedMesh, const std::vector<QVector2D> &verticesCcw, float h, bool inverseOrder)
@@ -8,9 +8,8 @@
 
 #include <vector>
 
+#include "OsmParserThread.h"
 #include "Viewer3DMapProvider.h"
-
-class OsmParserThread;
 class QVariant;
 
 class OsmParser : public Viewer3DMapProvider
@@ -42,8 +41,10 @@ class OsmParser : public Viewer3DMapProvider
 private:
     void _setBuildingLevelHeight(const QVariant &value);
     void _onOsmParserFinished(bool isValid);
-    void _triangulateWallsExtrudedPolygon(std::vector<QVector3D> &triangulatedMesh, const std::vector<QVector2D> &verticesCcw, float h, bool inverseOrder);
-    void _triangulateRectangle(std::vector<QVector3D> &triangulatedMesh, const std::vector<QVector3D> &verticesCcw, bool invertNormal);
+    /// Thread safe, runs for many buildings at once
+    static QByteArray _buildingMesh(const OsmParserThread::BuildingType_t &building, float levelHeight);
+    static void _triangulateWallsExtrudedPolygon(std::vector<QVector3D> &triangulatedMesh, const std::vector<QVector2D> &verticesCcw, float h, bool inverseOrder);
+    static void _triangulateRectangle(std::vector<QVector3D> &triangulatedMesh, const std::vector<QVector3D> &verticesCcw, bool invertNormal);
 
     OsmParserThread *_osmParserWorker = nullptr;
 
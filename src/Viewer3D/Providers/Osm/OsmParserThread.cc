@@ -1,17 +1,26 @@
 #include "OsmParserThread.h"
 
+#include "QGCFileHelper.h"
 #include "QGCGeo.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtCore/QDataStream>
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QThread>
 
+#include <mapbox/earcut.hpp>
+
 #include <osmium/handler.hpp>
 #include <osmium/io/reader.hpp>
 #include <osmium/io/xml_input.hpp>
 #include <osmium/visitor.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <exception>
 #include <limits>
@@ -41,12 +50,11 @@ class OsmBuildingHandler : public osmium::handler::Handler
             return;
         }
 
-        QGeoCoordinate coord;
-        coord.setLatitude(node.location().lat());
-        coord.setLongitude(node.location().lon());
-        coord.setAltitude(0);
-
-        nodes.insert(static_cast<uint64_t>(nodeId), coord);
+        const uint64_t id = static_cast<uint64_t>(nodeId);
+        if (!nodes.isEmpty() && (id <= nodes.constLast().id)) {
+            _nodesSorted = false;
+        }
+        nodes.append(OsmParserThread::NodeType_t{id, node.location().lat(), node.location().lon()});
     }
 
     void way(const osmium::Way &way)
@@ -64,18 +72,20 @@ class OsmBuildingHandler : public osmium::handler::Handler
         double xMax = -1e10, xMin = 1e10;
         double yMax = -1e10, yMin = 1e10;
 
+        _sortNodes();
+
         for (const auto &nr : way.nodes()) {
             const int64_t refId = nr.ref();
             if (refId <= 0) {
                 continue;
             }
 
-            auto it = nodes.constFind(static_cast<uint64_t>(refId));
-            if (it == nodes.constEnd()) {
+            const OsmParserThread::NodeType_t *const node = findNode(static_cast<uint64_t>(refId));
+            if (!node) {
                 continue;
             }
 
-            const QGeoCoordinate &gpsCoord = it.value();
+            const QGeoCoordinate gpsCoord(node->latitude, node->longitude, 0);
             gpsPoints.push_back(gpsCoord);
             const QVector3D localPt = QGCGeo::convertGpsToEnu(gpsCoord, _gpsRef);
             localPoints.push_back(QVector2D(localPt.x(), localPt.y()));
@@ -184,12 +194,36 @@ class OsmBuildingHandler : public osmium::handler::Handler
         }
     }
 
-    QMap<uint64_t, QGeoCoordinate> nodes;
-    QMap<uint64_t, OsmParserThread::BuildingType_t> buildings;
+    const OsmParserThread::NodeType_t *findNode(uint64_t id) const
+    {
+        const auto it = std::lower_bound(nodes.cbegin(), nodes.cend(), id,
+                                         [](const OsmParserThread::NodeType_t &node, uint64_t nodeId) { return node.id < nodeId; });
+        return ((it != nodes.cend()) && (it->id == id)) ? &(*it) : nullptr;
+    }
+
+    // Sorted, flat node storage; OSM files normally list nodes in id order so sorting is rarely needed
+    QList<OsmParserThread::NodeType_t> nodes;
+    QHash<uint64_t, OsmParserThread::BuildingType_t> buildings;
     QGeoCoordinate coordMin;
     QGeoCoordinate coordMax;
 
 private:
+    void _sortNodes()
+    {
+        if (_nodesSorted) {
+            return;
+        }
+        std::stable_sort(nodes.begin(), nodes.end(),
+                         [](const OsmParserThread::NodeType_t &a, const OsmParserThread::NodeType_t &b) { return a.id < b.id; });
+        // Keep the last definition of a duplicated id
+        auto last = std::unique(nodes.rbegin(), nodes.rend(),
+                                [](const OsmParserThread::NodeType_t &a, const OsmParserThread::NodeType_t &b) { return a.id == b.id; });
+        nodes.erase(nodes.begin(), last.base());
+        _nodesSorted = true;
+    }
+
+    bool _nodesSorted = true;
+
     const QGeoCoordinate &_gpsRef;
     const QStringList &_singleStorey;
     const QStringList &_doubleStoreyLeisure;
@@ -211,6 +245,160 @@ void OsmParserThread::BuildingType_t::append(const std::vector<QVector2D> &newPo
     target.insert(target.end(), newPoints.begin(), newPoints.end());
 }
 
+std::vector<uint32_t> OsmParserThread::triangulateRoof(const BuildingType_t &building)
+{
+    using Point = std::array<float, 2>;
+    std::vector<std::vector<Point>> polygon(building.points_local_inner.empty() ? 1 : 2);
+
+    polygon[0].reserve(building.points_local.size());
+    for (const QVector2D &pt : building.points_local) {
+        polygon[0].push_back({pt.x(), pt.y()});
+    }
+    if (!building.points_local_inner.empty()) {
+        polygon[1].reserve(building.points_local_inner.size());
+        for (const QVector2D &pt : building.points_local_inner) {
+            polygon[1].push_back({pt.x(), pt.y()});
+        }
+    }
+
+    return mapbox::earcut<uint32_t>(polygon);
+}
+
+// ============================================================================
+// Mesh cache
+// ============================================================================
+
+namespace {
+
+template<typename T>
+void writeVector(QDataStream &stream, const std::vector<T> &values)
+{
+    stream << static_cast<quint32>(values.size());
+    (void) stream.writeRawData(reinterpret_cast<const char *>(values.data()), static_cast<int>(values.size() * sizeof(T)));
+}
+
+template<typename T>
+bool readVector(QDataStream &stream, std::vector<T> &values)
+{
+    quint32 count = 0;
+    stream >> count;
+    if ((stream.status() != QDataStream::Ok) || (count > (stream.device()->bytesAvailable() / sizeof(T)))) {
+        return false;
+    }
+    values.resize(count);
+    const int bytes = static_cast<int>(count * sizeof(T));
+    return stream.readRawData(reinterpret_cast<char *>(values.data()), bytes) == bytes;
+}
+
+void writeCoordinate(QDataStream &stream, const QGeoCoordinate &coordinate)
+{
+    stream << coordinate.latitude() << coordinate.longitude();
+}
+
+QGeoCoordinate readCoordinate(QDataStream &stream)
+{
+    double latitude = 0;
+    double longitude = 0;
+    stream >> latitude >> longitude;
+    return QGeoCoordinate(latitude, longitude, 0);
+}
+
+} // namespace
+
+QString OsmParserThread::_meshCachePath(const QString &filePath) const
+{
+    if (_cacheDirectory.isEmpty()) {
+        return QString();
+    }
+
+    const QString hash = QGCFileHelper::computeFileHash(filePath, QCryptographicHash::Sha1);
+    if (hash.isEmpty()) {
+        return QString();
+    }
+
+    return QDir(_cacheDirectory).filePath(hash + QStringLiteral(".osmmesh"));
+}
+
+bool OsmParserThread::_loadMeshCache(const QString &cachePath)
+{
+    QFile file(cachePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if ((magic != kMeshCacheMagic) || (version != kMeshCacheVersion)) {
+        qCDebug(OsmParserThreadLog) << "Ignoring mesh cache with version" << version << cachePath;
+        return false;
+    }
+
+    const QGeoCoordinate gpsRefPoint = readCoordinate(stream);
+    const QGeoCoordinate coordinateMin = readCoordinate(stream);
+    const QGeoCoordinate coordinateMax = readCoordinate(stream);
+
+    quint32 buildingCount = 0;
+    stream >> buildingCount;
+
+    QHash<uint64_t, BuildingType_t> buildings;
+    buildings.reserve(buildingCount);
+    for (quint32 i = 0; (i < buildingCount) && (stream.status() == QDataStream::Ok); i++) {
+        quint64 id = 0;
+        BuildingType_t building;
+        stream >> id >> building.height >> building.levels >> building.bb_min >> building.bb_max;
+        if (!readVector(stream, building.points_local) || !readVector(stream, building.points_local_inner) || !readVector(stream, building.roof_indices)) {
+            break;
+        }
+        buildings.insert(id, std::move(building));
+    }
+
+    if ((stream.status() != QDataStream::Ok) || (static_cast<quint32>(buildings.size()) != buildingCount)) {
+        qCWarning(OsmParserThreadLog) << "Corrupt mesh cache" << cachePath;
+        (void) file.remove();
+        return false;
+    }
+
+    _gpsRefPoint = gpsRefPoint;
+    _coordinateMin = coordinateMin;
+    _coordinateMax = coordinateMax;
+    _mapBuildings = std::move(buildings);
+    return true;
+}
+
+void OsmParserThread::_saveMeshCache(const QString &cachePath) const
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << kMeshCacheMagic << kMeshCacheVersion;
+    writeCoordinate(stream, _gpsRefPoint);
+    writeCoordinate(stream, _coordinateMin);
+    writeCoordinate(stream, _coordinateMax);
+
+    // Only what buildingToMesh() uses, untagged ways and the GPS copies are left out
+    quint32 buildingCount = 0;
+    for (const BuildingType_t &building : _mapBuildings) {
+        buildingCount += building.hasHeight() ? 1 : 0;
+    }
+    stream << buildingCount;
+
+    for (auto it = _mapBuildings.cbegin(); it != _mapBuildings.cend(); ++it) {
+        const BuildingType_t &building = it.value();
+        if (!building.hasHeight()) {
+            continue;
+        }
+        stream << static_cast<quint64>(it.key()) << building.height << building.levels << building.bb_min << building.bb_max;
+        writeVector(stream, building.points_local);
+        writeVector(stream, building.points_local_inner);
+        writeVector(stream, building.roof_indices);
+    }
+
+    if (!QDir().mkpath(_cacheDirectory) || !QGCFileHelper::atomicWrite(cachePath, data)) {
+        qCWarning(OsmParserThreadLog) << "Failed to write mesh cache" << cachePath;
+    }
+}
+
 // ============================================================================
 // OsmParserThread
 // ============================================================================
@@ -241,6 +429,7 @@ void OsmParserThread::_parseOsmFile(const QString &filePath)
 {
     _mapNodes.clear();
     _mapBuildings.clear();
+    _loadedFromCache = false;
 
     if (filePath.isEmpty()) {
         if (_mapLoadedFlag) {
@@ -274,6 +463,18 @@ void OsmParserThread::_parseOsmFile(const QString &filePath)
         return;
     }
 
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+
+    const QString cachePath = _meshCachePath(resolvedPath);
+    if (!cachePath.isEmpty() && _loadMeshCache(cachePath)) {
+        qCDebug(OsmParserThreadLog) << _mapBuildings.size() << "buildings loaded from cache in" << loadTimer.elapsed() << "ms";
+        _loadedFromCache = true;
+        _mapLoadedFlag = true;
+        emit fileParsed(true);
+        return;
+    }
+
     try {
         osmium::io::File inputFile{resolvedPath.toStdString()};
         osmium::io::Reader reader{inputFile, osmium::osm_entity_bits::all};
@@ -309,11 +510,11 @@ void OsmParserThread::_parseOsmFile(const QString &filePath)
             double maxLat = std::numeric_limits<double>::lowest();
             double maxLon = std::numeric_limits<double>::lowest();
 
-            for (auto it = _mapNodes.cbegin(); it != _mapNodes.cend(); ++it) {
-                minLat = std::fmin(minLat, it.value().latitude());
-                minLon = std::fmin(minLon, it.value().longitude());
-                maxLat = std::fmax(maxLat, it.value().latitude());
-                maxLon = std::fmax(maxLon, it.value().longitude());
+            for (const NodeType_t &node : std::as_const(_mapNodes)) {
+                minLat = std::fmin(minLat, node.latitude);
+                minLon = std::fmin(minLon, node.longitude);
+                maxLat = std::fmax(maxLat, node.latitude);
+                maxLon = std::fmax(maxLon, node.longitude);
             }
 
             _coordinateMin = QGeoCoordinate(minLat, minLon, 0);
@@ -357,6 +558,13 @@ void OsmParserThread::_parseOsmFile(const QString &filePath)
             _coordinateMax = handler.coordMax;
         }
 
+        _triangulateBuildings();
+        qCDebug(OsmParserThreadLog) << _mapBuildings.size() << "buildings parsed in" << loadTimer.elapsed() << "ms";
+
+        if (!cachePath.isEmpty()) {
+            _saveMeshCache(cachePath);
+        }
+
         _mapLoadedFlag = true;
         emit fileParsed(true);
     } catch (const std::exception &e) {
@@ -364,3 +572,19 @@ void OsmParserThread::_parseOsmFile(const QString &filePath)
         emit fileParsed(false);
     }
 }
+
+void OsmParserThread::_triangulateBuildings()
+{
+    QList<BuildingType_t *> buildings;
+    buildings.reserve(_mapBuildings.size());
+    for (BuildingType_t &building : _mapBuildings) {
+        if (building.hasHeight()) {
+            buildings.append(&building);
+        }
+    }
+
+    // Buildings are independent, earcut runs on all cores
+    QtConcurrent::blockingMap(buildings, [](BuildingType_t *building) {
+        building->roof_indices = triangulateRoof(*building);
+    });
+}
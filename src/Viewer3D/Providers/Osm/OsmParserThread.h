@@ -1,6 +1,7 @@
 #pragma once
 
-#include <QtCore/QMap>
+#include <QtCore/QHash>
+#include <QtCore/QList>
 #include <QtCore/QObject>
 #include <QtCore/QStringList>
 #include <QtGui/QVector2D>
@@ -11,6 +12,11 @@
 
 class QThread;
 
+/// Parses an OSM file into building footprints on a worker thread.
+///
+/// Roofs are triangulated in parallel right after parsing. When a cache directory is set the footprints and
+/// roof triangles are stored there keyed by the hash of the source file, so loading the same file again
+/// skips parsing and triangulation.
 class OsmParserThread : public QObject
 {
     Q_OBJECT
@@ -18,12 +24,20 @@ class OsmParserThread : public QObject
     friend class OsmParserThreadTest;
 
 public:
+    struct NodeType_t
+    {
+        uint64_t id = 0;
+        double latitude = 0;
+        double longitude = 0;
+    };
+
     struct BuildingType_t
     {
-        std::vector<QGeoCoordinate> points_gps;
+        std::vector<QGeoCoordinate> points_gps;         ///< Empty when loaded from the mesh cache
         std::vector<QGeoCoordinate> points_gps_inner;
         std::vector<QVector2D> points_local;
         std::vector<QVector2D> points_local_inner;
+        std::vector<uint32_t> roof_indices;             ///< Triangles over points_local followed by points_local_inner
         QVector2D bb_max = QVector2D(-1e6, -1e6);
         QVector2D bb_min = QVector2D(1e6, 1e6);
         float height = 0;
@@ -31,6 +45,7 @@ class OsmParserThread : public QObject
 
         void append(const std::vector<QGeoCoordinate> &newPoints, bool isInner);
         void append(const std::vector<QVector2D> &newPoints, bool isInner);
+        bool hasHeight() const { return (height > 0) || (levels > 0); }
     };
 
     explicit OsmParserThread(QObject *parent = nullptr);
@@ -38,9 +53,17 @@ class OsmParserThread : public QObject
 
     void start(const QString &filePath);
 
+    /// Where parsed buildings are cached, empty (the default) disables the cache. Call before start().
+    void setCacheDirectory(const QString &cacheDirectory) { _cacheDirectory = cacheDirectory; }
+    const QString &cacheDirectory() const { return _cacheDirectory; }
+    bool loadedFromCache() const { return _loadedFromCache; }
+
+    static std::vector<uint32_t> triangulateRoof(const BuildingType_t &building);
+
     const QGeoCoordinate& gpsRefPoint() const { return _gpsRefPoint; }
-    const QMap<uint64_t, QGeoCoordinate>& mapNodes() const { return _mapNodes; }
-    const QMap<uint64_t, BuildingType_t>& mapBuildings() const { return _mapBuildings; }
+    /// Sorted by id, empty when loaded from the mesh cache
+    const QList<NodeType_t>& mapNodes() const { return _mapNodes; }
+    const QHash<uint64_t, BuildingType_t>& mapBuildings() const { return _mapBuildings; }
     const QGeoCoordinate& coordinateMin() const { return _coordinateMin; }
     const QGeoCoordinate& coordinateMax() const { return _coordinateMax; }
 
@@ -50,10 +73,14 @@ class OsmParserThread : public QObject
 
 private:
     void _parseOsmFile(const QString &filePath);
+    void _triangulateBuildings();
+    QString _meshCachePath(const QString &filePath) const;
+    bool _loadMeshCache(const QString &cachePath);
+    void _saveMeshCache(const QString &cachePath) const;
 
     QGeoCoordinate _gpsRefPoint;
-    QMap<uint64_t, QGeoCoordinate> _mapNodes;
-    QMap<uint64_t, BuildingType_t> _mapBuildings;
+    QList<NodeType_t> _mapNodes;
+    QHash<uint64_t, BuildingType_t> _mapBuildings;
     QGeoCoordinate _coordinateMin;
     QGeoCoordinate _coordinateMax;
 
@@ -71,5 +98,10 @@ class OsmParserThread : public QObject
         QStringLiteral("sauna")
     };
 
+    QString _cacheDirectory;
+    bool _loadedFromCache = false;
     bool _mapLoadedFlag = false;
+
+    static constexpr quint32 kMeshCacheMagic = 0x514F534D;     ///< "QOSM"
+    static constexpr quint32 kMeshCacheVersion = 1;            ///< Bump whenever the layout or the parsing rules change
 };
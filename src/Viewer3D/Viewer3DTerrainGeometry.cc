@@ -6,7 +6,9 @@
 #include "SettingsManager.h"
 #include "Viewer3DSettings.h"
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QByteArray>
+#include <QtCore/QElapsedTimer>
 
 #include <cmath>
 
@@ -23,37 +25,52 @@ Viewer3DTerrainGeometry::Viewer3DTerrainGeometry()
 
 void Viewer3DTerrainGeometry::updateEarthData()
 {
-    clear();
-    const int stride = 3 * sizeof(float)
-                     + 3 * sizeof(float)   // normals
-                     + 2 * sizeof(float);  // UV
-
-    if (!_buildTerrain(roiMin(), roiMax(), refCoordinate(), true)) {
-        qCDebug(Viewer3DTerrainGeometryLog) << "buildTerrain returned false (sector/stack count likely 0)";
+    const BuildParams_t params{_sectorCount, _stackCount, roiMin(), roiMax(), refCoordinate()};
+    if (_hasRequest && (params == _requestedParams)) {
+        qCDebug(Viewer3DTerrainGeometryLog) << "Terrain unchanged, skipping rebuild";
         return;
     }
 
-    QByteArray vertexData;
-    vertexData.resize(_vertices.size() * stride);
-    float *p = reinterpret_cast<float *>(vertexData.data());
-
-    for (size_t i = 0; i < _vertices.size(); ++i) {
-        *p++ = _vertices[i].x();
-        *p++ = _vertices[i].y();
-        *p++ = _vertices[i].z();
+    if ((params.sectorCount <= 0) || (params.stackCount <= 0)) {
+        qCDebug(Viewer3DTerrainGeometryLog) << "buildTerrain skipped (sector/stack count is 0)";
+        // Forget the last request and drop builds still running, so neither can bring the old terrain back
+        _hasRequest = false;
+        ++_buildGeneration;
+        clear();
+        update();
+        return;
+    }
 
-        *p++ = _normals[i].x();
-        *p++ = _normals[i].y();
-        *p++ = _normals[i].z();
+    _requestedParams = params;
+    _hasRequest = true;
+
+    // Results of builds superseded while they ran are dropped
+    const int generation = ++_buildGeneration;
+    (void) QtConcurrent::run([params]() {
+        QElapsedTimer buildTimer;
+        buildTimer.start();
+        TerrainMesh_t mesh = _buildTerrainMesh(params, true);
+        _packTerrainMesh(mesh);
+        qCDebug(Viewer3DTerrainGeometryLog) << "Terrain built in" << buildTimer.elapsed() << "ms";
+        return mesh;
+    }).then(this, [this, generation](TerrainMesh_t mesh) {
+        if (generation == _buildGeneration) {
+            _applyTerrainMesh(std::move(mesh));
+        }
+    });
+}
 
-        *p++ = _texCoords[i].x();
-        *p++ = _texCoords[i].y();
-    }
+void Viewer3DTerrainGeometry::_applyTerrainMesh(TerrainMesh_t &&mesh)
+{
+    clear();
 
-    qCDebug(Viewer3DTerrainGeometryLog) << "Terrain built:" << _vertices.size() << "vertices," << _sectorCount << "sectors," << _stackCount << "stacks";
+    qCDebug(Viewer3DTerrainGeometryLog) << "Terrain:" << (mesh.vertexData.size() / kStride) << "vertices,"
+                                        << (mesh.indexData.size() / static_cast<qsizetype>(3 * sizeof(uint32_t))) << "triangles,"
+                                        << _sectorCount << "sectors," << _stackCount << "stacks";
 
-    setVertexData(vertexData);
-    setStride(stride);
+    setVertexData(mesh.vertexData);
+    setIndexData(mesh.indexData);
+    setStride(kStride);
 
     setPrimitiveType(QQuick3DGeometry::PrimitiveType::Triangles);
     addAttribute(QQuick3DGeometry::Attribute::PositionSemantic,
@@ -65,10 +82,40 @@ void Viewer3DTerrainGeometry::updateEarthData()
     addAttribute(QQuick3DGeometry::Attribute::TexCoordSemantic,
                  6 * sizeof(float),
                  QQuick3DGeometry::Attribute::F32Type);
+    addAttribute(QQuick3DGeometry::Attribute::IndexSemantic,
+                 0,
+                 QQuick3DGeometry::Attribute::U32Type);
 
     update();
 }
 
+void Viewer3DTerrainGeometry::_packTerrainMesh(TerrainMesh_t &mesh)
+{
+    mesh.vertexData.resize(static_cast<qsizetype>(mesh.vertices.size()) * kStride);
+    float *p = reinterpret_cast<float *>(mesh.vertexData.data());
+
+    for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+        *p++ = mesh.vertices[i].x();
+        *p++ = mesh.vertices[i].y();
+        *p++ = mesh.vertices[i].z();
+
+        *p++ = mesh.normals[i].x();
+        *p++ = mesh.normals[i].y();
+        *p++ = mesh.normals[i].z();
+
+        *p++ = mesh.texCoords[i].x();
+        *p++ = mesh.texCoords[i].y();
+    }
+
+    mesh.indexData = QByteArray(reinterpret_cast<const char *>(mesh.indices.data()), static_cast<qsizetype>(mesh.indices.size() * sizeof(uint32_t)));
+
+    // The GPU buffers are all that is kept
+    mesh.vertices = {};
+    mesh.texCoords = {};
+    mesh.normals = {};
+    mesh.indices = {};
+}
+
 QVector3D Viewer3DTerrainGeometry::_computeFaceNormal(const QVector3D &x1, const QVector3D &x2, const QVector3D &x3)
 {
     constexpr float EPSILON = 0.000001f;
@@ -102,9 +149,8 @@ void Viewer3DTerrainGeometry::_clearScene()
     clear();
     setSectorCount(0);
     setStackCount(0);
-    _vertices.clear();
-    _normals.clear();
-    _texCoords.clear();
+    _hasRequest = false;
+    ++_buildGeneration;
     update();
 }
 
@@ -126,21 +172,20 @@ void Viewer3DTerrainGeometry::setStackCount(int newStackCount)
     emit stackCountChanged();
 }
 
-bool Viewer3DTerrainGeometry::_buildTerrain(const QGeoCoordinate &roiMinCoordinate, const QGeoCoordinate &roiMaxCoordinate, const QGeoCoordinate &refCoordinate, bool scale)
+Viewer3DTerrainGeometry::TerrainMesh_t Viewer3DTerrainGeometry::_buildTerrainMesh(const BuildParams_t &params, bool scale)
 {
-    if (_sectorCount == 0 || _stackCount == 0) {
-        return false;
-    }
+    const int sectorCount = params.sectorCount;
+    const int stackCount = params.stackCount;
 
-    const float sectorLength = std::abs(roiMaxCoordinate.longitude() - roiMinCoordinate.longitude());
-    const float stackLength = std::abs(roiMaxCoordinate.latitude() - roiMinCoordinate.latitude());
-    const float stackRef = roiMaxCoordinate.latitude();
-    const float sectorRef = roiMinCoordinate.longitude();
+    const float sectorLength = std::abs(params.roiMax.longitude() - params.roiMin.longitude());
+    const float stackLength = std::abs(params.roiMax.latitude() - params.roiMin.latitude());
+    const float stackRef = params.roiMax.latitude();
+    const float sectorRef = params.roiMin.longitude();
 
-    struct Vertex {
-        float x, y, z, s, t;
-    };
-    std::vector<Vertex> tmpVertices;
+    TerrainMesh_t mesh;
+    const size_t vertexCount = static_cast<size_t>(stackCount + 1) * static_cast<size_t>(sectorCount + 1);
+    mesh.vertices.reserve(vertexCount);
+    mesh.texCoords.reserve(vertexCount);
 
     float minT = 10;
     float maxT = -10;
@@ -148,110 +193,81 @@ bool Viewer3DTerrainGeometry::_buildTerrain(const QGeoCoordinate &roiMinCoordina
     float maxS = -10;
 
     // Resolution of each polygon changes by the portion
-    const float sectorStep = sectorLength / _sectorCount;
-    const float stackStep = stackLength / _stackCount;
+    const float sectorStep = sectorLength / sectorCount;
+    const float stackStep = stackLength / stackCount;
     float sectorAngle, stackAngle;
 
-    for (int i = 0; i <= _stackCount; ++i) {
+    // Grid vertices are shared by up to six triangles
+    for (int i = 0; i <= stackCount; ++i) {
         stackAngle = stackRef - i * stackStep;
 
-        for (int j = 0; j <= _sectorCount; ++j) {
+        for (int j = 0; j <= sectorCount; ++j) {
             sectorAngle = sectorRef + j * sectorStep;
 
-            Vertex vertex;
-            const QVector3D localPoint = QGCGeo::convertGpsToEnu(QGeoCoordinate(stackAngle, sectorAngle, 0), refCoordinate);
-            vertex.x = localPoint.x();
-            vertex.y = localPoint.y();
-            vertex.z = 0;
+            const QVector3D localPoint = QGCGeo::convertGpsToEnu(QGeoCoordinate(stackAngle, sectorAngle, 0), params.refCoordinate);
+            mesh.vertices.push_back(QVector3D(localPoint.x(), localPoint.y(), 0));
 
-            vertex.s = (sectorAngle + 180.0f) / 360.0f;
-            minS = std::fmin(minS, vertex.s);
-            maxS = std::fmax(maxS, vertex.s);
+            const float s = (sectorAngle + 180.0f) / 360.0f;
+            minS = std::fmin(minS, s);
+            maxS = std::fmax(maxS, s);
 
+            float t;
             if (std::abs(stackAngle) < kMaxLatitude) {
                 const double sinLatitude = std::sin(qDegreesToRadians(stackAngle));
-                vertex.t = 0.5 - std::log((1 + sinLatitude) / (1 - sinLatitude)) / (4 * M_PI);
+                t = 0.5 - std::log((1 + sinLatitude) / (1 - sinLatitude)) / (4 * M_PI);
             } else {
-                vertex.t = (stackRef - stackAngle) / 180;
+                t = (stackRef - stackAngle) / 180;
             }
-            minT = std::fmin(minT, vertex.t);
-            maxT = std::fmax(maxT, vertex.t);
+            minT = std::fmin(minT, t);
+            maxT = std::fmax(maxT, t);
 
-            tmpVertices.push_back(vertex);
+            mesh.texCoords.push_back(QVector2D(s, t));
         }
     }
 
-    const float scaleT = maxT - minT;
-    const float scaleS = maxS - minS;
-    _vertices.clear();
-    _texCoords.clear();
-    _normals.clear();
-
-    Vertex v1, v2, v3, v4;
-    int vi1, vi2;
-    QVector3D n;
-
-    for (int i = 0; i < _stackCount; ++i) {
-        vi1 = i * (_sectorCount + 1);
-        vi2 = (i + 1) * (_sectorCount + 1);
-        stackAngle = stackRef - i * stackStep;
+    if (scale) {
+        const float scaleT = maxT - minT;
+        const float scaleS = maxS - minS;
+        for (QVector2D &texCoord : mesh.texCoords) {
+            texCoord = QVector2D((texCoord.x() - minS) / scaleS, (texCoord.y() - minT) / scaleT);
+        }
+    }
 
-        for (int j = 0; j < _sectorCount; ++j, ++vi1, ++vi2) {
-            v1 = tmpVertices[vi1];
-            v2 = tmpVertices[vi2];
-            v3 = tmpVertices[vi1 + 1];
-            v4 = tmpVertices[vi2 + 1];
-
-            if (scale) {
-                v1.s = (v1.s - minS) / scaleS;
-                v1.t = (v1.t - minT) / scaleT;
-                v2.s = (v2.s - minS) / scaleS;
-                v2.t = (v2.t - minT) / scaleT;
-                v3.s = (v3.s - minS) / scaleS;
-                v3.t = (v3.t - minT) / scaleT;
-                v4.s = (v4.s - minS) / scaleS;
-                v4.t = (v4.t - minT) / scaleT;
-            }
+    mesh.indices.reserve(static_cast<size_t>(stackCount) * static_cast<size_t>(sectorCount) * 6);
+    mesh.normals.assign(vertexCount, QVector3D(0, 0, 0));
 
-            if (stackAngle < 90) {
-                _vertices.push_back(QVector3D(v1.x, v1.y, v1.z));
-                _vertices.push_back(QVector3D(v2.x, v2.y, v2.z));
-                _vertices.push_back(QVector3D(v3.x, v3.y, v3.z));
+    const auto addTriangle = [&mesh](uint32_t a, uint32_t b, uint32_t c) {
+        mesh.indices.push_back(a);
+        mesh.indices.push_back(b);
+        mesh.indices.push_back(c);
 
-                _texCoords.push_back(QVector2D(v1.s, v1.t));
-                _texCoords.push_back(QVector2D(v2.s, v2.t));
-                _texCoords.push_back(QVector2D(v3.s, v3.t));
+        // Smooth normals, every vertex averages the faces around it
+        const QVector3D n = _computeFaceNormal(mesh.vertices[a], mesh.vertices[b], mesh.vertices[c]);
+        mesh.normals[a] += n;
+        mesh.normals[b] += n;
+        mesh.normals[c] += n;
+    };
 
-                n = _computeFaceNormal(QVector3D(v1.x, v1.y, v1.z),
-                                      QVector3D(v2.x, v2.y, v2.z),
-                                      QVector3D(v3.x, v3.y, v3.z));
+    for (int i = 0; i < stackCount; ++i) {
+        uint32_t vi1 = static_cast<uint32_t>(i * (sectorCount + 1));
+        uint32_t vi2 = static_cast<uint32_t>((i + 1) * (sectorCount + 1));
+        stackAngle = stackRef - i * stackStep;
 
-                for (int k = 0; k < 3; ++k) {
-                    _normals.push_back(n);
-                }
+        for (int j = 0; j < sectorCount; ++j, ++vi1, ++vi2) {
+            if (stackAngle < 90) {
+                addTriangle(vi1, vi2, vi1 + 1);
             }
-
             if (stackAngle > -90) {
-                _vertices.push_back(QVector3D(v3.x, v3.y, v3.z));
-                _vertices.push_back(QVector3D(v2.x, v2.y, v2.z));
-                _vertices.push_back(QVector3D(v4.x, v4.y, v4.z));
-
-                _texCoords.push_back(QVector2D(v3.s, v3.t));
-                _texCoords.push_back(QVector2D(v2.s, v2.t));
-                _texCoords.push_back(QVector2D(v4.s, v4.t));
-
-                n = _computeFaceNormal(QVector3D(v3.x, v3.y, v3.z),
-                                      QVector3D(v2.x, v2.y, v2.z),
-                                      QVector3D(v4.x, v4.y, v4.z));
-
-                for (int k = 0; k < 3; ++k) {
-                    _normals.push_back(n);
-                }
+                addTriangle(vi1 + 1, vi2, vi2 + 1);
             }
         }
     }
 
-    return true;
+    for (QVector3D &normal : mesh.normals) {
+        normal.normalize();
+    }
+
+    return mesh;
 }
 
 void Viewer3DTerrainGeometry::setRoiMin(const QGeoCoordinate &newRoiMin)
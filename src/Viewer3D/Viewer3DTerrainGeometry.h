@@ -8,6 +8,10 @@
 
 #include <vector>
 
+/// Flat map plane spanning the ROI, one grid cell per map tile.
+///
+/// The grid is an indexed mesh with shared vertices and is built and packed on the thread pool, the GUI thread
+/// only swaps the finished buffers in. Requests which would produce the mesh already shown are skipped.
 class Viewer3DTerrainGeometry : public QQuick3DGeometry
 {
     Q_OBJECT
@@ -49,13 +53,40 @@ class Viewer3DTerrainGeometry : public QQuick3DGeometry
     void refCoordinateChanged();
 
 private:
-    bool _buildTerrain(const QGeoCoordinate &roiMinCoordinate, const QGeoCoordinate &roiMaxCoordinate, const QGeoCoordinate &refCoordinate, bool scale);
+    struct BuildParams_t
+    {
+        int sectorCount = 0;
+        int stackCount = 0;
+        QGeoCoordinate roiMin;
+        QGeoCoordinate roiMax;
+        QGeoCoordinate refCoordinate;
+
+        bool operator==(const BuildParams_t &other) const = default;
+    };
+
+    struct TerrainMesh_t
+    {
+        std::vector<QVector3D> vertices;
+        std::vector<QVector2D> texCoords;
+        std::vector<QVector3D> normals;
+        std::vector<uint32_t> indices;
+        QByteArray vertexData;      ///< Interleaved position, normal, UV
+        QByteArray indexData;
+    };
+
+    /// Thread safe
+    static TerrainMesh_t _buildTerrainMesh(const BuildParams_t &params, bool scale);
+    /// Thread safe. Fills vertexData and indexData and releases the vectors they were packed from.
+    static void _packTerrainMesh(TerrainMesh_t &mesh);
     static QVector3D _computeFaceNormal(const QVector3D &x1, const QVector3D &x2, const QVector3D &x3);
+    void _applyTerrainMesh(TerrainMesh_t &&mesh);
     void _clearScene();
 
-    std::vector<QVector3D> _vertices;
-    std::vector<QVector2D> _texCoords;
-    std::vector<QVector3D> _normals;
+    static constexpr int kStride = (3 + 3 + 2) * sizeof(float);    ///< Position, normal, UV
+
+    BuildParams_t _requestedParams;     ///< Last mesh built or being built
+    bool _hasRequest = false;
+    int _buildGeneration = 0;
 
     QGeoCoordinate _roiMin;
     QGeoCoordinate _roiMax;
@@ -47,10 +47,11 @@ void Viewer3DTerrainTexture::_updateTexture()
 {
     qCDebug(Viewer3DTerrainTextureLog) << "Texture loaded:" << _terrainTileLoader->mapSize();
     setSize(_terrainTileLoader->mapSize());
-    setFormat(QQuick3DTextureData::RGBA32F);
+    setFormat(QQuick3DTextureData::RGBA8);
     setHasTransparency(false);
 
-    setTextureData(_terrainTileLoader->mapData());
+    // The loader is discarded below, take its buffer instead of copying it
+    setTextureData(_terrainTileLoader->takeMapData());
     _setTextureLoaded(true);
     setTextureGeometryDone(true);
     disconnect(_terrainTileLoader, &Viewer3DTileQuery::mapTileDownloaded, this, &Viewer3DTerrainTexture::setTextureDownloadProgress);
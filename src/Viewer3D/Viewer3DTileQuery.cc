@@ -5,11 +5,12 @@
 #include "QGCMapUrlEngine.h"
 #include "Viewer3DTileReply.h"
 
-#include <QtGui/QPainter>
-#include <QtGui/QPixmap>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtGui/QColor>
 #include <QtNetwork/QNetworkAccessManager>
 
 #include <cmath>
+#include <cstring>
 
 QGC_LOGGING_CATEGORY(Viewer3DTileQueryLog, "Viewer3d.Viewer3DTileQuery")
 
@@ -25,30 +26,58 @@ void Viewer3DTileQuery::MapTileContainer_t::init()
 {
     mapWidth = (tileMaxIndex.x() - tileMinIndex.x() + 1) * tileSize;
     mapHeight = (tileMaxIndex.y() - tileMinIndex.y() + 1) * tileSize;
-    mapTextureImage = QImage(mapWidth, mapHeight, QImage::Format_RGBA32FPx4);
-    mapTextureImage.fill(Qt::gray);
+
+    // Tiles which never arrive stay gray, fill one row and replicate it
+    const qsizetype rowBytes = static_cast<qsizetype>(mapWidth) * bytesPerPixel;
+    mapTextureData = QByteArray(rowBytes * mapHeight, Qt::Uninitialized);
+    char *const bits = mapTextureData.data();
+    const QColor gray(Qt::gray);
+    for (int x = 0; x < mapWidth; x++) {
+        char *const pixel = bits + (x * bytesPerPixel);
+        pixel[0] = static_cast<char>(gray.red());
+        pixel[1] = static_cast<char>(gray.green());
+        pixel[2] = static_cast<char>(gray.blue());
+        pixel[3] = static_cast<char>(0xFF);
+    }
+    for (int y = 1; y < mapHeight; y++) {
+        (void) memcpy(bits + (y * rowBytes), bits, rowBytes);
+    }
 }
 
-void Viewer3DTileQuery::MapTileContainer_t::setMapTile()
+QImage Viewer3DTileQuery::MapTileContainer_t::decodeTile(const QByteArray &tileData)
 {
-    QPixmap tmpPixmap;
-    tmpPixmap.loadFromData(currentTileData);
-    QImage tmpImage = tmpPixmap.toImage().convertToFormat(QImage::Format_RGBA32FPx4);
+    QImage tileImage;
+    if (!tileImage.loadFromData(tileData)) {
+        return QImage();
+    }
 
-    QPainter painter(&mapTextureImage);
-    int idxX = (currentTileIndex.x() - tileMinIndex.x()) * tileSize;
-    int idxY = (currentTileIndex.y() - tileMinIndex.y()) * tileSize;
-    painter.drawImage(idxX, idxY, tmpImage);
+    if (tileImage.size() != QSize(tileSize, tileSize)) {
+        tileImage = tileImage.scaled(tileSize, tileSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+
+    return tileImage.convertToFormat(QImage::Format_RGBA8888);
 }
 
-QByteArray Viewer3DTileQuery::MapTileContainer_t::mapData() const
+void Viewer3DTileQuery::MapTileContainer_t::setMapTile(QPoint tileIndex, const QImage &tileImage)
 {
-    return QByteArray(reinterpret_cast<const char *>(mapTextureImage.constBits()), mapTextureImage.sizeInBytes());
+    const int idxX = (tileIndex.x() - tileMinIndex.x()) * tileSize;
+    const int idxY = (tileIndex.y() - tileMinIndex.y()) * tileSize;
+    if (tileImage.isNull() || (idxX < 0) || (idxY < 0) || ((idxX + tileSize) > mapWidth) || ((idxY + tileSize) > mapHeight)) {
+        return;
+    }
+
+    const qsizetype rowBytes = static_cast<qsizetype>(mapWidth) * bytesPerPixel;
+    const qsizetype tileRowBytes = static_cast<qsizetype>(tileSize) * bytesPerPixel;
+    char *const bits = mapTextureData.data() + (idxY * rowBytes) + (idxX * bytesPerPixel);
+    for (int y = 0; y < tileSize; y++) {
+        (void) memcpy(bits + (y * rowBytes), tileImage.constScanLine(y), tileRowBytes);
+    }
 }
 
 void Viewer3DTileQuery::MapTileContainer_t::clear()
 {
     tileList.clear();
+    mapTextureData.clear();
 }
 
 void Viewer3DTileQuery::_loadMapTiles(int zoomLevel, QPoint tileMinIndex, QPoint tileMaxIndex)
@@ -59,6 +88,11 @@ void Viewer3DTileQuery::_loadMapTiles(int zoomLevel, QPoint tileMinIndex, QPoint
     _mapToBeLoaded.tileMaxIndex = tileMaxIndex;
     _mapToBeLoaded.init();
 
+    _generation++;
+    _pendingDecodes = 0;
+    _peakPendingDecodes = 0;
+    _buildTimer.start();
+
     if (!_networkManager) {
         _networkManager = new QNetworkAccessManager(this);
         _networkManager->setTransferTimeout(9000);
@@ -173,36 +207,66 @@ void Viewer3DTileQuery::_tileDone(Viewer3DTileInfo tileData)
     const qsizetype itemRemoved = _mapToBeLoaded.tileList.removeAll(key);
 
     if (itemRemoved > 0) {
-        _mapToBeLoaded.currentTileIndex = QPoint(tileData.x, tileData.y);
-        _mapToBeLoaded.currentTileData = tileData.data;
-        _mapToBeLoaded.setMapTile();
         _downloadedTilesCount++;
         emit mapTileDownloaded(100.0f * (static_cast<float>(_downloadedTilesCount) / static_cast<float>(_totalTilesCount)));
 
-        if (_mapToBeLoaded.tileList.isEmpty()) {
-            qCDebug(Viewer3DTileQueryLog) << "All tiles downloaded";
-            _downloadedTilesCount = _totalTilesCount;
-            emit loadingMapCompleted();
-        }
+        // Decoding is the expensive part, keep it off the GUI thread
+        _pendingDecodes++;
+        _peakPendingDecodes = qMax(_peakPendingDecodes, _pendingDecodes);
+        const int generation = _generation;
+        const QPoint tileIndex(tileData.x, tileData.y);
+        (void) QtConcurrent::run(&MapTileContainer_t::decodeTile, tileData.data).then(this, [this, generation, tileIndex](const QImage &tileImage) {
+            _tileDecoded(generation, tileIndex, tileImage);
+        });
     }
 
     _cleanupReply(reply);
 }
 
+void Viewer3DTileQuery::_tileDecoded(int generation, QPoint tileIndex, const QImage &tileImage)
+{
+    if (generation != _generation) {
+        return;
+    }
+
+    _pendingDecodes--;
+    if (tileImage.isNull()) {
+        qCWarning(Viewer3DTileQueryLog) << "Failed to decode tile" << tileIndex;
+    } else {
+        _mapToBeLoaded.setMapTile(tileIndex, tileImage);
+    }
+
+    _checkLoadingCompleted();
+}
+
+void Viewer3DTileQuery::_checkLoadingCompleted()
+{
+    if (!_mapToBeLoaded.tileList.isEmpty() || (_pendingDecodes > 0)) {
+        return;
+    }
+
+    // Decoded tiles waiting for their copy are the only memory on top of the texture itself
+    const qsizetype tileBytes = static_cast<qsizetype>(MapTileContainer_t::tileSize) * MapTileContainer_t::tileSize * MapTileContainer_t::bytesPerPixel;
+    qCDebug(Viewer3DTileQueryLog) << "All tiles downloaded, texture" << _mapToBeLoaded.mapWidth << "x" << _mapToBeLoaded.mapHeight
+                                  << "built in" << _buildTimer.elapsed() << "ms, peak memory"
+                                  << (_mapToBeLoaded.mapTextureData.size() + (_peakPendingDecodes * tileBytes)) / 1024 << "kB";
+    _downloadedTilesCount = _totalTilesCount;
+    emit loadingMapCompleted();
+}
+
 void Viewer3DTileQuery::_tileGiveUp(Viewer3DTileInfo tileData)
 {
     auto *reply = qobject_cast<Viewer3DTileReply *>(QObject::sender());
     _cleanupReply(reply);
 
     const QString key = _tileKey(tileData.mapId, tileData.x, tileData.y, tileData.zoomLevel);
-    _mapToBeLoaded.tileList.removeAll(key);
+    if (_mapToBeLoaded.tileList.removeAll(key) == 0) {
+        return;
+    }
     _downloadedTilesCount++;
     emit mapTileDownloaded(100.0f * (static_cast<float>(_downloadedTilesCount) / static_cast<float>(_totalTilesCount)));
 
-    if (_mapToBeLoaded.tileList.isEmpty()) {
-        _downloadedTilesCount = _totalTilesCount;
-        emit loadingMapCompleted();
-    }
+    _checkLoadingCompleted();
 }
 
 void Viewer3DTileQuery::_tileEmpty(Viewer3DTileInfo tileData)
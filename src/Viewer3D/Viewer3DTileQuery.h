@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QtCore/QByteArray>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QObject>
 #include <QtCore/QPoint>
 #include <QtCore/QSize>
@@ -9,6 +10,8 @@
 #include <QtGui/QImage>
 #include <QtPositioning/QGeoCoordinate>
 
+#include <utility>
+
 #include "Viewer3DTileInfo.h"
 #include "Viewer3DTileStatistics.h"
 
@@ -28,7 +31,9 @@ class Viewer3DTileQuery : public QObject
 
     void adaptiveMapTilesLoader(const QString &mapType, int mapId, const QGeoCoordinate &coordinateMin, const QGeoCoordinate &coordinateMax);
     int maxTileCount(int zoomLevel, const QGeoCoordinate &coordinateMin, const QGeoCoordinate &coordinateMax);
-    QByteArray mapData() const { return _mapToBeLoaded.mapData(); }
+    QByteArray mapData() const { return _mapToBeLoaded.mapTextureData; }
+    /// Hands the assembled RGBA8 texture over without copying it, the query is empty afterwards
+    QByteArray takeMapData() { return std::exchange(_mapToBeLoaded.mapTextureData, QByteArray()); }
     QSize mapSize() const { return QSize(_mapToBeLoaded.mapWidth, _mapToBeLoaded.mapHeight); }
 
 signals:
@@ -42,28 +47,33 @@ class Viewer3DTileQuery : public QObject
     void _tileDone(Viewer3DTileInfo tileData);
     void _tileGiveUp(Viewer3DTileInfo tileData);
     void _tileEmpty(Viewer3DTileInfo tileData);
+    void _tileDecoded(int generation, QPoint tileIndex, const QImage &tileImage);
+    void _checkLoadingCompleted();
     void _cleanupReply(Viewer3DTileReply *reply);
     static QString _tileKey(int mapId, int x, int y, int zoomLevel);
 
+    /// The map texture as tightly packed 8 bit RGBA, the layout QQuick3DTextureData::RGBA8 uploads directly.
+    /// Tiles are decoded on the thread pool and only copied into their block of the texture on the GUI thread.
     struct MapTileContainer_t
     {
         static constexpr int tileSize = 256;
+        static constexpr int bytesPerPixel = 4;
 
         QStringList tileList;
         QPoint tileMinIndex;
         QPoint tileMaxIndex;
-        QPoint currentTileIndex;
-        QByteArray currentTileData;
-        QImage mapTextureImage;
+        QByteArray mapTextureData;
 
         int zoomLevel = 0;
         int mapWidth = 0;
         int mapHeight = 0;
 
         void init();
-        void setMapTile();
-        QByteArray mapData() const;
+        void setMapTile(QPoint tileIndex, const QImage &tileImage);
         void clear();
+
+        /// Thread safe, returns a null image if the data can not be decoded
+        static QImage decodeTile(const QByteArray &tileData);
     };
 
     QNetworkAccessManager *_networkManager = nullptr;
@@ -72,6 +82,11 @@ class Viewer3DTileQuery : public QObject
     QGeoCoordinate _textureCoordinateMax;
     QString _mapType;
 
+    QElapsedTimer _buildTimer;
+    int _generation = 0;        ///< Bumped for every tile set, decodes finishing for an older one are dropped
+    int _pendingDecodes = 0;
+    int _peakPendingDecodes = 0;
+
     int _totalTilesCount = 0;
     int _downloadedTilesCount = 0;
     int _mapId = 0;
@@ -1,40 +1,340 @@
 #include "ADSBTest.h"
 
+#include <QtCore/QFile>
+#include <QtCore/QRandomGenerator>
+#include <QtPositioning/QGeoRectangle>
 #include <QtNetwork/QTcpServer>
 #include <QtTest/QSignalSpy>
 
+#include "ADSBConflictDetector.h"
+#include "ADSBSBSParser.h"
 #include "ADSBTCPLink.h"
-#include "ADSBVehicle.h"
+#include "ADSBTrafficModel.h"
+#include "ADSBTrafficStore.h"
 #include "ADSBVehicleManager.h"
-#include "QmlObjectListModel.h"
 
-void ADSBTest::_adsbVehicleTest()
+namespace {
+
+ADSB::VehicleInfo_t locationUpdate(uint32_t icaoAddress, double latitude, double longitude)
+{
+    ADSB::VehicleInfo_t vehicleInfo;
+    vehicleInfo.icaoAddress = icaoAddress;
+    vehicleInfo.location = QGeoCoordinate(latitude, longitude);
+    vehicleInfo.availableFlags = ADSB::LocationAvailable;
+    return vehicleInfo;
+}
+
+/// altitude NaN leaves the altitude unreported
+ADSB::VehicleInfo_t movingUpdate(uint32_t icaoAddress, const QGeoCoordinate &location, double heading, double velocity)
 {
+    ADSB::VehicleInfo_t vehicleInfo = locationUpdate(icaoAddress, location.latitude(), location.longitude());
+    vehicleInfo.heading = heading;
+    vehicleInfo.velocity = velocity;
+    vehicleInfo.availableFlags |= ADSB::HeadingAvailable | ADSB::VelocityAvailable;
+    if (!qIsNaN(location.altitude())) {
+        vehicleInfo.location.setAltitude(location.altitude());
+        vehicleInfo.availableFlags |= ADSB::AltitudeAvailable;
+    }
+    return vehicleInfo;
+}
+
+} // namespace
+
+void ADSBTest::_trafficStoreUpdateTest()
+{
+    ADSBTrafficStore store;
+
+    // Aircraft are only tracked once their location is known
     ADSB::VehicleInfo_t vehicleInfo;
     vehicleInfo.icaoAddress = 1;
     vehicleInfo.callsign = QStringLiteral("1");
     vehicleInfo.location = QGeoCoordinate(1., 1., 1.);
     vehicleInfo.heading = 1.;
-    vehicleInfo.alert = false;
     vehicleInfo.availableFlags = ADSB::CallsignAvailable;
-    ADSBVehicle* const adsbVehicle = new ADSBVehicle(vehicleInfo, this);
-    QVERIFY(adsbVehicle != nullptr);
-    QVERIFY(!adsbVehicle->expired());
-    QCOMPARE(adsbVehicle->icaoAddress(), vehicleInfo.icaoAddress);
-    QCOMPARE(adsbVehicle->callsign(), vehicleInfo.callsign);
-    QCOMPARE_NE(adsbVehicle->coordinate(), vehicleInfo.location);
+    QVERIFY(!store.update(vehicleInfo, 0));
+    QCOMPARE(store.count(), 0);
+
+    vehicleInfo.availableFlags = ADSB::LocationAvailable | ADSB::CallsignAvailable;
+    QVERIFY(store.update(vehicleInfo, 0));
+    QCOMPARE(store.count(), 1);
+    const int slot = store.slot(1);
+    QCOMPARE(slot, 0);
+    QCOMPARE(store.callsign(slot), vehicleInfo.callsign);
+    QCOMPARE(store.coordinate(slot), QGeoCoordinate(1., 1.));
+    QVERIFY(qIsNaN(store.heading(slot)));
+    const quint32 revision = store.revision(slot);
+
+    // Only the available fields are merged
     ADSB::VehicleInfo_t vehicleInfo2;
-    vehicleInfo2.icaoAddress = 2;
-    vehicleInfo2.callsign = QStringLiteral("2");
-    vehicleInfo2.location = QGeoCoordinate(2., 2.);
-    vehicleInfo2.availableFlags = ADSB::CallsignAvailable | ADSB::LocationAvailable;
-    adsbVehicle->update(vehicleInfo2);
-    QCOMPARE_NE(adsbVehicle->callsign(), vehicleInfo2.callsign);
-    QCOMPARE_NE(adsbVehicle->coordinate(), vehicleInfo2.location);
     vehicleInfo2.icaoAddress = 1;
-    adsbVehicle->update(vehicleInfo2);
-    QCOMPARE(adsbVehicle->callsign(), vehicleInfo2.callsign);
-    QCOMPARE(adsbVehicle->coordinate(), vehicleInfo2.location);
+    vehicleInfo2.callsign = QStringLiteral("2");
+    vehicleInfo2.location = QGeoCoordinate(2., 2., 100.);
+    vehicleInfo2.heading = 90.;
+    vehicleInfo2.availableFlags = ADSB::HeadingAvailable | ADSB::AltitudeAvailable;
+    QVERIFY(store.update(vehicleInfo2, 10));
+    QCOMPARE(store.callsign(slot), vehicleInfo.callsign);
+    QCOMPARE(store.coordinate(slot), QGeoCoordinate(1., 1., 100.));
+    QCOMPARE(store.heading(slot), 90.);
+    QVERIFY(store.revision(slot) != revision);
+
+    // Repeating the same data is not a change
+    QVERIFY(!store.update(vehicleInfo2, 20));
+}
+
+void ADSBTest::_trafficStoreSpatialQueryTest()
+{
+    ADSBTrafficStore store;
+    QVERIFY(store.update(locationUpdate(1, 47.0, 8.0), 0));
+    QVERIFY(store.update(locationUpdate(2, 47.5, 8.5), 0));
+    QVERIFY(store.update(locationUpdate(3, -33.9, 151.2), 0));
+    QVERIFY(store.update(locationUpdate(4, 10.0, 179.9), 0));
+
+    const auto icaoAddresses = [&store](const QList<int> &slots) {
+        QList<uint32_t> result;
+        for (const int slot : slots) {
+            result.append(store.icaoAddress(slot));
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    };
+
+    QList<int> slots;
+    store.slotsInRect(QGeoRectangle(QGeoCoordinate(48., 7.), QGeoCoordinate(46., 9.)), slots);
+    QCOMPARE(icaoAddresses(slots), QList<uint32_t>({1, 2}));
+
+    slots.clear();
+    store.slotsInRect(QGeoRectangle(QGeoCoordinate(47.2, 7.), QGeoCoordinate(46., 8.2)), slots);
+    QCOMPARE(icaoAddresses(slots), QList<uint32_t>({1}));
+
+    // Across the antimeridian
+    slots.clear();
+    store.slotsInRect(QGeoRectangle(QGeoCoordinate(11., 179.), QGeoCoordinate(9., -179.)), slots);
+    QCOMPARE(icaoAddresses(slots), QList<uint32_t>({4}));
+
+    // The whole world walks the occupied cells only
+    slots.clear();
+    store.slotsInRect(QGeoRectangle(QGeoCoordinate(90., -180.), QGeoCoordinate(-90., 180.)), slots);
+    QCOMPARE(slots.count(), 4);
+
+    // 47.5,8.5 is about 67 km from 47,8
+    slots.clear();
+    store.slotsInRange(QGeoCoordinate(47.0, 8.0), 50000., slots);
+    QCOMPARE(icaoAddresses(slots), QList<uint32_t>({1}));
+    slots.clear();
+    store.slotsInRange(QGeoCoordinate(47.0, 8.0), 80000., slots);
+    QCOMPARE(icaoAddresses(slots), QList<uint32_t>({1, 2}));
+
+    // Moving an aircraft updates the index
+    QVERIFY(store.update(locationUpdate(3, 47.1, 8.1), 1));
+    slots.clear();
+    store.slotsInRange(QGeoCoordinate(47.0, 8.0), 50000., slots);
+    QCOMPARE(icaoAddresses(slots), QList<uint32_t>({1, 3}));
+}
+
+void ADSBTest::_trafficStoreExpiryTest()
+{
+    ADSBTrafficStore store(10000);
+    QVERIFY(store.update(locationUpdate(1, 47.0, 8.0), 0));
+    QVERIFY(store.update(locationUpdate(2, 47.0, 8.1), 0));
+    QVERIFY(store.update(locationUpdate(3, 47.0, 8.2), 0));
+
+    QVERIFY(store.expire(5000).isEmpty());
+
+    // Aircraft 2 keeps reporting
+    QVERIFY(store.update(locationUpdate(2, 47.0, 8.15), 8000));
+    const QList<uint32_t> expired = store.expire(10000);
+    QCOMPARE(expired.count(), 2);
+    QVERIFY(expired.contains(1));
+    QVERIFY(expired.contains(3));
+    QCOMPARE(store.count(), 1);
+    QCOMPARE(store.slot(2), 0);
+
+    // The moved aircraft is still indexed at its new slot
+    QList<int> slots;
+    store.slotsInRange(QGeoCoordinate(47.0, 8.15), 1000., slots);
+    QCOMPARE(slots, QList<int>({0}));
+
+    // Expiry still happens when the wheel is serviced late
+    QCOMPARE(store.expire(60000), QList<uint32_t>({2}));
+    QCOMPARE(store.count(), 0);
+}
+
+void ADSBTest::_trafficModelPublishTest()
+{
+    ADSBTrafficStore store;
+    ADSBTrafficModel model(&store);
+    QSignalSpy insertSpy(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removeSpy(&model, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy changeSpy(&model, &QAbstractItemModel::dataChanged);
+
+    for (uint32_t icaoAddress = 1; icaoAddress <= 5; icaoAddress++) {
+        QVERIFY(store.update(locationUpdate(icaoAddress, 47.0, 8.0 + (icaoAddress * 0.01)), 0));
+    }
+
+    const auto allSlots = [&store]() {
+        QList<int> slots;
+        for (int slot = 0; slot < store.count(); slot++) {
+            slots.append(slot);
+        }
+        return slots;
+    };
+
+    // All new aircraft arrive in a single insertion
+    model.publish(allSlots());
+    QCOMPARE(model.count(), 5);
+    QCOMPARE(insertSpy.count(), 1);
+    QCOMPARE(changeSpy.count(), 0);
+
+    // Nothing changed, nothing is signalled
+    model.publish(allSlots());
+    QCOMPARE(insertSpy.count(), 1);
+    QCOMPARE(changeSpy.count(), 0);
+
+    // Two adjacent aircraft moved
+    QVERIFY(store.update(locationUpdate(2, 47.1, 8.0), 1));
+    QVERIFY(store.update(locationUpdate(3, 47.1, 8.1), 1));
+    model.publish(allSlots());
+    QCOMPARE(changeSpy.count(), 1);
+    QCOMPARE(changeSpy.at(0).at(0).toModelIndex().row(), 1);
+    QCOMPARE(changeSpy.at(0).at(1).toModelIndex().row(), 2);
+    QCOMPARE(model.data(model.index(1), ADSBTrafficModel::CoordinateRole).value<QGeoCoordinate>(), QGeoCoordinate(47.1, 8.0));
+
+    // Only aircraft 1 and 5 stay visible, the three in between go in one removal
+    model.publish({store.slot(1), store.slot(5)});
+    QCOMPARE(model.count(), 2);
+    QCOMPARE(removeSpy.count(), 1);
+    QCOMPARE(model.data(model.index(1), ADSBTrafficModel::IcaoAddressRole).toUInt(), 5u);
+}
+
+void ADSBTest::_conflictDetectorTest()
+{
+    const QGeoCoordinate ownPosition(47.0, 8.0, 500.);
+
+    ADSBTrafficStore store;
+    // Head on, 5 km north at the same altitude: closest approach in 50 s
+    QVERIFY(store.update(movingUpdate(1, ownPosition.atDistanceAndAzimuth(5000., 0.), 180., 100.), 0));
+    // Same track offset 1 km east, passes outside the horizontal threshold
+    QVERIFY(store.update(movingUpdate(2, ownPosition.atDistanceAndAzimuth(5000., 0.).atDistanceAndAzimuth(1000., 90.), 180., 100.), 0));
+    // Head on but 500 m above
+    QVERIFY(store.update(movingUpdate(3, ownPosition.atDistanceAndAzimuth(5000., 0., 500.), 180., 100.), 0));
+    // Head on 4 km north without altitude, which is treated as conflicting vertically
+    QGeoCoordinate noAltitude = ownPosition.atDistanceAndAzimuth(4000., 0.);
+    noAltitude.setAltitude(qQNaN());
+    QVERIFY(store.update(movingUpdate(4, noAltitude, 180., 100.), 0));
+    // Head on but beyond the look-ahead time
+    QVERIFY(store.update(movingUpdate(5, ownPosition.atDistanceAndAzimuth(20000., 0.), 180., 100.), 0));
+    // Already close and moving away
+    QVERIFY(store.update(movingUpdate(6, ownPosition.atDistanceAndAzimuth(300., 90.), 90., 50.), 0));
+
+    ADSBConflictDetector::OwnVehicle ownVehicle;
+    ownVehicle.id = 1;
+    ownVehicle.position = ownPosition;
+
+    ADSBConflictDetector detector;
+    QList<ADSBConflictDetector::Threat> threats;
+    detector.evaluate(store, {ownVehicle}, ADSBConflictDetector::Thresholds(), threats);
+
+    // Ranked by time to closest approach
+    QCOMPARE(threats.count(), 3);
+    QCOMPARE(threats[0].icaoAddress, 6u);
+    QCOMPARE(threats[0].tcpa, 0.);
+    QVERIFY(qAbs(threats[0].cpaDistance - 300.) < 5.);
+    QCOMPARE(threats[1].icaoAddress, 4u);
+    QVERIFY(qAbs(threats[1].tcpa - 40.) < 0.5);
+    QVERIFY(qIsNaN(threats[1].verticalSeparation));
+    QCOMPARE(threats[2].icaoAddress, 1u);
+    QCOMPARE(threats[2].vehicleId, 1);
+    QVERIFY(qAbs(threats[2].tcpa - 50.) < 0.5);
+    QVERIFY(threats[2].cpaDistance < 10.);
+    QVERIFY(qAbs(threats[2].distance - 5000.) < 25.);
+
+    // The own vehicle climbing at 10 m/s clears the head on aircraft vertically
+    ownVehicle.velocityUp = 10.;
+    detector.evaluate(store, {ownVehicle}, ADSBConflictDetector::Thresholds(), threats);
+    QCOMPARE(threats.count(), 2);
+    QCOMPARE(threats[1].icaoAddress, 4u);
+
+    // A longer look-ahead brings in the distant aircraft
+    ADSBConflictDetector::Thresholds thresholds;
+    thresholds.lookaheadSeconds = 300.;
+    ownVehicle.velocityUp = 0.;
+    detector.evaluate(store, {ownVehicle}, thresholds, threats);
+    QCOMPARE(threats.count(), 4);
+    QCOMPARE(threats.last().icaoAddress, 5u);
+}
+
+void ADSBTest::_threatListTest()
+{
+    const QGeoCoordinate ownPosition(47.0, 8.0, 500.);
+
+    // Head on aircraft at increasing distances, queued far to near so the ranking has to reorder them
+    ADSBTrafficStore store;
+    for (uint32_t icaoAddress = 1; icaoAddress <= 5; icaoAddress++) {
+        ADSB::VehicleInfo_t vehicleInfo = movingUpdate(icaoAddress, ownPosition.atDistanceAndAzimuth((6 - icaoAddress) * 1000., 0.), 180., 100.);
+        vehicleInfo.callsign = QStringLiteral("TEST%1").arg(icaoAddress);
+        vehicleInfo.availableFlags |= ADSB::CallsignAvailable;
+        QVERIFY(store.update(vehicleInfo, 0));
+    }
+
+    ADSBConflictDetector::OwnVehicle ownVehicle;
+    ownVehicle.id = 1;
+    ownVehicle.position = ownPosition;
+
+    ADSBConflictDetector detector;
+    QList<ADSBConflictDetector::Threat> threats;
+    detector.evaluate(store, {ownVehicle}, ADSBConflictDetector::Thresholds(), threats);
+    QCOMPARE(threats.count(), 5);
+
+    // The display list keeps the most urgent first and stops at the requested count
+    const QVariantList list = ADSBVehicleManager::threatList(threats, store, 3);
+    QCOMPARE(list.count(), 3);
+    for (qsizetype i = 0; i < list.count(); i++) {
+        const QVariantMap threat = list[i].toMap();
+        const uint32_t icaoAddress = 5 - static_cast<uint32_t>(i);
+        QCOMPARE(threat[QStringLiteral("icaoAddress")].toUInt(), icaoAddress);
+        QCOMPARE(threat[QStringLiteral("callsign")].toString(), QStringLiteral("TEST%1").arg(icaoAddress));
+        QCOMPARE(threat[QStringLiteral("vehicleId")].toInt(), 1);
+        QVERIFY(threat[QStringLiteral("coordinate")].value<QGeoCoordinate>().isValid());
+        if (i > 0) {
+            QVERIFY(list[i - 1].toMap()[QStringLiteral("tcpa")].toDouble() < threat[QStringLiteral("tcpa")].toDouble());
+        }
+    }
+
+    QVERIFY(ADSBVehicleManager::threatList({}, store, 3).isEmpty());
+}
+
+void ADSBTest::_conflictDetectorBenchmark()
+{
+    // Synthetic traffic spread over 100 km around four vehicles
+    static constexpr qsizetype aircraftCount = 5000;
+    const QGeoCoordinate center(47.0, 8.0, 1000.);
+
+    QRandomGenerator random(42);
+    ADSBTrafficStore store;
+    for (uint32_t icaoAddress = 1; icaoAddress <= static_cast<uint32_t>(aircraftCount); icaoAddress++) {
+        QGeoCoordinate location = center.atDistanceAndAzimuth(random.bounded(50000.), random.bounded(360.), random.bounded(3000.) - 1500.);
+        QVERIFY(store.update(movingUpdate(icaoAddress, location, random.bounded(360.), 50. + random.bounded(200.)), 0));
+    }
+    QCOMPARE(store.count(), aircraftCount);
+
+    QList<ADSBConflictDetector::OwnVehicle> ownVehicles;
+    for (int id = 1; id <= 4; id++) {
+        ADSBConflictDetector::OwnVehicle ownVehicle;
+        ownVehicle.id = id;
+        ownVehicle.position = center.atDistanceAndAzimuth(id * 1000., id * 90.);
+        ownVehicle.velocityNorth = 15.;
+        ownVehicles.append(ownVehicle);
+    }
+
+    ADSBConflictDetector detector;
+    QList<ADSBConflictDetector::Threat> threats;
+    QBENCHMARK {
+        detector.evaluate(store, ownVehicles, ADSBConflictDetector::Thresholds(), threats);
+    }
+
+    for (qsizetype i = 1; i < threats.count(); i++) {
+        QVERIFY(threats[i - 1].tcpa <= threats[i].tcpa);
+    }
 }
 
 void ADSBTest::_adsbTcpLinkTest()
@@ -165,7 +465,89 @@ void ADSBTest::_adsbVehicleManagerTest()
     vehicleInfo.alert = false;
     vehicleInfo.availableFlags = ADSB::LocationAvailable;
     manager->adsbVehicleUpdate(vehicleInfo);
-    QCOMPARE(manager->adsbVehicles()->count(), initialCount + 1);
+    QVERIFY(manager->trafficStore().contains(vehicleInfo.icaoAddress));
+
+    // Model updates are batched
+    QCOMPARE_TRUE_WAIT(manager->adsbVehicles()->count(), initialCount + 1, TestTimeout::mediumMs());
+}
+
+void ADSBTest::_sbsParserTest()
+{
+    ADSB::VehicleInfo_t vehicleInfo;
+    QVERIFY(ADSBSBSParser::parseLine("MSG,3,1,1,4840D6,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,35000H,,,47.0,-122.0,,,,1,,0\r\n", vehicleInfo));
+    QCOMPARE(vehicleInfo.icaoAddress, static_cast<uint32_t>(0x4840D6));
+    QCOMPARE(vehicleInfo.availableFlags, ADSB::LocationAvailable | ADSB::AltitudeAvailable | ADSB::AlertAvailable);
+    QCOMPARE(vehicleInfo.location.latitude(), 47.0);
+    QCOMPARE(vehicleInfo.location.longitude(), -122.0);
+    QCOMPARE(vehicleInfo.location.altitude(), 35000 * 0.3048);
+    QVERIFY(vehicleInfo.alert);
+
+    vehicleInfo = ADSB::VehicleInfo_t();
+    QVERIFY(ADSBSBSParser::parseLine("MSG,4,1,1,4840D6,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,,100,270,,,-640,,0,0,0,0", vehicleInfo));
+    QCOMPARE(vehicleInfo.availableFlags, ADSB::HeadingAvailable | ADSB::VelocityAvailable | ADSB::VerticalVelAvailable);
+    QCOMPARE(vehicleInfo.heading, 270.);
+    QCOMPARE(vehicleInfo.velocity, 100 * 0.514444);
+    QCOMPARE(vehicleInfo.verticalVel, -640 * 0.00508);
+
+    vehicleInfo = ADSB::VehicleInfo_t();
+    QVERIFY(ADSBSBSParser::parseLine("MSG,1,1,1,ABCDEF,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,CALL123 ,,,,,,,,,,", vehicleInfo));
+    QCOMPARE(vehicleInfo.callsign, QStringLiteral("CALL123"));
+
+    QVERIFY(!ADSBSBSParser::parseLine("MSG,8,1,1,ABCDEF,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,,,,,,,,,,,0", vehicleInfo));
+    QVERIFY(!ADSBSBSParser::parseLine("MSG,1,1,1,ABCDEF,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,", vehicleInfo));
+    QVERIFY(!ADSBSBSParser::parseLine("MSG,3,1,1,4840D6,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,35000,,,47.0,-122.0", vehicleInfo));
+    QVERIFY(!ADSBSBSParser::parseLine("MSG", vehicleInfo));
+}
+
+void ADSBTest::_sbsParserCoalescesUpdatesTest()
+{
+    ADSBSBSParser parser;
+    const QByteArray data(
+        "MSG,3,1,1,4840D6,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,35000,,,47.0,-122.0,,,,0,,0\n"
+        "MSG,1,1,1,4840D6,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,CALL123,,,,,,,,,,\n"
+        "MSG,3,1,1,4840D6,1,2024/01/01,12:00:00.500,2024/01/01,12:00:00.500,,35100,,,47.1,-122.1,,,,0,,0\n"
+        "MSG,4,1,1,ABCDEF,1,2024/01/01,12:00:00.000,2024/01/01,12:00:00.000,,,100,90,,,0,,0,0,0,0\n"
+        "MSG,3,1,1,ABCDEF,1,2024/01/01,12:00:00.000,2024/01/");
+
+    // The incomplete last line is left for the next read
+    const qsizetype consumed = parser.parse(data);
+    QCOMPARE(consumed, data.lastIndexOf('\n') + 1);
+    QCOMPARE(parser.linesParsed(), quint64(4));
+
+    QList<ADSB::VehicleInfo_t> updates = parser.takePendingUpdates();
+    QCOMPARE(updates.size(), 2);
+    QVERIFY(!parser.hasPendingUpdates());
+
+    const auto it = std::find_if(updates.cbegin(), updates.cend(), [](const ADSB::VehicleInfo_t &info) { return info.icaoAddress == 0x4840D6; });
+    QVERIFY(it != updates.cend());
+    QCOMPARE(it->availableFlags, ADSB::LocationAvailable | ADSB::AltitudeAvailable | ADSB::AlertAvailable | ADSB::CallsignAvailable);
+    QCOMPARE(it->callsign, QStringLiteral("CALL123"));
+    QCOMPARE(it->location.latitude(), 47.1);
+    QCOMPARE(it->location.altitude(), 35100 * 0.3048);
+}
+
+void ADSBTest::_sbsReplayBenchmark()
+{
+    QFile captureFile(QStringLiteral(":/unittest/sbs_capture.txt"));
+    QVERIFY(captureFile.open(QIODevice::ReadOnly));
+    const QByteArray capture = captureFile.readAll();
+    QVERIFY(!capture.isEmpty());
+
+    // Replay in socket sized chunks so lines are split across reads like on a live feed
+    static constexpr qsizetype chunkSize = 1460;
+    qsizetype vehicleCount = 0;
+    QBENCHMARK {
+        ADSBSBSParser parser;
+        QByteArray buffer;
+        for (qsizetype offset = 0; offset < capture.size(); offset += chunkSize) {
+            buffer.append(QByteArrayView(capture).sliced(offset, qMin(chunkSize, capture.size() - offset)));
+            (void) buffer.remove(0, parser.parse(buffer));
+        }
+        QVERIFY(buffer.isEmpty());
+        vehicleCount = parser.takePendingUpdates().size();
+    }
+
+    QCOMPARE(vehicleCount, 80);
 }
 
 UT_REGISTER_TEST(ADSBTest, TestLabel::Unit)
@@ -7,10 +7,19 @@ class ADSBTest : public UnitTest
     Q_OBJECT
 
 private slots:
-    void _adsbVehicleTest();
+    void _trafficStoreUpdateTest();
+    void _trafficStoreSpatialQueryTest();
+    void _trafficStoreExpiryTest();
+    void _trafficModelPublishTest();
+    void _conflictDetectorTest();
+    void _threatListTest();
+    void _conflictDetectorBenchmark();
     void _adsbTcpLinkTest();
     void _adsbTcpLinkRejectsNullHostTest();
     void _adsbTcpLinkIgnoresInvalidMessagesTest();
     void _adsbTcpLinkCallsignMessageTest();
     void _adsbVehicleManagerTest();
+    void _sbsParserTest();
+    void _sbsParserCoalescesUpdatesTest();
+    void _sbsReplayBenchmark();
 };
@@ -1,6 +1,8 @@
 #include "OnboardLogDownloadTest.h"
 
 #include <QtCore/QDir>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QTimeZone>
 
 #include "OnboardLogController.h"
 #include "OnboardLogEntry.h"
@@ -37,7 +39,48 @@ void OnboardLogDownloadTest::_downloadTest()
     multiSpyLogDownloadController->clearAllSignals();
     const QString downloadFile = QDir(downloadTo).filePath("log_0_UnknownDate.ulg");
     QVERIFY(UnitTest::fileCompare(downloadFile, _mockLink->logDownloadFile()));
+    QVERIFY(!QFile::exists(downloadFile + QStringLiteral(".part")));
+
+    // Downloading the same log again skips the complete copy already on disk
+    model->value<QGCOnboardLogEntry*>(0)->setSelected(true);
+    controller->download(downloadTo);
+    if (controller->_getDownloadingLogs()) {
+        QVERIFY(multiSpyLogDownloadController->waitForSignal("downloadingLogsChanged", TestTimeout::longMs()));
+    }
+    QCOMPARE(controller->_getDownloadingLogs(), false);
+    QVERIFY(!QFile::exists(QDir(downloadTo).filePath("log_0_UnknownDate_1.ulg")));
+    QVERIFY(UnitTest::fileCompare(downloadFile, _mockLink->logDownloadFile()));
     (void)QFile::remove(downloadFile);
 }
 
+void OnboardLogDownloadTest::_resumeJournalTest()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    QGCOnboardLogEntry entry(3, QDateTime::fromSecsSinceEpoch(1700000000, QTimeZone::UTC), 5 * OnboardLogDownloadData::kChunkSize, true);
+    OnboardLogDownloadData downloadData(&entry);
+    downloadData.file.setFileName(tempDir.filePath(QStringLiteral("log_3.ulg")));
+    QCOMPARE(downloadData.loadJournal(), -1);
+
+    downloadData.current_chunk = 2;
+    QVERIFY(downloadData.saveJournal());
+    QCOMPARE(downloadData.loadJournal(), 2);
+
+    // The journal only advances once the log data could be flushed to the file
+    downloadData.advanceChunk();
+    QCOMPARE(downloadData.loadJournal(), 2);
+    QVERIFY(downloadData.file.open(QIODevice::WriteOnly));
+    downloadData.advanceChunk();
+    QCOMPARE(downloadData.loadJournal(), 4);
+    downloadData.file.close();
+
+    // A different log which ends up with the same file name must not resume from the journal
+    entry.setSize(4 * OnboardLogDownloadData::kChunkSize);
+    QCOMPARE(downloadData.loadJournal(), -1);
+
+    downloadData.removeJournal();
+    QVERIFY(!QFile::exists(downloadData.journalPath()));
+}
+
 UT_REGISTER_TEST(OnboardLogDownloadTest, TestLabel::Integration, TestLabel::AnalyzeView, TestLabel::Vehicle)
@@ -8,4 +8,5 @@ class OnboardLogDownloadTest : public VehicleTest
 
 private slots:
     void _downloadTest();
+    void _resumeJournalTest();
 };
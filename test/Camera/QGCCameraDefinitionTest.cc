@@ -0,0 +1,156 @@
+#include "QGCCameraDefinitionTest.h"
+#include "QGCCameraDefinition.h"
+
+#include <QtCore/QDataStream>
+
+namespace {
+
+constexpr const char *_definitionXml = R"(<?xml version="1.0" encoding="UTF-8" ?>
+<mavlinkcamera>
+    <definition version="7">
+        <model>TestCam</model>
+        <vendor>QGC</vendor>
+    </definition>
+    <parameters>
+        <parameter name="CAM_MODE" type="uint32" default="1" control="0">
+            <description>Camera Mode</description>
+            <updates>
+                <update>CAM_ISO</update>
+            </updates>
+            <options>
+                <option name="Photo" value="0">
+                    <exclusions>
+                        <exclude>CAM_VIDRES</exclude>
+                    </exclusions>
+                </option>
+                <option name="Video" value="1">
+                    <parameterranges>
+                        <parameterrange parameter="CAM_ISO" condition="CAM_EXPMODE=1">
+                            <roption name="100" value="100" />
+                            <roption name="200" value="200" />
+                        </parameterrange>
+                    </parameterranges>
+                </option>
+            </options>
+        </parameter>
+        <parameter name="CAM_EV" type="float" default="0" min="-2" max="2" step="0.5" decimalPlaces="1" unit="">
+            <description>Exposure Compensation</description>
+        </parameter>
+    </parameters>
+    <localization>
+        <locale name="de_DE">
+            <strings original="Camera Mode" translated="Kameramodus" />
+        </locale>
+    </localization>
+</mavlinkcamera>
+)";
+
+} // namespace
+
+void QGCCameraDefinitionTest::_parse_test()
+{
+    QGCCameraDefinition definition;
+    QString errorString;
+    QVERIFY2(QGCCameraDefinition::parse(_definitionXml, definition, errorString), qPrintable(errorString));
+
+    QCOMPARE(definition.version, 7);
+    QCOMPARE(definition.model, QStringLiteral("TestCam"));
+    QCOMPARE(definition.vendor, QStringLiteral("QGC"));
+    QCOMPARE(definition.parameters.count(), 2);
+
+    const QGCCameraDefinition::Parameter &mode = definition.parameters[0];
+    QCOMPARE(mode.name, QStringLiteral("CAM_MODE"));
+    QCOMPARE(mode.type, QStringLiteral("uint32"));
+    QCOMPARE(mode.description, QStringLiteral("Camera Mode"));
+    QCOMPARE(mode.defaultValue, QStringLiteral("1"));
+    QVERIFY(!mode.control);
+    QVERIFY(mode.min.isNull());
+    QCOMPARE(mode.updates, QStringList{ QStringLiteral("CAM_ISO") });
+    QCOMPARE(mode.options.count(), 2);
+    QCOMPARE(mode.options[0].exclusions, QStringList{ QStringLiteral("CAM_VIDRES") });
+    QCOMPARE(mode.options[1].ranges.count(), 1);
+    QCOMPARE(mode.options[1].ranges[0].parameter, QStringLiteral("CAM_ISO"));
+    QCOMPARE(mode.options[1].ranges[0].condition, QStringLiteral("CAM_EXPMODE=1"));
+    QCOMPARE(mode.options[1].ranges[0].optValues, (QStringList{ QStringLiteral("100"), QStringLiteral("200") }));
+
+    const QGCCameraDefinition::Parameter &ev = definition.parameters[1];
+    QVERIFY(ev.control);
+    QCOMPARE(ev.min, QStringLiteral("-2"));
+    QCOMPARE(ev.step, QStringLiteral("0.5"));
+    QCOMPARE(ev.decimalPlaces, QStringLiteral("1"));
+    QVERIFY(!ev.unit.isNull());
+    QVERIFY(ev.unit.isEmpty());
+}
+
+void QGCCameraDefinitionTest::_parseMissingType_test()
+{
+    QByteArray xml(_definitionXml);
+    xml.replace(R"(type="float" )", "");
+
+    QGCCameraDefinition definition;
+    QString errorString;
+    QVERIFY(!QGCCameraDefinition::parse(xml, definition, errorString));
+    QVERIFY(errorString.contains(QStringLiteral("CAM_EV")));
+
+    QVERIFY(!QGCCameraDefinition::parse("<mavlinkcamera><definition", definition, errorString));
+    QVERIFY(!errorString.isEmpty());
+}
+
+void QGCCameraDefinitionTest::_localize_test()
+{
+    const QByteArray xml(_definitionXml);
+    QVERIFY(QGCCameraDefinition::localize(xml, QStringLiteral("de_de")).contains(">Kameramodus<"));
+    QVERIFY(QGCCameraDefinition::localize(xml, QStringLiteral("de_at")).contains(">Kameramodus<"));
+    QCOMPARE(QGCCameraDefinition::localize(xml, QStringLiteral("fr_fr")), xml);
+}
+
+void QGCCameraDefinitionTest::_serializeRoundTrip_test()
+{
+    QGCCameraDefinition parsed;
+    QString errorString;
+    QVERIFY(QGCCameraDefinition::parse(_definitionXml, parsed, errorString));
+
+    const QByteArray compiled = parsed.serialize();
+    QGCCameraDefinition loaded;
+    QVERIFY(QGCCameraDefinition::deserialize(compiled, loaded));
+
+    QCOMPARE(loaded.version, parsed.version);
+    QCOMPARE(loaded.model, parsed.model);
+    QCOMPARE(loaded.parameters.count(), parsed.parameters.count());
+    for (qsizetype i = 0; i < parsed.parameters.count(); i++) {
+        const QGCCameraDefinition::Parameter &a = parsed.parameters[i];
+        const QGCCameraDefinition::Parameter &b = loaded.parameters[i];
+        QCOMPARE(b.name, a.name);
+        QCOMPARE(b.defaultValue, a.defaultValue);
+        QCOMPARE(b.min.isNull(), a.min.isNull());
+        QCOMPARE(b.unit.isNull(), a.unit.isNull());
+        QCOMPARE(b.control, a.control);
+        QCOMPARE(b.updates, a.updates);
+        QCOMPARE(b.options.count(), a.options.count());
+        for (qsizetype j = 0; j < a.options.count(); j++) {
+            QCOMPARE(b.options[j].value, a.options[j].value);
+            QCOMPARE(b.options[j].exclusions, a.options[j].exclusions);
+            QCOMPARE(b.options[j].ranges.count(), a.options[j].ranges.count());
+        }
+    }
+}
+
+void QGCCameraDefinitionTest::_deserializeRejectsStale_test()
+{
+    QGCCameraDefinition parsed;
+    QString errorString;
+    QVERIFY(QGCCameraDefinition::parse(_definitionXml, parsed, errorString));
+    QByteArray compiled = parsed.serialize();
+
+    QGCCameraDefinition loaded;
+    QVERIFY(!QGCCameraDefinition::deserialize(compiled.left(compiled.size() - 3), loaded));
+    QVERIFY(!QGCCameraDefinition::deserialize(_definitionXml, loaded));
+
+    // Format version follows the magic
+    QDataStream stream(&compiled, QIODevice::ReadWrite);
+    stream.skipRawData(sizeof(quint32));
+    stream << quint32(QGCCameraDefinition::kFormatVersion + 1);
+    QVERIFY(!QGCCameraDefinition::deserialize(compiled, loaded));
+}
+
+UT_REGISTER_TEST(QGCCameraDefinitionTest, TestLabel::Unit)
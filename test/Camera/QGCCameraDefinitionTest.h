@@ -0,0 +1,15 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class QGCCameraDefinitionTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _parse_test();
+    void _parseMissingType_test();
+    void _localize_test();
+    void _serializeRoundTrip_test();
+    void _deserializeRejectsStale_test();
+};
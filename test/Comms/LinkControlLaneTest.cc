@@ -0,0 +1,62 @@
+#include "LinkControlLaneTest.h"
+
+#include "LinkControlLane.h"
+
+#include <QtCore/QCoreApplication>
+
+void LinkControlLaneTest::_testNewestPerKey()
+{
+    QList<QByteArray> written;
+    LinkControlLane lane([&written](const QByteArray &data) { written.append(data); });
+
+    const LinkControlLane::Clock::time_point now = LinkControlLane::Clock::now();
+    lane.post(1, QByteArrayLiteral("stick 1"), now);
+    lane.post(2, QByteArrayLiteral("gimbal 1"), now);
+    lane.post(1, QByteArrayLiteral("stick 2"), now);
+    QVERIFY(written.isEmpty());
+
+    QCoreApplication::processEvents();
+
+    QCOMPARE(written.count(), 2);
+    QCOMPARE(written[0], QByteArrayLiteral("stick 2"));
+    QCOMPARE(written[1], QByteArrayLiteral("gimbal 1"));
+    QCOMPARE(lane.latencyStats().supersededCount, 1ULL);
+}
+
+void LinkControlLaneTest::_testAheadOfQueuedWrites()
+{
+    QStringList order;
+    LinkControlLane lane([&order](const QByteArray &data) { order.append(QString::fromLatin1(data)); });
+
+    // Bulk writes reach a worker as queued calls, the control message posted after them must still go first
+    for (int i = 0; i < 3; i++) {
+        (void) QMetaObject::invokeMethod(&lane, [&order]() { order.append(QStringLiteral("bulk")); }, Qt::QueuedConnection);
+    }
+    lane.post(1, QByteArrayLiteral("control"), LinkControlLane::Clock::now());
+
+    QCoreApplication::processEvents();
+
+    QCOMPARE(order.count(), 4);
+    QCOMPARE(order.first(), QStringLiteral("control"));
+}
+
+void LinkControlLaneTest::_testLatencyStats()
+{
+    LinkControlLane lane([](const QByteArray &) {});
+
+    const LinkControlLane::Clock::time_point sampleTime = LinkControlLane::Clock::now() - std::chrono::milliseconds(5);
+    lane.post(1, QByteArrayLiteral("stick"), sampleTime);
+    QCoreApplication::processEvents();
+
+    LinkControlLane::LatencyStats stats = lane.latencyStats();
+    QCOMPARE(stats.count, 1ULL);
+    QVERIFY(stats.meanUs >= 5000.);
+    QVERIFY(stats.maxUs >= stats.meanUs);
+
+    lane.resetLatencyStats();
+    stats = lane.latencyStats();
+    QCOMPARE(stats.count, 0ULL);
+    QCOMPARE(stats.maxUs, 0.);
+}
+
+UT_REGISTER_TEST(LinkControlLaneTest, TestLabel::Unit, TestLabel::Comms)
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class LinkControlLaneTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testNewestPerKey();
+    void _testAheadOfQueuedWrites();
+    void _testLatencyStats();
+};
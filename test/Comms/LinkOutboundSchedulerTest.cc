@@ -0,0 +1,315 @@
+#include "LinkOutboundSchedulerTest.h"
+
+#include "LinkOutboundScheduler.h"
+#include "MAVLinkLib.h"
+
+#include <algorithm>
+
+namespace {
+
+QByteArray toFrame(const mavlink_message_t &message)
+{
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    const uint16_t length = mavlink_msg_to_send_buffer(buffer, &message);
+    return QByteArray(reinterpret_cast<const char*>(buffer), length);
+}
+
+QByteArray heartbeatFrame()
+{
+    mavlink_message_t message;
+    (void) mavlink_msg_heartbeat_pack_chan(255, MAV_COMP_ID_MISSIONPLANNER, MAVLINK_COMM_0, &message,
+                                           MAV_TYPE_GCS, MAV_AUTOPILOT_INVALID, 0, 0, MAV_STATE_ACTIVE);
+    return toFrame(message);
+}
+
+QByteArray paramRequestFrame(int16_t index)
+{
+    const char paramId[MAVLINK_MSG_PARAM_REQUEST_READ_FIELD_PARAM_ID_LEN] = {};
+    mavlink_message_t message;
+    (void) mavlink_msg_param_request_read_pack_chan(255, MAV_COMP_ID_MISSIONPLANNER, MAVLINK_COMM_0, &message,
+                                                    1, MAV_COMP_ID_AUTOPILOT1, paramId, index);
+    return toFrame(message);
+}
+
+QByteArray systemTimeFrame()
+{
+    mavlink_message_t message;
+    (void) mavlink_msg_system_time_pack_chan(255, MAV_COMP_ID_MISSIONPLANNER, MAVLINK_COMM_0, &message, 1, 2);
+    return toFrame(message);
+}
+
+QByteArray rtcmFrame()
+{
+    uint8_t data[MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN];
+    memset(data, 0x55, sizeof(data));
+    mavlink_message_t message;
+    (void) mavlink_msg_gps_rtcm_data_pack_chan(255, MAV_COMP_ID_MISSIONPLANNER, MAVLINK_COMM_0, &message, 0, sizeof(data), data);
+    return toFrame(message);
+}
+
+/// The scheduler only looks at the header flag, the signature itself doesn't matter here
+QByteArray signedFrame(QByteArray frame)
+{
+    frame[2] = static_cast<char>(static_cast<uint8_t>(frame[2]) | MAVLINK_IFLAG_SIGNED);
+    return frame;
+}
+
+} // namespace
+
+void LinkOutboundSchedulerTest::_testClassify()
+{
+    QCOMPARE(LinkOutboundScheduler::classify(heartbeatFrame()), LinkOutboundScheduler::CommandClass);
+    QCOMPARE(LinkOutboundScheduler::classify(paramRequestFrame(1)), LinkOutboundScheduler::BulkClass);
+    QCOMPARE(LinkOutboundScheduler::classify(systemTimeFrame()), LinkOutboundScheduler::TelemetryClass);
+    QCOMPARE(LinkOutboundScheduler::classify(rtcmFrame()), LinkOutboundScheduler::CorrectionClass);
+    QCOMPARE(LinkOutboundScheduler::classify(QByteArrayLiteral("\r\r\r")), LinkOutboundScheduler::TelemetryClass);
+    QCOMPARE(LinkOutboundScheduler::classify(QByteArray()), LinkOutboundScheduler::TelemetryClass);
+}
+
+void LinkOutboundSchedulerTest::_testUnlimited()
+{
+    LinkOutboundScheduler scheduler;
+
+    const QByteArray heartbeat = heartbeatFrame();
+    scheduler.enqueue(paramRequestFrame(1), 0);
+    scheduler.enqueue(heartbeat, 0);
+
+    QList<QByteArray> ready;
+    scheduler.takeReady(0, ready);
+
+    QCOMPARE(ready.count(), 2);
+    QCOMPARE(ready[0], heartbeat);
+    QVERIFY(scheduler.isEmpty());
+}
+
+void LinkOutboundSchedulerTest::_testCommandsAheadOfBulk()
+{
+    LinkOutboundScheduler scheduler(1000);
+
+    const QByteArray firstRequest = paramRequestFrame(0);
+    scheduler.enqueue(firstRequest, 0);
+    for (int16_t i = 1; i < 50; i++) {
+        scheduler.enqueue(paramRequestFrame(i), 0);
+    }
+    const QByteArray heartbeat = heartbeatFrame();
+    scheduler.enqueue(heartbeat, 0);
+
+    QList<QByteArray> ready;
+    scheduler.takeReady(0, ready);
+
+    QVERIFY(ready.count() > 1);
+    QVERIFY(ready.count() < 51);
+    QCOMPARE(ready[0], heartbeat);
+    QCOMPARE(ready[1], firstRequest);
+
+    // A command queued behind a bulk backlog goes out as soon as budget allows
+    const QByteArray nextHeartbeat = heartbeatFrame();
+    scheduler.enqueue(nextHeartbeat, 0);
+    ready.clear();
+    scheduler.takeReady(100, ready);
+    QVERIFY(!ready.isEmpty());
+    QCOMPARE(ready.first(), nextHeartbeat);
+}
+
+void LinkOutboundSchedulerTest::_testPacing()
+{
+    static constexpr qint64 bytesPerSecond = 1000;
+    LinkOutboundScheduler scheduler(bytesPerSecond);
+
+    const QByteArray frame = paramRequestFrame(1);
+    for (int i = 0; i < 200; i++) {
+        scheduler.enqueue(frame, 0);
+    }
+
+    qint64 sentBytes = 0;
+    for (qint64 nowMs = 0; nowMs <= 2000; nowMs += 10) {
+        QList<QByteArray> ready;
+        scheduler.takeReady(nowMs, ready);
+        for (const QByteArray &data : ready) {
+            sentBytes += data.size();
+        }
+        QVERIFY(sentBytes <= (MAVLINK_MAX_PACKET_LEN + ((bytesPerSecond * nowMs) / 1000)));
+    }
+
+    // Two seconds at the budget, less what is left over in the bucket
+    QVERIFY(sentBytes >= ((2 * bytesPerSecond) - frame.size()));
+    QVERIFY(!scheduler.isEmpty());
+}
+
+void LinkOutboundSchedulerTest::_testStats()
+{
+    LinkOutboundScheduler scheduler(1000);
+
+    for (int16_t i = 0; i < 50; i++) {
+        scheduler.enqueue(paramRequestFrame(i), 0);
+    }
+    scheduler.enqueue(heartbeatFrame(), 0);
+
+    const LinkOutboundScheduler::ClassStats &bulk = scheduler.classStats(LinkOutboundScheduler::BulkClass);
+    QCOMPARE(bulk.queuedMessages, qsizetype(50));
+    QCOMPARE(bulk.maxQueuedMessages, qsizetype(50));
+    QCOMPARE(bulk.queuedBytes, 50 * paramRequestFrame(0).size());   // Same length whatever the sequence number
+
+    QList<QByteArray> ready;
+    for (qint64 nowMs = 0; !scheduler.isEmpty(); nowMs += 10) {
+        scheduler.takeReady(nowMs, ready);
+    }
+
+    const LinkOutboundScheduler::ClassStats &command = scheduler.classStats(LinkOutboundScheduler::CommandClass);
+    QCOMPARE(command.sentMessages, 1ULL);
+    QCOMPARE(command.maxLatencyMs, 0.);
+
+    QCOMPARE(bulk.queuedMessages, qsizetype(0));
+    QCOMPARE(bulk.queuedBytes, qsizetype(0));
+    QCOMPARE(bulk.sentMessages, 50ULL);
+    QVERIFY(bulk.maxLatencyMs > 0.);
+    QVERIFY(bulk.meanLatencyMs < bulk.maxLatencyMs);
+}
+
+void LinkOutboundSchedulerTest::_testSignedInOrder()
+{
+    LinkOutboundScheduler scheduler(1000);
+
+    QVERIFY(!LinkOutboundScheduler::isSigned(heartbeatFrame()));
+    QVERIFY(LinkOutboundScheduler::isSigned(signedFrame(heartbeatFrame())));
+
+    QList<QByteArray> queued;
+    for (int16_t i = 0; i < 20; i++) {
+        queued.append(signedFrame(paramRequestFrame(i)));
+    }
+    queued.append(signedFrame(heartbeatFrame()));
+    for (const QByteArray &frame : std::as_const(queued)) {
+        scheduler.enqueue(frame, 0);
+    }
+
+    // The heartbeat would overtake the requests if it weren't signed
+    QList<QByteArray> ready;
+    for (qint64 nowMs = 0; !scheduler.isEmpty(); nowMs += 10) {
+        scheduler.takeReady(nowMs, ready);
+    }
+    QCOMPARE(ready, queued);
+
+    // Priority returns once the signed frames are out
+    scheduler.enqueue(paramRequestFrame(1), 1000);
+    const QByteArray heartbeat = heartbeatFrame();
+    scheduler.enqueue(heartbeat, 1000);
+    ready.clear();
+    scheduler.takeReady(1000, ready);
+    QVERIFY(!ready.isEmpty());
+    QCOMPARE(ready.first(), heartbeat);
+}
+
+void LinkOutboundSchedulerTest::_testQueueCap()
+{
+    LinkOutboundScheduler scheduler(1000);
+
+    const qsizetype maxQueued = LinkOutboundScheduler::kMaxQueuedMessages[LinkOutboundScheduler::BulkClass];
+    QList<QByteArray> frames;
+    for (qsizetype i = 0; i < maxQueued + 10; i++) {
+        frames.append(paramRequestFrame(static_cast<int16_t>(i)));
+        scheduler.enqueue(frames.last(), 0);
+    }
+
+    const LinkOutboundScheduler::ClassStats &bulk = scheduler.classStats(LinkOutboundScheduler::BulkClass);
+    QCOMPARE(bulk.queuedMessages, maxQueued);
+    QCOMPARE(bulk.droppedMessages, 10ULL);
+
+    // The oldest were dropped
+    QList<QByteArray> ready;
+    scheduler.takeReady(0, ready);
+    QVERIFY(!ready.isEmpty());
+    QCOMPARE(ready.first(), frames[10]);
+}
+
+void LinkOutboundSchedulerTest::_testBulkNotStarved()
+{
+    // Just enough budget for the command stream, bulk only gets through once it has waited too long
+    static constexpr qint64 bytesPerSecond = 2000;
+    LinkOutboundScheduler scheduler(bytesPerSecond);
+
+    // Drain the initial burst so the request can't slip through on it
+    for (int i = 0; i < 20; i++) {
+        scheduler.enqueue(heartbeatFrame(), 0);
+    }
+    const QByteArray request = paramRequestFrame(1);
+    scheduler.enqueue(request, 0);
+
+    bool requestSent = false;
+    qint64 sentMs = 0;
+    for (qint64 nowMs = 0; (nowMs <= (2 * LinkOutboundScheduler::kMaxWaitMs)) && !requestSent; nowMs += 10) {
+        for (int i = 0; i < 3; i++) {
+            scheduler.enqueue(heartbeatFrame(), nowMs);
+        }
+        QList<QByteArray> ready;
+        scheduler.takeReady(nowMs, ready);
+        if (ready.contains(request)) {
+            requestSent = true;
+            sentMs = nowMs;
+        }
+    }
+
+    QVERIFY(requestSent);
+    QVERIFY(sentMs >= LinkOutboundScheduler::kMaxWaitMs);
+}
+
+void LinkOutboundSchedulerTest::_testCorrectionsNotThrottled()
+{
+    static constexpr qint64 bytesPerSecond = 10000;
+    LinkOutboundScheduler scheduler(bytesPerSecond);
+
+    // A bulk backlog which uses up whatever budget it is given
+    for (int16_t i = 0; i < 500; i++) {
+        scheduler.enqueue(paramRequestFrame(i), 0);
+    }
+    QList<QByteArray> ready;
+    scheduler.takeReady(0, ready);
+
+    // Two corrections every 100 ms stay within their share, they must never wait behind the backlog
+    QVERIFY((2 * rtcmFrame().size() * 10) <= (bytesPerSecond * LinkOutboundScheduler::kCorrectionShare));
+    for (qint64 nowMs = 100; nowMs <= 1000; nowMs += 100) {
+        scheduler.enqueue(rtcmFrame(), nowMs);
+        scheduler.enqueue(rtcmFrame(), nowMs);
+
+        ready.clear();
+        scheduler.takeReady(nowMs, ready);
+        const qsizetype corrections = std::count_if(ready.cbegin(), ready.cend(), [](const QByteArray &frame) {
+            return LinkOutboundScheduler::classify(frame) == LinkOutboundScheduler::CorrectionClass;
+        });
+        QCOMPARE(corrections, qsizetype(2));
+        QVERIFY(ready.count() > corrections);
+    }
+
+    QCOMPARE(scheduler.classStats(LinkOutboundScheduler::CorrectionClass).maxLatencyMs, 0.);
+}
+
+void LinkOutboundSchedulerTest::_testCommandsDuringCorrectionFlood()
+{
+    // Corrections arriving far faster than the link can carry them
+    LinkOutboundScheduler scheduler(1000);
+
+    static constexpr qint64 heartbeatMs = 500;
+    const QByteArray heartbeat = heartbeatFrame();
+    bool heartbeatSent = false;
+    qint64 sentMs = 0;
+    for (qint64 nowMs = 0; (nowMs <= (heartbeatMs + LinkOutboundScheduler::kMaxWaitMs)) && !heartbeatSent; nowMs += 10) {
+        for (int i = 0; i < 4; i++) {
+            scheduler.enqueue(rtcmFrame(), nowMs);
+        }
+        if (nowMs == heartbeatMs) {
+            scheduler.enqueue(heartbeat, nowMs);
+        }
+
+        QList<QByteArray> ready;
+        scheduler.takeReady(nowMs, ready);
+        if (ready.contains(heartbeat)) {
+            heartbeatSent = true;
+            sentMs = nowMs;
+        }
+    }
+
+    QVERIFY(heartbeatSent);
+    QVERIFY((sentMs - heartbeatMs) < LinkOutboundScheduler::kMaxWaitMs);
+    QVERIFY(scheduler.classStats(LinkOutboundScheduler::CorrectionClass).droppedMessages > 0);
+}
+
+UT_REGISTER_TEST(LinkOutboundSchedulerTest, TestLabel::Unit, TestLabel::Comms)
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class LinkOutboundSchedulerTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testClassify();
+    void _testUnlimited();
+    void _testCommandsAheadOfBulk();
+    void _testPacing();
+    void _testStats();
+    void _testSignedInOrder();
+    void _testQueueCap();
+    void _testBulkNotStarved();
+    void _testCorrectionsNotThrottled();
+    void _testCommandsDuringCorrectionFlood();
+};
@@ -0,0 +1,62 @@
+#include "LinkOutboundShapingTest.h"
+
+#include "LinkConfiguration.h"
+#include "LinkOutboundScheduler.h"
+#include "MAVLinkProtocol.h"
+#include "Vehicle.h"
+
+namespace {
+
+void writeMessage(LinkInterface *link, const mavlink_message_t &message)
+{
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    const uint16_t length = mavlink_msg_to_send_buffer(buffer, &message);
+    link->writeBytesThreadSafe(reinterpret_cast<const char*>(buffer), length);
+}
+
+} // namespace
+
+void LinkOutboundShapingTest::_testCommandNotStarvedByBulk()
+{
+    MockLink *const link = mockLink();
+    const uint8_t systemId = static_cast<uint8_t>(MAVLinkProtocol::instance()->getSystemId());
+    const uint8_t componentId = static_cast<uint8_t>(MAVLinkProtocol::getComponentId());
+
+    // A slow radio: the parameter burst below takes a couple of seconds at this budget
+    static constexpr int bytesPerSecond = 500;
+    link->linkConfiguration()->setOutboundBytesPerSecond(bytesPerSecond);
+
+    const int paramRequestsBefore = link->receivedMavlinkMessageCount(MAVLINK_MSG_ID_PARAM_REQUEST_READ);
+
+    static constexpr int paramRequestCount = 60;
+    const char paramId[MAVLINK_MSG_PARAM_REQUEST_READ_FIELD_PARAM_ID_LEN] = {};
+    for (int i = 0; i < paramRequestCount; i++) {
+        mavlink_message_t message;
+        (void) mavlink_msg_param_request_read_pack_chan(systemId, componentId, link->mavlinkChannel(), &message,
+                                                        static_cast<uint8_t>(vehicle()->id()), MAV_COMP_ID_AUTOPILOT1, paramId, static_cast<int16_t>(i));
+        writeMessage(link, message);
+    }
+
+    mavlink_message_t command;
+    (void) mavlink_msg_command_long_pack_chan(systemId, componentId, link->mavlinkChannel(), &command,
+                                              static_cast<uint8_t>(vehicle()->id()), MAV_COMP_ID_AUTOPILOT1,
+                                              MAV_CMD_DO_SET_SERVO, 0, 9, 1500, 0, 0, 0, 0, 0);
+    writeMessage(link, command);
+
+    // The command overtakes the queued parameter requests
+    QTRY_COMPARE_WITH_TIMEOUT(link->receivedMavCommandCount(MAV_CMD_DO_SET_SERVO), 1, 1000);
+    QVERIFY((link->receivedMavlinkMessageCount(MAVLINK_MSG_ID_PARAM_REQUEST_READ) - paramRequestsBefore) < paramRequestCount);
+
+    // And the burst still drains at the budget
+    QTRY_COMPARE_WITH_TIMEOUT(link->receivedMavlinkMessageCount(MAVLINK_MSG_ID_PARAM_REQUEST_READ) - paramRequestsBefore, paramRequestCount, 10000);
+
+    const LinkOutboundScheduler::ClassStats commandStats = link->outboundStats(LinkOutboundScheduler::CommandClass);
+    const LinkOutboundScheduler::ClassStats bulk = link->outboundStats(LinkOutboundScheduler::BulkClass);
+    QVERIFY(bulk.maxQueuedMessages >= paramRequestCount - 20);
+    QCOMPARE(bulk.queuedMessages, qsizetype(0));
+    QVERIFY(bulk.maxLatencyMs > commandStats.maxLatencyMs);
+
+    link->linkConfiguration()->setOutboundBytesPerSecond(0);
+}
+
+UT_REGISTER_TEST(LinkOutboundShapingTest, TestLabel::Integration, TestLabel::Comms)
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "BaseClasses/VehicleTest.h"
+
+class LinkOutboundShapingTest : public VehicleTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testCommandNotStarvedByBulk();
+};
@@ -278,6 +278,24 @@ void APMParameterMetaDataTest::_loadBundledAPMMetaData()
     QVERIFY(!battMon->shortDescription().isEmpty());
 }
 
+void APMParameterMetaDataTest::_materializeOnFirstRequest()
+{
+    QScopedPointer<APMParameterMetaData> meta(_loadFromJson(kAPMJson, nullptr));
+    QVERIFY(meta);
+
+    // Loading only indexes the json, no FactMetaData is built up front
+    QVERIFY(meta->findChildren<FactMetaData*>(Qt::FindDirectChildrenOnly).isEmpty());
+
+    FactMetaData *fact = meta->getMetaDataForFact("TEST_PARAM", FactMetaData::valueTypeFloat);
+    QVERIFY(fact);
+    QCOMPARE(fact->name(), "TEST_PARAM");
+    QCOMPARE(meta->findChildren<FactMetaData*>(Qt::FindDirectChildrenOnly).count(), 1);
+
+    // Subsequent requests return the same instance
+    QCOMPARE(meta->getMetaDataForFact("TEST_PARAM", FactMetaData::valueTypeFloat), fact);
+    QCOMPARE(meta->findChildren<FactMetaData*>(Qt::FindDirectChildrenOnly).count(), 1);
+}
+
 void APMParameterMetaDataTest::_verifyFullAPMParse()
 {
     const QString file = QStringLiteral(":/FirmwarePlugin/APM/APMParameterFactMetaData.Copter.4.7.json");
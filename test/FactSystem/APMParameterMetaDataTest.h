@@ -23,6 +23,7 @@ private slots:
     void _loadMissingFile();
     void _loadEmptyJson();
     void _loadBundledAPMMetaData();
+    void _materializeOnFirstRequest();
     void _verifyFullAPMParse();
     void _versionFromJsonDataAPMFormat();
     void _invalidEnumKeySkipped();
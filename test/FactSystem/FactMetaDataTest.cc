@@ -317,4 +317,28 @@ void FactMetaDataTest::_setMinMax_test()
     QVERIFY(!meta.maxIsDefaultForType());
 }
 
+void FactMetaDataTest::_sharedMapFromJsonFile_test()
+{
+    const QString jsonFile = QStringLiteral(":/json/CameraSpec.FactMetaData.json");
+
+    const QMap<QString, FactMetaData*> first = FactMetaData::sharedMapFromJsonFile(jsonFile);
+    const QMap<QString, FactMetaData*> second = FactMetaData::sharedMapFromJsonFile(jsonFile);
+
+    QVERIFY(!first.isEmpty());
+    QCOMPARE(second.keys(), first.keys());
+    for (auto it = first.constBegin(); it != first.constEnd(); ++it) {
+        QCOMPARE(second.value(it.key()), it.value());
+        QVERIFY(!it.value()->parent());
+    }
+
+    // A private map parsed from the same file must not alias the shared instances
+    QObject owner;
+    const QMap<QString, FactMetaData*> privateMap = FactMetaData::createMapFromJsonFile(jsonFile, &owner);
+    QCOMPARE(privateMap.keys(), first.keys());
+    for (auto it = privateMap.constBegin(); it != privateMap.constEnd(); ++it) {
+        QVERIFY(it.value() != first.value(it.key()));
+        QCOMPARE(it.value()->rawDefaultValue(), first.value(it.key())->rawDefaultValue());
+    }
+}
+
 UT_REGISTER_TEST(FactMetaDataTest, TestLabel::Unit)
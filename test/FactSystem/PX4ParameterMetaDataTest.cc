@@ -499,6 +499,24 @@ void PX4ParameterMetaDataTest::_verifyFullPX4Parse()
     QVERIFY2(withReboot > 0, "Expected at least one PX4 parameter with reboot-required metadata");
 }
 
+void PX4ParameterMetaDataTest::_materializeOnFirstRequest()
+{
+    PX4ParameterMetaData meta;
+    meta.loadParameterFactMetaDataFile(QStringLiteral(":/FirmwarePlugin/PX4/PX4ParameterFactMetaData.json"));
+
+    // Loading only indexes the json, no FactMetaData is built up front
+    QVERIFY(meta.findChildren<FactMetaData*>(Qt::FindDirectChildrenOnly).isEmpty());
+
+    FactMetaData *emergc = meta.getMetaDataForFact("ADSB_EMERGC", FactMetaData::valueTypeInt32);
+    QVERIFY(emergc);
+    QCOMPARE(emergc->name(), "ADSB_EMERGC");
+    QCOMPARE(meta.findChildren<FactMetaData*>(Qt::FindDirectChildrenOnly).count(), 1);
+
+    // Subsequent requests return the same instance
+    QCOMPARE(meta.getMetaDataForFact("ADSB_EMERGC", FactMetaData::valueTypeInt32), emergc);
+    QCOMPARE(meta.findChildren<FactMetaData*>(Qt::FindDirectChildrenOnly).count(), 1);
+}
+
 void PX4ParameterMetaDataTest::_versionFromFileName()
 {
     QCOMPARE(ParameterMetaData::versionFromFileName("ParameterFactMetaData_3.4.7.json"),
@@ -539,4 +557,50 @@ void PX4ParameterMetaDataTest::_versionFromJsonDataNoVersion()
     QVERIFY(ParameterMetaData::versionFromJsonData("not json{{{").isNull());
 }
 
+void PX4ParameterMetaDataTest::_benchmarkLoadBundledMetaData()
+{
+    // Connect time cost: what a vehicle pays before any parameter page is opened
+    const QString file = QStringLiteral(":/FirmwarePlugin/PX4/PX4ParameterFactMetaData.json");
+    QVERIFY(QFile::exists(file));
+
+    QBENCHMARK {
+        PX4ParameterMetaData meta;
+        meta.loadParameterFactMetaDataFile(file);
+        QVERIFY(meta.findChildren<FactMetaData*>(Qt::FindDirectChildrenOnly).isEmpty());
+    }
+}
+
+void PX4ParameterMetaDataTest::_benchmarkMaterializeAllBundledMetaData()
+{
+    // Cost of building every FactMetaData, which loading used to pay up front. The object count is the memory
+    // that lazy materialization keeps off the heap until parameters are actually shown.
+    const QString file = QStringLiteral(":/FirmwarePlugin/PX4/PX4ParameterFactMetaData.json");
+    QFile jsonFile(file);
+    QVERIFY(jsonFile.open(QIODevice::ReadOnly));
+    const QJsonArray parameters = QJsonDocument::fromJson(jsonFile.readAll()).object().value(u"parameters").toArray();
+    jsonFile.close();
+
+    QList<QPair<QString, FactMetaData::ValueType_t>> requests;
+    for (const QJsonValue &paramVal : parameters) {
+        const QJsonObject param = paramVal.toObject();
+        bool unknownType = false;
+        const FactMetaData::ValueType_t valueType = FactMetaData::stringToType(param.value(u"type").toString(), unknownType);
+        if (!unknownType) {
+            requests.append({ param.value(u"name").toString(), valueType });
+        }
+    }
+    QVERIFY(requests.count() > 1000);
+
+    qsizetype materialized = 0;
+    QBENCHMARK {
+        PX4ParameterMetaData meta;
+        meta.loadParameterFactMetaDataFile(file);
+        for (const auto &[name, valueType] : std::as_const(requests)) {
+            (void) meta.getMetaDataForFact(name, valueType);
+        }
+        materialized = meta.findChildren<FactMetaData*>(Qt::FindDirectChildrenOnly).count();
+    }
+    QVERIFY(materialized > 1000);
+}
+
 UT_REGISTER_TEST(PX4ParameterMetaDataTest, TestLabel::Unit)
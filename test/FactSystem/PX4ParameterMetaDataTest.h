@@ -31,8 +31,13 @@ private slots:
     void _loadMissingFile();
     void _loadBundledPX4MetaData();
     void _verifyFullPX4Parse();
+    void _materializeOnFirstRequest();
     void _versionFromFileName();
     void _versionFromFileNameNoMatch();
     void _versionFromJsonDataAPMFormat();
     void _versionFromJsonDataNoVersion();
+
+    // Benchmarks (QBENCHMARK)
+    void _benchmarkLoadBundledMetaData();
+    void _benchmarkMaterializeAllBundledMetaData();
 };
@@ -35,6 +35,39 @@ inline QByteArray buildRtcmFrame(uint16_t messageId, int extraPayloadBytes = 0)
     return frame;
 }
 
+// Build an MSM or legacy GPS observation frame with the epoch time and multiple message bit set
+inline QByteArray buildObservationFrame(uint16_t messageId, uint32_t epoch, bool multipleMessage, int payloadBytes = 100)
+{
+    QByteArray payload(payloadBytes, 0);
+    const auto writeBits = [&payload](int bitOffset, int count, uint32_t value) {
+        for (int i = 0; i < count; i++) {
+            if ((value >> (count - 1 - i)) & 0x01) {
+                const int bit = bitOffset + i;
+                payload[bit / 8] = static_cast<char>(static_cast<uint8_t>(payload[bit / 8]) | (0x80 >> (bit % 8)));
+            }
+        }
+    };
+    writeBits(0, 12, messageId);
+    writeBits(24, 30, epoch);
+    writeBits(54, 1, multipleMessage ? 1 : 0);
+
+    QByteArray frame;
+    frame.append(static_cast<char>(RTCM3_PREAMBLE));
+    frame.append(static_cast<char>((payloadBytes >> 8) & 0x03));
+    frame.append(static_cast<char>(payloadBytes & 0xFF));
+    frame.append(payload);
+
+    const uint32_t crc = RTCMParser::crc24q(
+        reinterpret_cast<const uint8_t*>(frame.constData()),
+        static_cast<size_t>(frame.size()));
+
+    frame.append(static_cast<char>((crc >> 16) & 0xFF));
+    frame.append(static_cast<char>((crc >> 8) & 0xFF));
+    frame.append(static_cast<char>(crc & 0xFF));
+
+    return frame;
+}
+
 // Verify NMEA checksum: XOR of bytes between '$' and '*'
 inline bool verifyNmeaChecksum(const QByteArray& sentence)
 {
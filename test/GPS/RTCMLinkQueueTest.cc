@@ -0,0 +1,173 @@
+#include "RTCMLinkQueueTest.h"
+#include "RTCMLinkQueue.h"
+#include "GpsTestHelpers.h"
+
+void RTCMLinkQueueTest::_testUnlimitedPriorityOrder()
+{
+    RTCMLinkQueue queue;
+    queue.enqueue(GpsTestHelpers::buildRtcmFrame(1019, 60), 0, 0);
+    queue.enqueue(GpsTestHelpers::buildRtcmFrame(1005, 17), 1, 0);
+    queue.enqueue(GpsTestHelpers::buildRtcmFrame(1077, 200), 2, 0);
+
+    QList<RTCMLinkQueue::Message> ready;
+    queue.takeReady(0, ready);
+
+    QCOMPARE(ready.count(), 3);
+    QCOMPARE(ready[0].messageId, static_cast<uint16_t>(1077));
+    QCOMPARE(ready[0].sequenceId, static_cast<uint8_t>(2));
+    QCOMPARE(ready[1].messageId, static_cast<uint16_t>(1005));
+    QCOMPARE(ready[2].messageId, static_cast<uint16_t>(1019));
+    QVERIFY(queue.isEmpty());
+}
+
+void RTCMLinkQueueTest::_testPacedLink()
+{
+    // Half of a 57600 baud radio
+    static constexpr qint64 bytesPerSecond = 2880;
+    RTCMLinkQueue queue(bytesPerSecond);
+
+    // Ten constellations' worth of 500 byte observations arrive at once
+    const QByteArray frame = GpsTestHelpers::buildRtcmFrame(1071, 500);
+    qsizetype queued = 0;
+    for (uint16_t id = 1071; id <= 1137; id += 10) {
+        queue.enqueue(GpsTestHelpers::buildRtcmFrame(id, 500), 0, 0);
+        queued++;
+    }
+
+    QList<RTCMLinkQueue::Message> ready;
+    queue.takeReady(0, ready);
+    QVERIFY(ready.count() > 0);
+    QVERIFY(ready.count() < queued);
+
+    // Never more than the bucket depth plus the rate
+    qsizetype sent = ready.count();
+    for (qint64 nowMs = 100; nowMs <= 1000; nowMs += 100) {
+        ready.clear();
+        queue.takeReady(nowMs, ready);
+        sent += ready.count();
+
+        const double budget = qMax(bytesPerSecond * RTCMLinkQueue::kBurstMs / 1000., static_cast<double>(RTCMLinkQueue::wireSize(1029))) + (bytesPerSecond * nowMs / 1000.);
+        QVERIFY(sent * RTCMLinkQueue::wireSize(frame.size()) <= budget);
+    }
+    QVERIFY(sent > 2);
+}
+
+void RTCMLinkQueueTest::_testObservationsBeforeEphemeris()
+{
+    RTCMLinkQueue queue(1000);
+
+    // Drain the initial burst
+    queue.enqueue(GpsTestHelpers::buildRtcmFrame(1019, 1000), 0, 0);
+    QList<RTCMLinkQueue::Message> ready;
+    queue.takeReady(0, ready);
+    QCOMPARE(ready.count(), 1);
+
+    // The ephemeris queued first has to wait for the observation
+    queue.enqueue(GpsTestHelpers::buildRtcmFrame(1020, 100), 1, 100);
+    queue.enqueue(GpsTestHelpers::buildRtcmFrame(1077, 100), 2, 100);
+
+    ready.clear();
+    queue.takeReady(200, ready);
+    QCOMPARE(ready.count(), 1);
+    QCOMPARE(ready[0].messageId, static_cast<uint16_t>(1077));
+
+    ready.clear();
+    queue.takeReady(400, ready);
+    QCOMPARE(ready.count(), 1);
+    QCOMPARE(ready[0].messageId, static_cast<uint16_t>(1020));
+}
+
+void RTCMLinkQueueTest::_testSupersede()
+{
+    RTCMLinkQueue queue;
+
+    // A newer epoch replaces the waiting one
+    queue.enqueue(GpsTestHelpers::buildObservationFrame(1077, 1000, false), 0, 0);
+    queue.enqueue(GpsTestHelpers::buildObservationFrame(1087, 1000, false), 1, 0);
+    queue.enqueue(GpsTestHelpers::buildObservationFrame(1077, 2000, false), 2, 1000);
+    QCOMPARE(queue.droppedCount(), static_cast<quint64>(1));
+
+    // So does a newer station description
+    queue.enqueue(GpsTestHelpers::buildRtcmFrame(1005, 17), 5, 1000);
+    queue.enqueue(GpsTestHelpers::buildRtcmFrame(1005, 17), 6, 1000);
+    QCOMPARE(queue.droppedCount(), static_cast<quint64>(2));
+
+    // Ephemerides of different satellites share the message id
+    queue.enqueue(GpsTestHelpers::buildRtcmFrame(1019, 60), 3, 1000);
+    queue.enqueue(GpsTestHelpers::buildRtcmFrame(1019, 60), 4, 1000);
+    QCOMPARE(queue.droppedCount(), static_cast<quint64>(2));
+
+    QList<RTCMLinkQueue::Message> ready;
+    queue.takeReady(1000, ready);
+    QCOMPARE(ready.count(), 5);
+    QCOMPARE(ready[0].messageId, static_cast<uint16_t>(1077));
+    QCOMPARE(ready[0].sequenceId, static_cast<uint8_t>(2));
+    QCOMPARE(ready[1].messageId, static_cast<uint16_t>(1087));
+    QCOMPARE(ready[2].sequenceId, static_cast<uint8_t>(6));
+}
+
+void RTCMLinkQueueTest::_testEpochKeptWhole()
+{
+    RTCMLinkQueue queue;
+
+    // One MSM7 epoch split over two messages with the same id
+    queue.enqueue(GpsTestHelpers::buildObservationFrame(1077, 5000, true), 0, 0);
+    queue.enqueue(GpsTestHelpers::buildObservationFrame(1077, 5000, false), 1, 0);
+    QCOMPARE(queue.droppedCount(), static_cast<quint64>(0));
+
+    // An older epoch arriving late doesn't replace anything either
+    queue.enqueue(GpsTestHelpers::buildObservationFrame(1077, 4000, false), 2, 0);
+    QCOMPARE(queue.droppedCount(), static_cast<quint64>(0));
+
+    QList<RTCMLinkQueue::Message> ready;
+    queue.takeReady(0, ready);
+    QCOMPARE(ready.count(), 3);
+    QCOMPARE(ready[0].sequenceId, static_cast<uint8_t>(0));
+    QCOMPARE(ready[1].sequenceId, static_cast<uint8_t>(1));
+
+    // The next epoch replaces every part of the waiting one, its own parts are kept together
+    queue.enqueue(GpsTestHelpers::buildObservationFrame(1077, 5000, true), 3, 0);
+    queue.enqueue(GpsTestHelpers::buildObservationFrame(1077, 5000, false), 4, 0);
+    queue.enqueue(GpsTestHelpers::buildObservationFrame(1077, 6000, true), 5, 0);
+    queue.enqueue(GpsTestHelpers::buildObservationFrame(1077, 6000, false), 6, 0);
+    QCOMPARE(queue.droppedCount(), static_cast<quint64>(2));
+
+    ready.clear();
+    queue.takeReady(0, ready);
+    QCOMPARE(ready.count(), 2);
+    QCOMPARE(ready[0].sequenceId, static_cast<uint8_t>(5));
+    QCOMPARE(ready[1].sequenceId, static_cast<uint8_t>(6));
+
+    // The GPS week rolls over, the epoch just after it is the newer one
+    queue.enqueue(GpsTestHelpers::buildObservationFrame(1077, 604799000, false), 7, 0);
+    queue.enqueue(GpsTestHelpers::buildObservationFrame(1077, 0, false), 8, 0);
+    QCOMPARE(queue.droppedCount(), static_cast<quint64>(3));
+}
+
+void RTCMLinkQueueTest::_testStaleDropped()
+{
+    RTCMLinkQueue queue(10);
+
+    // Fill the bucket so nothing else can go out for a while
+    queue.enqueue(GpsTestHelpers::buildRtcmFrame(1019, 1000), 0, 0);
+    QList<RTCMLinkQueue::Message> ready;
+    queue.takeReady(0, ready);
+    QCOMPARE(ready.count(), 1);
+
+    queue.enqueue(GpsTestHelpers::buildRtcmFrame(1077, 100), 1, 0);
+    queue.enqueue(GpsTestHelpers::buildRtcmFrame(1020, 100), 2, 0);
+
+    // The observation is useless after a few seconds, the ephemeris is not
+    ready.clear();
+    queue.takeReady(RTCMLinkQueue::kMaxObservationAgeMs + 1, ready);
+    QCOMPARE(queue.droppedCount(), static_cast<quint64>(1));
+    QVERIFY(ready.isEmpty());
+    QVERIFY(!queue.isEmpty());
+
+    ready.clear();
+    queue.takeReady(RTCMLinkQueue::kMaxAgeMs + 1, ready);
+    QCOMPARE(queue.droppedCount(), static_cast<quint64>(2));
+    QVERIFY(queue.isEmpty());
+}
+
+UT_REGISTER_TEST(RTCMLinkQueueTest, TestLabel::Unit)
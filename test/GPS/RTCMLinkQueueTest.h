@@ -0,0 +1,16 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class RTCMLinkQueueTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testUnlimitedPriorityOrder();
+    void _testPacedLink();
+    void _testObservationsBeforeEphemeris();
+    void _testSupersede();
+    void _testEpochKeptWhole();
+    void _testStaleDropped();
+};
@@ -322,4 +322,59 @@ void RTCMParserTest::_testParserCorruptedPreamble()
     QVERIFY(parser.validateCrc());
 }
 
+// ---------------------------------------------------------------------------
+// Message Classification Tests
+// ---------------------------------------------------------------------------
+
+void RTCMParserTest::_testMessageClass()
+{
+    for (uint16_t id : { 1001, 1004, 1012, 1074, 1077, 1087, 1097, 1107, 1117, 1127, 1137 }) {
+        QCOMPARE(RTCMParser::messageClass(id), RTCMParser::Observation);
+    }
+    for (uint16_t id : { 1005, 1006, 1008, 1033, 1230 }) {
+        QCOMPARE(RTCMParser::messageClass(id), RTCMParser::StationInfo);
+    }
+    for (uint16_t id : { 1019, 1020, 1042, 1045, 1046 }) {
+        QCOMPARE(RTCMParser::messageClass(id), RTCMParser::Ephemeris);
+    }
+
+    // Gaps between the MSM blocks and unknown ids
+    for (uint16_t id : { 0, 1013, 1070, 1078, 1080, 1138, 4094 }) {
+        QCOMPARE(RTCMParser::messageClass(id), RTCMParser::Other);
+    }
+}
+
+void RTCMParserTest::_testFrameMessageId()
+{
+    const QByteArray frame = GpsTestHelpers::buildRtcmFrame(1077, 20);
+    const auto *bytes = reinterpret_cast<const uint8_t*>(frame.constData());
+    QCOMPARE(RTCMParser::frameMessageId(bytes, static_cast<size_t>(frame.size())), static_cast<uint16_t>(1077));
+
+    // Too short to hold an id
+    QCOMPARE(RTCMParser::frameMessageId(bytes, 4), static_cast<uint16_t>(0));
+
+    // Not a frame
+    const uint8_t garbage[] = { 0x00, 0x00, 0x02, 0x43, 0x50 };
+    QCOMPARE(RTCMParser::frameMessageId(garbage, sizeof(garbage)), static_cast<uint16_t>(0));
+}
+
+void RTCMParserTest::_testFrameObservationHeader()
+{
+    const QByteArray frame = GpsTestHelpers::buildObservationFrame(1077, 345678000, true);
+    const auto *bytes = reinterpret_cast<const uint8_t*>(frame.constData());
+
+    RTCMParser::ObservationHeader header;
+    QVERIFY(RTCMParser::frameObservationHeader(bytes, static_cast<size_t>(frame.size()), header));
+    QCOMPARE(header.epoch, static_cast<uint32_t>(345678000));
+    QCOMPARE(header.epochBits, static_cast<uint8_t>(30));
+    QVERIFY(header.multipleMessage);
+
+    // Too short to hold the epoch
+    QVERIFY(!RTCMParser::frameObservationHeader(bytes, 8, header));
+
+    // Not an observation
+    const QByteArray station = GpsTestHelpers::buildRtcmFrame(1005, 17);
+    QVERIFY(!RTCMParser::frameObservationHeader(reinterpret_cast<const uint8_t*>(station.constData()), static_cast<size_t>(station.size()), header));
+}
+
 UT_REGISTER_TEST(RTCMParserTest, TestLabel::Unit)
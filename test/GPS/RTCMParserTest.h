@@ -27,4 +27,9 @@ private slots:
     void _testParserMaxLength();
     void _testParserTruncatedFrame();
     void _testParserCorruptedPreamble();
+
+    // Message classification
+    void _testMessageClass();
+    void _testFrameMessageId();
+    void _testFrameObservationHeader();
 };
@@ -1,5 +1,6 @@
 #include "JoystickTest.h"
 
+#include "Fact.h"
 #include "Joystick.h"
 #include "JoystickSDL.h"
 #include "MockJoystick.h"
@@ -7,6 +8,8 @@
 
 #include <QtCore/QPointer>
 
+#include <cmath>
+
 void JoystickTest::initTestCase()
 {
     UnitTest::initTestCase();
@@ -291,6 +294,70 @@ void JoystickTest::_pollingUpdatesValuesTest()
     _pumpEvents();
 }
 
+void JoystickTest::_axisSendScheduleTest()
+{
+    _mockJoystick = std::unique_ptr<MockJoystick>(MockJoystick::create(QStringLiteral("Schedule Test"), 6, 16, 1));
+    QVERIFY(_mockJoystick->isValid());
+    _pumpEvents();
+    _discoveredJoysticks = JoystickSDL::discover();
+    JoystickSDL* js = _findJoystickByInstanceId(_mockJoystick->instanceId());
+    QVERIFY(js != nullptr);
+
+    Fact* const axisFrequencyHz = js->settings()->axisFrequencyHz();
+    const QVariant savedFrequency = axisFrequencyHz->rawValue();
+    axisFrequencyHz->setRawValue(100.);
+
+    js->_startPollingForConfiguration();
+    QVERIFY(js->isRunning());
+    QTRY_VERIFY_WITH_TIMEOUT(js->sendIntervalStats().count >= 20, 5000);
+    js->_stopPollingForConfiguration();
+    QVERIFY(js->wait(1000));
+
+    axisFrequencyHz->setRawValue(savedFrequency);
+
+    // Wall clock timing on a loaded CI machine is only good for a sanity check, the statistics themselves
+    // are checked with synthetic intervals in _sendIntervalStatsTest
+    const Joystick::SendIntervalStats stats = js->sendIntervalStats();
+    QCOMPARE(stats.targetMs, 10.);
+    QVERIFY(stats.minMs > 0.);
+    QVERIFY(stats.minMs <= stats.meanMs);
+    QVERIFY(stats.meanMs <= stats.maxMs);
+    QVERIFY(stats.meanMs < (10. * stats.targetMs));
+    QVERIFY(stats.jitterMs >= 0.);
+}
+
+void JoystickTest::_sendIntervalStatsTest()
+{
+    _mockJoystick = std::unique_ptr<MockJoystick>(MockJoystick::create(QStringLiteral("Interval Stats Test"), 6, 16, 1));
+    QVERIFY(_mockJoystick->isValid());
+    _pumpEvents();
+    _discoveredJoysticks = JoystickSDL::discover();
+    JoystickSDL* js = _findJoystickByInstanceId(_mockJoystick->instanceId());
+    QVERIFY(js != nullptr);
+
+    using namespace std::chrono_literals;
+    js->resetSendIntervalStats();
+
+    // A late send followed by a catch up one, as the deadline schedule produces them
+    js->_recordSendInterval(10ms, 0ms, 10ms);
+    js->_recordSendInterval(14ms, 4ms, 10ms);
+    js->_recordSendInterval(6ms, 0ms, 10ms);
+    js->_recordSendInterval(10ms, 0ms, 10ms);
+
+    const Joystick::SendIntervalStats stats = js->sendIntervalStats();
+    QCOMPARE(stats.count, 4ULL);
+    QCOMPARE(stats.targetMs, 10.);
+    QCOMPARE(stats.meanMs, 10.);
+    QCOMPARE(stats.minMs, 6.);
+    QCOMPARE(stats.maxMs, 14.);
+    QCOMPARE(stats.maxLatenessMs, 4.);
+    // Sample standard deviation of 10, 14, 6, 10
+    QVERIFY(qAbs(stats.jitterMs - std::sqrt(32. / 3.)) < 1e-9);
+
+    js->resetSendIntervalStats();
+    QCOMPARE(js->sendIntervalStats().count, 0ULL);
+}
+
 //-----------------------------------------------------------------------------
 // Calibration Tests
 //-----------------------------------------------------------------------------
@@ -44,6 +44,8 @@ private slots:
 
     // Polling/update tests
     void _pollingUpdatesValuesTest();
+    void _axisSendScheduleTest();
+    void _sendIntervalStatsTest();
 
     // Calibration tests
     void _calibrationDataTest();
@@ -0,0 +1,166 @@
+#include "QGCApplicationTest.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QMetaMethod>
+
+#include "QGCApplication.h"
+
+void QGCApplicationTest::init()
+{
+    UnitTest::init();
+    qgcApp()->addCompressedSignal(QMetaMethod::fromSignal(&CompressedSignalEmitter::valueChanged));
+    qgcApp()->resetCompressedSignalStats();
+}
+
+void QGCApplicationTest::cleanup()
+{
+    qgcApp()->removeCompressedSignal(QMetaMethod::fromSignal(&CompressedSignalEmitter::valueChanged));
+    UnitTest::cleanup();
+}
+
+void QGCApplicationTest::_testCompressedSignalKeepsNewest()
+{
+    CompressedSignalEmitter emitter;
+    CompressedSignalReceiver receiver;
+    (void) connect(&emitter, &CompressedSignalEmitter::valueChanged, &receiver, &CompressedSignalReceiver::onValue, Qt::QueuedConnection);
+
+    constexpr int kEmitCount = 1000;
+    for (int i = 0; i < kEmitCount; i++) {
+        emit emitter.valueChanged(i);
+    }
+    QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+
+    QCOMPARE(receiver.callCount, 1);
+    QCOMPARE(receiver.lastValue, kEmitCount - 1);
+
+    // The first call is posted before there is anything to compress, the first duplicate scans for it and the
+    // remaining duplicates are found through the index
+    const QGCApplication::CompressedSignalStats stats = qgcApp()->compressedSignalStats();
+    QCOMPARE(stats.coalesced, static_cast<quint64>(kEmitCount - 1));
+    QVERIFY(stats.indexMisses <= 2);
+}
+
+void QGCApplicationTest::_testCompressedSignalPerReceiver()
+{
+    CompressedSignalEmitter emitter;
+    CompressedSignalReceiver receiver1;
+    CompressedSignalReceiver receiver2;
+    (void) connect(&emitter, &CompressedSignalEmitter::valueChanged, &receiver1, &CompressedSignalReceiver::onValue, Qt::QueuedConnection);
+    (void) connect(&emitter, &CompressedSignalEmitter::valueChanged, &receiver2, &CompressedSignalReceiver::onValue, Qt::QueuedConnection);
+
+    for (int i = 0; i < 10; i++) {
+        emit emitter.valueChanged(i);
+    }
+    QCoreApplication::sendPostedEvents(&receiver1, QEvent::MetaCall);
+    QCoreApplication::sendPostedEvents(&receiver2, QEvent::MetaCall);
+
+    QCOMPARE(receiver1.callCount, 1);
+    QCOMPARE(receiver1.lastValue, 9);
+    QCOMPARE(receiver2.callCount, 1);
+    QCOMPARE(receiver2.lastValue, 9);
+}
+
+void QGCApplicationTest::_testUncompressedSignalDelivered()
+{
+    CompressedSignalEmitter emitter;
+    CompressedSignalReceiver receiver;
+    (void) connect(&emitter, &CompressedSignalEmitter::uncompressedValueChanged, &receiver, &CompressedSignalReceiver::onValue, Qt::QueuedConnection);
+
+    for (int i = 0; i < 10; i++) {
+        emit emitter.uncompressedValueChanged(i);
+    }
+    QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+
+    QCOMPARE(receiver.callCount, 10);
+    QCOMPARE(qgcApp()->compressedSignalStats().coalesced, static_cast<quint64>(0));
+}
+
+void QGCApplicationTest::_testCompressedSignalAfterDelivery()
+{
+    CompressedSignalEmitter emitter;
+    CompressedSignalReceiver receiver;
+    (void) connect(&emitter, &CompressedSignalEmitter::valueChanged, &receiver, &CompressedSignalReceiver::onValue, Qt::QueuedConnection);
+    (void) connect(&emitter, &CompressedSignalEmitter::uncompressedValueChanged, &receiver, &CompressedSignalReceiver::onValue, Qt::QueuedConnection);
+
+    // Keep another call queued so compressEvent is consulted for every post
+    emit emitter.uncompressedValueChanged(-10);
+    emit emitter.valueChanged(1);
+    emit emitter.valueChanged(2);
+    QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+    QCOMPARE(receiver.callCount, 2);
+    QCOMPARE(receiver.lastValue, 2);
+
+    // A call which has already been delivered must not swallow the next one
+    emit emitter.uncompressedValueChanged(-20);
+    emit emitter.valueChanged(3);
+    QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+    QCOMPARE(receiver.callCount, 4);
+    QCOMPARE(receiver.lastValue, 3);
+}
+
+void QGCApplicationTest::_benchmarkCompressedSignalFlood()
+{
+    CompressedSignalEmitter emitter;
+    CompressedSignalReceiver receiver;
+    CompressedSignalReceiver backlog;
+    (void) connect(&emitter, &CompressedSignalEmitter::valueChanged, &receiver, &CompressedSignalReceiver::onValue, Qt::QueuedConnection);
+    (void) connect(&emitter, &CompressedSignalEmitter::uncompressedValueChanged, &backlog, &CompressedSignalReceiver::onValue, Qt::QueuedConnection);
+
+    // Telemetry style backlog which the previous implementation walked for every compressed post
+    constexpr int kBacklogCount = 5000;
+    constexpr int kEmitCount = 5000;
+    for (int i = 0; i < kBacklogCount; i++) {
+        emit emitter.uncompressedValueChanged(i);
+    }
+
+    QBENCHMARK {
+        for (int i = 0; i < kEmitCount; i++) {
+            emit emitter.valueChanged(i);
+        }
+        QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+    }
+
+    QCoreApplication::sendPostedEvents(&backlog, QEvent::MetaCall);
+    QCOMPARE(backlog.callCount, kBacklogCount);
+    QCOMPARE(receiver.lastValue, kEmitCount - 1);
+}
+
+void QGCApplicationTest::_benchmarkCompressedSignalMiss()
+{
+    CompressedSignalReceiver receiver;
+    CompressedSignalReceiver backlog;
+    CompressedSignalEmitter backlogEmitter;
+    (void) connect(&backlogEmitter, &CompressedSignalEmitter::uncompressedValueChanged, &backlog, &CompressedSignalReceiver::onValue, Qt::QueuedConnection);
+
+    // Every post is the first of its connection since the last delivery, so the index never holds it
+    constexpr int kEmitterCount = 1000;
+    QObject emitterOwner;
+    QList<CompressedSignalEmitter*> emitters;
+    for (int i = 0; i < kEmitterCount; i++) {
+        emitters.append(new CompressedSignalEmitter(&emitterOwner));
+        (void) connect(emitters.last(), &CompressedSignalEmitter::valueChanged, &receiver, &CompressedSignalReceiver::onValue, Qt::QueuedConnection);
+    }
+
+    constexpr int kBacklogCount = 5000;
+    for (int i = 0; i < kBacklogCount; i++) {
+        emit backlogEmitter.uncompressedValueChanged(i);
+    }
+
+    int iterations = 0;
+    QBENCHMARK {
+        for (CompressedSignalEmitter *emitter : std::as_const(emitters)) {
+            emit emitter->valueChanged(iterations);
+        }
+        QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+        iterations++;
+    }
+
+    QCoreApplication::sendPostedEvents(&backlog, QEvent::MetaCall);
+    QCOMPARE(backlog.callCount, kBacklogCount);
+    QCOMPARE(receiver.callCount, iterations * kEmitterCount);
+
+    // Only the first call of each burst is posted without compressEvent seeing it, one scan picks it up
+    QVERIFY(qgcApp()->compressedSignalStats().indexMisses <= static_cast<quint64>(iterations));
+}
+
+UT_REGISTER_TEST(QGCApplicationTest, TestLabel::Unit)
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class CompressedSignalEmitter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CompressedSignalEmitter(QObject *parent = nullptr) : QObject(parent) {}
+
+signals:
+    void valueChanged(int value);
+    void uncompressedValueChanged(int value);
+};
+
+class CompressedSignalReceiver : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CompressedSignalReceiver(QObject *parent = nullptr) : QObject(parent) {}
+
+    int callCount = 0;
+    int lastValue = -1;
+
+public slots:
+    void onValue(int value)
+    {
+        callCount++;
+        lastValue = value;
+    }
+};
+
+class QGCApplicationTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void init() override;
+    void cleanup() override;
+
+    void _testCompressedSignalKeepsNewest();
+    void _testCompressedSignalPerReceiver();
+    void _testUncompressedSignalDelivered();
+    void _testCompressedSignalAfterDelivery();
+    void _benchmarkCompressedSignalFlood();
+    void _benchmarkCompressedSignalMiss();
+};
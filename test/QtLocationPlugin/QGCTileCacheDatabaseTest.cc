@@ -946,9 +946,11 @@ void QGCTileCacheDatabaseTest::_testTablesExist()
     }
 
     const QStringList expected = {
+        QStringLiteral("CacheStats"),
         QStringLiteral("SetTiles"),
         QStringLiteral("Tiles"),
         QStringLiteral("TilesDownload"),
+        QStringLiteral("TileSetRanges"),
         QStringLiteral("TileSets"),
     };
     QCOMPARE(tables.size(), expected.size());
@@ -980,7 +982,7 @@ void QGCTileCacheDatabaseTest::_testTilesTableColumns()
                      query.value(4).toString(), query.value(5).toBool()});
     }
 
-    QCOMPARE(cols.size(), 7);
+    QCOMPARE(cols.size(), 9);
 
     auto findCol = [&](const QString& name) -> const ColInfo* {
         for (const auto& c : cols) {
@@ -1022,6 +1024,16 @@ void QGCTileCacheDatabaseTest::_testTilesTableColumns()
     QVERIFY(c);
     QCOMPARE(c->type, QStringLiteral("INTEGER"));
     QCOMPARE(c->dflt, QStringLiteral("0"));
+
+    c = findCol(QStringLiteral("lastAccess"));
+    QVERIFY(c);
+    QCOMPARE(c->type, QStringLiteral("INTEGER"));
+    QCOMPARE(c->dflt, QStringLiteral("0"));
+
+    c = findCol(QStringLiteral("pinned"));
+    QVERIFY(c);
+    QCOMPARE(c->type, QStringLiteral("INTEGER"));
+    QCOMPARE(c->dflt, QStringLiteral("0"));
 }
 
 void QGCTileCacheDatabaseTest::_testTileSetsTableColumns()
@@ -1233,7 +1245,7 @@ void QGCTileCacheDatabaseTest::_testIndexesExist()
 
     const QStringList expected = {
         QStringLiteral("idx_settiles_setid"),           QStringLiteral("idx_settiles_tileid"),
-        QStringLiteral("idx_settiles_unique"),          QStringLiteral("idx_tiles_date"),
+        QStringLiteral("idx_settiles_unique"),          QStringLiteral("idx_tiles_lru"),
         QStringLiteral("idx_tilesdownload_setid_hash"), QStringLiteral("idx_tilesdownload_setid_state"),
     };
 
@@ -1292,4 +1304,372 @@ void QGCTileCacheDatabaseTest::_testForeignKeyCascadeDelete()
     }
 }
 
+void QGCTileCacheDatabaseTest::_testCreateTileSetStoresRanges()
+{
+    auto db = _createInitializedDB();
+
+    const QStringList providerTypes = UrlFactory::getProviderTypes();
+    QVERIFY(!providerTypes.isEmpty());
+    const QString type = providerTypes.first();
+
+    const auto setID = db->createTileSet(QStringLiteral("Range Set"), type, 37.0, -122.0, 36.0, -121.0, 5, 9, type, 0);
+    QVERIFY(setID.has_value());
+
+    // One row per zoom level instead of one TilesDownload row per tile
+    QSqlQuery query(db->database());
+    QVERIFY(query.prepare("SELECT z, x0, x1, y0, y1, nextIndex FROM TileSetRanges WHERE setID = ? ORDER BY z"));
+    query.addBindValue(setID.value());
+    QVERIFY(query.exec());
+    int z = 5;
+    while (query.next()) {
+        QCOMPARE(query.value(0).toInt(), z);
+        const QGCTileSet expected = UrlFactory::getTileCount(z, -122.0, 37.0, -121.0, 36.0, type);
+        QCOMPARE(query.value(1).toInt(), expected.tileX0);
+        QCOMPARE(query.value(2).toInt(), expected.tileX1);
+        QCOMPARE(query.value(3).toInt(), expected.tileY0);
+        QCOMPARE(query.value(4).toInt(), expected.tileY1);
+        QCOMPARE(query.value(5).toLongLong(), 0);
+        z++;
+    }
+    QCOMPARE(z, 10);
+
+    QVERIFY(query.prepare("SELECT COUNT(*) FROM TilesDownload WHERE setID = ?"));
+    query.addBindValue(setID.value());
+    QVERIFY(query.exec());
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toInt(), 0);
+
+    QVERIFY(db->deleteTileSet(setID.value()));
+    QVERIFY(query.prepare("SELECT COUNT(*) FROM TileSetRanges WHERE setID = ?"));
+    query.addBindValue(setID.value());
+    QVERIFY(query.exec());
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toInt(), 0);
+}
+
+void QGCTileCacheDatabaseTest::_testGetTileDownloadListWalksRanges()
+{
+    auto db = _createInitializedDB();
+
+    const QStringList providerTypes = UrlFactory::getProviderTypes();
+    QVERIFY(!providerTypes.isEmpty());
+    const QString type = providerTypes.first();
+
+    const auto setID = db->createTileSet(QStringLiteral("Walk Set"), type, 37.0, -122.0, 36.0, -121.0, 8, 10, type, 0);
+    QVERIFY(setID.has_value());
+
+    qint64 totalTiles = 0;
+    int firstX = 0;
+    int firstY = 0;
+    {
+        QSqlQuery query(db->database());
+        QVERIFY(query.prepare("SELECT x0, x1, y0, y1 FROM TileSetRanges WHERE setID = ? ORDER BY z"));
+        query.addBindValue(setID.value());
+        QVERIFY(query.exec());
+        QVERIFY(query.next());
+        firstX = query.value(0).toInt();
+        firstY = query.value(2).toInt();
+        do {
+            totalTiles += static_cast<qint64>(query.value(1).toInt() - query.value(0).toInt() + 1) *
+                          (query.value(3).toInt() - query.value(2).toInt() + 1);
+        } while (query.next());
+    }
+    QVERIFY(totalTiles > 2);
+
+    // The first tile of the set is already cached and must be linked rather than downloaded
+    const QString cachedHash = UrlFactory::getTileHash(type, firstX, firstY, 8);
+    const QByteArray data(32, 'C');
+    QVERIFY(db->saveTile(cachedHash, QStringLiteral("png"), data, type, QGCTileCacheDatabase::kInvalidTileSet));
+
+    quint32 linkedCount = 0;
+    quint64 linkedSize = 0;
+    QList<QGCTile> tiles = db->getTileDownloadList(setID.value(), 1, &linkedCount, &linkedSize);
+    QCOMPARE(tiles.size(), 1);
+    QCOMPARE(linkedCount, 1u);
+    QCOMPARE(linkedSize, static_cast<quint64>(data.size()));
+    QVERIFY(tiles.first().hash != cachedHash);
+    QCOMPARE(tiles.first().z, 8);
+
+    qint64 handedOut = tiles.size();
+    while (true) {
+        linkedCount = 0;
+        bool moreTiles = false;
+        tiles = db->getTileDownloadList(setID.value(), 50, &linkedCount, nullptr, &moreTiles);
+        QCOMPARE(linkedCount, 0u);
+        if (tiles.isEmpty()) {
+            QVERIFY(!moreTiles);
+            break;
+        }
+        for (const QGCTile &tile : std::as_const(tiles)) {
+            QVERIFY(tile.hash != cachedHash);
+        }
+        handedOut += tiles.size();
+    }
+    QCOMPARE(handedOut, totalTiles - 1);
+
+    QSqlQuery query(db->database());
+    QVERIFY(query.prepare("SELECT COUNT(*) FROM TileSetRanges WHERE setID = ? AND nextIndex < (x1 - x0 + 1) * (y1 - y0 + 1)"));
+    query.addBindValue(setID.value());
+    QVERIFY(query.exec());
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toInt(), 0);
+
+    QVERIFY(query.prepare("SELECT COUNT(*) FROM SetTiles WHERE setID = ?"));
+    query.addBindValue(setID.value());
+    QVERIFY(query.exec());
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toInt(), 1);
+
+    // Tiles reset to pending are handed out again even though every range is exhausted
+    QVERIFY(db->updateAllTileDownloadStates(setID.value(), QGCTile::StatePending));
+    tiles = db->getTileDownloadList(setID.value(), 10);
+    QCOMPARE(tiles.size(), static_cast<qsizetype>(qMin<qint64>(10, totalTiles - 1)));
+}
+
+void QGCTileCacheDatabaseTest::_testGetTileDownloadListBoundsRangeWalk()
+{
+    auto db = _createInitializedDB();
+
+    const QStringList providerTypes = UrlFactory::getProviderTypes();
+    QVERIFY(!providerTypes.isEmpty());
+    const QString type = providerTypes.first();
+
+    // A single zoom level large enough to hold more than two calls' worth of tiles
+    const auto setID = db->createTileSet(QStringLiteral("Cached Set"), type, 40.0, -122.0, 30.0, -110.0, 12, 12, type, 0);
+    QVERIFY(setID.has_value());
+
+    int x0 = 0;
+    int y0 = 0;
+    qint64 height = 0;
+    qint64 totalTiles = 0;
+    {
+        QSqlQuery query(db->database());
+        QVERIFY(query.prepare("SELECT x0, x1, y0, y1 FROM TileSetRanges WHERE setID = ?"));
+        query.addBindValue(setID.value());
+        QVERIFY(query.exec());
+        QVERIFY(query.next());
+        x0 = query.value(0).toInt();
+        y0 = query.value(2).toInt();
+        height = query.value(3).toInt() - y0 + 1;
+        totalTiles = (query.value(1).toInt() - x0 + 1) * height;
+    }
+    const int cachedTiles = (2 * QGCTileCacheDatabase::kRangeTilesPerCall) + 10;
+    QVERIFY(totalTiles > cachedTiles);
+
+    // Everything the first two calls walk is already cached, in the x-major order the ranges are walked in
+    QVERIFY(db->database().transaction());
+    {
+        QSqlQuery query(db->database());
+        QVERIFY(query.prepare("INSERT INTO Tiles(hash, format, tile, size, type, date, lastAccess) VALUES(?, 'png', ?, 4, ?, 0, 0)"));
+        for (int index = 0; index < cachedTiles; index++) {
+            const int x = x0 + static_cast<int>(index / height);
+            const int y = y0 + static_cast<int>(index % height);
+            query.bindValue(0, UrlFactory::getTileHash(type, x, y, 12));
+            query.bindValue(1, QByteArray(4, 'C'));
+            query.bindValue(2, UrlFactory::getQtMapIdFromProviderType(type));
+            QVERIFY(query.exec());
+        }
+    }
+    QVERIFY(db->database().commit());
+
+    // Each call stops after its walk budget, without handing out tiles, until the uncached ones are reached
+    quint32 linkedCount = 0;
+    bool moreTiles = false;
+    QList<QGCTile> tiles = db->getTileDownloadList(setID.value(), 10, &linkedCount, nullptr, &moreTiles);
+    QVERIFY(tiles.isEmpty());
+    QVERIFY(moreTiles);
+    QCOMPARE(linkedCount, static_cast<quint32>(QGCTileCacheDatabase::kRangeTilesPerCall));
+
+    tiles = db->getTileDownloadList(setID.value(), 10, &linkedCount, nullptr, &moreTiles);
+    QVERIFY(tiles.isEmpty());
+    QVERIFY(moreTiles);
+    QCOMPARE(linkedCount, static_cast<quint32>(QGCTileCacheDatabase::kRangeTilesPerCall));
+
+    tiles = db->getTileDownloadList(setID.value(), 10, &linkedCount, nullptr, &moreTiles);
+    QCOMPARE(tiles.size(), 10);
+    QVERIFY(moreTiles);
+    QCOMPARE(linkedCount, 10u);
+}
+
+void QGCTileCacheDatabaseTest::_testSchemaVersionMigratesV1()
+{
+    const QString path = tempPath("v1.db");
+
+    {
+        QGCTileCacheDatabase db(path);
+        QVERIFY(db.init());
+        QVERIFY(db.connectDB());
+        const auto defaultSetID = db.findTileSetID(QStringLiteral("Default Tile Set"));
+        QVERIFY(defaultSetID.has_value());
+        QVERIFY(db.saveTile(QStringLiteral("v1_tile"), QStringLiteral("png"), QByteArray("data"), QStringLiteral("T"),
+                            QGCTileCacheDatabase::kInvalidTileSet));
+        _insertDownloadRecord(&db, defaultSetID.value(), QStringLiteral("v1_pending"), QGCTile::StatePending);
+
+        // Roll the file back to what a version 1 build left behind
+        QSqlQuery query(db.database());
+        QVERIFY(query.exec("DROP TABLE TileSetRanges"));
+        QVERIFY(query.exec("PRAGMA user_version = 1"));
+        db.disconnectDB();
+    }
+
+    QGCTileCacheDatabase db(path);
+    QVERIFY(db.init());
+    QVERIFY(db.connectDB());
+
+    QVERIFY(db.findTile(QStringLiteral("v1_tile")).has_value());
+
+    QSqlQuery query(db.database());
+    QVERIFY(query.exec("PRAGMA user_version"));
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toInt(), QGCTileCacheDatabase::kSchemaVersion);
+    QVERIFY(query.exec("SELECT COUNT(*) FROM TileSetRanges"));
+
+    const auto defaultSetID = db.findTileSetID(QStringLiteral("Default Tile Set"));
+    QVERIFY(defaultSetID.has_value());
+    const QList<QGCTile> tiles = db.getTileDownloadList(defaultSetID.value(), 10);
+    QCOMPARE(tiles.size(), 1);
+    QCOMPARE(tiles.first().hash, QStringLiteral("v1_pending"));
+}
+
+void QGCTileCacheDatabaseTest::_testPruneCacheLeastRecentlyUsed()
+{
+    auto db = _createInitializedDB();
+
+    const QByteArray data(100, 'L');
+    for (const char *hash : {"lru_a", "lru_b", "lru_c"}) {
+        QVERIFY(db->saveTile(QString::fromLatin1(hash), QStringLiteral("png"), data, QStringLiteral("T"),
+                             QGCTileCacheDatabase::kInvalidTileSet));
+    }
+
+    // Inserted oldest first, so insertion order alone would evict lru_a
+    {
+        QSqlQuery query(db->database());
+        QVERIFY(query.exec("UPDATE Tiles SET lastAccess = 100, date = 100 WHERE hash = 'lru_a'"));
+        QVERIFY(query.exec("UPDATE Tiles SET lastAccess = 200, date = 200 WHERE hash = 'lru_b'"));
+        QVERIFY(query.exec("UPDATE Tiles SET lastAccess = 300, date = 300 WHERE hash = 'lru_c'"));
+    }
+
+    // Reading is only recorded in memory until the next flush
+    QVERIFY(db->getTile(QStringLiteral("lru_a")) != nullptr);
+    {
+        QSqlQuery query(db->database());
+        QVERIFY(query.exec("SELECT lastAccess FROM Tiles WHERE hash = 'lru_a'"));
+        QVERIFY(query.next());
+        QCOMPARE(query.value(0).toLongLong(), 100);
+    }
+
+    QVERIFY(db->pruneCache(100));
+
+    QVERIFY(db->findTile(QStringLiteral("lru_a")).has_value());
+    QVERIFY(!db->findTile(QStringLiteral("lru_b")).has_value());
+    QVERIFY(db->findTile(QStringLiteral("lru_c")).has_value());
+
+    QSqlQuery query(db->database());
+    QVERIFY(query.exec("SELECT lastAccess FROM Tiles WHERE hash = 'lru_a'"));
+    QVERIFY(query.next());
+    QVERIFY(query.value(0).toLongLong() > 300);
+}
+
+void QGCTileCacheDatabaseTest::_testCacheStatsTrackPinnedTiles()
+{
+    auto db = _createInitializedDB();
+
+    quint64 setID = 0;
+    _insertTileSet(db.get(), QStringLiteral("PinnedSet"), setID);
+
+    const QByteArray shared(40, 'S');
+    const QByteArray loose(10, 'D');
+    QVERIFY(db->saveTile(QStringLiteral("pin_shared"), QStringLiteral("png"), shared, QStringLiteral("T"),
+                         QGCTileCacheDatabase::kInvalidTileSet));
+    QVERIFY(db->saveTile(QStringLiteral("pin_shared"), QStringLiteral("png"), shared, QStringLiteral("T"), setID));
+    QVERIFY(db->saveTile(QStringLiteral("pin_default"), QStringLiteral("png"), loose, QStringLiteral("T"),
+                         QGCTileCacheDatabase::kInvalidTileSet));
+
+    TotalsResult totals = db->computeTotals();
+    QCOMPARE(totals.totalCount, static_cast<quint32>(2));
+    QCOMPARE(totals.totalSize, static_cast<quint64>(50));
+    QCOMPARE(totals.defaultCount, static_cast<quint32>(1));
+    QCOMPARE(totals.defaultSize, static_cast<quint64>(10));
+
+    // A tile held by an offline set is never evicted
+    QVERIFY(db->pruneCache(1000));
+    QVERIFY(db->findTile(QStringLiteral("pin_shared")).has_value());
+    QVERIFY(!db->findTile(QStringLiteral("pin_default")).has_value());
+
+    totals = db->computeTotals();
+    QCOMPARE(totals.totalCount, static_cast<quint32>(1));
+    QCOMPARE(totals.totalSize, static_cast<quint64>(40));
+    QCOMPARE(totals.defaultCount, static_cast<quint32>(0));
+
+    // Once the set is gone the tile is only cached and becomes evictable again
+    QVERIFY(db->deleteTileSet(setID));
+    totals = db->computeTotals();
+    QCOMPARE(totals.totalCount, static_cast<quint32>(1));
+    QCOMPARE(totals.defaultCount, static_cast<quint32>(1));
+    QCOMPARE(totals.defaultSize, static_cast<quint64>(40));
+
+    QVERIFY(db->pruneCache(1000));
+    totals = db->computeTotals();
+    QCOMPARE(totals.totalCount, static_cast<quint32>(0));
+    QCOMPARE(totals.totalSize, static_cast<quint64>(0));
+    QCOMPARE(totals.defaultCount, static_cast<quint32>(0));
+}
+
+void QGCTileCacheDatabaseTest::_testSchemaVersionMigratesV2()
+{
+    const QString path = tempPath("v2.db");
+
+    {
+        QSqlDatabase v2 = QSqlDatabase::addDatabase("QSQLITE", "v2_setup");
+        v2.setDatabaseName(path);
+        QVERIFY(v2.open());
+        QSqlQuery q(v2);
+        QVERIFY(q.exec("CREATE TABLE Tiles (tileID INTEGER PRIMARY KEY NOT NULL, hash TEXT NOT NULL UNIQUE, format TEXT "
+                       "NOT NULL, tile BLOB NULL, size INTEGER, type INTEGER, date INTEGER DEFAULT 0)"));
+        QVERIFY(q.exec("CREATE TABLE TileSets (setID INTEGER PRIMARY KEY NOT NULL, name TEXT NOT NULL UNIQUE, typeStr "
+                       "TEXT, topleftLat REAL DEFAULT 0.0, topleftLon REAL DEFAULT 0.0, bottomRightLat REAL DEFAULT 0.0, "
+                       "bottomRightLon REAL DEFAULT 0.0, minZoom INTEGER DEFAULT 3, maxZoom INTEGER DEFAULT 3, type "
+                       "INTEGER DEFAULT -1, numTiles INTEGER DEFAULT 0, defaultSet INTEGER DEFAULT 0, date INTEGER "
+                       "DEFAULT 0)"));
+        QVERIFY(q.exec("CREATE TABLE SetTiles (setID INTEGER NOT NULL, tileID INTEGER NOT NULL)"));
+        QVERIFY(q.exec("CREATE INDEX idx_tiles_date ON Tiles(date)"));
+        QVERIFY(q.exec("INSERT INTO TileSets(setID, name, defaultSet) VALUES(1, 'Default Tile Set', 1)"));
+        QVERIFY(q.exec("INSERT INTO TileSets(setID, name, defaultSet) VALUES(2, 'Offline', 0)"));
+        QVERIFY(q.exec("INSERT INTO Tiles(tileID, hash, format, tile, size, type, date) VALUES(1, 'v2_cached', 'png', "
+                       "X'AA', 5, 0, 10)"));
+        QVERIFY(q.exec("INSERT INTO Tiles(tileID, hash, format, tile, size, type, date) VALUES(2, 'v2_offline', 'png', "
+                       "X'BB', 7, 0, 20)"));
+        QVERIFY(q.exec("INSERT INTO SetTiles(setID, tileID) VALUES(1, 1)"));
+        QVERIFY(q.exec("INSERT INTO SetTiles(setID, tileID) VALUES(1, 2)"));
+        QVERIFY(q.exec("INSERT INTO SetTiles(setID, tileID) VALUES(2, 2)"));
+        QVERIFY(q.exec("PRAGMA user_version = 2"));
+        v2.close();
+    }
+    QSqlDatabase::removeDatabase("v2_setup");
+
+    QGCTileCacheDatabase db(path);
+    QVERIFY(db.init());
+    QVERIFY(db.connectDB());
+
+    {
+        QSqlQuery query(db.database());
+        QVERIFY(query.exec("PRAGMA user_version"));
+        QVERIFY(query.next());
+        QCOMPARE(query.value(0).toInt(), QGCTileCacheDatabase::kSchemaVersion);
+        QVERIFY(query.exec("SELECT lastAccess FROM Tiles WHERE hash = 'v2_cached'"));
+        QVERIFY(query.next());
+        QCOMPARE(query.value(0).toLongLong(), 10);
+    }
+
+    const TotalsResult totals = db.computeTotals();
+    QCOMPARE(totals.totalCount, static_cast<quint32>(2));
+    QCOMPARE(totals.totalSize, static_cast<quint64>(12));
+    QCOMPARE(totals.defaultCount, static_cast<quint32>(1));
+    QCOMPARE(totals.defaultSize, static_cast<quint64>(5));
+
+    QVERIFY(db.pruneCache(1000));
+    QVERIFY(!db.findTile(QStringLiteral("v2_cached")).has_value());
+    QVERIFY(db.findTile(QStringLiteral("v2_offline")).has_value());
+}
+
 UT_REGISTER_TEST(QGCTileCacheDatabaseTest, TestLabel::Unit)
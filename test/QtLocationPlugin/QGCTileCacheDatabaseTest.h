@@ -54,6 +54,13 @@ private slots:
     void _testTilesDownloadTableColumns();
     void _testIndexesExist();
     void _testForeignKeyCascadeDelete();
+    void _testCreateTileSetStoresRanges();
+    void _testGetTileDownloadListWalksRanges();
+    void _testGetTileDownloadListBoundsRangeWalk();
+    void _testSchemaVersionMigratesV1();
+    void _testPruneCacheLeastRecentlyUsed();
+    void _testCacheStatsTrackPinnedTiles();
+    void _testSchemaVersionMigratesV2();
 
 private:
     std::unique_ptr<QGCTileCacheDatabase> _createInitializedDB();
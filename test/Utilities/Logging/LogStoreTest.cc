@@ -1,8 +1,12 @@
 #include "LogStoreTest.h"
 
+#include <QtSql/QSqlDatabase>
+#include <QtSql/QSqlQuery>
 #include <QtTest/QSignalSpy>
 #include <QtTest/QTest>
 
+#include <memory>
+
 #include "UnitTestList.h"
 
 #include "LogEntry.h"
@@ -19,6 +23,58 @@ static void appendAndWait(LogStore* store, const QList<LogEntry>& entries)
     QTRY_VERIFY_WITH_TIMEOUT(store->entryCount() >= before + entries.size(), TestTimeout::shortMs());
 }
 
+/// Writes a log database the way a build without the search and session indexes left it
+static bool createUnindexedStore(const QString& dbPath, const QString& sessionId, int rowCount)
+{
+    const QString connName = QStringLiteral("LogStoreTest_unindexed");
+    bool ok = false;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), connName);
+        db.setDatabaseName(dbPath);
+        if (db.open()) {
+            QSqlQuery q(db);
+            ok = q.exec(QStringLiteral("CREATE TABLE log_entries ("
+                                       "  id INTEGER PRIMARY KEY AUTOINCREMENT,"
+                                       "  session_id TEXT NOT NULL,"
+                                       "  timestamp INTEGER NOT NULL,"
+                                       "  level INTEGER NOT NULL,"
+                                       "  category TEXT,"
+                                       "  message TEXT,"
+                                       "  file TEXT,"
+                                       "  function TEXT,"
+                                       "  line INTEGER DEFAULT 0,"
+                                       "  formatted TEXT"
+                                       ")"));
+
+            static const QStringList categories = {
+                QStringLiteral("Vehicle.Link"), QStringLiteral("MAVLink.Protocol"), QStringLiteral("Comms.Serial"),
+                QStringLiteral("FactSystem.Fact"), QStringLiteral("Utilities.LogStore"),
+            };
+            static const QStringList words = {
+                QStringLiteral("heartbeat"), QStringLiteral("timeout"), QStringLiteral("param"), QStringLiteral("ack"),
+                QStringLiteral("retry"), QStringLiteral("link"), QStringLiteral("lost"), QStringLiteral("connected"),
+            };
+
+            ok = ok && db.transaction();
+            q.prepare(QStringLiteral("INSERT INTO log_entries (session_id, timestamp, level, category, message) VALUES (?, ?, ?, ?, ?)"));
+            for (int i = 0; ok && i < rowCount; ++i) {
+                q.addBindValue(sessionId);
+                q.addBindValue(static_cast<qint64>(i));
+                q.addBindValue(i % 5);
+                q.addBindValue(categories[i % categories.size()]);
+                q.addBindValue(QStringLiteral("%1 %2 %3 seq %4")
+                                   .arg(words[i % words.size()], words[(i / 3) % words.size()], words[(i / 7) % words.size()])
+                                   .arg(i));
+                ok = q.exec();
+            }
+            ok = ok && db.commit();
+        }
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(connName);
+    return ok;
+}
+
 void LogStoreTest::_openAndClose()
 {
     LogStore* store = openStore();
@@ -159,4 +215,149 @@ void LogStoreTest::_exportSessionEmpty()
     QVERIFY(!QFile::exists(exportPath));
 }
 
+
+void LogStoreTest::_fullTextFilters()
+{
+    LogStore* store = openStore();
+    QVERIFY(store);
+    QVERIFY(store->isFullTextSearchAvailable());
+
+    appendAndWait(store, {
+        makeEntry(QStringLiteral("Heartbeat lost on link 1"), LogEntry::Warning, QStringLiteral("Vehicle.Link")),
+        makeEntry(QStringLiteral("param \"SYSID\" 50% done"), LogEntry::Info, QStringLiteral("FactSystem.Param")),
+        makeEntry(QStringLiteral("heartbeat restored"), LogEntry::Info, QStringLiteral("Vehicle.Link")),
+    });
+
+    LogStore::QueryParams params;
+    params.sessionId = store->sessionId();
+
+    // Substring, case-insensitive, same as the LIKE filter
+    params.textFilter = QStringLiteral("HEARTBEAT");
+    auto results = store->query(params);
+    QCOMPARE(results.size(), 2);
+    QCOMPARE(results[0].message, QStringLiteral("Heartbeat lost on link 1"));
+
+    params.textFilter = QStringLiteral("eartbea");
+    QCOMPARE(store->query(params).size(), 2);
+
+    // Query syntax characters are matched literally
+    params.textFilter = QStringLiteral("\"SYSID\" 50%");
+    results = store->query(params);
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results[0].category, QStringLiteral("FactSystem.Param"));
+
+    // Category and text combine
+    params.textFilter = QStringLiteral("heartbeat");
+    params.category = QStringLiteral("link");
+    params.minLevel = LogEntry::Warning;
+    QCOMPARE(store->query(params).size(), 1);
+
+    // Terms shorter than a trigram fall back to LIKE
+    params.textFilter = QStringLiteral("1");
+    params.category = QStringLiteral("Li");
+    params.minLevel = LogEntry::Debug;
+    results = store->query(params);
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results[0].message, QStringLiteral("Heartbeat lost on link 1"));
+}
+
+void LogStoreTest::_rankedSearch()
+{
+    LogStore* store = openStore();
+    QVERIFY(store);
+
+    appendAndWait(store, {
+        makeEntry(QStringLiteral("a long message which mentions timeout only once among many other words")),
+        makeEntry(QStringLiteral("timeout timeout")),
+        makeEntry(QStringLiteral("nothing to see")),
+    });
+
+    LogStore::QueryParams params;
+    params.sessionId = store->sessionId();
+    params.textFilter = QStringLiteral("timeout");
+
+    auto results = store->query(params);
+    QCOMPARE(results.size(), 2);
+    QVERIFY(results[0].message.startsWith(QStringLiteral("a long")));
+
+    params.rankByRelevance = true;
+    results = store->query(params);
+    QCOMPARE(results.size(), 2);
+    QCOMPARE(results[0].message, QStringLiteral("timeout timeout"));
+
+    // Pagination walks the ranked order
+    params.limit = 1;
+    params.offset = 1;
+    results = store->query(params);
+    QCOMPARE(results.size(), 1);
+    QVERIFY(results[0].message.startsWith(QStringLiteral("a long")));
+}
+
+void LogStoreTest::_sessionIndex()
+{
+    LogStore* store = openStore();
+    QVERIFY(store);
+
+    populateStore(store, 25);
+    store->flush();
+    QTRY_COMPARE_WITH_TIMEOUT(store->entryCount(), 25, TestTimeout::shortMs());
+    appendAndWait(store, {makeEntry(QStringLiteral("last"))});
+
+    QCOMPARE(store->sessions(), QStringList{store->sessionId()});
+    QCOMPARE(store->sessionEntryCount(store->sessionId()), 26);
+    QCOMPARE(store->sessionEntryCount(QStringLiteral("nonexistent")), 0);
+
+    QVERIFY(store->deleteSession(store->sessionId()));
+    QVERIFY(store->sessions().isEmpty());
+
+    LogStore::QueryParams params;
+    params.textFilter = QStringLiteral("last");
+    QVERIFY(store->query(params).isEmpty());
+}
+
+void LogStoreTest::_existingDatabaseIndexed()
+{
+    const QString oldSession = QStringLiteral("oldsess1");
+    QVERIFY(createUnindexedStore(tempPath(QStringLiteral("existing.db")), oldSession, 100));
+
+    LogStore* store = openStore(QStringLiteral("existing.db"));
+    QVERIFY(store);
+
+    QVERIFY(store->sessions().contains(oldSession));
+    QCOMPARE(store->sessionEntryCount(oldSession), 100);
+
+    appendAndWait(store, {makeEntry(QStringLiteral("new heartbeat"))});
+    const QStringList sessions = store->sessions();
+    QCOMPARE(sessions, (QStringList{oldSession, store->sessionId()}));
+
+    LogStore::QueryParams params;
+    params.textFilter = QStringLiteral("seq 42");
+    const auto results = store->query(params);
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results[0].category, QStringLiteral("Comms.Serial"));
+}
+
+void LogStoreTest::_searchBenchmark()
+{
+    constexpr int kRowCount = 100000;
+    QVERIFY(createUnindexedStore(tempPath(QStringLiteral("benchmark.db")), QStringLiteral("benchsess"), kRowCount));
+
+    // Opening indexes every existing row, allow for that on slow machines
+    auto store = std::make_unique<LogStore>();
+    store->open(tempPath(QStringLiteral("benchmark.db")));
+    QVERIFY(waitForStoreOpen(store.get(), TestTimeout::longMs()));
+    QCOMPARE(store->sessionEntryCount(QStringLiteral("benchsess")), kRowCount);
+
+    LogStore::QueryParams params;
+    params.category = QStringLiteral("LogStore");
+    params.textFilter = QStringLiteral("seq 1999");
+    params.limit = 100;
+
+    QList<LogEntry> results;
+    QBENCHMARK {
+        results = store->query(params);
+    }
+    QVERIFY(!results.isEmpty());
+}
+
 UT_REGISTER_TEST(LogStoreTest, TestLabel::Unit, TestLabel::Utilities)
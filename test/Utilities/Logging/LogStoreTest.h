@@ -15,4 +15,9 @@ private slots:
     void _exportSession();
     void _entryCount();
     void _exportSessionEmpty();
+    void _fullTextFilters();
+    void _rankedSearch();
+    void _sessionIndex();
+    void _existingDatabaseIndexed();
+    void _searchBenchmark();
 };
@@ -8,6 +8,7 @@
 #include "FTPManager.h"
 #include "MockLinkFTP.h"
 #include "MultiVehicleManager.h"
+#include "QGCMath.h"
 #include "UnitTest.h"
 #include "Vehicle.h"
 const FTPManagerTest::TestCase_t FTPManagerTest::_rgTestCases[] = {
@@ -47,6 +48,8 @@ void FTPManagerTest::_sizeTestCaseWorker(int fileSize)
     // void downloadComplete   (const QString& file, const QString& errorMsg);
     QList<QVariant> arguments = spyDownloadComplete.takeFirst();
     QVERIFY(arguments[1].toString().isEmpty());
+    QCOMPARE(ftpManager->transferStats().bytesTransferred, static_cast<uint32_t>(fileSize));
+    QCOMPARE(ftpManager->transferStats().retransmits, 0u);
     _verifyFileSizeAndDelete(arguments[0].toString(), fileSize);
     _disconnectMockLink();
 }
@@ -105,6 +108,8 @@ void FTPManagerTest::_testLostPackets()
     // void downloadComplete   (const QString& file, const QString& errorMsg);
     QList<QVariant> arguments = spyDownloadComplete.takeFirst();
     QVERIFY(arguments[1].toString().isEmpty());
+    // Gap filling reads can complete out of order, but every byte must be accounted for exactly once
+    QCOMPARE(ftpManager->transferStats().bytesTransferred, static_cast<uint32_t>(fileSize));
     _verifyFileSizeAndDelete(arguments[0].toString(), fileSize);
     _disconnectMockLink();
 }
@@ -280,4 +285,235 @@ void FTPManagerTest::_testUpload()
     _disconnectMockLink();
 }
 
+void FTPManagerTest::_testQueuedUpload()
+{
+    _connectMockLinkNoInitialConnectSequence();
+    _mockLink->mockLinkFTP()->clearUploadedFiles();
+    FTPManager* ftpManager = _vehicle->ftpManager();
+    const QString tempDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
+    const int fileSize = 4 * 1024;
+    const QString filename = QStringLiteral("%1%2").arg(MockLinkFTP::sizeFilenamePrefix).arg(fileSize);
+    const QString remotePath(QStringLiteral("/mock/upload/queued.bin"));
+    const QByteArray payload(300, 'q');
+    QTemporaryFile tempFile;
+    QVERIFY(tempFile.open());
+    QCOMPARE(tempFile.write(payload), static_cast<qint64>(payload.size()));
+    tempFile.close();
+
+    // A running download makes a direct upload fail, the queued one waits for it instead
+    QSignalSpy spyDownloadComplete(ftpManager, &FTPManager::downloadComplete);
+    QVERIFY(ftpManager->download(MAV_COMP_ID_AUTOPILOT1, filename, tempDir));
+    QVERIFY(!ftpManager->upload(MAV_COMP_ID_AUTOPILOT1, remotePath, tempFile.fileName()));
+
+    QObject context;
+    bool uploadCalled = false;
+    QString uploadedPath;
+    QString uploadError;
+    ftpManager->queueUpload(FTPManager::Priority::Interactive, &context,
+        [&](const QString& path, const QString& errorMsg) {
+            QCOMPARE(spyDownloadComplete.count(), 1);
+            uploadCalled = true;
+            uploadedPath = path;
+            uploadError = errorMsg;
+        },
+        MAV_COMP_ID_AUTOPILOT1, remotePath, tempFile.fileName());
+    QCOMPARE(ftpManager->queuedOperationCount(), 1);
+
+    QVERIFY_TRUE_WAIT(uploadCalled, TestTimeout::longMs());
+    QVERIFY2(uploadError.isEmpty(), qPrintable(uploadError));
+    QCOMPARE(uploadedPath, remotePath);
+    QCOMPARE(_mockLink->mockLinkFTP()->uploadedFileContents(remotePath), payload);
+    _verifyFileSizeAndDelete(spyDownloadComplete.first()[0].toString(), fileSize);
+    _mockLink->mockLinkFTP()->clearUploadedFiles();
+    _disconnectMockLink();
+}
+
+void FTPManagerTest::_testQueuedOperationPriority()
+{
+    _connectMockLinkNoInitialConnectSequence();
+    FTPManager* ftpManager = _vehicle->ftpManager();
+    const QString tempDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
+    const int fileSize = 4 * 1024;
+    const QString filename = QStringLiteral("%1%2").arg(MockLinkFTP::sizeFilenamePrefix).arg(fileSize);
+
+    // Keep the manager busy so the queued operations have to wait
+    QSignalSpy spyDownloadComplete(ftpManager, &FTPManager::downloadComplete);
+    QVERIFY(ftpManager->download(MAV_COMP_ID_AUTOPILOT1, filename, tempDir));
+    QVERIFY(ftpManager->busy());
+
+    QObject context;
+    QStringList completionOrder;
+    QString bulkFile;
+    QString bulkError = QStringLiteral("not called");
+    ftpManager->queueDownload(FTPManager::Priority::Bulk, &context,
+        [&](const QString& file, const QString& errorMsg) {
+            completionOrder.append(QStringLiteral("bulk"));
+            bulkFile = file;
+            bulkError = errorMsg;
+        },
+        MAV_COMP_ID_AUTOPILOT1, filename, tempDir, QStringLiteral("queued_bulk"));
+    QStringList dirList;
+    ftpManager->queueListDirectory(FTPManager::Priority::Interactive, &context,
+        [&](const QStringList& entries, const QString& errorMsg) {
+            completionOrder.append(QStringLiteral("list"));
+            QVERIFY(errorMsg.isEmpty());
+            dirList = entries;
+        },
+        MAV_COMP_ID_AUTOPILOT1, QStringLiteral("/"));
+    QCOMPARE(ftpManager->queuedOperationCount(), 2);
+
+    QVERIFY_TRUE_WAIT(completionOrder.count() == 2, TestTimeout::longMs());
+    QCOMPARE(completionOrder, QStringList({ QStringLiteral("list"), QStringLiteral("bulk") }));
+    QVERIFY(!dirList.isEmpty());
+    QVERIFY2(bulkError.isEmpty(), qPrintable(bulkError));
+    _verifyFileSizeAndDelete(bulkFile, fileSize);
+
+    // Direct download plus the queued one, each signalled once
+    QCOMPARE(spyDownloadComplete.count(), 2);
+    _verifyFileSizeAndDelete(spyDownloadComplete.first()[0].toString(), fileSize);
+    _disconnectMockLink();
+}
+
+void FTPManagerTest::_testBulkDownloadPreempted()
+{
+    _connectMockLinkNoInitialConnectSequence();
+    FTPManager* ftpManager = _vehicle->ftpManager();
+    const QString tempDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
+    const int fileSize = 64 * 1024;
+    const QString filename = QStringLiteral("%1%2").arg(MockLinkFTP::sizeFilenamePrefix).arg(fileSize);
+
+    QObject context;
+    QStringList completionOrder;
+    QString bulkFile;
+    QString bulkError = QStringLiteral("not called");
+    ftpManager->queueDownload(FTPManager::Priority::Bulk, &context,
+        [&](const QString& file, const QString& errorMsg) {
+            completionOrder.append(QStringLiteral("bulk"));
+            bulkFile = file;
+            bulkError = errorMsg;
+        },
+        MAV_COMP_ID_AUTOPILOT1, filename, tempDir, QStringLiteral("preempted_bulk"));
+
+    // Ask for the listing once part of the file is on disk
+    bool listQueued = false;
+    QString listError = QStringLiteral("not called");
+    (void) connect(ftpManager, &FTPManager::commandProgress, &context, [&](float /*value*/) {
+        if (listQueued) {
+            return;
+        }
+        listQueued = true;
+        ftpManager->queueListDirectory(FTPManager::Priority::Interactive, &context,
+            [&](const QStringList& /*entries*/, const QString& errorMsg) {
+                completionOrder.append(QStringLiteral("list"));
+                listError = errorMsg;
+            },
+            MAV_COMP_ID_AUTOPILOT1, QStringLiteral("/"));
+    });
+
+    // The listing runs first, then the download picks up where it stopped
+    QVERIFY_TRUE_WAIT(completionOrder.count() == 2, TestTimeout::longMs());
+    QCOMPARE(completionOrder, QStringList({ QStringLiteral("list"), QStringLiteral("bulk") }));
+    QVERIFY2(listError.isEmpty(), qPrintable(listError));
+    QVERIFY2(bulkError.isEmpty(), qPrintable(bulkError));
+    _verifyFileSizeAndDelete(bulkFile, fileSize);
+    _disconnectMockLink();
+}
+
+void FTPManagerTest::_testGapFillWindowAdaptation()
+{
+    FTPManager::DownloadState_t state;
+    state.reset();
+    state.fillWindow = FTPManager::_initialFillWindow;
+
+    // Grows by one for each full window of acks
+    for (int i = 0; i < FTPManager::_initialFillWindow - 1; i++) {
+        state.fillAcked();
+    }
+    QCOMPARE(state.fillWindow, FTPManager::_initialFillWindow);
+    state.fillAcked();
+    QCOMPARE(state.fillWindow, FTPManager::_initialFillWindow + 1);
+    QCOMPARE(state.fillAcksInWindow, 0);
+
+    // Never past the maximum
+    for (int i = 0; i < 1000; i++) {
+        state.fillAcked();
+    }
+    QCOMPARE(state.fillWindow, FTPManager::_maxFillWindow);
+
+    // Halves on timeout and starts counting acks again
+    state.fillAcked();
+    state.fillTimedOut();
+    QCOMPARE(state.fillWindow, FTPManager::_maxFillWindow / 2);
+    QCOMPARE(state.fillAcksInWindow, 0);
+
+    // Never below a single outstanding read
+    for (int i = 0; i < 10; i++) {
+        state.fillTimedOut();
+    }
+    QCOMPARE(state.fillWindow, 1);
+    state.fillAcked();
+    QCOMPARE(state.fillWindow, 2);
+}
+
+void FTPManagerTest::_testCancelQueuedOperations()
+{
+    _connectMockLinkNoInitialConnectSequence();
+    FTPManager* ftpManager = _vehicle->ftpManager();
+    _mockLink->mockLinkFTP()->setErrorMode(MockLinkFTP::errModeNoResponse);
+
+    QSignalSpy spyListDirectoryComplete(ftpManager, &FTPManager::listDirectoryComplete);
+    QVERIFY(ftpManager->listDirectory(MAV_COMP_ID_AUTOPILOT1, "/"));
+
+    QObject context;
+    QString queuedError;
+    ftpManager->queueDownload(FTPManager::Priority::Normal, &context,
+        [&](const QString& /*file*/, const QString& errorMsg) { queuedError = errorMsg; },
+        MAV_COMP_ID_AUTOPILOT1, QStringLiteral("/general.json"), QStandardPaths::writableLocation(QStandardPaths::TempLocation));
+    QCOMPARE(ftpManager->queuedOperationCount(), 1);
+
+    ftpManager->cancelQueuedOperations(&context);
+    QCOMPARE(ftpManager->queuedOperationCount(), 0);
+    QVERIFY(!queuedError.isEmpty());
+
+    // Operation which was not queued by the context is left running
+    QVERIFY(ftpManager->busy());
+    QVERIFY_SIGNAL_WAIT(spyListDirectoryComplete, TestTimeout::longMs());
+    _disconnectMockLink();
+}
+
+void FTPManagerTest::_testCalcFileCRC32()
+{
+    _connectMockLinkNoInitialConnectSequence();
+    FTPManager* ftpManager = _vehicle->ftpManager();
+
+    QSignalSpy spyDownloadComplete(ftpManager, &FTPManager::downloadComplete);
+    QVERIFY(ftpManager->download(MAV_COMP_ID_AUTOPILOT1, QStringLiteral("/general.json"), QStandardPaths::writableLocation(QStandardPaths::TempLocation)));
+    QVERIFY_SIGNAL_WAIT(spyDownloadComplete, TestTimeout::longMs());
+    const QList<QVariant> downloadArguments = spyDownloadComplete.takeFirst();
+    QVERIFY(downloadArguments[1].toString().isEmpty());
+
+    QFile downloadFile(downloadArguments[0].toString());
+    QVERIFY(downloadFile.open(QIODevice::ReadOnly));
+    const QByteArray bytes = downloadFile.readAll();
+    downloadFile.close();
+    (void) downloadFile.remove();
+    const uint32_t localCRC32 = QGC::crc32(reinterpret_cast<const uint8_t*>(bytes.constData()), static_cast<unsigned>(bytes.size()), 0);
+
+    // void calcFileCRC32Complete(const QString& file, uint32_t crc32, const QString& errorMsg);
+    QSignalSpy spyCRC32Complete(ftpManager, &FTPManager::calcFileCRC32Complete);
+    QVERIFY(ftpManager->calcFileCRC32(MAV_COMP_ID_AUTOPILOT1, QStringLiteral("/general.json")));
+    QVERIFY_SIGNAL_WAIT(spyCRC32Complete, TestTimeout::longMs());
+    QList<QVariant> arguments = spyCRC32Complete.takeFirst();
+    QVERIFY2(arguments[2].toString().isEmpty(), qPrintable(arguments[2].toString()));
+    QCOMPARE(arguments[1].toUInt(), localCRC32);
+
+    // Unknown files are reported as errors
+    QVERIFY(ftpManager->calcFileCRC32(MAV_COMP_ID_AUTOPILOT1, QStringLiteral("/bogus")));
+    QVERIFY_SIGNAL_WAIT(spyCRC32Complete, TestTimeout::longMs());
+    arguments = spyCRC32Complete.takeFirst();
+    QVERIFY(!arguments[2].toString().isEmpty());
+
+    _disconnectMockLink();
+}
+
 UT_REGISTER_TEST(FTPManagerTest, TestLabel::Integration, TestLabel::Vehicle, TestLabel::Serial)
@@ -21,6 +21,12 @@ private slots:
     void _testListDirectoryBadSequence();
     void _testListDirectoryCancel();
     void _testUpload();
+    void _testQueuedUpload();
+    void _testQueuedOperationPriority();
+    void _testBulkDownloadPreempted();
+    void _testGapFillWindowAdaptation();
+    void _testCancelQueuedOperations();
+    void _testCalcFileCRC32();
 
     // Overrides from UnitTest
     void cleanup() override;
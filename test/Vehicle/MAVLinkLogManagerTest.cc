@@ -1,12 +1,91 @@
 #include "MAVLinkLogManagerTest.h"
 
+#include <QtCore/QFile>
 #include <QtCore/QStandardPaths>
+#include <QtCore/QTemporaryDir>
 
+#include "MAVLinkLib.h"
 #include "MAVLinkLogManager.h"
 #include "MultiVehicleManager.h"
 #include "UnitTest.h"
 #include "Vehicle.h"
 
+namespace {
+
+struct LoggingDataPacket {
+    uint16_t sequence;
+    uint8_t firstMessage;
+    QByteArray data;
+};
+
+constexpr int kUlogHeaderSize = 16;
+
+/// ULog header followed by data messages of varying length, some longer than a LOGGING_DATA payload
+QByteArray makeUlogStream(int messageCount)
+{
+    QByteArray stream;
+    const char header[kUlogHeaderSize] = { 'U', 'L', 'o', 'g', 0x01, 0x12, 0x35, 0x01, 0, 0, 0, 0, 0, 0, 0, 0 };
+    (void) stream.append(header, kUlogHeaderSize);
+
+    for (int i = 0; i < messageCount; i++) {
+        const int payloadSize = 20 + ((i * 37) % 400);
+        (void) stream.append(static_cast<char>(payloadSize & 0xFF));
+        (void) stream.append(static_cast<char>(payloadSize >> 8));
+        (void) stream.append('D');
+        for (int j = 0; j < payloadSize; j++) {
+            (void) stream.append(static_cast<char>((i + j) & 0xFF));
+        }
+    }
+
+    return stream;
+}
+
+/// Splits a ULog stream into LOGGING_DATA payloads the same way the PX4 mavlink logger does
+QList<LoggingDataPacket> makeCapture(const QByteArray &stream)
+{
+    QList<qsizetype> messageStarts;
+    for (qsizetype pos = kUlogHeaderSize; pos < stream.size(); ) {
+        messageStarts.append(pos);
+        const uint8_t *const ptr = reinterpret_cast<const uint8_t*>(stream.constData() + pos);
+        pos += ptr[0] + (ptr[1] * 256) + 3;
+    }
+
+    QList<LoggingDataPacket> capture;
+    uint16_t sequence = 0;
+    qsizetype pos = 0;
+    int nextStart = 0;
+    while (pos < stream.size()) {
+        const qsizetype len = qMin<qsizetype>(MAVLINK_MSG_LOGGING_DATA_FIELD_DATA_LEN, stream.size() - pos);
+        while ((nextStart < messageStarts.size()) && (messageStarts[nextStart] < pos)) {
+            nextStart++;
+        }
+
+        uint8_t firstMessage = 255;
+        if (pos == 0) {
+            // The processor strips the header before applying the offset
+            firstMessage = 0;
+        } else if ((nextStart < messageStarts.size()) && (messageStarts[nextStart] < (pos + len))) {
+            firstMessage = static_cast<uint8_t>(messageStarts[nextStart] - pos);
+        }
+
+        capture.append({ sequence++, firstMessage, stream.mid(pos, len) });
+        pos += len;
+    }
+
+    return capture;
+}
+
+QByteArray readFile(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+} // namespace
+
 void MAVLinkLogManagerTest::_testInitMAVLinkLogManager()
 {
     _connectMockLinkNoInitialConnectSequence();
@@ -16,4 +95,77 @@ void MAVLinkLogManagerTest::_testInitMAVLinkLogManager()
     QVERIFY(mavlinkLogManager);
 }
 
+void MAVLinkLogManagerTest::_testStreamReassembly()
+{
+    _connectMockLinkNoInitialConnectSequence();
+    MAVLinkLogManager* const mavlinkLogManager = new MAVLinkLogManager(MultiVehicleManager::instance()->activeVehicle(), this);
+    QTemporaryDir* const tempDir = createTempDir();
+    QVERIFY(tempDir);
+
+    const QByteArray stream = makeUlogStream(500);
+    const QList<LoggingDataPacket> capture = makeCapture(stream);
+
+    MAVLinkLogProcessor processor;
+    QVERIFY(processor.create(mavlinkLogManager, tempDir->path(), 1));
+    QVERIFY(processor.valid());
+    for (const LoggingDataPacket &packet : capture) {
+        QVERIFY(processor.processStreamData(packet.sequence, packet.firstMessage, packet.data));
+    }
+    processor.close();
+
+    QCOMPARE(processor.backlogDrops(), 0);
+    QCOMPARE(processor.pendingBytes(), qint64(0));
+    QCOMPARE(readFile(processor.fileName()), stream);
+}
+
+void MAVLinkLogManagerTest::_testStreamDropout()
+{
+    _connectMockLinkNoInitialConnectSequence();
+    MAVLinkLogManager* const mavlinkLogManager = new MAVLinkLogManager(MultiVehicleManager::instance()->activeVehicle(), this);
+    QTemporaryDir* const tempDir = createTempDir();
+    QVERIFY(tempDir);
+
+    const QByteArray stream = makeUlogStream(100);
+    QList<LoggingDataPacket> capture = makeCapture(stream);
+    QVERIFY(capture.count() > 10);
+    capture.removeAt(5);
+
+    MAVLinkLogProcessor processor;
+    QVERIFY(processor.create(mavlinkLogManager, tempDir->path(), 1));
+    for (const LoggingDataPacket &packet : capture) {
+        QVERIFY(processor.processStreamData(packet.sequence, packet.firstMessage, packet.data));
+    }
+    processor.close();
+
+    const QByteArray output = readFile(processor.fileName());
+    QVERIFY(output.startsWith(stream.left(kUlogHeaderSize)));
+    QVERIFY(output.size() < stream.size());
+
+    // Dropout message: size 2, type 'O', duration in ms
+    const char dropout[] = { 2, 0, 'O', 10, 0 };
+    QVERIFY(output.contains(QByteArray(dropout, sizeof(dropout))));
+}
+
+void MAVLinkLogManagerTest::_benchmarkStreamThroughput()
+{
+    _connectMockLinkNoInitialConnectSequence();
+    MAVLinkLogManager* const mavlinkLogManager = new MAVLinkLogManager(MultiVehicleManager::instance()->activeVehicle(), this);
+    QTemporaryDir* const tempDir = createTempDir();
+    QVERIFY(tempDir);
+
+    // Roughly 1 MB, a few seconds of high rate streamed logging
+    const QList<LoggingDataPacket> capture = makeCapture(makeUlogStream(5000));
+
+    int iteration = 0;
+    QBENCHMARK {
+        MAVLinkLogProcessor processor;
+        QVERIFY(processor.create(mavlinkLogManager, tempDir->path(), static_cast<uint8_t>(iteration++)));
+        for (const LoggingDataPacket &packet : capture) {
+            (void) processor.processStreamData(packet.sequence, packet.firstMessage, packet.data);
+        }
+        processor.close();
+        QCOMPARE(processor.backlogDrops(), 0);
+    }
+}
+
 UT_REGISTER_TEST(MAVLinkLogManagerTest, TestLabel::Integration, TestLabel::Vehicle)
@@ -8,4 +8,9 @@ class MAVLinkLogManagerTest : public VehicleTestManualConnect
 
 private slots:
     void _testInitMAVLinkLogManager();
+    void _testStreamReassembly();
+    void _testStreamDropout();
+
+    // Benchmarks (QBENCHMARK)
+    void _benchmarkStreamThroughput();
 };
@@ -0,0 +1,122 @@
+#include "TrajectoryPointsTest.h"
+#include "TrajectoryPoints.h"
+
+#include <QtTest/QSignalSpy>
+
+namespace {
+
+const QGeoCoordinate kOrigin(47.3977419, 8.5455938, 488.0);
+
+/// Feeds a zig-zag track, alternating north and east legs of the specified length
+void feedZigZag(TrajectoryPoints& trajectory, int legCount, double legLength)
+{
+    QGeoCoordinate coordinate = kOrigin;
+    trajectory._vehicleCoordinateChanged(coordinate);
+    for (int i = 0; i < legCount; i++) {
+        coordinate = coordinate.atDistanceAndAzimuth(legLength, (i % 2) ? 90.0 : 0.0);
+        trajectory._vehicleCoordinateChanged(coordinate);
+    }
+}
+
+} // namespace
+
+void TrajectoryPointsTest::_collinearPointsUpdateLast_test()
+{
+    TrajectoryPoints trajectory(nullptr);
+    QSignalSpy addedSpy(&trajectory, &TrajectoryPoints::pointAdded);
+    QSignalSpy updatedSpy(&trajectory, &TrajectoryPoints::updateLastPoint);
+
+    QGeoCoordinate coordinate = kOrigin;
+    trajectory._vehicleCoordinateChanged(coordinate);
+    for (int i = 0; i < 20; i++) {
+        coordinate = coordinate.atDistanceAndAzimuth(10.0, 45.0);
+        trajectory._vehicleCoordinateChanged(coordinate);
+    }
+
+    // Straight line collapses to its start and end point
+    QCOMPARE(trajectory.pointCount(0), 2);
+    const QVariantList points = trajectory.list(0);
+    QCOMPARE(points.count(), 2);
+    QVERIFY(points.last().value<QGeoCoordinate>().distanceTo(coordinate) < 0.05);
+
+    QVERIFY(updatedSpy.count() > 0);
+    QCOMPARE(addedSpy.count(), 2 * TrajectoryPoints::levelCount);
+}
+
+void TrajectoryPointsTest::_coarserLevelsHaveFewerPoints_test()
+{
+    TrajectoryPoints trajectory(nullptr);
+    feedZigZag(trajectory, 400, 5.0);
+
+    QCOMPARE(trajectory.pointCount(0), 401);
+    for (int level = 1; level < TrajectoryPoints::levelCount; level++) {
+        QVERIFY2(trajectory.pointCount(level) < trajectory.pointCount(level - 1), qPrintable(QStringLiteral("level %1").arg(level)));
+        QVERIFY(trajectory.pointCount(level) >= 2);
+    }
+
+    QVERIFY(trajectory.list(-1).isEmpty());
+    QVERIFY(trajectory.list(TrajectoryPoints::levelCount).isEmpty());
+}
+
+void TrajectoryPointsTest::_levelBudgetThinsOldPoints_test()
+{
+    TrajectoryPoints trajectory(nullptr);
+    QSignalSpy resetSpy(&trajectory, &TrajectoryPoints::pointsReset);
+
+    const int legCount = TrajectoryPoints::_maxLevelPoints + 100;
+    feedZigZag(trajectory, legCount, 5.0);
+
+    QVERIFY(trajectory.pointCount(0) <= TrajectoryPoints::_maxLevelPoints);
+    QVERIFY(resetSpy.count() > 0);
+    QCOMPARE(resetSpy.first().at(0).toInt(), 0);
+
+    // First and most recent points survive thinning
+    const QVariantList points = trajectory.list(0);
+    QVERIFY(points.first().value<QGeoCoordinate>().distanceTo(kOrigin) < 0.05);
+    QVERIFY(points.last().value<QGeoCoordinate>().distanceTo(trajectory._levels[0].lastPoint) < 0.05);
+}
+
+void TrajectoryPointsTest::_levelForZoom_test()
+{
+    TrajectoryPoints trajectory(nullptr);
+
+    QCOMPARE(trajectory.levelForZoom(20, kOrigin.latitude()), 0);
+    QCOMPARE(trajectory.levelForZoom(3, kOrigin.latitude()), TrajectoryPoints::levelCount - 1);
+
+    int previousLevel = trajectory.levelForZoom(20, kOrigin.latitude());
+    for (int zoom = 19; zoom >= 3; zoom--) {
+        const int level = trajectory.levelForZoom(zoom, kOrigin.latitude());
+        QVERIFY(level >= previousLevel);
+        previousLevel = level;
+    }
+}
+
+void TrajectoryPointsTest::_packedCoordinateRoundTrip_test()
+{
+    const QGeoCoordinate coordinate(-33.8567844, 151.2152967);
+    const QGeoCoordinate unpacked = TrajectoryPoints::_unpack(TrajectoryPoints::_pack(coordinate));
+
+    QCOMPARE_FUZZY(unpacked.latitude(), coordinate.latitude(), 1e-7);
+    QCOMPARE_FUZZY(unpacked.longitude(), coordinate.longitude(), 1e-7);
+}
+
+void TrajectoryPointsTest::_clear_test()
+{
+    TrajectoryPoints trajectory(nullptr);
+    QSignalSpy clearedSpy(&trajectory, &TrajectoryPoints::pointsCleared);
+
+    feedZigZag(trajectory, 20, 5.0);
+    QVERIFY(trajectory.pointCount(0) > 0);
+
+    trajectory.clear();
+    QCOMPARE(clearedSpy.count(), 1);
+    for (int level = 0; level < TrajectoryPoints::levelCount; level++) {
+        QCOMPARE(trajectory.pointCount(level), 0);
+    }
+
+    // Tracking starts over from the next position
+    trajectory._vehicleCoordinateChanged(kOrigin);
+    QCOMPARE(trajectory.pointCount(0), 1);
+}
+
+UT_REGISTER_TEST(TrajectoryPointsTest, TestLabel::Unit, TestLabel::Vehicle)
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class TrajectoryPointsTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _collinearPointsUpdateLast_test();
+    void _coarserLevelsHaveFewerPoints_test();
+    void _levelBudgetThinsOldPoints_test();
+    void _levelForZoom_test();
+    void _packedCoordinateRoundTrip_test();
+    void _clear_test();
+};
@@ -9,6 +9,7 @@ QGC_LOGGING_CATEGORY(GStreamerTestLog, "VideoManager.GStreamer.GStreamerTest")
 #include "GStreamer.h"
 #include "GStreamerHelpers.h"
 #include "GStreamerLogging.h"
+#include "GstVideoFrameBuffer.h"
 #include "GstVideoReceiver.h"
 
 #include <QtCore/QDir>
@@ -21,7 +22,6 @@ QGC_LOGGING_CATEGORY(GStreamerTestLog, "VideoManager.GStreamer.GStreamerTest")
 
 #ifdef Q_OS_MACOS
 #include "GstAppSinkAdapter.h"
-#include <QtMultimedia/QVideoFrame>
 #include <QtMultimedia/QVideoSink>
 #endif
 
@@ -448,6 +448,70 @@ void GStreamerTest::_testAppsinkFrameDelivery()
 #endif // Q_OS_MACOS
 }
 
+void GStreamerTest::_testVideoFrameBufferZeroCopy_data()
+{
+    QTest::addColumn<QString>("gstFormat");
+    QTest::addColumn<int>("pixelFormat");
+    QTest::addColumn<int>("planeCount");
+
+    QTest::newRow("NV12") << QStringLiteral("NV12") << static_cast<int>(QVideoFrameFormat::Format_NV12) << 2;
+    QTest::newRow("I420") << QStringLiteral("I420") << static_cast<int>(QVideoFrameFormat::Format_YUV420P) << 3;
+    QTest::newRow("BGRA") << QStringLiteral("BGRA") << static_cast<int>(QVideoFrameFormat::Format_BGRA8888) << 1;
+}
+
+void GStreamerTest::_testVideoFrameBufferZeroCopy()
+{
+    QFETCH(QString, gstFormat);
+    QFETCH(int, pixelFormat);
+    QFETCH(int, planeCount);
+
+    const QString description = QStringLiteral(
+        "videotestsrc num-buffers=1 ! video/x-raw,format=%1,width=320,height=240,framerate=30/1 ! "
+        "appsink name=sink sync=false").arg(gstFormat);
+    GstElement *pipeline = gst_parse_launch(qPrintable(description), nullptr);
+    QVERIFY2(pipeline, "Failed to create videotestsrc ! appsink pipeline");
+
+    GstElement *appsink = gst_bin_get_by_name(GST_BIN(pipeline), "sink");
+    QVERIFY(appsink);
+    QVERIFY(gst_element_set_state(pipeline, GST_STATE_PLAYING) != GST_STATE_CHANGE_FAILURE);
+
+    GstSample *sample = nullptr;
+    g_signal_emit_by_name(appsink, "pull-sample", &sample);
+    gst_object_unref(appsink);
+    if (!sample) {
+        gst_element_set_state(pipeline, GST_STATE_NULL);
+        gst_object_unref(pipeline);
+        QFAIL("appsink did not produce a sample");
+    }
+
+    GstBuffer *buffer = gst_buffer_ref(gst_sample_get_buffer(sample));
+    QVideoFrame frame = GstVideoFrameBuffer::createFrame(sample);
+    gst_sample_unref(sample);
+
+    QVERIFY(frame.isValid());
+    QCOMPARE(static_cast<int>(frame.pixelFormat()), pixelFormat);
+    QCOMPARE(frame.size(), QSize(320, 240));
+
+    // The frame must map the GstBuffer memory itself rather than a copy of it
+    GstMapInfo mapInfo;
+    QVERIFY(gst_buffer_map(buffer, &mapInfo, GST_MAP_READ));
+    QVERIFY(frame.map(QVideoFrame::ReadOnly));
+    QCOMPARE(frame.planeCount(), planeCount);
+    const uchar *frameData = frame.bits(0);
+    QVERIFY((frameData >= mapInfo.data) && (frameData < (mapInfo.data + mapInfo.size)));
+    frame.unmap();
+    gst_buffer_unmap(buffer, &mapInfo);
+
+    // Releasing the frame drops its reference on the buffer
+    const int refsWithFrame = GST_MINI_OBJECT_REFCOUNT_VALUE(buffer);
+    frame = QVideoFrame();
+    QCOMPARE(GST_MINI_OBJECT_REFCOUNT_VALUE(buffer), refsWithFrame - 1);
+
+    gst_buffer_unref(buffer);
+    gst_element_set_state(pipeline, GST_STATE_NULL);
+    gst_object_unref(pipeline);
+}
+
 #else
 
 void GStreamerTest::init() { UnitTest::init(); QSKIP("GStreamer not enabled"); }
@@ -464,6 +528,8 @@ void GStreamerTest::_testCreateVideoReceiver() { QSKIP("GStreamer not enabled");
 void GStreamerTest::_testPipelineSmokeTest() { QSKIP("GStreamer not enabled"); }
 void GStreamerTest::_testRuntimeVersionCheck() { QSKIP("GStreamer not enabled"); }
 void GStreamerTest::_testAppsinkFrameDelivery() { QSKIP("GStreamer not enabled"); }
+void GStreamerTest::_testVideoFrameBufferZeroCopy_data() { QSKIP("GStreamer not enabled"); }
+void GStreamerTest::_testVideoFrameBufferZeroCopy() { QSKIP("GStreamer not enabled"); }
 
 #endif
 
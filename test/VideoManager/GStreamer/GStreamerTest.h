@@ -22,4 +22,6 @@ private slots:
     void _testPipelineSmokeTest();
     void _testRuntimeVersionCheck();
     void _testAppsinkFrameDelivery();
+    void _testVideoFrameBufferZeroCopy_data();
+    void _testVideoFrameBufferZeroCopy();
 };
@@ -0,0 +1,99 @@
+#include "SubtitleWriterTest.h"
+#include "SubtitleWriter.h"
+
+#include <QtCore/QDataStream>
+
+namespace {
+
+SubtitleWriter::Layout testLayout()
+{
+    SubtitleWriter::Layout layout;
+    layout.size = QSize(640, 480);
+
+    SubtitleWriter::Field altitude;
+    altitude.name = QStringLiteral("Alt");
+    altitude.units = QStringLiteral("m");
+    altitude.type = FactMetaData::valueTypeDouble;
+    altitude.decimalPlaces = 1;
+    altitude.changeScale = 10.;
+    layout.fields.append(altitude);
+
+    SubtitleWriter::Field mode;
+    mode.name = QStringLiteral("Mode");
+    mode.type = FactMetaData::valueTypeString;
+    layout.fields.append(mode);
+
+    return layout;
+}
+
+} // namespace
+
+void SubtitleWriterTest::_testValuesDiffer()
+{
+    const SubtitleWriter::Layout layout = testLayout();
+    const SubtitleWriter::Field &altitude = layout.fields[0];
+
+    // Changes below the displayed precision do not produce a new entry
+    QVERIFY(!SubtitleWriter::valuesDiffer(altitude, 10.01, 10.04));
+    QVERIFY(SubtitleWriter::valuesDiffer(altitude, 10.01, 10.11));
+    QVERIFY(!SubtitleWriter::valuesDiffer(altitude, qQNaN(), qQNaN()));
+    QVERIFY(SubtitleWriter::valuesDiffer(altitude, qQNaN(), 10.));
+
+    QVERIFY(!SubtitleWriter::valuesDiffer(layout.fields[1], QStringLiteral("Hold"), QStringLiteral("Hold")));
+    QVERIFY(SubtitleWriter::valuesDiffer(layout.fields[1], QStringLiteral("Hold"), QStringLiteral("Land")));
+}
+
+void SubtitleWriterTest::_testSubtitleEntry()
+{
+    const SubtitleWriter::Layout layout = testLayout();
+    const QString entry = QString::fromUtf8(SubtitleWriter::formatSubtitleEntry(layout, { 12.34, QStringLiteral("Hold") }, 0, 2500));
+
+    QVERIFY(entry.contains(QStringLiteral("Dialogue: 0,0:00:00.0,0:00:02.5,Default")));
+    QVERIFY(entry.contains(QStringLiteral("Alt:")));
+    QVERIFY(entry.contains(QStringLiteral("12.3 m")));
+    QVERIFY(entry.contains(QStringLiteral("Hold")));
+    // Three columns with names and values plus the date
+    QCOMPARE(entry.count(QLatin1Char('\n')), 7);
+}
+
+void SubtitleWriterTest::_testTrackRecord()
+{
+    const SubtitleWriter::Layout layout = testLayout();
+
+    QByteArray header = SubtitleWriter::formatTrackHeader(layout);
+    QVERIFY(header.startsWith("QGCT"));
+    QDataStream headerStream(header.sliced(4));
+    headerStream.setVersion(QDataStream::Qt_6_0);
+    headerStream.setByteOrder(QDataStream::LittleEndian);
+    quint16 version = 0;
+    quint16 fieldCount = 0;
+    headerStream >> version >> fieldCount;
+    QCOMPARE(version, SubtitleWriter::kTrackVersion);
+    QCOMPARE(fieldCount, quint16(2));
+
+    // Only the mode changed, so the record holds only that field
+    const QByteArray record = SubtitleWriter::formatTrackRecord(layout, { 12.34, QStringLiteral("Hold") }, { 12.31, QStringLiteral("Land") }, 1500);
+    QDataStream stream(record);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    quint32 timeMs = 0;
+    quint16 changedCount = 0;
+    quint16 index = 0;
+    QString mode;
+    stream >> timeMs >> changedCount >> index >> mode;
+    QCOMPARE(timeMs, 1500u);
+    QCOMPARE(changedCount, quint16(1));
+    QCOMPARE(index, quint16(1));
+    QCOMPARE(mode, QStringLiteral("Land"));
+    QVERIFY(stream.atEnd());
+
+    // The first record holds every field
+    const QByteArray first = SubtitleWriter::formatTrackRecord(layout, {}, { 12.34, QStringLiteral("Hold") }, 0);
+    QDataStream firstStream(first);
+    firstStream.setVersion(QDataStream::Qt_6_0);
+    firstStream.setByteOrder(QDataStream::LittleEndian);
+    firstStream >> timeMs >> changedCount;
+    QCOMPARE(changedCount, quint16(2));
+}
+
+UT_REGISTER_TEST(SubtitleWriterTest, TestLabel::Unit)
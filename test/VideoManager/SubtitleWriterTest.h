@@ -0,0 +1,13 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class SubtitleWriterTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testValuesDiffer();
+    void _testSubtitleEntry();
+    void _testTrackRecord();
+};
@@ -0,0 +1,130 @@
+#include "VideoStreamStatsTest.h"
+#include "VideoStreamStats.h"
+
+#include <QtTest/QSignalSpy>
+
+namespace {
+
+constexpr qint64 kFrameIntervalNs = 33'333'333; // 30 fps
+
+} // namespace
+
+void VideoStreamStatsTest::_testFrameRates()
+{
+    VideoStreamStats stats;
+    QSignalSpy spy(&stats, &VideoStreamStats::statsChanged);
+
+    for (int i = 0; i < 30; i++) {
+        stats.noteDecodedFrame(i * kFrameIntervalNs);
+        if ((i % 2) == 0) {
+            stats.noteDisplayedFrame(i * kFrameIntervalNs);
+        }
+    }
+    stats.publish(30 * kFrameIntervalNs);
+
+    QCOMPARE(spy.count(), 1);
+    QVERIFY(qAbs(stats.decodeFps() - 30.) < 0.01);
+    QVERIFY(qAbs(stats.displayFps() - 15.) < 0.01);
+
+    // A stalled stream decays to zero on the next publish
+    stats.publish(60 * kFrameIntervalNs);
+    QCOMPARE(stats.decodeFps(), 0.);
+    QCOMPARE(stats.displayFps(), 0.);
+}
+
+void VideoStreamStatsTest::_testJitterHistogram()
+{
+    VideoStreamStats stats;
+    const QList<int> buckets = stats.jitterBucketsMs();
+    QCOMPARE(stats.jitterHistogram().count(), buckets.count() + 1);
+
+    // Perfectly paced frames all land in the first bucket
+    qint64 timestamp = 0;
+    for (int i = 0; i < 10; i++) {
+        stats.noteDisplayedFrame(timestamp);
+        timestamp += kFrameIntervalNs;
+    }
+    QCOMPARE(stats.jitterHistogram().at(0), 9);
+    QVERIFY(stats.jitterMs() < 0.001);
+
+    // One frame 30ms late, the next one 30ms early
+    stats.noteDisplayedFrame(timestamp + 30'000'000);
+    stats.noteDisplayedFrame(timestamp + kFrameIntervalNs);
+
+    const QList<int> histogram = stats.jitterHistogram();
+    const qsizetype bucket20to50 = buckets.indexOf(50);
+    QVERIFY(bucket20to50 > 0);
+    QCOMPARE(histogram.at(bucket20to50), 2);
+    QVERIFY(stats.jitterMs() > 1.);
+}
+
+void VideoStreamStatsTest::_testLatencyAndLateFrames()
+{
+    VideoStreamStats stats;
+    QCOMPARE(stats.latencyMs(), -1.);
+
+    stats.noteDisplayedFrame(0, 100'000'000);
+    stats.noteDisplayedFrame(kFrameIntervalNs, 200'000'000);
+    stats.noteDisplayedFrame(2 * kFrameIntervalNs, -1);
+    stats.setDroppedFrames(4);
+    stats.publish(3 * kFrameIntervalNs);
+
+    QVERIFY(qAbs(stats.latencyMs() - 150.) < 0.001);
+    QCOMPARE(stats.lateFrames(), quint64(0));
+    QCOMPARE(stats.droppedFrames(), quint64(4));
+
+    // No timestamped frames in the next interval
+    stats.noteDisplayedFrame(4 * kFrameIntervalNs);
+    stats.publish(5 * kFrameIntervalNs);
+    QCOMPARE(stats.latencyMs(), -1.);
+}
+
+void VideoStreamStatsTest::_testLateFrameDeadline()
+{
+    VideoStreamStats stats;
+
+    // Without a nominal rate the deadline follows the measured interval
+    qint64 timestamp = 0;
+    for (int i = 0; i < 10; i++) {
+        stats.noteDisplayedFrame(timestamp);
+        timestamp += kFrameIntervalNs;
+    }
+    QCOMPARE(stats.lateFrames(), quint64(0));
+
+    // 10ms behind its slot is jitter, 25ms behind misses the deadline
+    timestamp += 10'000'000;
+    stats.noteDisplayedFrame(timestamp);
+    QCOMPARE(stats.lateFrames(), quint64(0));
+    timestamp += kFrameIntervalNs + 25'000'000;
+    stats.noteDisplayedFrame(timestamp);
+    QCOMPARE(stats.lateFrames(), quint64(1));
+
+    // A nominal 60fps stream makes a 30fps cadence late on every frame
+    stats.reset();
+    stats.setFrameInterval(kFrameIntervalNs / 2);
+    stats.noteDisplayedFrame(0);
+    stats.noteDisplayedFrame(kFrameIntervalNs);
+    stats.noteDisplayedFrame(2 * kFrameIntervalNs);
+    QCOMPARE(stats.lateFrames(), quint64(2));
+}
+
+void VideoStreamStatsTest::_testReset()
+{
+    VideoStreamStats stats;
+    stats.noteDisplayedFrame(0, 10'000'000);
+    stats.noteDisplayedFrame(kFrameIntervalNs);
+    stats.noteDisplayedFrame(3 * kFrameIntervalNs);
+    stats.setDroppedFrames(2);
+    stats.publish(2 * kFrameIntervalNs);
+
+    QSignalSpy spy(&stats, &VideoStreamStats::statsChanged);
+    stats.reset();
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(stats.displayFps(), 0.);
+    QCOMPARE(stats.lateFrames(), quint64(0));
+    QCOMPARE(stats.droppedFrames(), quint64(0));
+    QCOMPARE(stats.latencyMs(), -1.);
+    QCOMPARE(stats.jitterHistogram().at(0), 0);
+}
+
+UT_REGISTER_TEST(VideoStreamStatsTest, TestLabel::Unit)
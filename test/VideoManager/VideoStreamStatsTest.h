@@ -0,0 +1,15 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class VideoStreamStatsTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testFrameRates();
+    void _testJitterHistogram();
+    void _testLatencyAndLateFrames();
+    void _testLateFrameDeadline();
+    void _testReset();
+};
@@ -1,5 +1,6 @@
 #include "OsmParserThreadTest.h"
 
+#include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QTemporaryFile>
 #include <QtTest/QSignalSpy>
@@ -207,6 +208,66 @@ void OsmParserThreadTest::_testParseMultipolygonRelation()
     QFile::remove(absolutePath);
 }
 
+void OsmParserThreadTest::_testMeshCacheRoundTrip()
+{
+    const QString absolutePath =
+        _writeResourceToTempFile(tempDirPath(), QStringLiteral(":/unittest/test_buildings.osm"),
+                                 QStringLiteral("cache_XXXXXX.osm"));
+    QVERIFY(!absolutePath.isEmpty());
+    const QString cacheDir = QDir(tempDirPath()).filePath(QStringLiteral("OsmMeshCache"));
+
+    OsmParserThread parsed;
+    parsed.setCacheDirectory(cacheDir);
+    QSignalSpy parsedSpy(&parsed, &OsmParserThread::fileParsed);
+    parsed._parseOsmFile(absolutePath);
+    QCOMPARE(parsedSpy.count(), 1);
+    QVERIFY(parsedSpy.first().at(0).toBool());
+    QVERIFY(!parsed.loadedFromCache());
+    QCOMPARE(QDir(cacheDir).entryList(QDir::Files).count(), 1);
+
+    // Roofs are triangulated while parsing
+    QVERIFY(!parsed.mapBuildings().value(200).roof_indices.empty());
+
+    OsmParserThread cached;
+    cached.setCacheDirectory(cacheDir);
+    QSignalSpy cachedSpy(&cached, &OsmParserThread::fileParsed);
+    cached._parseOsmFile(absolutePath);
+    QCOMPARE(cachedSpy.count(), 1);
+    QVERIFY(cachedSpy.first().at(0).toBool());
+    QVERIFY(cached.loadedFromCache());
+    QVERIFY(cached.mapNodes().isEmpty());
+    QCOMPARE(cached.gpsRefPoint(), parsed.gpsRefPoint());
+    QCOMPARE(cached.coordinateMin(), parsed.coordinateMin());
+    QCOMPARE(cached.coordinateMax(), parsed.coordinateMax());
+
+    for (auto it = parsed.mapBuildings().cbegin(); it != parsed.mapBuildings().cend(); ++it) {
+        if (!it.value().hasHeight()) {
+            QVERIFY(!cached.mapBuildings().contains(it.key()));
+            continue;
+        }
+        QVERIFY(cached.mapBuildings().contains(it.key()));
+        const auto &building = cached.mapBuildings().value(it.key());
+        QCOMPARE(building.height, it.value().height);
+        QCOMPARE(building.levels, it.value().levels);
+        QVERIFY(building.points_local == it.value().points_local);
+        QVERIFY(building.points_local_inner == it.value().points_local_inner);
+        QVERIFY(building.roof_indices == it.value().roof_indices);
+    }
+
+    // A different source file must not hit the cache
+    QFile source(absolutePath);
+    QVERIFY(source.open(QIODevice::Append));
+    source.write("\n");
+    source.close();
+
+    OsmParserThread changed;
+    changed.setCacheDirectory(cacheDir);
+    changed._parseOsmFile(absolutePath);
+    QVERIFY(!changed.loadedFromCache());
+
+    QFile::remove(absolutePath);
+}
+
 void OsmParserThreadTest::_benchmarkParseOsmFile()
 {
     const QString absolutePath = _writeResourceToTempFile(tempDirPath(), QStringLiteral(":/unittest/map_sim_small.osm"),
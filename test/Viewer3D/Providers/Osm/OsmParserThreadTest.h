@@ -14,5 +14,6 @@ private slots:
     void _testBuildingTypeBoundingBox();
     void _testParseMultipleBuildings();
     void _testParseMultipolygonRelation();
+    void _testMeshCacheRoundTrip();
     void _benchmarkParseOsmFile();
 };
@@ -4,6 +4,39 @@
 
 #include "Viewer3DTerrainGeometry.h"
 
+#include <array>
+#include <cstring>
+
+namespace {
+
+const QGeoCoordinate kRoiMin(47.0, 8.0, 0);
+const QGeoCoordinate kRoiMax(47.01, 8.01, 0);
+const QGeoCoordinate kRef(47.005, 8.005, 0);
+
+/// Builds the terrain through the production path and waits for the buffers to be swapped in
+bool buildAndWait(Viewer3DTerrainGeometry &geo, int sectorCount, int stackCount)
+{
+    const qsizetype expectedIndexBytes = qsizetype(sectorCount) * stackCount * 6 * qsizetype(sizeof(uint32_t));
+    geo.setSectorCount(sectorCount);
+    geo.setStackCount(stackCount);
+    geo.setRoiMin(kRoiMin);
+    geo.setRoiMax(kRoiMax);
+    geo.setRefCoordinate(kRef);
+    geo.updateEarthData();
+    return QTest::qWaitFor([&geo, expectedIndexBytes]() { return geo.indexData().size() == expectedIndexBytes; }, TestTimeout::mediumMs());
+}
+
+/// Reads floats [offset, offset + N) of the interleaved vertex at index
+template<size_t N>
+std::array<float, N> vertexFloats(const Viewer3DTerrainGeometry &geo, qsizetype index, int offsetFloats)
+{
+    std::array<float, N> values{};
+    (void) std::memcpy(values.data(), geo.vertexData().constData() + (index * geo.stride()) + (offsetFloats * qsizetype(sizeof(float))), sizeof(values));
+    return values;
+}
+
+} // namespace
+
 void Viewer3DTerrainGeometryTest::_testComputeFaceNormal()
 {
     Viewer3DTerrainGeometry geo;
@@ -41,55 +74,35 @@ void Viewer3DTerrainGeometryTest::_testBuildTerrainZeroCounts()
 
     geo.setSectorCount(0);
     geo.setStackCount(0);
+    geo.setRoiMin(kRoiMin);
+    geo.setRoiMax(kRoiMax);
+    geo.setRefCoordinate(kRef);
 
-    QGeoCoordinate roiMin(47.0, 8.0, 0);
-    QGeoCoordinate roiMax(47.1, 8.1, 0);
-    QGeoCoordinate ref(47.05, 8.05, 0);
-
-    bool result = geo._buildTerrain(roiMin, roiMax, ref, true);
-    QVERIFY(!result);
+    QVERIFY(!geo._hasRequest);
+    QVERIFY(geo.vertexData().isEmpty());
+    QVERIFY(geo.indexData().isEmpty());
 }
 
 void Viewer3DTerrainGeometryTest::_testBuildTerrainValidRegion()
 {
     Viewer3DTerrainGeometry geo;
+    QVERIFY(buildAndWait(geo, 2, 2));
 
-    geo.setSectorCount(2);
-    geo.setStackCount(2);
-
-    QGeoCoordinate roiMin(47.0, 8.0, 0);
-    QGeoCoordinate roiMax(47.01, 8.01, 0);
-    QGeoCoordinate ref(47.005, 8.005, 0);
-
-    bool result = geo._buildTerrain(roiMin, roiMax, ref, true);
-    QVERIFY(result);
-
-    QVERIFY(!geo._vertices.empty());
-    QVERIFY(!geo._normals.empty());
-    QVERIFY(!geo._texCoords.empty());
-    QCOMPARE(geo._vertices.size(), geo._normals.size());
-    QCOMPARE(geo._vertices.size(), geo._texCoords.size());
+    QCOMPARE(geo.stride(), Viewer3DTerrainGeometry::kStride);
+    QCOMPARE(geo.vertexData().size(), qsizetype(3 * 3 * Viewer3DTerrainGeometry::kStride));
+    QCOMPARE(geo.primitiveType(), QQuick3DGeometry::PrimitiveType::Triangles);
+    QCOMPARE(geo.attributeCount(), 4);
 }
 
 void Viewer3DTerrainGeometryTest::_testClearScene()
 {
     Viewer3DTerrainGeometry geo;
-
-    geo.setSectorCount(2);
-    geo.setStackCount(2);
-
-    QGeoCoordinate roiMin(47.0, 8.0, 0);
-    QGeoCoordinate roiMax(47.01, 8.01, 0);
-    QGeoCoordinate ref(47.005, 8.005, 0);
-
-    geo._buildTerrain(roiMin, roiMax, ref, true);
-    QVERIFY(!geo._vertices.empty());
+    QVERIFY(buildAndWait(geo, 2, 2));
 
     geo._clearScene();
 
-    QVERIFY(geo._vertices.empty());
-    QVERIFY(geo._normals.empty());
-    QVERIFY(geo._texCoords.empty());
+    QVERIFY(geo.vertexData().isEmpty());
+    QVERIFY(geo.indexData().isEmpty());
     QCOMPARE(geo.sectorCount(), 0);
     QCOMPARE(geo.stackCount(), 0);
 }
@@ -114,28 +127,77 @@ void Viewer3DTerrainGeometryTest::_testBuildTerrainVertexCountScaling()
 {
     Viewer3DTerrainGeometry geo;
 
-    QGeoCoordinate roiMin(47.0, 8.0, 0);
-    QGeoCoordinate roiMax(47.01, 8.01, 0);
-    QGeoCoordinate ref(47.005, 8.005, 0);
-
     // 2x2 grid
-    geo.setSectorCount(2);
-    geo.setStackCount(2);
-    geo._buildTerrain(roiMin, roiMax, ref, true);
-    const size_t count2x2 = geo._vertices.size();
+    QVERIFY(buildAndWait(geo, 2, 2));
+    const qsizetype count2x2 = geo.vertexData().size() / geo.stride();
 
     // 4x4 grid should produce more vertices
-    geo._vertices.clear();
-    geo._normals.clear();
-    geo._texCoords.clear();
-    geo.setSectorCount(4);
-    geo.setStackCount(4);
-    geo._buildTerrain(roiMin, roiMax, ref, true);
-    const size_t count4x4 = geo._vertices.size();
+    QVERIFY(buildAndWait(geo, 4, 4));
+    const qsizetype count4x4 = geo.vertexData().size() / geo.stride();
 
     QVERIFY(count4x4 > count2x2);
 }
 
+void Viewer3DTerrainGeometryTest::_testBuildTerrainIndexed()
+{
+    Viewer3DTerrainGeometry geo;
+
+    constexpr int kSectors = 8;
+    constexpr int kStacks = 6;
+    QVERIFY(buildAndWait(geo, kSectors, kStacks));
+
+    // One shared vertex per grid point, two triangles per cell
+    const qsizetype vertexCount = geo.vertexData().size() / geo.stride();
+    QCOMPARE(vertexCount, qsizetype((kSectors + 1) * (kStacks + 1)));
+    const qsizetype indexCount = geo.indexData().size() / qsizetype(sizeof(uint32_t));
+    QCOMPARE(indexCount, qsizetype(kSectors * kStacks * 6));
+    for (qsizetype i = 0; i < indexCount; ++i) {
+        uint32_t index = 0;
+        (void) std::memcpy(&index, geo.indexData().constData() + (i * qsizetype(sizeof(uint32_t))), sizeof(index));
+        QVERIFY(index < uint32_t(vertexCount));
+    }
+
+    // The plane is flat, so the smoothed normals are unit length and all face the same way
+    const std::array<float, 3> first = vertexFloats<3>(geo, 0, 3);
+    const QVector3D firstNormal(first[0], first[1], first[2]);
+    for (qsizetype i = 0; i < vertexCount; ++i) {
+        const std::array<float, 3> n = vertexFloats<3>(geo, i, 3);
+        const QVector3D normal(n[0], n[1], n[2]);
+        QCOMPARE_FUZZY(normal.length(), 1.0f, 0.0001f);
+        QCOMPARE_FUZZY(QVector3D::dotProduct(normal, firstNormal), 1.0f, 0.0001f);
+
+        const std::array<float, 2> uv = vertexFloats<2>(geo, i, 6);
+        QVERIFY(uv[0] >= -0.0001f && uv[0] <= 1.0001f);
+        QVERIFY(uv[1] >= -0.0001f && uv[1] <= 1.0001f);
+    }
+}
+
+void Viewer3DTerrainGeometryTest::_testUpdateEarthDataAsync()
+{
+    Viewer3DTerrainGeometry geo;
+
+    geo.setSectorCount(4);
+    geo.setStackCount(3);
+    geo.setRoiMin(QGeoCoordinate(47.0, 8.0, 0));
+    geo.setRoiMax(QGeoCoordinate(47.01, 8.01, 0));
+
+    // Setting the reference coordinate starts a build on the thread pool
+    geo.setRefCoordinate(QGeoCoordinate(47.005, 8.005, 0));
+    QTRY_VERIFY_WITH_TIMEOUT(!geo.vertexData().isEmpty(), TestTimeout::mediumMs());
+    QCOMPARE(geo.vertexData().size(), qsizetype(5 * 4 * Viewer3DTerrainGeometry::kStride));
+    QCOMPARE(geo.indexData().size(), qsizetype(4 * 3 * 6 * sizeof(uint32_t)));
+
+    // Same inputs again, nothing to rebuild
+    const int generation = geo._buildGeneration;
+    geo.updateEarthData();
+    QCOMPARE(geo._buildGeneration, generation);
+
+    geo.setStackCount(5);
+    geo.updateEarthData();
+    QCOMPARE(geo._buildGeneration, generation + 1);
+    QTRY_COMPARE_WITH_TIMEOUT(geo.indexData().size(), qsizetype(4 * 5 * 6 * sizeof(uint32_t)), TestTimeout::mediumMs());
+}
+
 void Viewer3DTerrainGeometryTest::_testRoiSetters()
 {
     Viewer3DTerrainGeometry geo;
@@ -200,4 +262,17 @@ void Viewer3DTerrainGeometryTest::_testPropertySetters()
     }
 }
 
+void Viewer3DTerrainGeometryTest::_benchmarkBuildTerrain()
+{
+    // Largest grid the tile loader produces is about 200 tiles, benchmark well above it
+    const Viewer3DTerrainGeometry::BuildParams_t params{
+        256, 256, QGeoCoordinate(47.0, 8.0, 0), QGeoCoordinate(47.2, 8.3, 0), QGeoCoordinate(47.1, 8.15, 0)};
+
+    QBENCHMARK
+    {
+        Viewer3DTerrainGeometry::TerrainMesh_t mesh = Viewer3DTerrainGeometry::_buildTerrainMesh(params, true);
+        Viewer3DTerrainGeometry::_packTerrainMesh(mesh);
+    }
+}
+
 UT_REGISTER_TEST(Viewer3DTerrainGeometryTest, TestLabel::Unit)
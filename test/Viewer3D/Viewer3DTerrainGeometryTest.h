@@ -15,7 +15,10 @@ private slots:
     void _testBuildTerrainZeroCounts();
     void _testBuildTerrainValidRegion();
     void _testBuildTerrainVertexCountScaling();
+    void _testBuildTerrainIndexed();
+    void _testUpdateEarthDataAsync();
     void _testClearScene();
     void _testPropertySetters();
     void _testRoiSetters();
+    void _benchmarkBuildTerrain();
 };
@@ -1,5 +1,11 @@
 #include "Viewer3DTileQueryTest.h"
 
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QBuffer>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFuture>
+#include <QtGui/QColor>
+#include <QtGui/QImage>
 #include <QtPositioning/QGeoCoordinate>
 
 #include "MapProvider.h"
@@ -61,4 +67,69 @@ void Viewer3DTileQueryTest::_testTileCoordinateRoundTrip()
     }
 }
 
+void Viewer3DTileQueryTest::_testMapTextureAssembly()
+{
+    using MapTileContainer_t = Viewer3DTileQuery::MapTileContainer_t;
+
+    // Fixed fixture: 12 x 12 PNG tiles, each filled with a color derived from its index
+    constexpr int kTilesPerSide = 12;
+    const QPoint tileMinIndex(1000, 2000);
+    const auto tileColor = [](int x, int y) { return QColor(x * 20, y * 20, 0x80); };
+
+    QList<QByteArray> tileFiles;
+    for (int y = 0; y < kTilesPerSide; y++) {
+        for (int x = 0; x < kTilesPerSide; x++) {
+            QImage tile(MapTileContainer_t::tileSize, MapTileContainer_t::tileSize, QImage::Format_RGB32);
+            tile.fill(tileColor(x, y));
+            QByteArray png;
+            QBuffer buffer(&png);
+            QVERIFY(buffer.open(QIODevice::WriteOnly));
+            QVERIFY(tile.save(&buffer, "PNG"));
+            tileFiles.append(png);
+        }
+    }
+
+    QElapsedTimer buildTimer;
+    buildTimer.start();
+
+    MapTileContainer_t container;
+    container.tileMinIndex = tileMinIndex;
+    container.tileMaxIndex = tileMinIndex + QPoint(kTilesPerSide - 1, kTilesPerSide - 1);
+    container.init();
+
+    QList<QFuture<QImage>> decodes;
+    for (const QByteArray &tileFile : std::as_const(tileFiles)) {
+        decodes.append(QtConcurrent::run(&MapTileContainer_t::decodeTile, tileFile));
+    }
+    for (qsizetype i = 0; i < decodes.count(); i++) {
+        const QPoint tileIndex = tileMinIndex + QPoint(static_cast<int>(i % kTilesPerSide), static_cast<int>(i / kTilesPerSide));
+        container.setMapTile(tileIndex, decodes[i].result());
+    }
+
+    const qint64 buildMs = buildTimer.elapsed();
+
+    const int mapSide = kTilesPerSide * MapTileContainer_t::tileSize;
+    QCOMPARE(container.mapWidth, mapSide);
+    QCOMPARE(container.mapHeight, mapSide);
+    QCOMPARE(container.mapTextureData.size(), qsizetype(mapSide) * mapSide * MapTileContainer_t::bytesPerPixel);
+
+    // Sample the center of every tile
+    const auto *bits = reinterpret_cast<const uchar *>(container.mapTextureData.constData());
+    for (int y = 0; y < kTilesPerSide; y++) {
+        for (int x = 0; x < kTilesPerSide; x++) {
+            const int px = (x * MapTileContainer_t::tileSize) + (MapTileContainer_t::tileSize / 2);
+            const int py = (y * MapTileContainer_t::tileSize) + (MapTileContainer_t::tileSize / 2);
+            const uchar *pixel = bits + ((qsizetype(py) * mapSide + px) * MapTileContainer_t::bytesPerPixel);
+            const QColor expected = tileColor(x, y);
+            QCOMPARE(int(pixel[0]), expected.red());
+            QCOMPARE(int(pixel[1]), expected.green());
+            QCOMPARE(int(pixel[2]), expected.blue());
+            QCOMPARE(int(pixel[3]), 0xFF);
+        }
+    }
+
+    qDebug() << "Map texture" << mapSide << "x" << mapSide << "from" << tileFiles.count() << "tiles:"
+             << container.mapTextureData.size() / 1024 << "kB, built in" << buildMs << "ms";
+}
+
 UT_REGISTER_TEST(Viewer3DTileQueryTest, TestLabel::Unit)
@@ -11,4 +11,5 @@ class Viewer3DTileQueryTest : public UnitTest
 private slots:
     void _testMaxTileCount();
     void _testTileCoordinateRoundTrip();
+    void _testMapTextureAssembly();
 };